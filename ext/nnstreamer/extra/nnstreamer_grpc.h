@@ -39,9 +39,19 @@ typedef enum {
 typedef enum {
   GRPC_DIRECTION_NONE = 0,
   GRPC_DIRECTION_TENSORS_TO_BUFFER, /* from tensors to protobuf/flatbuf */
-  GRPC_DIRECTION_BUFFER_TO_TENSORS  /* from protobuf/flatbuf to tensors */
+  GRPC_DIRECTION_BUFFER_TO_TENSORS, /* from protobuf/flatbuf to tensors */
+  GRPC_DIRECTION_BIDIRECTIONAL      /* requests and responses on the same stream */
 } grpc_direction;
 
+/**
+ * @brief enum for the policy to fan in concurrent client streams (server only)
+ */
+typedef enum {
+  GRPC_FANIN_NONE = 0,
+  GRPC_FANIN_FIFO,        /* deliver buffers in arrival order over all clients */
+  GRPC_FANIN_ROUND_ROBIN  /* deliver one buffer from each client in turn */
+} grpc_fanin;
+
 /**
  * @brief structure for grpc configuration
  */
@@ -54,6 +64,13 @@ typedef struct {
 
   gboolean is_server;
   gboolean is_blocking;
+  gboolean is_invoke; /* request/response mode shared by src and sink */
+
+  guint num_threads;  /* number of completion queue threads (non-blocking server) */
+  guint queue_size;   /* max buffers held per client stream (0: unlimited) */
+  grpc_fanin fanin;
+
+  guint max_in_flight; /* max requests not responded yet (invoke mode) */
 
   grpc_cb cb;
   void *cb_data;
@@ -77,6 +94,11 @@ enum
   PROP_HOST,
   PROP_PORT,
   PROP_OUT,
+  PROP_NUM_THREADS,
+  PROP_QUEUE_SIZE,
+  PROP_FANIN,
+  PROP_INVOKE,
+  PROP_MAX_IN_FLIGHT,
 };
 
 /**
@@ -87,10 +109,15 @@ extern "C" {
 #endif
 
 grpc_idl grpc_get_idl (const gchar *idl_str);
+grpc_fanin grpc_get_fanin (const gchar *fanin_str);
 
 void * grpc_new (const grpc_config * config);
 void grpc_destroy (void * instance);
 
+void * grpc_lookup (const grpc_config * config, guint timeout_ms);
+void grpc_set_send_config (void * instance, const GstTensorsConfig * config);
+void grpc_release (void * instance);
+
 gboolean grpc_start (void * instance);
 void grpc_stop (void * instance);
 
@@ -25,8 +25,90 @@
 #define NNS_GRPC_FLATBUF_NAME    "libnnstreamer_grpc_flatbuf.so"
 #define NNS_GRPC_CREATE_INSTANCE "create_instance"
 
+/**
+ * @brief Default max number of requests not responded yet (invoke mode)
+ */
+#define DEFAULT_MAX_IN_FLIGHT    (4U)
+
+/**
+ * @brief Timeout of a request not responded (invoke mode, msec).
+ * The request is regarded as dropped in the pipeline after the timeout.
+ */
+#define INVOKE_REQUEST_TIMEOUT   (10000U)
+
 using namespace grpc;
 
+/** @brief instances serving request/response streams, shared by src and sink */
+static std::mutex invoke_registry_lock;
+static std::condition_variable invoke_registry_cond;
+static std::map<std::string, NNStreamerRPC *> invoke_registry;
+
+/**
+ * @brief GstMetaGRPCInvoke meta to correlate a response with its request.
+ */
+typedef struct {
+  GstMeta meta;
+  guint64 id; /**< id of the request */
+} GstMetaGRPCInvoke;
+
+/** @brief get the type of the invoke meta */
+static GType
+gst_meta_grpc_invoke_api_get_type (void)
+{
+  static volatile GType type;
+  /* no tags, so that the meta is kept while transforming the buffer */
+  static const gchar *tags[] = { NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type;
+    const GstMetaInfo *meta_info = gst_meta_get_info ("GstMetaGRPCInvoke");
+
+    if (meta_info)
+      _type = meta_info->api;
+    else
+      _type = gst_meta_api_type_register ("GstMetaGRPCInvokeAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+/** @brief init the invoke meta */
+static gboolean
+gst_meta_grpc_invoke_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
+{
+  ((GstMetaGRPCInvoke *) meta)->id = 0;
+  return TRUE;
+}
+
+/** @brief transform the invoke meta (source to dest) */
+static gboolean
+gst_meta_grpc_invoke_transform (GstBuffer * transbuf, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  NNStreamerRPC::set_invoke_id (transbuf, ((GstMetaGRPCInvoke *) meta)->id);
+  return TRUE;
+}
+
+/** @brief get the info of the invoke meta */
+static const GstMetaInfo *
+gst_meta_grpc_invoke_get_info (void)
+{
+  static const GstMetaInfo *meta_info = NULL;
+
+  if (g_once_init_enter (&meta_info)) {
+    const GstMetaInfo *mi = gst_meta_get_info ("GstMetaGRPCInvoke");
+
+    if (mi == NULL)
+      mi = gst_meta_register (gst_meta_grpc_invoke_api_get_type (),
+          "GstMetaGRPCInvoke", sizeof (GstMetaGRPCInvoke),
+          (GstMetaInitFunction) gst_meta_grpc_invoke_init,
+          (GstMetaFreeFunction) NULL,
+          (GstMetaTransformFunction) gst_meta_grpc_invoke_transform);
+    g_once_init_leave (&meta_info, mi);
+  }
+  return meta_info;
+}
+
 /** @brief create new instance of NNStreamerRPC */
 NNStreamerRPC *
 NNStreamerRPC::createInstance (const grpc_config * config)
@@ -74,17 +156,81 @@ NNStreamerRPC::createInstance (const grpc_config * config)
 NNStreamerRPC::NNStreamerRPC (const grpc_config * config):
   host_ (config->host), port_ (config->port),
   is_server_ (config->is_server), is_blocking_ (config->is_blocking),
+  num_threads_ (MAX (config->num_threads, 1U)),
+  queue_size_ (config->queue_size), fanin_ (config->fanin),
+  max_in_flight_ (config->max_in_flight > 0 ?
+      config->max_in_flight : DEFAULT_MAX_IN_FLIGHT),
   direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
   config_ (config->config), server_instance_ (nullptr), handle_ (nullptr),
-  stop_ (false)
+  stop_ (false), fanin_seq_ (0), fanin_stop_ (false), invoke_id_ (0),
+  requested_port_ (config->port), send_config_ (config->config),
+  refcount_ (1)
 {
   queue_ = gst_data_queue_new (_data_queue_check_full_cb,
       NULL, NULL, NULL);
+  gst_tensors_config_init (&send_config_copy_);
 }
 
 /** @brief destructor of NNStreamerRPC */
 NNStreamerRPC::~NNStreamerRPC () {
+  unregister_invoke ();
+  _fanin_stop ();
   g_clear_pointer (&queue_, gst_object_unref);
+  gst_tensors_info_free (&send_config_copy_.info);
+}
+
+/**
+ * @brief set the config of tensors to be sent.
+ * The config is copied, because the element sharing the instance
+ * (invoke mode) may be finalized before the instance.
+ */
+void
+NNStreamerRPC::setSendConfig (const GstTensorsConfig *config) {
+  g_return_if_fail (config != NULL);
+
+  std::lock_guard<std::mutex> lock (send_config_lock_);
+
+  gst_tensors_info_free (&send_config_copy_.info);
+  gst_tensors_config_copy (&send_config_copy_, config);
+  send_config_ = &send_config_copy_;
+}
+
+/** @brief get the copy of the config of tensors to be sent */
+void
+NNStreamerRPC::getSendConfig (GstTensorsConfig *config) {
+  g_return_if_fail (config != NULL);
+
+  std::lock_guard<std::mutex> lock (send_config_lock_);
+
+  gst_tensors_config_copy (config, send_config_);
+}
+
+/** @brief set the id of the request to the buffer (invoke mode) */
+void
+NNStreamerRPC::set_invoke_id (GstBuffer *buffer, guint64 id) {
+  GstMetaGRPCInvoke *meta;
+
+  meta = (GstMetaGRPCInvoke *) gst_buffer_get_meta (buffer,
+      gst_meta_grpc_invoke_api_get_type ());
+  if (meta == NULL)
+    meta = (GstMetaGRPCInvoke *) gst_buffer_add_meta (buffer,
+        gst_meta_grpc_invoke_get_info (), NULL);
+
+  meta->id = id;
+}
+
+/** @brief get the id of the request from the buffer (invoke mode) */
+gboolean
+NNStreamerRPC::get_invoke_id (GstBuffer *buffer, guint64 *id) {
+  GstMetaGRPCInvoke *meta;
+
+  meta = (GstMetaGRPCInvoke *) gst_buffer_get_meta (buffer,
+      gst_meta_grpc_invoke_api_get_type ());
+  if (meta == NULL)
+    return FALSE;
+
+  *id = meta->id;
+  return TRUE;
 }
 
 /** @brief start gRPC server */
@@ -93,10 +239,23 @@ NNStreamerRPC::start () {
   if (direction_ == GRPC_DIRECTION_NONE)
     return FALSE;
 
-  if (is_server_)
-    return _start_server ();
-  else
-    return _start_client ();
+  if (is_server_) {
+    /* fan in concurrent client streams of the non-blocking server */
+    if (!is_blocking_ && direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS &&
+        fanin_ != GRPC_FANIN_NONE && !fanin_worker_.joinable ())
+      fanin_worker_ = std::thread ([this] { this->_fanin_thread (); });
+
+    if (!_start_server ())
+      return FALSE;
+  } else {
+    if (!_start_client ())
+      return FALSE;
+  }
+
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL)
+    return register_invoke ();
+
+  return TRUE;
 }
 
 /** @brief stop the thread */
@@ -108,6 +267,11 @@ NNStreamerRPC::stop () {
   /* notify to the worker */
   stop_ = true;
 
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    std::lock_guard<std::mutex> lock (invoke_lock_);
+    invoke_cond_.notify_all ();
+  }
+
   if (queue_) {
     /* wait until the queue's flushed */
     while (!gst_data_queue_is_empty (queue_))
@@ -117,23 +281,50 @@ NNStreamerRPC::stop () {
   }
 
   if (is_server_) {
-    if (server_instance_.get ())
-      server_instance_->Shutdown ();
+    if (server_instance_.get ()) {
+      if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+        /* cancel the request/response streams of connected clients */
+        server_instance_->Shutdown (std::chrono::system_clock::now () +
+            std::chrono::milliseconds (100));
+      } else {
+        server_instance_->Shutdown ();
+      }
+    }
+
+    for (auto &cq : completion_queues_)
+      cq->Shutdown ();
+  }
 
-    if (completion_queue_.get ())
-      completion_queue_->Shutdown ();
+  for (auto &server_worker : server_workers_) {
+    if (server_worker.joinable ())
+      server_worker.join ();
   }
 
   if (worker_.joinable ())
     worker_.join ();
+
+  _fanin_stop ();
 }
 
 /** @brief send buffer holding tensors */
 gboolean
 NNStreamerRPC::send (GstBuffer *buffer) {
   GstDataQueueItem *item;
+  guint64 seq = 0;
+
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    if (is_server_)
+      return _invoke_send_response (buffer);
 
-  buffer = gst_buffer_ref (buffer);
+    if (!_invoke_send_request (&seq))
+      return FALSE;
+
+    /* shallow copy sharing the memories, to tag the sequence number */
+    buffer = gst_buffer_copy (buffer);
+    set_invoke_id (buffer, seq);
+  } else {
+    buffer = gst_buffer_ref (buffer);
+  }
 
   item = g_new0 (GstDataQueueItem, 1);
   item->object = GST_MINI_OBJECT (buffer);
@@ -143,12 +334,485 @@ NNStreamerRPC::send (GstBuffer *buffer) {
 
   if (!gst_data_queue_push (queue_, item)) {
     item->destroy (item);
+
+    if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+      std::lock_guard<std::mutex> lock (invoke_lock_);
+
+      invoke_pending_.erase (seq);
+      invoke_cond_.notify_all ();
+    }
     return FALSE;
   }
 
   return TRUE;
 }
 
+/** @brief register a new client stream to be fanned in */
+ClientQueue *
+NNStreamerRPC::fanin_open () {
+  if (!fanin_worker_.joinable ())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock (fanin_lock_);
+
+  clients_.emplace_back ();
+  clients_.back ().dropped = 0;
+  clients_.back ().closed = FALSE;
+
+  return &clients_.back ();
+}
+
+/** @brief notify that the client stream is finished */
+void
+NNStreamerRPC::fanin_close (ClientQueue *client) {
+  g_return_if_fail (client != NULL);
+
+  std::lock_guard<std::mutex> lock (fanin_lock_);
+
+  client->closed = TRUE;
+  if (client->dropped > 0)
+    ml_logw ("%u buffers of a client stream were dropped", client->dropped);
+
+  fanin_cond_.notify_one ();
+}
+
+/** @brief push the buffer to the client queue, dropping the oldest if full */
+void
+NNStreamerRPC::fanin_push (ClientQueue *client, GstBuffer *buffer) {
+  g_return_if_fail (client != NULL);
+
+  std::lock_guard<std::mutex> lock (fanin_lock_);
+
+  if (fanin_stop_) {
+    gst_buffer_unref (buffer);
+    return;
+  }
+
+  if (queue_size_ > 0 && client->buffers.size () >= queue_size_) {
+    gst_buffer_unref (client->buffers.front ().second);
+    client->buffers.pop_front ();
+    client->dropped++;
+  }
+
+  client->buffers.emplace_back (fanin_seq_++, buffer);
+  fanin_cond_.notify_one ();
+}
+
+/** @brief pick the next buffer according to the fan-in policy (locked) */
+GstBuffer *
+NNStreamerRPC::_fanin_pop () {
+  std::list<ClientQueue>::iterator next = clients_.end ();
+  std::list<ClientQueue>::iterator it = clients_.begin ();
+  GstBuffer *buffer;
+
+  while (it != clients_.end ()) {
+    if (it->buffers.empty ()) {
+      if (it->closed)
+        it = clients_.erase (it);
+      else
+        it++;
+      continue;
+    }
+
+    if (next == clients_.end () ||
+        it->buffers.front ().first < next->buffers.front ().first)
+      next = it;
+
+    /* round-robin: the first non-empty one, as served clients move back */
+    if (fanin_ == GRPC_FANIN_ROUND_ROBIN)
+      break;
+    it++;
+  }
+
+  if (next == clients_.end ())
+    return NULL;
+
+  buffer = next->buffers.front ().second;
+  next->buffers.pop_front ();
+
+  if (fanin_ == GRPC_FANIN_ROUND_ROBIN)
+    clients_.splice (clients_.end (), clients_, next);
+
+  return buffer;
+}
+
+/** @brief fan-in thread delivering buffers of all clients via callback */
+void
+NNStreamerRPC::_fanin_thread () {
+  std::unique_lock<std::mutex> lock (fanin_lock_);
+
+  while (!fanin_stop_) {
+    GstBuffer *buffer = _fanin_pop ();
+
+    if (buffer == NULL) {
+      fanin_cond_.wait (lock);
+      continue;
+    }
+
+    /**
+     * do not hold the lock while the callback pushes the buffer, it waits
+     * until the element takes the previous one (back-pressure to clients)
+     */
+    lock.unlock ();
+
+    if (cb_)
+      cb_ (cb_data_, buffer);
+    else
+      gst_buffer_unref (buffer);
+
+    lock.lock ();
+  }
+}
+
+/** @brief stop the fan-in thread and release pending buffers */
+void
+NNStreamerRPC::_fanin_stop () {
+  {
+    std::lock_guard<std::mutex> lock (fanin_lock_);
+    fanin_stop_ = true;
+    fanin_cond_.notify_all ();
+  }
+
+  if (fanin_worker_.joinable ())
+    fanin_worker_.join ();
+
+  for (auto &client : clients_) {
+    for (auto &item : client.buffers)
+      gst_buffer_unref (item.second);
+  }
+  clients_.clear ();
+}
+
+/** @brief open a request/response stream of a client (server only) */
+InvokeStream *
+NNStreamerRPC::invoke_open () {
+  InvokeStream *stream = new InvokeStream;
+
+  stream->pending = 0;
+  stream->closed = FALSE;
+
+  return stream;
+}
+
+/** @brief notify that the client finished sending requests */
+void
+NNStreamerRPC::invoke_close (InvokeStream *stream) {
+  g_return_if_fail (stream != NULL);
+
+  std::lock_guard<std::mutex> lock (invoke_lock_);
+
+  stream->closed = TRUE;
+  invoke_cond_.notify_all ();
+}
+
+/** @brief release the stream, dropping requests not responded yet */
+void
+NNStreamerRPC::invoke_release (InvokeStream *stream) {
+  g_return_if_fail (stream != NULL);
+
+  {
+    std::lock_guard<std::mutex> lock (invoke_lock_);
+    auto it = invoke_pending_.begin ();
+
+    while (it != invoke_pending_.end ()) {
+      if (it->second.stream == stream)
+        it = invoke_pending_.erase (it);
+      else
+        it++;
+    }
+  }
+
+  for (auto &item : stream->responses)
+    gst_buffer_unref (item.second);
+  delete stream;
+}
+
+/**
+ * @brief deliver a request of the stream to the pipeline (server only).
+ * It waits while the stream has too many requests in flight, which in turn
+ * throttles the client by the flow control of gRPC.
+ */
+gboolean
+NNStreamerRPC::invoke_request (InvokeStream *stream, guint64 seq,
+    GstBuffer *buffer) {
+  InvokeRequest request;
+  guint64 id;
+
+  g_return_val_if_fail (stream != NULL, FALSE);
+
+  {
+    std::unique_lock<std::mutex> lock (invoke_lock_);
+
+    _invoke_wait (lock, [this, stream] {
+      return stream->pending < max_in_flight_;
+    });
+
+    if (stop_) {
+      gst_buffer_unref (buffer);
+      return FALSE;
+    }
+
+    request.stream = stream;
+    request.seq = seq;
+    request.deadline = std::chrono::steady_clock::now () +
+        std::chrono::milliseconds (INVOKE_REQUEST_TIMEOUT);
+
+    /* the id is unique over all streams and correlates the response */
+    id = invoke_id_++;
+    invoke_pending_[id] = request;
+    stream->pending++;
+  }
+
+  set_invoke_id (buffer, id);
+
+  if (cb_)
+    cb_ (cb_data_, buffer);
+  else
+    gst_buffer_unref (buffer);
+
+  return TRUE;
+}
+
+/** @brief wait and pop the next response of the stream (server only) */
+gboolean
+NNStreamerRPC::invoke_pop_response (InvokeStream *stream, GstBuffer **buffer,
+    guint64 *seq) {
+  g_return_val_if_fail (stream != NULL, FALSE);
+
+  std::unique_lock<std::mutex> lock (invoke_lock_);
+
+  _invoke_wait (lock, [stream] {
+    return !stream->responses.empty () ||
+        (stream->closed && stream->pending == 0);
+  });
+
+  if (stream->responses.empty ())
+    return FALSE;
+
+  *seq = stream->responses.front ().first;
+  *buffer = stream->responses.front ().second;
+  stream->responses.pop_front ();
+  stream->pending--;
+
+  invoke_cond_.notify_all ();
+  return TRUE;
+}
+
+/**
+ * @brief notify that the response of the request is received (client only).
+ * The server responds in order of the requests, so the former requests
+ * not responded yet were dropped in the server pipeline.
+ */
+void
+NNStreamerRPC::invoke_done (guint64 seq) {
+  std::lock_guard<std::mutex> lock (invoke_lock_);
+
+  _invoke_retire (invoke_pending_.lower_bound (seq), NULL);
+  invoke_pending_.erase (seq);
+  invoke_cond_.notify_all ();
+}
+
+/** @brief wait until a request is allowed to be in flight (client only) */
+gboolean
+NNStreamerRPC::_invoke_send_request (guint64 *seq) {
+  std::unique_lock<std::mutex> lock (invoke_lock_);
+  InvokeRequest request;
+
+  _invoke_wait (lock, [this] {
+    return invoke_pending_.size () < max_in_flight_;
+  });
+
+  if (stop_)
+    return FALSE;
+
+  request.stream = NULL;
+  request.seq = invoke_id_;
+  request.deadline = std::chrono::steady_clock::now () +
+      std::chrono::milliseconds (INVOKE_REQUEST_TIMEOUT);
+
+  *seq = invoke_id_++;
+  invoke_pending_[*seq] = request;
+  return TRUE;
+}
+
+/** @brief route the response to the stream of its request (server only) */
+gboolean
+NNStreamerRPC::_invoke_send_response (GstBuffer *buffer) {
+  std::lock_guard<std::mutex> lock (invoke_lock_);
+  InvokeStream *stream;
+  guint64 id;
+
+  if (!get_invoke_id (buffer, &id)) {
+    ml_logw ("Cannot find the request of the response, "
+        "the meta of tensor_src_grpc is missing. Dropping it");
+    return TRUE;
+  }
+
+  auto it = invoke_pending_.find (id);
+  if (it == invoke_pending_.end ()) {
+    ml_logw ("Failed to find the request of the response (id %" G_GUINT64_FORMAT
+        ", expired or duplicated), dropping it", id);
+    return TRUE;
+  }
+
+  stream = it->second.stream;
+
+  /* the pipeline keeps the order, the former requests of the stream were dropped */
+  _invoke_retire (it, stream);
+
+  stream->responses.emplace_back (it->second.seq, gst_buffer_ref (buffer));
+  invoke_pending_.erase (it);
+
+  invoke_cond_.notify_all ();
+  return TRUE;
+}
+
+/**
+ * @brief retire the requests before @a end, which will not be responded (locked).
+ * @param stream the stream of the requests to retire (NULL for all requests)
+ */
+void
+NNStreamerRPC::_invoke_retire (std::map<guint64, InvokeRequest>::iterator end,
+    InvokeStream *stream) {
+  auto it = invoke_pending_.begin ();
+  guint retired = 0;
+
+  while (it != end) {
+    if (stream == NULL || it->second.stream == stream) {
+      if (it->second.stream)
+        it->second.stream->pending--;
+
+      it = invoke_pending_.erase (it);
+      retired++;
+    } else {
+      it++;
+    }
+  }
+
+  if (retired > 0)
+    ml_logw ("%u requests were not responded, dropped in the pipeline", retired);
+}
+
+/** @brief expire the requests not responded until the deadline (locked) */
+void
+NNStreamerRPC::_invoke_expire () {
+  auto now = std::chrono::steady_clock::now ();
+  auto it = invoke_pending_.begin ();
+
+  /* the deadline increases with the id */
+  while (it != invoke_pending_.end () && it->second.deadline <= now)
+    it++;
+
+  if (it != invoke_pending_.begin ()) {
+    _invoke_retire (it, NULL);
+    invoke_cond_.notify_all ();
+  }
+}
+
+/** @brief get the key to pair src and sink in invoke mode */
+std::string
+NNStreamerRPC::_invoke_key (gboolean is_server, const gchar *host, gint port) {
+  if (is_server)
+    return "server:" + std::to_string (port);
+
+  return std::string ("client:") + host + ":" + std::to_string (port);
+}
+
+/**
+ * @brief register the instance to be shared with the paired element.
+ * The server is registered with the bound port (the port may be 0 to bind
+ * an available one).
+ */
+gboolean
+NNStreamerRPC::register_invoke () {
+  std::lock_guard<std::mutex> lock (invoke_registry_lock);
+  std::string key = _invoke_key (is_server_, host_, port_);
+
+  if (invoke_registry.find (key) != invoke_registry.end ()) {
+    ml_loge ("Another element already serves invoke mode at %s", key.c_str ());
+    return FALSE;
+  }
+
+  invoke_registry[key] = this;
+  invoke_key_ = key;
+  invoke_registry_cond.notify_all ();
+
+  return TRUE;
+}
+
+/** @brief unregister the instance, the paired element may keep its reference */
+void
+NNStreamerRPC::unregister_invoke () {
+  std::lock_guard<std::mutex> lock (invoke_registry_lock);
+
+  if (invoke_key_.empty ())
+    return;
+
+  invoke_registry.erase (invoke_key_);
+  invoke_key_.clear ();
+}
+
+/**
+ * @brief find the registered instance matching the config (locked).
+ * A server with the port 0 is matched with the only server which was
+ * requested to bind an available port.
+ */
+static NNStreamerRPC *
+_lookup_invoke_locked (const grpc_config *config, const std::string &key,
+    gboolean *ambiguous)
+{
+  NNStreamerRPC *found = NULL;
+
+  if (!config->is_server || config->port != 0) {
+    auto it = invoke_registry.find (key);
+    return (it != invoke_registry.end ()) ? it->second : NULL;
+  }
+
+  for (auto &item : invoke_registry) {
+    if (item.second->isInvokeServerOfAnyPort ()) {
+      if (found) {
+        *ambiguous = TRUE;
+        return NULL;
+      }
+      found = item.second;
+    }
+  }
+
+  return found;
+}
+
+/**
+ * @brief find the registered instance matching the config and ref it.
+ * It waits until the paired element registers the instance or the timeout.
+ */
+NNStreamerRPC *
+NNStreamerRPC::lookup_invoke (const grpc_config *config, guint timeout_ms) {
+  std::unique_lock<std::mutex> lock (invoke_registry_lock);
+  std::string key = _invoke_key (config->is_server, config->host, config->port);
+  NNStreamerRPC *instance = NULL;
+  gboolean ambiguous = FALSE;
+
+  invoke_registry_cond.wait_until (lock, std::chrono::steady_clock::now () +
+      std::chrono::milliseconds (timeout_ms), [&] {
+        instance = _lookup_invoke_locked (config, key, &ambiguous);
+        return instance != NULL || ambiguous;
+      });
+
+  if (ambiguous) {
+    ml_loge ("Multiple servers bound an available port in invoke mode, "
+        "set the port to find the paired element.");
+    return NULL;
+  }
+
+  if (instance == NULL)
+    return NULL;
+
+  instance->ref ();
+  instance->setSendConfig (config->config);
+
+  return instance;
+}
+
 /** @brief start server service */
 gboolean
 NNStreamerRPC::_start_server () {
@@ -202,6 +866,20 @@ grpc_get_idl (const gchar *idl_str)
     return GRPC_IDL_NONE;
 }
 
+/**
+ * @brief get gRPC fan-in policy enum from a given string
+ */
+grpc_fanin
+grpc_get_fanin (const gchar *fanin_str)
+{
+  if (g_ascii_strcasecmp (fanin_str, "fifo") == 0)
+    return GRPC_FANIN_FIFO;
+  else if (g_ascii_strcasecmp (fanin_str, "round-robin") == 0)
+    return GRPC_FANIN_ROUND_ROBIN;
+  else
+    return GRPC_FANIN_NONE;
+}
+
 /**
  * @brief gRPC C++ wrapper to create the class instance
  */
@@ -224,7 +902,60 @@ grpc_destroy (void *instance)
   g_return_if_fail (instance != NULL);
 
   NNStreamerRPC * self = static_cast<NNStreamerRPC *> (instance);
-  void *handle = self->getModuleHandle ();
+
+  if (self->getDirection () == GRPC_DIRECTION_BIDIRECTIONAL) {
+    /* the paired element may still hold the instance */
+    self->unregister_invoke ();
+    self->stop ();
+  }
+
+  grpc_release (instance);
+}
+
+/**
+ * @brief gRPC C++ wrapper to find the instance in invoke mode
+ * @param timeout_ms time to wait for the paired element to start (msec)
+ * @return the instance started by the paired element, or NULL if not found.
+ *         Call grpc_release() to release it.
+ */
+void *
+grpc_lookup (const grpc_config * config, guint timeout_ms)
+{
+  g_return_val_if_fail (config != NULL, NULL);
+
+  return static_cast <void *> (NNStreamerRPC::lookup_invoke (config,
+        timeout_ms));
+}
+
+/**
+ * @brief gRPC C++ wrapper to update the config of tensors to be sent
+ */
+void
+grpc_set_send_config (void * instance, const GstTensorsConfig * config)
+{
+  g_return_if_fail (instance != NULL);
+  g_return_if_fail (config != NULL);
+
+  NNStreamerRPC * self = static_cast<NNStreamerRPC *> (instance);
+
+  self->setSendConfig (config);
+}
+
+/**
+ * @brief gRPC C++ wrapper to release the reference of the class instance
+ */
+void
+grpc_release (void *instance)
+{
+  g_return_if_fail (instance != NULL);
+
+  NNStreamerRPC * self = static_cast<NNStreamerRPC *> (instance);
+  void *handle;
+
+  if (!self->unref ())
+    return;
+
+  handle = self->getModuleHandle ();
 
   delete self;
 
@@ -360,6 +1091,37 @@ grpc_common_set_property (GObject * self, gboolean * silent,
       grpc->config.port = g_value_get_int (value);
       silent_debug ("Set port = %d", grpc->config.port);
       break;
+    case PROP_NUM_THREADS:
+      grpc->config.num_threads = g_value_get_uint (value);
+      silent_debug ("Set num-threads = %u", grpc->config.num_threads);
+      break;
+    case PROP_QUEUE_SIZE:
+      grpc->config.queue_size = g_value_get_uint (value);
+      silent_debug ("Set queue-size = %u", grpc->config.queue_size);
+      break;
+    case PROP_INVOKE:
+      grpc->config.is_invoke = g_value_get_boolean (value);
+      silent_debug ("Set invoke = %d", grpc->config.is_invoke);
+      break;
+    case PROP_MAX_IN_FLIGHT:
+      grpc->config.max_in_flight = g_value_get_uint (value);
+      silent_debug ("Set max-in-flight = %u", grpc->config.max_in_flight);
+      break;
+    case PROP_FANIN:
+    {
+      const gchar * fanin_str = g_value_get_string (value);
+
+      if (fanin_str) {
+        grpc_fanin fanin = grpc_get_fanin (fanin_str);
+        if (fanin != GRPC_FANIN_NONE) {
+          grpc->config.fanin = fanin;
+          silent_debug ("Set fan-in = %s", fanin_str);
+        } else {
+          ml_loge ("Invalid fan-in policy provided: %s", fanin_str);
+        }
+      }
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -404,6 +1166,30 @@ grpc_common_get_property (GObject * self, gboolean silent, guint out,
     case PROP_OUT:
       g_value_set_uint (value, out);
       break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, grpc->config.num_threads);
+      break;
+    case PROP_QUEUE_SIZE:
+      g_value_set_uint (value, grpc->config.queue_size);
+      break;
+    case PROP_INVOKE:
+      g_value_set_boolean (value, grpc->config.is_invoke);
+      break;
+    case PROP_MAX_IN_FLIGHT:
+      g_value_set_uint (value, grpc->config.max_in_flight);
+      break;
+    case PROP_FANIN:
+      switch (grpc->config.fanin) {
+        case GRPC_FANIN_FIFO:
+          g_value_set_string (value, "fifo");
+          break;
+        case GRPC_FANIN_ROUND_ROBIN:
+          g_value_set_string (value, "round-robin");
+          break;
+        default:
+          break;
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -20,12 +20,47 @@
 #include <gst/base/gstdataqueue.h>
 #include <grpcpp/grpcpp.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace grpc {
 
+/**
+ * @brief bounded queue of a client stream to be fanned in
+ */
+typedef struct {
+  std::deque<std::pair<guint64, GstBuffer *>> buffers; /**< (arrival seq, buffer) */
+  guint dropped;    /**< number of buffers dropped as the queue was full */
+  gboolean closed;  /**< the client stream is finished */
+} ClientQueue;
+
+/**
+ * @brief responses of a request/response stream (server only)
+ */
+typedef struct {
+  std::deque<std::pair<guint64, GstBuffer *>> responses; /**< (seq, buffer) */
+  guint pending;    /**< number of requests not responded yet */
+  gboolean closed;  /**< the client finished sending requests */
+} InvokeStream;
+
+/**
+ * @brief a request not responded yet (invoke mode)
+ */
+typedef struct {
+  InvokeStream *stream; /**< stream of the request (server only) */
+  guint64 seq;          /**< sequence number of the request in the stream */
+  std::chrono::steady_clock::time_point deadline; /**< expired if not responded until */
+} InvokeRequest;
+
 /**
  * @brief NNStreamer RPC service
  */
@@ -40,6 +75,37 @@ class NNStreamerRPC {
     void stop ();
     gboolean send (GstBuffer *buffer);
 
+    ClientQueue * fanin_open ();
+    void fanin_close (ClientQueue *client);
+    void fanin_push (ClientQueue *client, GstBuffer *buffer);
+
+    InvokeStream * invoke_open ();
+    void invoke_close (InvokeStream *stream);
+    void invoke_release (InvokeStream *stream);
+    gboolean invoke_request (InvokeStream *stream, guint64 seq, GstBuffer *buffer);
+    gboolean invoke_pop_response (InvokeStream *stream, GstBuffer **buffer, guint64 *seq);
+    void invoke_done (guint64 seq);
+
+    gboolean register_invoke ();
+    void unregister_invoke ();
+    static NNStreamerRPC * lookup_invoke (const grpc_config *config, guint timeout_ms);
+
+    static void set_invoke_id (GstBuffer *buffer, guint64 id);
+    static gboolean get_invoke_id (GstBuffer *buffer, guint64 *id);
+
+    /** @brief increase the reference count */
+    void ref () {
+      g_atomic_int_inc (&refcount_);
+    }
+
+    /** @brief decrease the reference count and return TRUE if it's the last */
+    gboolean unref () {
+      return g_atomic_int_dec_and_test (&refcount_);
+    }
+
+    void setSendConfig (const GstTensorsConfig *config);
+    void getSendConfig (GstTensorsConfig *config);
+
     /** @brief get gRPC listening port (server only) */
     int getListeningPort () {
       if (is_server_)
@@ -48,6 +114,11 @@ class NNStreamerRPC {
         return -EINVAL;
     }
 
+    /** @brief check whether it is the invoke server requested to bind an available port */
+    gboolean isInvokeServerOfAnyPort () {
+      return is_server_ && requested_port_ == 0;
+    }
+
     /** @brief set library module handle */
     void setModuleHandle (void * handle) {
       if (handle_ == NULL)
@@ -64,6 +135,18 @@ class NNStreamerRPC {
       return direction_;
     }
 
+    /**
+     * @brief wrap the payload of a received message into GstMemory.
+     * The memory shares the message, which is released with the last memory.
+     */
+    template <typename T>
+    static GstMemory * wrap_message (const std::shared_ptr<T> &msg,
+        const void *data, gsize size) {
+      return gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+          const_cast<gpointer> (data), size, 0, size,
+          new std::shared_ptr<T> (msg), _release_message<T>);
+    }
+
   protected:
     const gchar *host_;
     gint port_;
@@ -71,6 +154,11 @@ class NNStreamerRPC {
     gboolean is_server_;
     gboolean is_blocking_;
 
+    guint num_threads_;
+    guint queue_size_;
+    grpc_fanin fanin_;
+    guint max_in_flight_;
+
     grpc_direction direction_;
 
     grpc_cb cb_;
@@ -80,9 +168,10 @@ class NNStreamerRPC {
     GstDataQueue *queue_;
 
     std::unique_ptr<Server> server_instance_;
-    std::unique_ptr<ServerCompletionQueue> completion_queue_;
+    std::vector<std::unique_ptr<ServerCompletionQueue>> completion_queues_;
 
     std::thread worker_;
+    std::vector<std::thread> server_workers_;
 
     void * handle_;
     gboolean stop_;
@@ -96,6 +185,63 @@ class NNStreamerRPC {
     gboolean _start_server ();
     gboolean _start_client ();
 
+    gboolean _invoke_send_request (guint64 *seq);
+    gboolean _invoke_send_response (GstBuffer *buffer);
+    void _invoke_expire ();
+    void _invoke_retire (std::map<guint64, InvokeRequest>::iterator end,
+        InvokeStream *stream);
+    static std::string _invoke_key (gboolean is_server, const gchar *host, gint port);
+
+    /**
+     * @brief wait until the predicate is satisfied or stopped (locked).
+     * It wakes up at the deadline of the oldest request to expire it.
+     */
+    template <typename Predicate>
+    void _invoke_wait (std::unique_lock<std::mutex> &lock, Predicate pred) {
+      while (!stop_) {
+        _invoke_expire ();
+        if (pred ())
+          break;
+
+        if (invoke_pending_.empty ())
+          invoke_cond_.wait (lock);
+        else
+          invoke_cond_.wait_until (lock,
+              invoke_pending_.begin ()->second.deadline);
+      }
+    }
+
+    void _fanin_thread ();
+    void _fanin_stop ();
+    GstBuffer * _fanin_pop ();
+
+    /** @brief release the message shared by a wrapped memory */
+    template <typename T>
+    static void _release_message (gpointer data) {
+      delete static_cast<std::shared_ptr<T> *> (data);
+    }
+
+    std::list<ClientQueue> clients_;
+    std::mutex fanin_lock_;
+    std::condition_variable fanin_cond_;
+    std::thread fanin_worker_;
+    guint64 fanin_seq_;
+    gboolean fanin_stop_;
+
+    std::mutex invoke_lock_;
+    std::condition_variable invoke_cond_;
+    std::map<guint64, InvokeRequest> invoke_pending_;
+    guint64 invoke_id_;
+    std::string invoke_key_;
+    gint requested_port_;
+
+    /** the config of tensors to be sent, owned by the element or copied */
+    GstTensorsConfig *send_config_;
+    GstTensorsConfig send_config_copy_;
+    std::mutex send_config_lock_;
+
+    gint refcount_;
+
     static gboolean _data_queue_check_full_cb (GstDataQueue * queue,
         guint visible, guint bytes, guint64 time, gpointer checkdata);
     static void _data_queue_item_free (GstDataQueueItem * item);
@@ -40,15 +40,22 @@ ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
 {
 }
 
-/** @brief parse tensors and deliver the buffer via callback */
+/** @brief parse tensors and deliver the buffer via callback or fan-in */
 void
-ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors)
+ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors,
+    ClientQueue *client)
 {
   GstBuffer *buffer;
 
+  /* the message was already consumed (e.g., the last read failed) */
+  if (tensors.size () == 0)
+    return;
+
   _get_buffer_from_tensors (tensors, &buffer);
 
-  if (cb_)
+  if (client)
+    fanin_push (client, buffer);
+  else if (cb_)
     cb_ (cb_data_, buffer);
   else
     gst_buffer_unref (buffer);
@@ -104,12 +111,18 @@ Status ServiceImplFlatbuf::_write_tensors (T writer)
   return Status::OK;
 }
 
-/** @brief convert tensors to buffer */
+/**
+ * @brief convert tensors to buffer
+ * @note The payload is not copied. The message is moved out of @a msg
+ *       and kept alive until all the memories of the buffer are released.
+ */
 void
 ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
     GstBuffer **buffer)
 {
-  const Tensors *tensors = msg.GetRoot ();
+  std::shared_ptr<Message<Tensors>> holder =
+      std::make_shared<Message<Tensors>> (std::move (msg));
+  const Tensors *tensors = holder->GetRoot ();
   guint num_tensor = tensors->num_tensor ();
   GstMemory *memory;
 
@@ -119,10 +132,8 @@ ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
     const Tensor * tensor = tensors->tensor ()->Get (i);
     const void * data = tensor->data ()->data ();
     gsize size = VectorLength (tensor->data ());
-    gpointer new_data = g_memdup (data, size);
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = wrap_message (holder, data, size);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -283,15 +294,17 @@ SyncServiceImplFlatbuf::_client_thread ()
 
 /** @brief Constructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::AsyncServiceImplFlatbuf (const grpc_config * config)
-  : ServiceImplFlatbuf (config), last_call_ (nullptr)
+  : ServiceImplFlatbuf (config), last_calls_ (num_threads_, nullptr)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::~AsyncServiceImplFlatbuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (auto call : last_calls_) {
+    if (call)
+      delete call;
+  }
 }
 
 
@@ -304,15 +317,17 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /* need to manually handle the completion queues, one per thread */
+  for (guint i = 0; i < num_threads_; i++)
+    completion_queues_.push_back (builder.AddCompletionQueue ());
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  for (guint i = 0; i < num_threads_; i++)
+    server_workers_.push_back (std::thread ([this, i] { this->_server_thread (i); }));
 
   return TRUE;
 }
@@ -339,19 +354,28 @@ AsyncServiceImplFlatbuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq,
+        guint idx)
+      : AsyncCallData (service), cq_ (cq), idx_ (idx), client_ (nullptr),
+        writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
 
+    /** @brief Destructor of AsyncCallDataServer */
+    ~AsyncCallDataServer ()
+    {
+      if (client_)
+        service_->fanin_close (client_);
+    }
+
     /** @brief implemented RunState () of AsyncCallDataServer */
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, client_);
           state_ = FINISH;
         } else {
           return;
@@ -370,12 +394,16 @@ class AsyncCallDataServer : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (idx_,
+              new AsyncCallDataServer (service_, cq_, idx_));
+
+          if (reader_.get () != nullptr)
+            client_ = service_->fanin_open ();
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, client_);
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
@@ -413,6 +441,9 @@ class AsyncCallDataServer : public AsyncCallData {
     ServerCompletionQueue *cq_;
     ServerContext ctx_;
 
+    guint idx_;
+    ClientQueue *client_;
+
     std::unique_ptr<ServerAsyncWriter<Message<Tensors>>> writer_;
     std::unique_ptr<ServerAsyncReader<Message<Empty>, Message<Tensors>>> reader_;
 };
@@ -492,12 +523,14 @@ class AsyncCallDataClient : public AsyncCallData {
     std::unique_ptr<ClientAsyncReader<Message<Tensors>>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread polling the idx-th completion queue */
 void
-AsyncServiceImplFlatbuf::_server_thread ()
+AsyncServiceImplFlatbuf::_server_thread (guint idx)
 {
+  ServerCompletionQueue *completion_queue = completion_queues_[idx].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (idx, new AsyncCallDataServer (this, completion_queue, idx));
 
   while (1) {
     void *tag;
@@ -508,7 +541,7 @@ AsyncServiceImplFlatbuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (completion_queue->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
@@ -555,6 +588,11 @@ AsyncServiceImplFlatbuf::_client_thread ()
 extern "C" NNStreamerRPC *
 create_instance (const grpc_config * config)
 {
+  if (config->dir == GRPC_DIRECTION_BIDIRECTIONAL) {
+    ml_loge ("Invoke mode is not supported with flatbuf IDL\n");
+    return NULL;
+  }
+
   if (config->is_blocking)
     return new SyncServiceImplFlatbuf (config);
   else
@@ -35,7 +35,7 @@ class ServiceImplFlatbuf : public NNStreamerRPC
   public:
     ServiceImplFlatbuf (const grpc_config * config);
 
-    void parse_tensors (Message<Tensors> &tensors);
+    void parse_tensors (Message<Tensors> &tensors, ClientQueue *client = nullptr);
     gboolean fill_tensors (Message<Tensors> &tensors);
 
   protected:
@@ -85,17 +85,17 @@ class AsyncServiceImplFlatbuf final
     AsyncServiceImplFlatbuf (const grpc_config * config);
     ~AsyncServiceImplFlatbuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint idx, AsyncCallData * call) { last_calls_[idx] = call; }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint idx);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
 };
 
 /** @brief Internal base class to serve a request */
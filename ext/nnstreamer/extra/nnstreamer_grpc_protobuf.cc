@@ -35,15 +35,28 @@ ServiceImplProtobuf::ServiceImplProtobuf (const grpc_config * config):
 {
 }
 
-/** @brief parse tensors and deliver the buffer via callback */
+/** @brief parse tensors and deliver the buffer via callback or fan-in */
 void
-ServiceImplProtobuf::parse_tensors (Tensors &tensors)
+ServiceImplProtobuf::parse_tensors (Tensors &tensors, ClientQueue *client)
 {
   GstBuffer *buffer;
+  guint64 seq = tensors.seq ();
+
+  /* the message was already consumed (e.g., the last read failed) */
+  if (tensors.num_tensor () == 0)
+    return;
 
   _get_buffer_from_tensors (tensors, &buffer);
 
-  if (cb_)
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    /* a response of the request having the same seq */
+    GST_BUFFER_OFFSET (buffer) = seq;
+    invoke_done (seq);
+  }
+
+  if (client)
+    fanin_push (client, buffer);
+  else if (cb_)
     cb_ (cb_data_, buffer);
   else
     gst_buffer_unref (buffer);
@@ -54,12 +67,17 @@ gboolean
 ServiceImplProtobuf::fill_tensors (Tensors &tensors)
 {
   GstDataQueueItem *item;
+  guint64 seq;
 
   if (!gst_data_queue_pop (queue_, &item))
     return FALSE;
 
   _get_tensors_from_buffer (GST_BUFFER (item->object), tensors);
 
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL &&
+      get_invoke_id (GST_BUFFER (item->object), &seq))
+    tensors.set_seq (seq);
+
   GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
   destroy (item);
 
@@ -99,24 +117,30 @@ Status ServiceImplProtobuf::_write_tensors (T writer)
   return Status::OK;
 }
 
-/** @brief convert tensors to buffer */
+/**
+ * @brief convert tensors to buffer
+ * @note The payload is not copied. The message is moved out of @a tensors
+ *       and kept alive until all the memories of the buffer are released.
+ */
 void
 ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
     GstBuffer **buffer)
 {
-  guint num_tensor = tensors.num_tensor ();
+  std::shared_ptr<Tensors> msg = std::make_shared<Tensors> ();
+  guint num_tensor;
   GstMemory *memory;
 
+  msg->Swap (&tensors);
+  num_tensor = msg->num_tensor ();
+
   *buffer = gst_buffer_new ();
 
   for (guint i = 0; i < num_tensor; i++) {
-    const Tensor * tensor = &tensors.tensor (i);
-    const void * data = tensor->data ().c_str ();
+    const Tensor * tensor = &msg->tensor (i);
+    const void * data = tensor->data ().data ();
     gsize size = tensor->data ().length ();
-    gpointer new_data = g_memdup (data, size);
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = wrap_message (msg, data, size);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -127,23 +151,28 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
     Tensors &tensors)
 {
   Tensors::frame_rate *fr;
+  GstTensorsConfig config;
   GstMapInfo map;
   gsize data_ptr = 0;
 
-  tensors.set_num_tensor (config_->info.num_tensors);
+  gst_tensors_config_init (&config);
+  getSendConfig (&config);
+
+  tensors.set_num_tensor (config.info.num_tensors);
 
   fr = tensors.mutable_fr ();
-  fr->set_rate_n (config_->rate_n);
-  fr->set_rate_d (config_->rate_d);
+  fr->set_rate_n (config.rate_n);
+  fr->set_rate_d (config.rate_d);
 
   if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
     ml_loge ("Unable to map the buffer\n");
+    gst_tensors_info_free (&config.info);
     return;
   }
 
-  for (guint i = 0; i < config_->info.num_tensors; i++) {
+  for (guint i = 0; i < config.info.num_tensors; i++) {
     nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
-    const GstTensorInfo * info = &config_->info.info[i];
+    const GstTensorInfo * info = &config.info.info[i];
     gsize tsize = gst_tensor_info_get_size (info);
 
     if (data_ptr + tsize > map.size) {
@@ -163,6 +192,7 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
   }
 
   gst_buffer_unmap (buffer, &map);
+  gst_tensors_info_free (&config.info);
 }
 
 /** @brief Constructor of SyncServiceImplProtobuf */
@@ -187,6 +217,58 @@ SyncServiceImplProtobuf::RecvTensors (ServerContext *context,
   return _write_tensors (writer);
 }
 
+/**
+ * @brief bidirectional streaming: a client sends requests and receives
+ *        the responses having the same seq
+ */
+Status
+SyncServiceImplProtobuf::InvokeTensors (ServerContext *context,
+    ServerReaderWriter<Tensors, Tensors> *stream)
+{
+  InvokeStream *client;
+  Tensors tensors;
+
+  if (direction_ != GRPC_DIRECTION_BIDIRECTIONAL)
+    return Status (StatusCode::UNIMPLEMENTED, "Not in invoke mode");
+
+  client = invoke_open ();
+
+  /* write responses while reading the next requests */
+  std::thread writer ([this, stream, client] {
+    GstBuffer *buffer;
+    guint64 seq;
+
+    while (invoke_pop_response (client, &buffer, &seq)) {
+      Tensors response;
+
+      _get_tensors_from_buffer (buffer, response);
+      response.set_seq (seq);
+      gst_buffer_unref (buffer);
+
+      if (!stream->Write (response))
+        break;
+    }
+  });
+
+  while (stream->Read (&tensors)) {
+    GstBuffer *buffer;
+    guint64 seq = tensors.seq ();
+
+    if (tensors.num_tensor () == 0)
+      continue;
+
+    _get_buffer_from_tensors (tensors, &buffer);
+    if (!invoke_request (client, seq, buffer))
+      break;
+  }
+
+  invoke_close (client);
+  writer.join ();
+  invoke_release (client);
+
+  return Status::OK;
+}
+
 /** @brief start gRPC server handling protobuf */
 gboolean
 SyncServiceImplProtobuf::start_server (std::string address)
@@ -248,6 +330,19 @@ SyncServiceImplProtobuf::_client_thread ()
     _read_tensors (reader.get ());
 
     reader->Finish ();
+  } else if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    /* initiate the RPC call */
+    std::shared_ptr< ClientReaderWriter<Tensors, Tensors> > stream(
+        client_stub_->InvokeTensors (&context));
+
+    /* read responses while writing the next requests */
+    std::thread reader ([this, stream] { this->_read_tensors (stream.get ()); });
+
+    _write_tensors (stream.get ());
+
+    stream->WritesDone ();
+    reader.join ();
+    stream->Finish ();
   } else {
     g_assert (0); /* internal logic error */
   }
@@ -255,15 +350,17 @@ SyncServiceImplProtobuf::_client_thread ()
 
 /** @brief Constructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::AsyncServiceImplProtobuf (const grpc_config * config)
-  : ServiceImplProtobuf (config), last_call_ (nullptr)
+  : ServiceImplProtobuf (config), last_calls_ (num_threads_, nullptr)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::~AsyncServiceImplProtobuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (auto call : last_calls_) {
+    if (call)
+      delete call;
+  }
 }
 
 /** @brief start gRPC server handling protobuf */
@@ -275,15 +372,17 @@ AsyncServiceImplProtobuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /* need to manually handle the completion queues, one per thread */
+  for (guint i = 0; i < num_threads_; i++)
+    completion_queues_.push_back (builder.AddCompletionQueue ());
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  for (guint i = 0; i < num_threads_; i++)
+    server_workers_.push_back (std::thread ([this, i] { this->_server_thread (i); }));
 
   return TRUE;
 }
@@ -310,19 +409,28 @@ AsyncServiceImplProtobuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq,
+        guint idx)
+      : AsyncCallData (service), cq_ (cq), idx_ (idx), client_ (nullptr),
+        writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
 
+    /** @brief Destructor of AsyncCallDataServer */
+    ~AsyncCallDataServer ()
+    {
+      if (client_)
+        service_->fanin_close (client_);
+    }
+
     /** @brief implemented RunState () of AsyncCallDataServer */
     void RunState (bool ok = true) override
     {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, client_);
           state_ = FINISH;
         } else {
           return;
@@ -341,12 +449,16 @@ class AsyncCallDataServer : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (idx_,
+              new AsyncCallDataServer (service_, cq_, idx_));
+
+          if (reader_.get () != nullptr)
+            client_ = service_->fanin_open ();
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, client_);
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
@@ -378,6 +490,9 @@ class AsyncCallDataServer : public AsyncCallData {
     ServerCompletionQueue *cq_;
     ServerContext ctx_;
 
+    guint idx_;
+    ClientQueue *client_;
+
     std::unique_ptr<ServerAsyncWriter<Tensors>> writer_;
     std::unique_ptr<ServerAsyncReader<Empty, Tensors>> reader_;
 };
@@ -451,12 +566,14 @@ class AsyncCallDataClient : public AsyncCallData {
     std::unique_ptr<ClientAsyncReader<Tensors>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread polling the idx-th completion queue */
 void
-AsyncServiceImplProtobuf::_server_thread ()
+AsyncServiceImplProtobuf::_server_thread (guint idx)
 {
+  ServerCompletionQueue *completion_queue = completion_queues_[idx].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (idx, new AsyncCallDataServer (this, completion_queue, idx));
 
   while (1) {
     void *tag;
@@ -467,7 +584,7 @@ AsyncServiceImplProtobuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (completion_queue->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
@@ -514,7 +631,8 @@ AsyncServiceImplProtobuf::_client_thread ()
 extern "C" void *
 create_instance (const grpc_config * config)
 {
-  if (config->is_blocking)
+  /* request/response streams are served by the sync service */
+  if (config->is_blocking || config->dir == GRPC_DIRECTION_BIDIRECTIONAL)
     return new SyncServiceImplProtobuf (config);
   else
     return new AsyncServiceImplProtobuf (config);
@@ -34,7 +34,7 @@ class ServiceImplProtobuf : public NNStreamerRPC
   public:
     ServiceImplProtobuf (const grpc_config * config);
 
-    void parse_tensors (Tensors &tensors);
+    void parse_tensors (Tensors &tensors, ClientQueue *client = nullptr);
     gboolean fill_tensors (Tensors &tensors);
 
   protected:
@@ -65,6 +65,9 @@ class SyncServiceImplProtobuf final
     Status RecvTensors (ServerContext *context, const Empty *request,
         ServerWriter<Tensors> *writer) override;
 
+    Status InvokeTensors (ServerContext *context,
+        ServerReaderWriter<Tensors, Tensors> *stream) override;
+
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
@@ -84,17 +87,17 @@ class AsyncServiceImplProtobuf final
     AsyncServiceImplProtobuf (const grpc_config * config);
     ~AsyncServiceImplProtobuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint idx, AsyncCallData * call) { last_calls_[idx] = call; }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint idx);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -250,6 +250,8 @@ getTensorType (NPY_TYPES npyType)
     return _NNS_FLOAT32;
   case NPY_FLOAT64:
     return _NNS_FLOAT64;
+  case NPY_FLOAT16:
+    return _NNS_FLOAT16;
   default:
     /** @todo Support other types */
     break;
@@ -287,6 +289,8 @@ getNumpyType (tensor_type tType)
     return NPY_FLOAT32;
   case _NNS_FLOAT64:
     return NPY_FLOAT64;
+  case _NNS_FLOAT16:
+    return NPY_FLOAT16;
   default:
     /** @todo Support other types */
     break;
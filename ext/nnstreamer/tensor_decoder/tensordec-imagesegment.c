@@ -81,6 +81,7 @@
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
+#include <hw_accel.h>
 #include "tensordecutil.h"
 
 #if defined(__aarch64__)
@@ -137,6 +138,7 @@ typedef struct
 
   GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
+  gboolean use_neon;        /**< TRUE to use neon, checked at runtime */
 } image_segments;
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -159,6 +161,11 @@ is_init (void **pdata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
+  idata->use_neon = FALSE;
+#if defined (NEON64_ENABLED)
+  /* can be disabled with cpu_features in the configuration */
+  idata->use_neon = cpu_accel_has_features (CPU_FEATURE_NEON);
+#endif
 
   return TRUE;
 }
@@ -197,19 +204,21 @@ _fill_color_map (image_segments * idata)
   idata->color_map[0] = 0; /* background */
 
 #if defined (NEON64_ENABLED)
-  idata->rgb_modifier = 0xFFFFFF / (idata->max_labels + 1);
-  for (i = 1; i <= idata->max_labels; i++) {
-    /* colors should be the same with neon calculations */
-    idata->color_map[i] = idata->rgb_modifier * i;
-    ((guint8 *)&idata->color_map[i])[3] = '\xff'; /* alpha */
+  if (idata->use_neon) {
+    idata->rgb_modifier = 0xFFFFFF / (idata->max_labels + 1);
+    for (i = 1; i <= idata->max_labels; i++) {
+      /* colors should be the same with neon calculations */
+      idata->color_map[i] = idata->rgb_modifier * i;
+      ((guint8 *)&idata->color_map[i])[3] = '\xff'; /* alpha */
+    }
+    return;
   }
-#else
+#endif
   for (i = 1; i <= idata->max_labels; i++) {
     /* any color value would be acceptable */
     idata->color_map[i] = g_rand_int_range (idata->rand, 0x101010, 0xFFFFFF);
     ((guint8 *)&idata->color_map[i])[3] = '\xff'; /* alpha */
   }
-#endif
 }
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -325,50 +334,51 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
   guint label_idx, idx = 0;
 
 #if defined (NEON64_ENABLED)
-  float32x4_t v_src_float;
+  if (idata->use_neon) {
+    float32x4_t v_src_float;
 
-  uint32x4_t v_src_uint;
-  uint32x4_t v_magic;
-  uint32x4_t v_mask;
-  uint32x4_t v_alpha;
-  uint32x4_t v_zero;
+    uint32x4_t v_src_uint;
+    uint32x4_t v_magic;
+    uint32x4_t v_mask;
+    uint32x4_t v_alpha;
+    uint32x4_t v_zero;
 
-  guint num_lanes = 4;
+    guint num_lanes = 4;
 
-  v_magic = vdupq_n_u32 (idata->rgb_modifier);
-  v_alpha = vdupq_n_u32 (ALPHA_HEX);
-  v_zero = vdupq_n_u32 (0);
+    v_magic = vdupq_n_u32 (idata->rgb_modifier);
+    v_alpha = vdupq_n_u32 (ALPHA_HEX);
+    v_zero = vdupq_n_u32 (0);
 
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
-    /* load float32 vector */
-    v_src_float = vld1q_f32 (input);
-    input += num_lanes;
+    for (idx = 0; idx + num_lanes <= num_pixels; idx += num_lanes) {
+      /* load float32 vector */
+      v_src_float = vld1q_f32 (input);
+      input += num_lanes;
 
-    /* convert float32 vector to uint32 vector */
-    v_src_uint = vcvtq_u32_f32 (v_src_float);
+      /* convert float32 vector to uint32 vector */
+      v_src_uint = vcvtq_u32_f32 (v_src_float);
 
-    /* multiply by magic number to fill RGB values */
-    v_src_uint = vmulq_u32 (v_src_uint, v_magic);
+      /* multiply by magic number to fill RGB values */
+      v_src_uint = vmulq_u32 (v_src_uint, v_magic);
 
-    /* check whether the label is zero (i.e., background) */
-    v_mask = vceqq_u32 (v_src_uint, v_zero);
-    v_mask = vbslq_u32 (v_mask, v_zero, v_alpha);
+      /* check whether the label is zero (i.e., background) */
+      v_mask = vceqq_u32 (v_src_uint, v_zero);
+      v_mask = vbslq_u32 (v_mask, v_zero, v_alpha);
 
-    /* set the alpha value unless it's background */
-    v_src_uint = vorrq_u32 (v_src_uint, v_mask);
+      /* set the alpha value unless it's background */
+      v_src_uint = vorrq_u32 (v_src_uint, v_mask);
 
-    /* store uint32 vector */
-    vst1q_u32 (output, v_src_uint);
-    output += num_lanes;
-  }
+      /* store uint32 vector */
+      vst1q_u32 (output, v_src_uint);
+      output += num_lanes;
+    }
 
-  if (num_pixels == idx)
-    return;
+    if (num_pixels == idx)
+      return;
 
-  /* handle remaining data */
-  input = (float *) idata->segment_map;
-  output = (uint32_t *) out_info->data;
-  idx -= num_lanes;
+    /* handle remaining data */
+    input = (float *) idata->segment_map;
+    output = (uint32_t *) out_info->data;
+  }
 #endif
   for (; idx < num_pixels; idx++) {
     label_idx = (guint) input[idx];
@@ -391,31 +401,32 @@ find_max_grayscale (image_segments * idata)
   guint idx = 0;
 
 #if defined (NEON64_ENABLED)
-  float32x4_t v_src, v_max;
-  guint num_lanes = 4;
+  if (idata->use_neon) {
+    float32x4_t v_src, v_max;
+    guint num_lanes = 4;
 
-  v_max = vdupq_n_f32 (0);
+    v_max = vdupq_n_f32 (0);
 
-  /* find the maximum value per lane */
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
-    v_src = vld1q_f32 (input);
-    input += num_lanes;
+    /* find the maximum value per lane */
+    for (idx = 0; idx + num_lanes <= num_pixels; idx += num_lanes) {
+      v_src = vld1q_f32 (input);
+      input += num_lanes;
 
-    v_max = vmaxq_f32 (v_src, v_max);
-  }
+      v_max = vmaxq_f32 (v_src, v_max);
+    }
 
-  /* find the maximum value among all lanes */
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 0));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 1));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 2));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 3));
+    /* find the maximum value among all lanes */
+    gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 0));
+    gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 1));
+    gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 2));
+    gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 3));
 
-  if (num_pixels == idx)
-    return gray_max;
+    if (num_pixels == idx)
+      return gray_max;
 
-  /* handle remaining data */
-  input = idata->segment_map;
-  idx -= num_lanes;
+    /* handle remaining data */
+    input = idata->segment_map;
+  }
 #endif
   for (; idx < num_pixels; idx++)
     gray_max = MAX (gray_max, input [idx]);
@@ -440,7 +451,7 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
     return;
 
 #if defined (NEON64_ENABLED)
-  {
+  if (idata->use_neon) {
     float32x4_t v_src_float;
     float32x4_t v_max_gray;
     float32x4_t v_max_rgb;
@@ -456,7 +467,7 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
     v_magic = vdupq_n_u32 (GRAYSCALE_HEX);
     v_alpha = vdupq_n_u32 (ALPHA_HEX);
 
-    for (idx = 0; idx < num_pixels; idx += num_lanes) {
+    for (idx = 0; idx + num_lanes <= num_pixels; idx += num_lanes) {
       /* load float32 vector */
       v_src_float = vld1q_f32 (input);
       input += num_lanes;
@@ -483,7 +494,6 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
     /* handle remaining data */
     input = idata->segment_map;
     output = (uint32_t *) out_info->data;
-    idx -= num_lanes;
   }
 #endif
   for (; idx < num_pixels; idx++) {
@@ -0,0 +1,399 @@
+/**
+ * GStreamer Tensor_Filter, Typed C++ Custom Filter Template
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ */
+/**
+ * @file	tensor_filter_cpp_typed.hh
+ * @date	18 Oct 2021
+ * @brief	Header-only typed layer of tensor_filter_cpp with compile-time tensor shapes.
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ *
+ * @note This is experimental. The API and Class definition is NOT stable.
+ *
+ * @details
+ *    tensor_filter_cpp passes untyped GstTensorMemory arrays to invoke().
+ *    With typed_filter, the types and dimensions of the tensors are given
+ *    as template arguments. getInputDim() and getOutputDim() are generated
+ *    at compile time, and invoke_typed() receives typed views of the
+ *    tensors, which the compiler can vectorize without casts or runtime
+ *    size checks.
+ *
+ *    Dimensions are in the order of nnstreamer (innermost first), e.g.,
+ *    In<uint8_t, 3, 224, 224> is "3:224:224" of uint8 (RGB 224x224).
+ *
+ * @details Usage examples
+ *
+ *          class myfilter
+ *              : public nnstreamer::typed_filter<nnstreamer::In<float, 3, 224, 224>,
+ *                                                nnstreamer::Out<float, 1000>> {
+ *            public:
+ *              myfilter (const char *name) : typed_filter (name) {}
+ *              int invoke_typed (const input_type &in, output_type &out) override {
+ *                for (size_t i = 0; i < out.size (); i++) out[i] = ...;
+ *                return 0;
+ *              }
+ *          };
+ *          - myfilter fx ("myfilter01");
+ *          - fx._register ();
+ *          - gst pipeline with ( ... ! tensor_filter framework=cpp
+ *                                      model=myfilter01 ! ... );
+ *
+ *          Multiple tensors: use tensors_spec<tensor_spec<...>, ...>.
+ *          The views are given as std::tuple, use std::get<N> ().
+ *
+ *          Batch: typed_filter<In, Out, N> appends the outermost dimension N
+ *          to each tensor (e.g., "3:224:224:N"). Override invoke_batch() to
+ *          process N frames at once. By default, it calls invoke_typed() for
+ *          each frame.
+ *
+ * To Packagers:
+ *
+ * This is to be exposed with "nnstreamer-c++-dev"
+ */
+#ifndef __NNS_TENSOR_FILTER_CPP_TYPED_H__
+#define __NNS_TENSOR_FILTER_CPP_TYPED_H__
+
+#ifdef __cplusplus
+
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <tensor_filter_cpp.hh>
+
+namespace nnstreamer {
+
+/**
+ * @brief Tensor type of a C++ element type. Unsupported types fail to compile.
+ */
+template <typename T> struct tensor_type_of;
+
+/** @brief Tensor type of int32_t */
+template <> struct tensor_type_of<int32_t> { static constexpr tensor_type value () { return _NNS_INT32; } };
+/** @brief Tensor type of uint32_t */
+template <> struct tensor_type_of<uint32_t> { static constexpr tensor_type value () { return _NNS_UINT32; } };
+/** @brief Tensor type of int16_t */
+template <> struct tensor_type_of<int16_t> { static constexpr tensor_type value () { return _NNS_INT16; } };
+/** @brief Tensor type of uint16_t */
+template <> struct tensor_type_of<uint16_t> { static constexpr tensor_type value () { return _NNS_UINT16; } };
+/** @brief Tensor type of int8_t */
+template <> struct tensor_type_of<int8_t> { static constexpr tensor_type value () { return _NNS_INT8; } };
+/** @brief Tensor type of uint8_t */
+template <> struct tensor_type_of<uint8_t> { static constexpr tensor_type value () { return _NNS_UINT8; } };
+/** @brief Tensor type of double */
+template <> struct tensor_type_of<double> { static constexpr tensor_type value () { return _NNS_FLOAT64; } };
+/** @brief Tensor type of float */
+template <> struct tensor_type_of<float> { static constexpr tensor_type value () { return _NNS_FLOAT32; } };
+/** @brief Tensor type of int64_t */
+template <> struct tensor_type_of<int64_t> { static constexpr tensor_type value () { return _NNS_INT64; } };
+/** @brief Tensor type of uint64_t */
+template <> struct tensor_type_of<uint64_t> { static constexpr tensor_type value () { return _NNS_UINT64; } };
+
+/**
+ * @brief Compile-time specification of a tensor (element type and dimensions, innermost first).
+ */
+template <typename T, unsigned int... Dims>
+struct tensor_spec {
+  static_assert (sizeof... (Dims) > 0, "A tensor should have one dimension at least.");
+  static_assert (sizeof... (Dims) <= NNS_TENSOR_RANK_LIMIT, "Too many dimensions.");
+
+  using element_type = T; /**< C++ type of the elements */
+
+  /** @brief The tensor type */
+  static constexpr tensor_type type () { return tensor_type_of<T>::value (); }
+
+  /** @brief The rank of the tensor */
+  static constexpr unsigned int rank () { return sizeof... (Dims); }
+
+  /** @brief The number of elements in a frame */
+  static constexpr size_t count ()
+  {
+    size_t n = 1;
+    for (unsigned int d : { Dims... })
+      n *= d;
+    return n;
+  }
+
+  /** @brief The size of a frame in bytes */
+  static constexpr size_t size () { return count () * sizeof (T); }
+
+  /** @brief Fill the tensor info. The outermost dimension is the number of frames if Batch > 1. */
+  template <unsigned int Batch>
+  static void fill (GstTensorInfo &info)
+  {
+    static_assert (Batch > 0, "Batch should be larger than 0.");
+    static_assert (Batch == 1 || sizeof... (Dims) < NNS_TENSOR_RANK_LIMIT,
+        "No dimension remains for the batch.");
+    const unsigned int dims[] = { Dims... };
+    unsigned int i;
+
+    info.type = type ();
+    for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+      info.dimension[i] = (i < rank ()) ? dims[i] : 1U;
+    if (Batch > 1)
+      info.dimension[rank ()] = Batch;
+  }
+};
+
+/**
+ * @brief Compile-time specification of the tensors.
+ */
+template <typename... Specs>
+struct tensors_spec {
+  static_assert (sizeof... (Specs) > 0, "Tensors should have one tensor at least.");
+  static_assert (sizeof... (Specs) <= NNS_TENSOR_SIZE_LIMIT, "Too many tensors.");
+
+  /** @brief The number of tensors */
+  static constexpr unsigned int num () { return sizeof... (Specs); }
+
+  /** @brief Fill the tensors info */
+  template <unsigned int Batch>
+  static void fill (GstTensorsInfo *info)
+  {
+    unsigned int i = 0;
+
+    info->num_tensors = num ();
+    /* expand Specs in order */
+    (void) std::initializer_list<int>{ (Specs::template fill<Batch> (info->info[i++]), 0)... };
+  }
+};
+
+/**
+ * @brief Single input tensor, e.g., In<float, 3, 224, 224>.
+ */
+template <typename T, unsigned int... Dims>
+using In = tensors_spec<tensor_spec<T, Dims...>>;
+
+/**
+ * @brief Single output tensor, e.g., Out<float, 1000>.
+ */
+template <typename T, unsigned int... Dims>
+using Out = tensors_spec<tensor_spec<T, Dims...>>;
+
+/**
+ * @brief Typed view of a tensor (one frame or contiguous frames). This does not own the data.
+ * @note The data is aligned to the element type at least.
+ */
+template <typename T, typename Spec>
+class tensor_view
+{
+  private:
+  T *ptr; /**< the first element */
+  unsigned int n; /**< the number of frames */
+
+  public:
+  using value_type = T; /**< C++ type of the elements */
+  using spec = Spec; /**< the spec of the tensor */
+
+  /** @brief Constructor */
+  tensor_view (T *data, unsigned int frames = 1) : ptr (data), n (frames)
+  {
+  }
+
+  /** @brief The number of elements in a frame */
+  static constexpr size_t frame_count () { return Spec::count (); }
+
+  /** @brief Pointer to the first element */
+  T *data () const { return ptr; }
+
+  /** @brief The number of elements */
+  size_t size () const { return frame_count () * n; }
+
+  /** @brief The number of frames */
+  unsigned int frames () const { return n; }
+
+  /** @brief Access the index-th element */
+  T &operator[] (size_t index) const { return ptr[index]; }
+
+  /** @brief Iterator to the first element */
+  T *begin () const { return ptr; }
+
+  /** @brief Iterator after the last element */
+  T *end () const { return ptr + size (); }
+
+  /** @brief The view of the index-th frame */
+  tensor_view frame (unsigned int index) const
+  {
+    return tensor_view (ptr + frame_count () * index, 1);
+  }
+};
+
+/**
+ * @brief Views of the tensors. A view for a single tensor, std::tuple of views for multiple tensors.
+ */
+template <bool Const, typename Specs> struct tensors_view;
+
+/**
+ * @brief Views of the single tensor.
+ */
+template <bool Const, typename Spec>
+struct tensors_view<Const, tensors_spec<Spec>> {
+  /** @brief C++ type of the elements */
+  using element_type = typename std::conditional<Const,
+      const typename Spec::element_type, typename Spec::element_type>::type;
+  using type = tensor_view<element_type, Spec>; /**< type of the view */
+
+  /** @brief Make the view of the memory */
+  static type make (const GstTensorMemory *mem, unsigned int frames)
+  {
+    assert (mem[0].size == Spec::size () * frames);
+    return type (static_cast<element_type *> (mem[0].data), frames);
+  }
+
+  /** @brief The view of the index-th frame */
+  static type frame (const type &views, unsigned int index)
+  {
+    return views.frame (index);
+  }
+};
+
+/**
+ * @brief Views of the multiple tensors.
+ */
+template <bool Const, typename... Specs>
+struct tensors_view<Const, tensors_spec<Specs...>> {
+  /** @brief type of the views */
+  using type = std::tuple<typename tensors_view<Const, tensors_spec<Specs>>::type...>;
+
+  /** @brief Make the views of the memories */
+  static type make (const GstTensorMemory *mem, unsigned int frames)
+  {
+    return make_views (mem, frames, std::index_sequence_for<Specs...>{});
+  }
+
+  /** @brief The views of the index-th frame */
+  static type frame (const type &views, unsigned int index)
+  {
+    return frame_views (views, index, std::index_sequence_for<Specs...>{});
+  }
+
+  private:
+  /** @brief Make the views of the memories */
+  template <size_t... I>
+  static type make_views (const GstTensorMemory *mem, unsigned int frames,
+      std::index_sequence<I...>)
+  {
+    return type (tensors_view<Const, tensors_spec<Specs>>::make (&mem[I], frames)...);
+  }
+
+  /** @brief The views of the index-th frame */
+  template <size_t... I>
+  static type frame_views (const type &views, unsigned int index, std::index_sequence<I...>)
+  {
+    return type (std::get<I> (views).frame (index)...);
+  }
+};
+
+/**
+ * @brief Typed C++ custom filter. Derive this and implement invoke_typed().
+ * @param InSpec tensors_spec (or In<>) of the input
+ * @param OutSpec tensors_spec (or Out<>) of the output
+ * @param Batch the number of frames in a buffer (the outermost dimension, if larger than 1)
+ */
+template <typename InSpec, typename OutSpec, unsigned int Batch = 1>
+class typed_filter : public tensor_filter_cpp
+{
+  public:
+  using input_type = typename tensors_view<true, InSpec>::type; /**< views of the input tensors */
+  using output_type = typename tensors_view<false, OutSpec>::type; /**< views of the output tensors */
+
+  /** @brief Constructor. modelName is the model property of tensor_filter. */
+  typed_filter (const char *modelName) : tensor_filter_cpp (modelName)
+  {
+  }
+
+  /** @brief Destructor */
+  virtual ~typed_filter ()
+  {
+  }
+
+  /**
+   * @brief Invoke a frame. Mandatory.
+   * @return 0 if OK. Non-zero if error.
+   */
+  virtual int invoke_typed (const input_type &in, output_type &out) = 0;
+
+  /**
+   * @brief Invoke num frames at once. Optional, this calls invoke_typed() for each frame by default.
+   * @return 0 if OK. Non-zero if error.
+   */
+  virtual int invoke_batch (unsigned int num, const input_type &in, output_type &out)
+  {
+    unsigned int i;
+    int ret;
+
+    for (i = 0; i < num; i++) {
+      const input_type in_frame = tensors_view<true, InSpec>::frame (in, i);
+      output_type out_frame = tensors_view<false, OutSpec>::frame (out, i);
+
+      ret = invoke_typed (in_frame, out_frame);
+      if (ret != 0)
+        return ret;
+    }
+
+    return 0;
+  }
+
+  /** @brief Input dimension generated from InSpec. Do not override. */
+  int getInputDim (GstTensorsInfo *info) final
+  {
+    InSpec::template fill<Batch> (info);
+    return 0;
+  }
+
+  /** @brief Output dimension generated from OutSpec. Do not override. */
+  int getOutputDim (GstTensorsInfo *info) final
+  {
+    OutSpec::template fill<Batch> (info);
+    return 0;
+  }
+
+  /** @brief The dimensions are fixed at compile time. Do not override. */
+  int setInputDim (const GstTensorsInfo *in, GstTensorsInfo *out) final
+  {
+    (void) in;
+    (void) out;
+    return -EINVAL;
+  }
+
+  /** @brief Output buffers are always preallocated. Do not override. */
+  bool isAllocatedBeforeInvoke () final
+  {
+    return true;
+  }
+
+  /** @brief Make the typed views and invoke. Do not override. */
+  int invoke (const GstTensorMemory *in, GstTensorMemory *out) final
+  {
+    const input_type in_views = tensors_view<true, InSpec>::make (in, Batch);
+    output_type out_views = tensors_view<false, OutSpec>::make (out, Batch);
+
+    if (Batch == 1)
+      return invoke_typed (in_views, out_views);
+
+    return invoke_batch (Batch, in_views, out_views);
+  }
+};
+
+} /* namespace nnstreamer */
+
+#endif /* __cplusplus */
+
+#endif /* __NNS_TENSOR_FILTER_CPP_TYPED_H__ */
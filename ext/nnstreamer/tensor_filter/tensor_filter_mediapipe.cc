@@ -15,6 +15,9 @@
  * This is the per-NN-framework plugin (mediapipe) for tensor_filter.
  */
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
@@ -68,8 +71,18 @@ class mediapipe_subplugin final : public tensor_filter_subplugin
 
   mediapipe::CalculatorGraphConfig config; /**< about .pbtxt file */
   mediapipe::CalculatorGraph graph;
+  std::unique_ptr<mediapipe::OutputStreamPoller> poller; /**< poller of the output stream, alive while the graph runs */
+  bool running; /**< the graph is started */
+
+  /**
+   * @brief Output packets owned by the output buffers, keyed by the data pointer.
+   * The buffers may outlive the instance which produced them, so the packets are not owned by the instance.
+   */
+  static std::map<void *, mediapipe::Packet> outputPacketMap;
+  static std::mutex outputPacketLock; /**< the buffers can be released in other threads */
 
   int loadMediapipeGraph (const GstTensorFilterProperties *prop);
+  int startMediapipeGraph ();
   static const char *name;
   static const accl_hw hw_list[];
   static const int num_hw = 0;
@@ -93,12 +106,14 @@ class mediapipe_subplugin final : public tensor_filter_subplugin
 
 const char *mediapipe_subplugin::name = "mediapipe";
 const accl_hw mediapipe_subplugin::hw_list[] = {};
+std::map<void *, mediapipe::Packet> mediapipe_subplugin::outputPacketMap;
+std::mutex mediapipe_subplugin::outputPacketLock;
 
 /**
  * @brief	mediapipe_subplugin Constructor
  */
 mediapipe_subplugin::mediapipe_subplugin ()
-    : tensor_filter_subplugin (), config_path (nullptr)
+    : tensor_filter_subplugin (), config_path (nullptr), running (false)
 {
   gst_tensors_info_init (&inputInfo);
   gst_tensors_info_init (&outputInfo);
@@ -115,20 +130,24 @@ mediapipe_subplugin::~mediapipe_subplugin ()
 
   g_free (config_path);
 
-  for (unsigned int i = 0; i < inputInfo.num_tensors; i++) {
-    status = graph.CloseInputStream (inputInfo.info[i].name);
+  if (running) {
+    for (unsigned int i = 0; i < inputInfo.num_tensors; i++) {
+      status = graph.CloseInputStream (inputInfo.info[i].name);
+      if (!status.ok ()) {
+        std::cerr << "Failed to close input stream" << std::endl;
+      }
+    }
+
+    status = graph.WaitUntilDone ();
     if (!status.ok ()) {
-      std::cerr << "Failed to close input stream" << std::endl;
+      std::cerr << "Failed to closing mediapipe graph" << std::endl;
     }
   }
 
   gst_tensors_info_free (&inputInfo);
   gst_tensors_info_free (&outputInfo);
 
-  status = graph.WaitUntilDone ();
-  if (!status.ok ()) {
-    std::cerr << "Failed to closing mediapipe graph" << std::endl;
-  }
+  /* do not clear the output packets here, the frames may be still used by the output buffers */
 }
 
 /**
@@ -163,6 +182,11 @@ mediapipe_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     std::cerr << "Failed to load mediapipe graph" << std::endl;
     throw std::runtime_error ("Failed to load mediapipe graph");
   }
+
+  if (startMediapipeGraph ()) {
+    std::cerr << "Failed to start mediapipe graph" << std::endl;
+    throw std::runtime_error ("Failed to start mediapipe graph");
+  }
 }
 
 /**
@@ -230,9 +254,40 @@ mediapipe_subplugin::loadMediapipeGraph (const GstTensorFilterProperties *prop)
   return 0;
 }
 
+/**
+ * @brief	start the graph once with the poller of the output stream.
+ * @return 0 if OK. non-zero if error.
+ *        -1 if adding the poller is failed.
+ *        -2 if starting the graph is failed.
+ */
+int
+mediapipe_subplugin::startMediapipeGraph ()
+{
+  mediapipe::Status status;
+
+  auto status_or_poller = graph.AddOutputStreamPoller (outputInfo.info[0].name);
+  if (!status_or_poller.ok ()) {
+    ml_loge ("Failed to add the poller of the output stream %s", outputInfo.info[0].name);
+    return -1;
+  }
+  poller = absl::make_unique<mediapipe::OutputStreamPoller> (
+      std::move (status_or_poller).ValueOrDie ());
+
+  status = graph.StartRun ({});
+  if (!status.ok ()) {
+    ml_loge ("Failed to start mediapipe graph: %s", config_path);
+    return -2;
+  }
+
+  running = true;
+  return 0;
+}
+
 /**
  * @brief	run the mediapipe graph
- * @todo there are few points which can help to improve the performance.
+ * @note The input frame refers to the input memory without copying it, the
+ *       packet of the input frame should be released when the output packet
+ *       of the same timestamp is produced (a graph without look-ahead).
  */
 void
 mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
@@ -246,16 +301,12 @@ mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *outp
   int input_widthStep = input_width * input_channels;
   mediapipe::Status status;
 
-  /* TODO to make it better, start the graph at init or previous step */
-  mediapipe::OutputStreamPoller poller
-      = graph.AddOutputStreamPoller (outputInfo.info[0].name).ValueOrDie ();
-  status = graph.StartRun ({});
-  if (!status.ok ()) {
-    std::cerr << "Fail to start mediapipe graph" << std::endl;
-    throw std::runtime_error ("Fail to start mediapipe graph");
+  if (!running || !poller) {
+    std::cerr << "Mediapipe graph is not started" << std::endl;
+    throw std::runtime_error ("Mediapipe graph is not started");
   }
 
-  // Wrap Mat into an ImageFrame.
+  /* wrap the input memory into an ImageFrame without copying it */
   auto input_frame = absl::make_unique<mediapipe::ImageFrame> (
       mediapipe::ImageFormat::SRGB, input_width, input_height, input_widthStep,
       (uint8_t *)input->data, inputPtrDeleter /* do nothing */
@@ -271,15 +322,28 @@ mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *outp
 
   // Get the graph result packet, or stop if that fails.
   mediapipe::Packet packet;
-  if (!poller.Next (&packet)) {
+  if (!poller->Next (&packet)) {
     std::cerr << "Failed to get output packet from mediapipe graph" << std::endl;
     throw std::runtime_error ("Failed to get output packet from mediapipe graph");
   }
   auto &output_frame = packet.Get<mediapipe::ImageFrame> ();
-  cv::Mat output_frame_mat = mediapipe::formats::MatView (&output_frame);
 
-  /* TODO remove memcpy if it's possible */
-  memcpy (output->data, output_frame_mat.data, output->size);
+  if ((size_t) output_frame.PixelDataSizeStoredContiguously () != output->size) {
+    std::cerr << "The size of output frame is different from the output tensor" << std::endl;
+    throw std::runtime_error ("Invalid size of output frame");
+  }
+
+  if (output_frame.IsContiguous ()) {
+    /* the output buffer holds the packet until it is released */
+    std::lock_guard<std::mutex> lock (outputPacketLock);
+
+    output->data = (void *) output_frame.PixelData ();
+    outputPacketMap[output->data] = packet;
+  } else {
+    /* rows are aligned with padding, copy them to be a tensor (freed with g_free) */
+    output->data = g_malloc (output->size);
+    output_frame.CopyToBuffer ((uint8_t *) output->data, output->size);
+  }
 
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
@@ -295,7 +359,7 @@ mediapipe_subplugin::getFrameworkInfo (GstTensorFilterFrameworkInfo &info)
 {
   info.name = name;
   info.allow_in_place = FALSE;
-  info.allocate_in_invoke = FALSE;
+  info.allocate_in_invoke = TRUE;
   info.run_without_model = FALSE;
   info.verify_model_path = TRUE;
   info.hw_list = hw_list;
@@ -326,6 +390,17 @@ mediapipe_subplugin::getModelInfo (
 int
 mediapipe_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data)
 {
+  if (ops == DESTROY_NOTIFY) {
+    std::lock_guard<std::mutex> lock (outputPacketLock);
+    auto it = outputPacketMap.find (data.data);
+
+    if (it != outputPacketMap.end ()) {
+      outputPacketMap.erase (it);
+      return 0;
+    }
+  }
+
+  /* the data is not a frame of the packet, g_free() it */
   return -ENOENT;
 }
 
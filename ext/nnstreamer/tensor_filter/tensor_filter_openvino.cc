@@ -180,6 +180,9 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
   this->_outputsDataMap = (this->_networkCNN).getOutputsInfo ();
   this->_isLoaded = false;
   this->_hw = ACCL_NONE;
+  for (guint i = 0; i < NNS_TENSOR_SIZE_LIMIT; ++i) {
+    this->_inData[i] = this->_outData[i] = nullptr;
+  }
 }
 
 /**
@@ -239,6 +242,54 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
   return RetSuccess;
 }
 
+/**
+ * @brief Bind the tensors to the infer request. A blob is created only if the data is changed.
+ * @return RetSuccess if OK. non-zero if error
+ */
+int
+TensorFilterOpenvino::bindBlobs (const GstTensorFilterProperties *prop,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint num_tensors;
+  guint i;
+
+  num_tensors = (prop->input_meta).num_tensors;
+  for (i = 0; i < num_tensors; ++i) {
+    const GstTensorInfo *info = &((prop->input_meta).info[i]);
+
+    if (this->_inData[i] == input[i].data)
+      continue;
+
+    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
+        this->_inputTensorDescs[i], &(input[i]), info->type);
+    if (blob == nullptr) {
+      ml_loge ("Failed to create a blob for the input tensor: %u", i);
+      return RetEInval;
+    }
+    this->_inferRequest.SetBlob (std::string (info->name), blob);
+    this->_inData[i] = input[i].data;
+  }
+
+  num_tensors = (prop->output_meta).num_tensors;
+  for (i = 0; i < num_tensors; ++i) {
+    const GstTensorInfo *info = &((prop->output_meta).info[i]);
+
+    if (this->_outData[i] == output[i].data)
+      continue;
+
+    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
+        this->_outputTensorDescs[i], &(output[i]), info->type);
+    if (blob == nullptr) {
+      ml_loge ("Failed to create a blob for the output tensor: %u", i);
+      return RetEInval;
+    }
+    this->_inferRequest.SetBlob (std::string (info->name), blob);
+    this->_outData[i] = output[i].data;
+  }
+
+  return RetSuccess;
+}
+
 /**
  * @brief	Get the information about the dimensions of input tensors from the given model
  * @param[out] info metadata containing the dimesions and types information of the input tensors
@@ -398,40 +449,27 @@ int
 TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
     const GstTensorMemory *input, GstTensorMemory *output)
 {
-  InferenceEngine::BlobMap inBlobMap;
-  InferenceEngine::BlobMap outBlobMap;
-  guint num_tensors;
-  guint i;
+  int ret;
 
-  num_tensors = (prop->input_meta).num_tensors;
-  for (i = 0; i < num_tensors; ++i) {
-    const GstTensorInfo *info = &((prop->input_meta).info[i]);
-    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
-        this->_inputTensorDescs[i], &(input[i]), prop->input_meta.info[i].type);
-    if (blob == nullptr) {
-      ml_loge ("Failed to create a blob for the input tensor: %u", i);
-      return RetEInval;
-    }
-    inBlobMap.insert (make_pair (std::string (info->name), blob));
+  if (!this->_isLoaded) {
+    ml_loge ("The model is not loaded.");
+    return RetEInval;
   }
-  this->_inferRequest.SetInput (inBlobMap);
 
-  num_tensors = (prop->output_meta).num_tensors;
-  for (i = 0; i < num_tensors; ++i) {
-    const GstTensorInfo *info = &((prop->output_meta).info[i]);
-    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
-        this->_outputTensorDescs[i], &(output[i]), prop->output_meta.info[i].type);
-    outBlobMap.insert (make_pair (std::string (info->name), blob));
-    if (blob == nullptr) {
-      ml_loge ("Failed to create a blob for the output tensor: %u", i);
-      return RetEInval;
+  try {
+    ret = bindBlobs (prop, input, output);
+    if (ret == RetSuccess)
+      this->_inferRequest.Infer ();
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to run the infer request: %s", e.what ());
+    /* the blobs may not be bound */
+    for (guint i = 0; i < NNS_TENSOR_SIZE_LIMIT; ++i) {
+      this->_inData[i] = this->_outData[i] = nullptr;
     }
+    ret = RetEInval;
   }
-  this->_inferRequest.SetOutput (outBlobMap);
 
-  this->_inferRequest.Infer ();
-
-  return RetSuccess;
+  return ret;
 }
 
 /**
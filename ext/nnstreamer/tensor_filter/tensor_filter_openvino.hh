@@ -91,6 +91,9 @@ protected:
 private:
   TensorFilterOpenvino ();
 
+  int bindBlobs (const GstTensorFilterProperties * prop,
+      const GstTensorMemory * input, GstTensorMemory * output);
+
   InferenceEngine::Core _ieCore;
   InferenceEngine::CNNNetReader _networkReaderCNN;
   InferenceEngine::CNNNetwork _networkCNN;
@@ -98,6 +101,8 @@ private:
   InferenceEngine::TensorDesc _outputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::ExecutableNetwork _executableNet;
   InferenceEngine::InferRequest _inferRequest;
+  void *_inData[NNS_TENSOR_SIZE_LIMIT]; /**< data of the bound input blobs */
+  void *_outData[NNS_TENSOR_SIZE_LIMIT]; /**< data of the bound output blobs */
   static std::map<accl_hw, std::string> _nnsAcclHwToOVDevMap;
 
   std::string _pathModelXml;
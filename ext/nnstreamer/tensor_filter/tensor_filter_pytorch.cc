@@ -34,6 +34,8 @@
 
 #include <nnstreamer_conf.h>
 
+#include <map>
+#include <mutex>
 #include <torch/script.h>
 
 /**
@@ -68,6 +70,8 @@ class TorchCore
   char *model_path;
   bool use_gpu;
   accl_hw accelerator;
+  int num_threads; /**< the number of intra-op threads, 0 to use the default */
+  bool inference_mode; /**< disable autograd while running the model */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
@@ -77,13 +81,41 @@ class TorchCore
   std::shared_ptr<torch::jit::script::Module> model;
 
   void setAccelerator (const char *accelerators);
+  void parseCustomProperties (const char *custom_properties);
   tensor_type getTensorTypeFromTorch (torch::Dtype torchType);
   bool getTensorTypeToTorch (tensor_type tensorType, torch::Dtype *torchType);
   int validateOutputTensor (at::Tensor output);
   int fillTensorDim (torch::autograd::Variable tensor_meta, tensor_dim dim);
-  int processIValue (torch::jit::IValue value, GstTensorMemory *output);
+  int processIValue (torch::jit::IValue value, const GstTensorMemory *input,
+      GstTensorMemory *output, std::vector<at::Tensor> &holder);
 };
 
+/**
+ * @brief	Output tensors owned by the output buffers, keyed by the data pointer.
+ * @details	The buffers may outlive the TorchCore which produced them (e.g., closing or reloading the model), so the tensors are not owned by TorchCore.
+ *		The same storage may be given to several outputs, so it is released when the count is 0.
+ */
+class TorchOutputTensors
+{
+  public:
+  void hold (std::vector<at::Tensor> &tensors);
+  void release (void *data);
+
+  private:
+  std::map<void *, std::pair<at::Tensor, int>> tensorMap;
+  std::mutex lock; /**< the buffers can be released in other threads */
+};
+
+/**
+ * @brief	Get the output tensors shared by all TorchCore instances.
+ */
+static TorchOutputTensors &
+getOutputTensors (void)
+{
+  static TorchOutputTensors tensors;
+  return tensors;
+}
+
 extern "C" { /* accessed by android api */
 void init_filter_torch (void) __attribute__((constructor));
 void fini_filter_torch (void) __attribute__((destructor));
@@ -103,6 +135,8 @@ TorchCore::TorchCore (const char *_model_path)
   use_gpu = false;
   first_run = true;
   accelerator = ACCL_NONE;
+  num_threads = 0;
+  inference_mode = true;
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -143,6 +177,43 @@ use_gpu_ini:
   }
 }
 
+/**
+ * @brief	Parse the custom properties (e.g., "NumThreads:4,InferenceMode:true")
+ */
+void
+TorchCore::parseCustomProperties (const char *custom_properties)
+{
+  gchar **strv;
+  guint i, len;
+
+  if (!custom_properties)
+    return;
+
+  strv = g_strsplit (custom_properties, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", -1);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "NumThreads") == 0) {
+        num_threads = (int) g_ascii_strtoll (pair[1], NULL, 10);
+      } else if (g_ascii_strcasecmp (pair[0], "InferenceMode") == 0) {
+        inference_mode = (g_ascii_strcasecmp (pair[1], "true") == 0);
+      } else {
+        ml_logw ("Unknown option (%s).", strv[i]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+}
+
 /**
  * @brief	initialize the object with torch model
  * @return 0 if OK. non-zero if error.
@@ -154,6 +225,12 @@ TorchCore::init (const GstTensorFilterProperties *prop)
   setAccelerator (prop->accl_str);
   g_message ("gpu = %d, accl = %s", use_gpu, get_accl_hw_str (accelerator));
 
+  parseCustomProperties (prop->custom_properties);
+
+  /** the intra-op thread pool is shared in the process */
+  if (num_threads > 0)
+    at::set_num_threads (num_threads);
+
   gst_tensors_info_copy (&inputTensorMeta, &prop->input_meta);
   gst_tensors_info_copy (&outputTensorMeta, &prop->output_meta);
 
@@ -249,6 +326,7 @@ TorchCore::getTensorTypeFromTorch (torch::Dtype torchType)
   case torch::kF64:
     return _NNS_FLOAT64;
   case torch::kF16:
+    return _NNS_FLOAT16;
   default:
     break;
   }
@@ -286,6 +364,9 @@ TorchCore::getTensorTypeToTorch (tensor_type tensorType, torch::Dtype *torchType
   case _NNS_FLOAT64:
     *torchType = torch::kF64;
     break;
+  case _NNS_FLOAT16:
+    *torchType = torch::kF16;
+    break;
   default:
     return false;
   }
@@ -377,19 +458,22 @@ TorchCore::getOutputTensorDim (GstTensorsInfo *info)
 /**
  * @brief	process the IValue after forward and extract data from ivalue.
  * @param[in] value IValue containing the output in tensor form
- * @param[out]  output Output tensor memory
+ * @param[in] input Input tensor memories
+ * @param[out]  output Output tensor memory, set to the data of the output tensor
+ * @param[out] holder Output tensors to be kept until the buffers are released
  * @return 0 if OK. non-zero if error.
  *         -1 if output tensor validation fails.
  */
 int
-TorchCore::processIValue (torch::jit::IValue value, GstTensorMemory *output)
+TorchCore::processIValue (torch::jit::IValue value, const GstTensorMemory *input,
+    GstTensorMemory *output, std::vector<at::Tensor> &holder)
 {
   g_assert (value.isTensor ());
   at::Tensor output_tensor = value.toTensor ();
 
   /** bring from gpu to cpu */
   if (use_gpu) {
-    output_tensor.to (at::kCPU);
+    output_tensor = output_tensor.to (at::kCPU);
   }
   /** make the memory contiguous for direct access */
   output_tensor = output_tensor.contiguous ();
@@ -400,8 +484,23 @@ TorchCore::processIValue (torch::jit::IValue value, GstTensorMemory *output)
     return -1;
   }
 
-  /** @todo avoid this memcpy */
-  std::memcpy (output->data, output_tensor.data_ptr (), output_tensor.nbytes ());
+  /**
+   * The output may be a view of the input (e.g., identity), which is owned by the input buffer.
+   * Copy it only in this case, otherwise the output buffer takes the tensor.
+   */
+  for (uint i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    const char *in_data = (const char *) input[i].data;
+    const char *out_data = (const char *) output_tensor.data_ptr ();
+
+    if (out_data >= in_data && out_data < in_data + input[i].size) {
+      output_tensor = output_tensor.clone ();
+      break;
+    }
+  }
+
+  output->data = output_tensor.data_ptr ();
+  output->size = output_tensor.nbytes ();
+  holder.push_back (output_tensor);
   return 0;
 }
 
@@ -426,6 +525,16 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
   torch::jit::IValue output_value;
   torch::Dtype type;
   at::Tensor tensor;
+  std::vector<at::Tensor> holder;
+
+  /** autograd is not used for inference, do not record the graph */
+#ifdef PYTORCH_VER_ATLEAST_1_9_0
+  c10::optional<c10::InferenceMode> guard;
+#else
+  c10::optional<torch::NoGradGuard> guard;
+#endif
+  if (inference_mode)
+    guard.emplace ();
 
   for (uint i = 0; i < inputTensorMeta.num_tensors; ++i) {
     std::vector<int64_t> input_shape;
@@ -442,7 +551,7 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
     tensor = torch::from_blob (input[i].data, input_shape, options);
 
     if (use_gpu) {
-      tensor.to (at::kCUDA);
+      tensor = tensor.to (at::kCUDA);
     }
 
     input_feeds.emplace_back (tensor);
@@ -472,7 +581,7 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 
   if (output_value.isTensor ()) {
     g_assert (outputTensorMeta.num_tensors == 1);
-    if (processIValue (output_value, &output[0])) {
+    if (processIValue (output_value, input, &output[0], holder)) {
       ml_loge ("Output Tensor Information is not valid");
       return -2;
     }
@@ -488,7 +597,7 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
     g_assert (outputTensorMeta.num_tensors == output_list.size ());
     int idx = 0;
     for (auto &ivalue_element : output_list) {
-      if (processIValue (ivalue_element, &output[idx++])) {
+      if (processIValue (ivalue_element, input, &output[idx++], holder)) {
         ml_loge ("Output Tensor Information is not valid");
         return -2;
       }
@@ -498,6 +607,9 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
     return -3;
   }
 
+  /* the output buffers own the tensors now */
+  getOutputTensors ().hold (holder);
+
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
   g_message ("Invoke() is finished: %" G_GINT64_FORMAT, (stop_time - start_time));
@@ -506,6 +618,42 @@ TorchCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
   return 0;
 }
 
+/**
+ * @brief	hold the output tensors until the output buffers are released
+ * @param[in] tensors The output tensors given to the output buffers
+ */
+void
+TorchOutputTensors::hold (std::vector<at::Tensor> &tensors)
+{
+  std::lock_guard<std::mutex> guard (lock);
+
+  for (auto &t : tensors) {
+    auto it = tensorMap.find (t.data_ptr ());
+
+    if (it != tensorMap.end ())
+      it->second.second++;
+    else
+      tensorMap.emplace (t.data_ptr (), std::make_pair (t, 1));
+  }
+}
+
+/**
+ * @brief	release the output tensor corresponding to the given data
+ * @param[in] data The data element
+ */
+void
+TorchOutputTensors::release (void *data)
+{
+  std::lock_guard<std::mutex> guard (lock);
+
+  if (data != nullptr) {
+    auto it = tensorMap.find (data);
+    if (it != tensorMap.end () && --it->second.second <= 0) {
+      tensorMap.erase (it);
+    }
+  }
+}
+
 /**
  * @brief	fill tensor dimension
  * @param tensor_meta	pytorch tensor variable
@@ -653,6 +801,18 @@ torch_getOutputDim (const GstTensorFilterProperties *prop, void **private_data,
   return core->getOutputTensorDim (info);
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : pytorch plugin's private data
+ * @param data : The data element.
+ */
+static void
+torch_destroyNotify (void **private_data, void *data)
+{
+  /* the instance may be closed already, the tensors are not owned by it */
+  getOutputTensors ().release (data);
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  * @param[in] hw backend accelerator hardware
@@ -675,7 +835,7 @@ static GstTensorFilterFramework NNS_support_pytorch = {.version = GST_TENSOR_FIL
   {.v0 = {
        .name = filter_subplugin_pytorch,
        .allow_in_place = FALSE, /** @todo: support this to optimize performance later. */
-       .allocate_in_invoke = FALSE,
+       .allocate_in_invoke = TRUE,
        .run_without_model = FALSE,
        .verify_model_path = TRUE, /* check that the given .pt files are valid */
        .statistics = nullptr,
@@ -683,7 +843,7 @@ static GstTensorFilterFramework NNS_support_pytorch = {.version = GST_TENSOR_FIL
        .getInputDimension = torch_getInputDim,
        .getOutputDimension = torch_getOutputDim,
        .setInputDimension = nullptr,
-       .destroyNotify = nullptr,
+       .destroyNotify = torch_destroyNotify,
        .reloadModel = nullptr,
        .checkAvailability = torch_checkAvailability,
        .allocateInInvoke = nullptr,
@@ -37,6 +37,8 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include <tensorflow/c/c_api.h>
@@ -59,6 +61,15 @@ typedef struct {
   std::vector<std::int64_t> dims;
 } tf_tensor_info_s;
 
+/**
+ * @brief	Input tensor wrapping the memory of the previous frame
+ */
+typedef struct {
+  TF_Tensor *tensor; /**< tensor wrapping the data, nullptr if in use */
+  void *data; /**< the data pointer of the wrapped memory */
+  size_t size; /**< the size of the wrapped memory */
+} tf_input_cache_s;
+
 /**
  * @brief	ring cache structure
  */
@@ -82,6 +93,9 @@ class TFCore
 
   private:
   char *model_path;
+  int intra_op_threads; /**< the number of threads in an op, 0 for default */
+  int inter_op_threads; /**< the number of ops in parallel, 0 for default */
+  int warmup_count; /**< the number of dummy invokes after loading the model */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors from
                                      user input */
@@ -90,6 +104,8 @@ class TFCore
 
   std::vector<tf_tensor_info_s> input_tensor_info; /* hold information for TF */
   std::map<void *, TF_Tensor *> outputTensorMap;
+  std::vector<tf_input_cache_s> input_cache;
+  std::mutex cache_lock;
 
   TF_Graph *graph;
   TF_Session *session;
@@ -97,6 +113,12 @@ class TFCore
   tensor_type getTensorTypeFromTF (TF_DataType tfType);
   TF_DataType getTensorTypeToTF (tensor_type tType);
   int validateTensor (const GstTensorsInfo *tensorInfo, int is_input);
+  void parseCustomProperties (const char *custom_properties);
+  int setSessionConfig (TF_SessionOptions *options);
+  int warmup ();
+  TF_Tensor *acquireInputTensor (unsigned int idx, const GstTensorMemory *mem);
+  void releaseInputTensor (unsigned int idx, TF_Tensor *tensor, const GstTensorMemory *mem);
+  void clearInputCache ();
   static void releaseBuffer (void *data, size_t t);
 };
 
@@ -121,6 +143,9 @@ TFCore::TFCore (const char *_model_path)
   model_path = g_strdup (_model_path);
   graph = nullptr;
   session = nullptr;
+  intra_op_threads = 0;
+  inter_op_threads = 0;
+  warmup_count = 0;
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -132,6 +157,8 @@ TFCore::TFCore (const char *_model_path)
  */
 TFCore::~TFCore ()
 {
+  clearInputCache ();
+
   if (graph != nullptr)
     TF_DeleteGraph (graph);
 
@@ -167,6 +194,8 @@ TFCore::~TFCore ()
 int
 TFCore::init (const GstTensorFilterProperties *prop)
 {
+  parseCustomProperties (prop->custom_properties);
+
   if (loadModel ()) {
     ml_loge ("Failed to load model");
     return -1;
@@ -185,9 +214,152 @@ TFCore::init (const GstTensorFilterProperties *prop)
   gst_tensors_info_copy (&inputTensorMeta, &prop->input_meta);
   gst_tensors_info_copy (&outputTensorMeta, &prop->output_meta);
 
+  input_cache.assign (inputTensorMeta.num_tensors, tf_input_cache_s{ nullptr, nullptr, 0 });
+
+  if (warmup_count > 0 && warmup () != 0) {
+    /* not fatal, the first frames will be slow */
+    ml_logw ("Failed to warm up the session of %s", model_path);
+  }
+
   return 0;
 }
 
+/**
+ * @brief	parse the custom properties of tensorflow
+ * @param custom_properties : the string of custom properties
+ * @note	IntraOpThreads and InterOpThreads set the thread pools of the
+ *        session (ConfigProto), Warmup runs N dummy invokes at open time.
+ */
+void
+TFCore::parseCustomProperties (const char *custom_properties)
+{
+  gchar **strv;
+  guint i, len;
+
+  if (custom_properties == NULL)
+    return;
+
+  strv = g_strsplit (custom_properties, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", -1);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "IntraOpThreads") == 0) {
+        intra_op_threads = MAX (0, (int)g_ascii_strtoll (pair[1], NULL, 10));
+      } else if (g_ascii_strcasecmp (pair[0], "InterOpThreads") == 0) {
+        inter_op_threads = MAX (0, (int)g_ascii_strtoll (pair[1], NULL, 10));
+      } else if (g_ascii_strcasecmp (pair[0], "Warmup") == 0) {
+        warmup_count = MAX (0, (int)g_ascii_strtoll (pair[1], NULL, 10));
+      } else {
+        ml_logw ("Unknown option (%s).", strv[i]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+}
+
+/**
+ * @brief	append a varint field to the serialized protocol buffer
+ */
+static void
+tf_proto_append_varint (std::string &proto, guint32 field, guint64 value)
+{
+  guint64 key = ((guint64)field << 3); /* wire type 0 (varint) */
+
+  for (guint64 v : { key, value }) {
+    while (v >= 0x80) {
+      proto.push_back ((char)((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+    proto.push_back ((char)v);
+  }
+}
+
+/**
+ * @brief	set the thread pools of the session with serialized ConfigProto
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFCore::setSessionConfig (TF_SessionOptions *options)
+{
+  /* field numbers of tensorflow.ConfigProto */
+  const guint32 intra_op_parallelism_threads = 2;
+  const guint32 inter_op_parallelism_threads = 5;
+  std::string proto;
+  int ret = 0;
+
+  if (intra_op_threads > 0)
+    tf_proto_append_varint (proto, intra_op_parallelism_threads, intra_op_threads);
+  if (inter_op_threads > 0)
+    tf_proto_append_varint (proto, inter_op_parallelism_threads, inter_op_threads);
+
+  if (proto.empty ())
+    return 0;
+
+  TF_Status *status = TF_NewStatus ();
+  TF_SetConfig (options, proto.data (), proto.size (), status);
+  if (TF_GetCode (status) != TF_OK) {
+    ml_loge ("Error setting session config!! - [Code: %d] %s",
+        TF_GetCode (status), TF_Message (status));
+    ret = -1;
+  }
+  TF_DeleteStatus (status);
+
+  return ret;
+}
+
+/**
+ * @brief	run the session with zero-filled inputs to initialize the kernels
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFCore::warmup ()
+{
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT];
+  unsigned int i;
+  int n, ret = 0;
+
+  for (i = 0; i < inputTensorMeta.num_tensors; i++) {
+    if (input_tensor_info[i].type == TF_STRING) {
+      /* zero-filled data is not a valid encoded input */
+      ml_logw ("Cannot warm up the model with string input.");
+      return -1;
+    }
+  }
+
+  for (i = 0; i < inputTensorMeta.num_tensors; i++) {
+    input[i].size = gst_tensor_info_get_size (&inputTensorMeta.info[i]);
+    input[i].data = g_malloc0 (input[i].size);
+  }
+
+  for (n = 0; n < warmup_count; n++) {
+    if (run (input, output) != 0) {
+      ret = -1;
+      break;
+    }
+
+    for (i = 0; i < outputTensorMeta.num_tensors; i++)
+      freeOutputTensor (output[i].data);
+  }
+
+  /* the cached tensors wrap the dummy inputs */
+  clearInputCache ();
+
+  for (i = 0; i < inputTensorMeta.num_tensors; i++)
+    g_free (input[i].data);
+
+  return ret;
+}
+
 /**
  * @brief	get the model path
  * @return the model path.
@@ -256,6 +428,13 @@ TFCore::loadModel ()
   }
 
   TF_SessionOptions *options = TF_NewSessionOptions ();
+  if (setSessionConfig (options) != 0) {
+    TF_DeleteSessionOptions (options);
+    TF_DeleteStatus (status);
+    TF_DeleteGraph (graph);
+    return -4;
+  }
+
   session = TF_NewSession (graph, options, status);
   TF_DeleteSessionOptions (options);
 
@@ -304,6 +483,10 @@ TFCore::getTensorTypeFromTF (TF_DataType tfType)
     return _NNS_FLOAT32;
   case TF_DOUBLE:
     return _NNS_FLOAT64;
+  case TF_HALF:
+    return _NNS_FLOAT16;
+  case TF_BFLOAT16:
+    return _NNS_BFLOAT16;
   default:
     /** @todo Support other types */
     break;
@@ -341,6 +524,10 @@ TFCore::getTensorTypeToTF (tensor_type tType)
     return TF_FLOAT;
   case _NNS_FLOAT64:
     return TF_DOUBLE;
+  case _NNS_FLOAT16:
+    return TF_HALF;
+  case _NNS_BFLOAT16:
+    return TF_BFLOAT16;
   default:
     /** @todo Support other types */
     break;
@@ -467,6 +654,81 @@ DeallocateInputTensor (void *data, size_t len, void *arg)
   return;
 }
 
+/**
+ * @brief	get the input tensor wrapping the given memory
+ * @note	the tensor of the previous frame is reused if the memory is the same
+ *        (e.g., from a buffer pool), otherwise a new tensor is created. The
+ *        deallocator does nothing for non-string types, the memory is owned by
+ *        the input buffer.
+ */
+TF_Tensor *
+TFCore::acquireInputTensor (unsigned int idx, const GstTensorMemory *mem)
+{
+  TF_Tensor *tensor = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock (cache_lock);
+    tf_input_cache_s &cache = input_cache[idx];
+
+    if (cache.tensor && cache.data == mem->data && cache.size == mem->size) {
+      tensor = cache.tensor;
+      /* in use, a concurrent invoke (shared model) creates another tensor */
+      cache.tensor = nullptr;
+    }
+  }
+
+  if (tensor == nullptr) {
+    tensor = TF_NewTensor (input_tensor_info[idx].type,
+        input_tensor_info[idx].dims.data (), input_tensor_info[idx].rank,
+        mem->data, mem->size, DeallocateInputTensor, &input_tensor_info[idx]);
+  }
+
+  return tensor;
+}
+
+/**
+ * @brief	keep the input tensor for the next frame or delete it
+ */
+void
+TFCore::releaseInputTensor (unsigned int idx, TF_Tensor *tensor, const GstTensorMemory *mem)
+{
+  TF_Tensor *old = tensor;
+
+  if (tensor == nullptr)
+    return;
+
+  /* tensorflow copies misaligned data, then the tensor does not wrap the memory */
+  if (TF_TensorData (tensor) == mem->data) {
+    std::lock_guard<std::mutex> lock (cache_lock);
+    tf_input_cache_s &cache = input_cache[idx];
+
+    old = cache.tensor;
+    cache.tensor = tensor;
+    cache.data = mem->data;
+    cache.size = mem->size;
+  }
+
+  if (old)
+    TF_DeleteTensor (old);
+}
+
+/**
+ * @brief	delete the cached input tensors
+ */
+void
+TFCore::clearInputCache ()
+{
+  std::lock_guard<std::mutex> lock (cache_lock);
+
+  for (auto &cache : input_cache) {
+    if (cache.tensor)
+      TF_DeleteTensor (cache.tensor);
+    cache.tensor = nullptr;
+    cache.data = nullptr;
+    cache.size = 0;
+  }
+}
+
 /**
  * @brief	run the model with the input.
  * @param[in] input : The array of input tensors
@@ -525,9 +787,7 @@ TFCore::run (const GstTensorMemory *input, GstTensorMemory *output)
           input[i].size, DeallocateInputTensor, &input_tensor_info[i]);
 #endif /* TF <= 2.3 or >= 2.4 */
     } else {
-      in_tensor = TF_NewTensor (input_tensor_info[i].type,
-          input_tensor_info[i].dims.data (), input_tensor_info[i].rank, input[i].data,
-          input[i].size, DeallocateInputTensor, &input_tensor_info[i]);
+      in_tensor = acquireInputTensor (i, &input[i]);
     }
     input_tensors.push_back (in_tensor);
   }
@@ -561,7 +821,10 @@ TFCore::run (const GstTensorMemory *input, GstTensorMemory *output)
 
 failed:
   for (unsigned int i = 0; i < input_tensors.size (); i++) {
-    TF_DeleteTensor (input_tensors[i]);
+    if (input_tensor_info[i].type == TF_STRING)
+      TF_DeleteTensor (input_tensors[i]);
+    else
+      releaseInputTensor (i, input_tensors[i], &input[i]);
   }
 
   TF_DeleteStatus (status);
@@ -497,12 +497,13 @@ TFLiteInterpreter::getTensorType (TfLiteType tfType)
 #endif
   case kTfLiteInt64:
     return _NNS_INT64;
+#ifdef TFLITE_FLOAT16
+  case kTfLiteFloat16:
+    return _NNS_FLOAT16;
+#endif
   case kTfLiteString:
 #ifdef TFLITE_COMPLEX64
   case kTfLiteComplex64:
-#endif
-#ifdef TFLITE_FLOAT16
-  case kTfLiteFloat16:
 #endif
   default:
     ml_loge ("Not supported Tensorflow Data Type: [%d].", tfType);
@@ -91,6 +91,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_sink_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default number of threads for non-blocking server
+ */
+#define DEFAULT_PROP_NUM_THREADS  1
+
+/**
+ * @brief Default request/response (invoke) mode and the timeout to find
+ *        the paired tensor_src_grpc (msec)
+ */
+#define DEFAULT_PROP_INVOKE       FALSE
+#define INVOKE_LOOKUP_TIMEOUT     1000
+
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT
 
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -176,6 +188,19 @@ gst_tensor_sink_grpc_class_init (GstTensorSinkGRPCClass * klass)
           "The number of output messages generated",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of threads serving client streams (non-blocking server)",
+          1, G_MAXUINT16, DEFAULT_PROP_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_INVOKE,
+      g_param_spec_boolean ("invoke", "Invoke",
+          "Request/response mode. Send buffers via tensor_src_grpc "
+          "(invoke=true) having the same server, host and port. The server "
+          "sends responses and the client sends requests",
+          DEFAULT_PROP_INVOKE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &sinktemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -209,6 +234,8 @@ grpc_config_init (GstTensorSinkGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_TENSORS_TO_BUFFER;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_threads = DEFAULT_PROP_NUM_THREADS;
+  grpc->config.is_invoke = DEFAULT_PROP_INVOKE;
   grpc->config.config = &self->config;
 }
 
@@ -253,14 +280,20 @@ gst_tensor_sink_grpc_setcaps (GstBaseSink * sink, GstCaps * caps)
 {
   GstTensorSinkGRPC *self;
   GstStructure *structure;
+  grpc_private *grpc;
 
   self = GST_TENSOR_SINK_GRPC (sink);
+  grpc = GET_GRPC_PRIVATE (self);
 
   GST_OBJECT_LOCK (self);
 
   structure = gst_caps_get_structure (caps, 0);
   gst_tensors_config_from_structure (&self->config, structure);
 
+  /* the instance shared in invoke mode keeps its own copy of the config */
+  if (grpc->config.is_invoke && grpc->instance)
+    grpc_set_send_config (grpc->instance, &self->config);
+
   GST_OBJECT_FLAG_SET (self, GST_TENSOR_SINK_GRPC_CONFIGURED);
 
   GST_OBJECT_UNLOCK (self);
@@ -281,6 +314,23 @@ gst_tensor_sink_grpc_render (GstBaseSink * sink, GstBuffer * buf)
   g_return_val_if_fail (GST_OBJECT_FLAG_IS_SET (self,
           GST_TENSOR_SINK_GRPC_STARTED), GST_FLOW_FLUSHING);
 
+  if (grpc->config.is_invoke && !grpc->instance) {
+    /* wait until the paired tensor_src_grpc is started */
+    grpc->instance = grpc_lookup (&grpc->config, INVOKE_LOOKUP_TIMEOUT);
+
+    if (!grpc->instance) {
+      GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND,
+          ("Failed to find the paired tensor_src_grpc in invoke mode."), (NULL));
+      return GST_FLOW_ERROR;
+    }
+
+    if (grpc->config.is_server) {
+      gint port = grpc_get_listening_port (grpc->instance);
+      if (port > 0)
+        g_object_set (self, "port", port, NULL);
+    }
+  }
+
   ret = grpc_send (grpc->instance, buf);
 
   return ret ? GST_FLOW_OK : GST_FLOW_ERROR;
@@ -335,8 +385,19 @@ gst_tensor_sink_grpc_start (GstBaseSink * sink)
   if (GST_OBJECT_FLAG_IS_SET (self, GST_TENSOR_SINK_GRPC_STARTED))
     return TRUE;
 
-  if (grpc->instance)
-    grpc_destroy (grpc->instance);
+  if (grpc->instance) {
+    if (grpc->config.is_invoke)
+      grpc_release (grpc->instance);
+    else
+      grpc_destroy (grpc->instance);
+  }
+  grpc->instance = NULL;
+
+  if (grpc->config.is_invoke) {
+    /* share the instance of tensor_src_grpc when the first buffer arrives */
+    GST_OBJECT_FLAG_SET (self, GST_TENSOR_SINK_GRPC_STARTED);
+    return TRUE;
+  }
 
   grpc->instance = grpc_new (&grpc->config);
   if (!grpc->instance)
@@ -368,8 +429,12 @@ gst_tensor_sink_grpc_stop (GstBaseSink * sink)
   if (!GST_OBJECT_FLAG_IS_SET (self, GST_TENSOR_SINK_GRPC_STARTED))
     return TRUE;
 
-  if (grpc->instance)
-    grpc_destroy (grpc->instance);
+  if (grpc->instance) {
+    if (grpc->config.is_invoke)
+      grpc_release (grpc->instance);
+    else
+      grpc_destroy (grpc->instance);
+  }
   grpc->instance = NULL;
 
   GST_OBJECT_FLAG_UNSET (self, GST_TENSOR_SINK_GRPC_STARTED);
@@ -386,8 +451,8 @@ gst_tensor_sink_grpc_unlock (GstBaseSink * sink)
   GstTensorSinkGRPC *self = GST_TENSOR_SINK_GRPC (sink);
   grpc_private *grpc = GET_GRPC_PRIVATE (self);
 
-  /* notify to gRPC */
-  if (grpc->instance)
+  /* notify to gRPC, the paired tensor_src_grpc stops the shared instance */
+  if (grpc->instance && !grpc->config.is_invoke)
     grpc_stop (grpc->instance);
 
   silent_debug ("Unlocking create");
@@ -89,6 +89,19 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_src_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default options for non-blocking server serving multiple clients
+ */
+#define DEFAULT_PROP_NUM_THREADS  1
+#define DEFAULT_PROP_QUEUE_SIZE   0
+#define DEFAULT_PROP_FANIN        "fifo"
+
+/**
+ * @brief Default options for request/response (invoke) mode
+ */
+#define DEFAULT_PROP_INVOKE         FALSE
+#define DEFAULT_PROP_MAX_IN_FLIGHT  4
+
 #define GST_TENSOR_SRC_GRPC_SCALED_TIME(self, count)\
   gst_util_uint64_scale (count, \
       self->config.rate_d * GST_SECOND, self->config.rate_n)
@@ -176,6 +189,39 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
           "The number of output buffers generated",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of threads serving client streams (non-blocking server)",
+          1, G_MAXUINT16, DEFAULT_PROP_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_SIZE,
+      g_param_spec_uint ("queue-size", "Queue size",
+          "The max number of buffers held per client stream, the oldest one "
+          "is dropped if full (0=unlimited and lossless, non-blocking server)",
+          0, G_MAXUINT, DEFAULT_PROP_QUEUE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_FANIN,
+      g_param_spec_string ("fan-in", "Fan-in policy",
+          "The policy to merge buffers of client streams: "
+          "fifo (arrival order) or round-robin (non-blocking server)",
+          DEFAULT_PROP_FANIN, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_INVOKE,
+      g_param_spec_boolean ("invoke", "Invoke",
+          "Request/response mode. Pair with tensor_sink_grpc (invoke=true) "
+          "having the same server, host and port. The server outputs requests "
+          "and the client outputs responses with the sequence id as offset",
+          DEFAULT_PROP_INVOKE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_IN_FLIGHT,
+      g_param_spec_uint ("max-in-flight", "Max in-flight",
+          "The max number of requests not responded yet per stream, "
+          "sending requests is blocked if reached (invoke mode)",
+          1, G_MAXUINT16, DEFAULT_PROP_MAX_IN_FLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &srctemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -200,12 +246,21 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
 
 /**
  * @brief callback for checking data_queue full
+ * @note The non-blocking server fans in the client streams. Its data queue
+ * holds one buffer so that the fan-in thread waits for the src task and
+ * the buffers are kept (or dropped) in the queues of the client streams.
  */
 static gboolean
 _data_queue_check_full_cb (GstDataQueue * queue, guint visible,
     guint bytes, guint64 time, gpointer checkdata)
 {
-  /** it's dummy */
+  GstTensorSrcGRPC *self = GST_TENSOR_SRC_GRPC_CAST (checkdata);
+  grpc_private *grpc = GET_GRPC_PRIVATE (self);
+
+  if (grpc->config.is_server && !grpc->config.is_blocking &&
+      !grpc->config.is_invoke)
+    return (visible >= 1);
+
   return FALSE;
 }
 
@@ -306,6 +361,11 @@ grpc_config_init (GstTensorSrcGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_BUFFER_TO_TENSORS;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_threads = DEFAULT_PROP_NUM_THREADS;
+  grpc->config.queue_size = DEFAULT_PROP_QUEUE_SIZE;
+  grpc->config.fanin = grpc_get_fanin (DEFAULT_PROP_FANIN);
+  grpc->config.is_invoke = DEFAULT_PROP_INVOKE;
+  grpc->config.max_in_flight = DEFAULT_PROP_MAX_IN_FLIGHT;
   grpc->config.cb = _grpc_callback;
   grpc->config.cb_data = (void *) self;
   grpc->config.config = &self->config;
@@ -320,7 +380,7 @@ gst_tensor_src_grpc_init (GstTensorSrcGRPC * self)
   gst_tensors_config_init (&self->config);
 
   self->queue = gst_data_queue_new (_data_queue_check_full_cb,
-      NULL, NULL, NULL);
+      NULL, NULL, self);
   self->silent = DEFAULT_PROP_SILENT;
   self->out = 0;
 
@@ -360,6 +420,9 @@ gst_tensor_src_grpc_start (GstBaseSrc * src)
   if (grpc->instance)
     grpc_destroy (grpc->instance);
 
+  grpc->config.dir = grpc->config.is_invoke ?
+      GRPC_DIRECTION_BIDIRECTIONAL : GRPC_DIRECTION_BUFFER_TO_TENSORS;
+
   grpc->instance = grpc_new (&grpc->config);
   if (!grpc->instance)
     return FALSE;
@@ -410,13 +473,14 @@ gst_tensor_src_grpc_unlock (GstBaseSrc * src)
   GstTensorSrcGRPC *self = GST_TENSOR_SRC_GRPC (src);
   grpc_private *grpc = GET_GRPC_PRIVATE (self);
 
+  /* wake up the fan-in thread waiting for the data queue before stopping */
+  silent_debug ("Unlocking create");
+  gst_data_queue_set_flushing (self->queue, TRUE);
+
   /* notify to gRPC */
   if (grpc->instance)
     grpc_stop (grpc->instance);
 
-  silent_debug ("Unlocking create");
-  gst_data_queue_set_flushing (self->queue, TRUE);
-
   return TRUE;
 }
 
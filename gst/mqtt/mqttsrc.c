@@ -98,6 +98,7 @@ static GstFlowReturn
 gst_mqtt_src_create (GstBaseSrc * basesrc, guint64 offset, guint size,
     GstBuffer ** buf);
 static gboolean gst_mqtt_src_query (GstBaseSrc * basesrc, GstQuery * query);
+static gboolean gst_mqtt_src_event (GstBaseSrc * basesrc, GstEvent * event);
 
 static gboolean gst_mqtt_src_get_debug (GstMqttSrc * self);
 static void gst_mqtt_src_set_debug (GstMqttSrc * self, const gboolean flag);
@@ -148,6 +149,25 @@ static void _put_timestamp_on_gst_buf (GstMqttSrc * self,
 static gboolean _subscribe (GstMqttSrc * self);
 static gboolean _unsubscribe (GstMqttSrc * self);
 
+/**
+ * @brief Check the buffer will be dropped in downstream by the throttling QoS
+ * @note The overflow QoS event (e.g., from tensor_filter) gives the timestamp
+ *       of the next buffer to be processed in downstream.
+ */
+static gboolean
+_is_gst_buffer_throttled (GstMqttSrc * self, GstBuffer * buf)
+{
+  gboolean skip;
+
+  GST_OBJECT_LOCK (self);
+  if (GST_BUFFER_DURATION_IS_VALID (buf))
+    self->qos_duration = GST_BUFFER_DURATION (buf);
+  skip = gst_tensor_qos_skip (&self->qos, GST_BUFFER_PTS (buf));
+  GST_OBJECT_UNLOCK (self);
+
+  return skip;
+}
+
 /**
  * @brief A utility function to check whether the timestamp marked by _put_timestamp_on_gst_buf () is valid or not
  */
@@ -207,6 +227,8 @@ gst_mqtt_src_init (GstMqttSrc * self)
   self->caps = NULL;
   self->latency = GST_CLOCK_TIME_NONE;
   self->num_dumped = 0;
+  gst_tensor_qos_reset (&self->qos);
+  self->qos_duration = GST_CLOCK_TIME_NONE;
 
   gst_base_src_set_live (basesrc, self->is_live);
 }
@@ -296,6 +318,7 @@ gst_mqtt_src_class_init (GstMqttSrcClass * klass)
   gstbasesrc_class->is_seekable = GST_DEBUG_FUNCPTR (gst_mqtt_src_is_seekable);
   gstbasesrc_class->create = GST_DEBUG_FUNCPTR (gst_mqtt_src_create);
   gstbasesrc_class->query = GST_DEBUG_FUNCPTR (gst_mqtt_src_query);
+  gstbasesrc_class->event = GST_DEBUG_FUNCPTR (gst_mqtt_src_event);
 
   gst_element_class_set_static_metadata (gstelement_class,
       "MQTT source", "Source/MQTT",
@@ -726,6 +749,18 @@ gst_mqtt_src_create (GstBaseSrc * basesrc, guint64 offset, guint size,
         continue;
       }
 
+      /** This buffer will be dropped in downstream. Skip it */
+      if (_is_gst_buffer_throttled (self, *buf)) {
+        if (self->debug) {
+          GST_DEBUG_OBJECT (self,
+              "%s: Skipped the received buffer! (total: %" G_GUINT64_FORMAT ")",
+              self->mqtt_topic, self->qos.skipped);
+        }
+        elapsed = self->mqtt_sub_timeout;
+        gst_buffer_unref (*buf);
+        continue;
+      }
+
       /** Update latency */
       clock = gst_element_get_clock (GST_ELEMENT (self));
       if (clock) {
@@ -790,6 +825,23 @@ ret_flow_err:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief An implementation of the GstBaseSrc vmethod that handles events
+ */
+static gboolean
+gst_mqtt_src_event (GstBaseSrc * basesrc, GstEvent * event)
+{
+  GstMqttSrc *self = GST_MQTT_SRC (basesrc);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_QOS) {
+    GST_OBJECT_LOCK (self);
+    gst_tensor_qos_update (&self->qos, event, self->qos_duration);
+    GST_OBJECT_UNLOCK (self);
+  }
+
+  return GST_BASE_SRC_CLASS (parent_class)->event (basesrc, event);
+}
+
 /**
  * @brief An implementation of the GstBaseSrc vmethod that handles queries
  */
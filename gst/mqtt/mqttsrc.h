@@ -17,6 +17,7 @@
 #include <gst/base/gstdataqueue.h>
 #include <gst/gst.h>
 #include <MQTTAsync.h>
+#include <tensor_common.h>
 
 #include "mqttcommon.h"
 
@@ -60,6 +61,10 @@ struct _GstMqttSrc {
   guint64 num_dumped;
   gint mqtt_qos;
 
+  /** throttling QoS (overflow) from downstream */
+  GstTensorQoS qos;
+  GstClockTime qos_duration; /**< the duration of the last received buffer */
+
   GAsyncQueue *aqueue;
   GMutex mqtt_src_mutex;
   GCond mqtt_src_gcond;
@@ -15,6 +15,8 @@
 
 #include <hw_accel.h>
 #include <errno.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_conf.h>
 
 #if defined(__aarch64__) || defined(__arm__)
 #if defined(__TIZEN__)
@@ -24,6 +26,10 @@
 #endif /* __TIZEN__ */
 #endif /* __arch64__ || __arm__ */
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <cpuid.h>
+#endif /* __x86_64__ || __i386__ */
+
 #if !defined(__APPLE__)
 #include <sys/auxv.h>
 #else
@@ -62,3 +68,321 @@ cpu_neon_accel_available (void)
 
   return neon_available;
 }
+
+/**
+ * @brief Names of the CPU features (the same order with cpu_feature bits).
+ */
+static const gchar *cpu_feature_names[] = {
+  "sse4.2", "avx2", "avx512f", "neon", "sve", "f16c", NULL
+};
+
+/**
+ * @brief An implementation of the kernel.
+ */
+typedef struct
+{
+  guint features; /**< CPU features required */
+  GCallback func; /**< implementation */
+} cpu_accel_impl;
+
+/**
+ * @brief CPU features enabled and the registered kernels.
+ */
+static struct
+{
+  GMutex lock;
+  guint features; /**< CPU features enabled */
+  GHashTable *kernels; /**< kernel name to the list of cpu_accel_impl */
+} cpu_accel;
+
+/**
+ * @brief Detect the CPU features.
+ */
+static guint
+_cpu_accel_detect (void)
+{
+  guint features = CPU_FEATURE_NONE;
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  guint eax, ebx, ecx, edx;
+
+  __builtin_cpu_init ();
+
+  if (__builtin_cpu_supports ("sse4.2"))
+    features |= CPU_FEATURE_SSE4_2;
+  if (__builtin_cpu_supports ("avx2"))
+    features |= CPU_FEATURE_AVX2;
+  if (__builtin_cpu_supports ("avx512f"))
+    features |= CPU_FEATURE_AVX512F;
+  /* older compilers do not know "f16c" in __builtin_cpu_supports */
+  if (__get_cpuid (1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C) &&
+      __builtin_cpu_supports ("avx"))
+    features |= CPU_FEATURE_F16C;
+#endif /* __x86_64__ || __i386__ */
+
+#if defined(__aarch64__) || defined(__arm__)
+  if (cpu_neon_accel_available () == 0)
+    features |= CPU_FEATURE_NEON;
+#endif /* __aarch64__ || __arm__ */
+
+#if defined(__aarch64__) && defined(HWCAP_SVE) && !defined(__APPLE__)
+  if (getauxval (AT_HWCAP) & HWCAP_SVE)
+    features |= CPU_FEATURE_SVE;
+#endif /* __aarch64__ */
+
+  return features;
+}
+
+/**
+ * @brief Parse the feature name.
+ */
+static guint
+_cpu_accel_parse_feature (const gchar * name)
+{
+  guint i;
+
+  for (i = 0; cpu_feature_names[i]; i++) {
+    if (g_ascii_strcasecmp (name, cpu_feature_names[i]) == 0)
+      return (1U << i);
+  }
+
+  nns_logw ("Unknown CPU feature '%s' in the configuration.", name);
+  return CPU_FEATURE_NONE;
+}
+
+/**
+ * @brief Apply the override of the configuration to the detected features.
+ */
+static guint
+_cpu_accel_override (guint detected, const gchar * str)
+{
+  gchar **names;
+  guint i, allowed = CPU_FEATURE_NONE, removed = CPU_FEATURE_NONE;
+  gboolean has_allowed = FALSE;
+
+  if (!str || g_ascii_strcasecmp (str, "auto") == 0)
+    return detected;
+  if (g_ascii_strcasecmp (str, "none") == 0)
+    return CPU_FEATURE_NONE;
+
+  /* "avx2,sse4.2" allows listed features only, "-avx512f" removes it. */
+  names = g_strsplit (str, ",", -1);
+  for (i = 0; names[i]; i++) {
+    gchar *name = g_strstrip (names[i]);
+
+    if (name[0] == '\0')
+      continue;
+
+    if (name[0] == '-') {
+      removed |= _cpu_accel_parse_feature (name + 1);
+    } else {
+      allowed |= _cpu_accel_parse_feature (name);
+      has_allowed = TRUE;
+    }
+  }
+  g_strfreev (names);
+
+  /* cannot enable the features which are not supported */
+  if (has_allowed)
+    detected &= allowed;
+
+  return detected & ~removed;
+}
+
+/**
+ * @brief Get the string of the features, caller should free the returned string.
+ */
+static gchar *
+_cpu_accel_features_string (guint features)
+{
+  GString *str = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; cpu_feature_names[i]; i++) {
+    if (features & (1U << i)) {
+      if (str->len > 0)
+        g_string_append_c (str, ',');
+      g_string_append (str, cpu_feature_names[i]);
+    }
+  }
+
+  if (str->len == 0)
+    g_string_append (str, "none");
+
+  return g_string_free (str, FALSE);
+}
+
+/**
+ * @brief Free the implementations of the kernel.
+ */
+static void
+_cpu_accel_free_impls (gpointer data)
+{
+  g_slist_free_full ((GSList *) data, g_free);
+}
+
+/**
+ * @brief Detect the CPU features and apply the override in the configuration.
+ */
+void
+cpu_accel_init (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized)) {
+    guint detected;
+    gchar *conf, *str;
+
+    g_mutex_init (&cpu_accel.lock);
+    cpu_accel.kernels = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, _cpu_accel_free_impls);
+
+    detected = _cpu_accel_detect ();
+    conf = nnsconf_get_custom_value_string ("common", "cpu_features");
+    cpu_accel.features = _cpu_accel_override (detected, conf);
+
+    str = _cpu_accel_features_string (cpu_accel.features);
+    nns_logi ("CPU features for the kernels: %s%s", str,
+        (cpu_accel.features != detected) ? " (overridden)" : "");
+    g_free (str);
+    g_free (conf);
+
+    g_once_init_leave (&initialized, 1);
+  }
+}
+
+/**
+ * @brief Get the CPU features enabled.
+ */
+guint
+cpu_accel_get_features (void)
+{
+  cpu_accel_init ();
+  return cpu_accel.features;
+}
+
+/**
+ * @brief Check if all given CPU features are enabled.
+ */
+gboolean
+cpu_accel_has_features (guint features)
+{
+  return (cpu_accel_get_features () & features) == features;
+}
+
+/**
+ * @brief Priority of the CPU features (the same order with cpu_feature bits).
+ * A kernel using the wider vector extension has higher priority. Note that the bit value does not mean the capability.
+ */
+static const guint cpu_feature_priority[] = {
+  1, /* sse4.2 */
+  3, /* avx2 */
+  4, /* avx512f */
+  1, /* neon */
+  2, /* sve */
+  2, /* f16c */
+};
+
+/**
+ * @brief Get the priority of the implementation, the highest priority of the features required.
+ */
+static guint
+_cpu_accel_impl_priority (const cpu_accel_impl * impl, guint * count)
+{
+  guint i, priority = 0;
+
+  *count = 0;
+  for (i = 0; i < G_N_ELEMENTS (cpu_feature_priority); i++) {
+    if (impl->features & (1U << i)) {
+      priority = MAX (priority, cpu_feature_priority[i]);
+      (*count)++;
+    }
+  }
+
+  return priority;
+}
+
+/**
+ * @brief Compare the implementations, the one requiring the feature with the highest priority comes first.
+ * If the priority is same, the one requiring more features comes first.
+ */
+static gint
+_cpu_accel_compare_impl (gconstpointer a, gconstpointer b)
+{
+  const cpu_accel_impl *ia = (const cpu_accel_impl *) a;
+  const cpu_accel_impl *ib = (const cpu_accel_impl *) b;
+  guint pa, pb, ca, cb;
+
+  pa = _cpu_accel_impl_priority (ia, &ca);
+  pb = _cpu_accel_impl_priority (ib, &cb);
+
+  if (pa != pb)
+    return (pa > pb) ? -1 : 1;
+  if (ca != cb)
+    return (ca > cb) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Register a kernel implementation requiring given CPU features.
+ */
+gboolean
+cpu_accel_register (const gchar * kernel, guint features, GCallback func)
+{
+  cpu_accel_impl *impl;
+  GSList *impls;
+  gpointer key;
+
+  g_return_val_if_fail (kernel != NULL && kernel[0] != '\0', FALSE);
+  g_return_val_if_fail (func != NULL, FALSE);
+
+  cpu_accel_init ();
+
+  impl = g_new0 (cpu_accel_impl, 1);
+  impl->features = features;
+  impl->func = func;
+
+  g_mutex_lock (&cpu_accel.lock);
+  if (g_hash_table_lookup_extended (cpu_accel.kernels, kernel, &key,
+          (gpointer *) & impls)) {
+    g_hash_table_steal (cpu_accel.kernels, kernel);
+  } else {
+    key = g_strdup (kernel);
+    impls = NULL;
+  }
+
+  impls = g_slist_insert_sorted (impls, impl, _cpu_accel_compare_impl);
+  g_hash_table_insert (cpu_accel.kernels, key, impls);
+  g_mutex_unlock (&cpu_accel.lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the best implementation of the kernel for the CPU features enabled.
+ */
+GCallback
+cpu_accel_get (const gchar * kernel)
+{
+  cpu_accel_impl *impl;
+  GCallback func = NULL;
+  GSList *l;
+
+  g_return_val_if_fail (kernel != NULL, NULL);
+
+  cpu_accel_init ();
+
+  g_mutex_lock (&cpu_accel.lock);
+  l = g_hash_table_lookup (cpu_accel.kernels, kernel);
+  for (; l; l = l->next) {
+    impl = (cpu_accel_impl *) l->data;
+
+    if ((cpu_accel.features & impl->features) == impl->features) {
+      func = impl->func;
+      break;
+    }
+  }
+  g_mutex_unlock (&cpu_accel.lock);
+
+  return func;
+}
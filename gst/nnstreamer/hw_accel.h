@@ -18,10 +18,61 @@
 
 #include <glib.h>
 
+G_BEGIN_DECLS
+
 /**
  * @brief Check if neon is supported
  * @retval 0 if supported, else -errno
  */
 gint cpu_neon_accel_available (void);
 
+/**
+ * @brief CPU features to select the kernels at runtime.
+ */
+typedef enum
+{
+  CPU_FEATURE_NONE = 0,
+  CPU_FEATURE_SSE4_2 = (1 << 0),
+  CPU_FEATURE_AVX2 = (1 << 1),
+  CPU_FEATURE_AVX512F = (1 << 2),
+  CPU_FEATURE_NEON = (1 << 3),
+  CPU_FEATURE_SVE = (1 << 4),
+  CPU_FEATURE_F16C = (1 << 5),
+} cpu_feature;
+
+/**
+ * @brief Detect the CPU features and apply the override in the configuration.
+ * @note The features are detected once. The override is read from [common] cpu_features of nnstreamer.ini
+ *       (or the envvar NNSTREAMER_common_cpu_features), e.g., "none", "avx2,sse4.2" or "-avx512f".
+ */
+void cpu_accel_init (void);
+
+/**
+ * @brief Get the CPU features enabled.
+ * @return Bitwise-or of cpu_feature
+ */
+guint cpu_accel_get_features (void);
+
+/**
+ * @brief Check if all given CPU features are enabled.
+ */
+gboolean cpu_accel_has_features (guint features);
+
+/**
+ * @brief Register a kernel implementation requiring given CPU features.
+ * @param[in] kernel The name of the kernel
+ * @param[in] features The CPU features required by the implementation (bitwise-or of cpu_feature)
+ * @param[in] func The implementation
+ * @return TRUE if registered
+ */
+gboolean cpu_accel_register (const gchar * kernel, guint features, GCallback func);
+
+/**
+ * @brief Get the best implementation of the kernel for the CPU features enabled.
+ * @param[in] kernel The name of the kernel
+ * @return The implementation or NULL if there is no available implementation
+ */
+GCallback cpu_accel_get (const gchar * kernel);
+
+G_END_DECLS
 #endif /* __G_HW_ACCEL__ */
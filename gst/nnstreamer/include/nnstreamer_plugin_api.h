@@ -528,10 +528,19 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem);
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If given memory has enough prefix (see gst_tensor_alloc_memory()), this writes the header into the prefix and returns the sub-memory without copying tensor data.
  */
 extern GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Allocate memory for tensor data, reserving the prefix for tensor header.
+ * @param[in] size the size of tensor data
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+extern GstMemory *
+gst_tensor_alloc_memory (gsize size);
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
@@ -60,7 +60,7 @@
 /**
  * @brief Possible tensor element types
  */
-#define GST_TENSOR_TYPE_ALL "{ float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }"
+#define GST_TENSOR_TYPE_ALL "{ float16, bfloat16, float32, float64, int64, uint64, int32, uint32, int16, uint16, int8, uint8 }"
 
 /**
  * @brief Possible tensor formats
@@ -155,6 +155,8 @@ typedef enum _nns_tensor_type
   _NNS_FLOAT32,
   _NNS_INT64,
   _NNS_UINT64,
+  _NNS_FLOAT16, /**< IEEE 754 half precision */
+  _NNS_BFLOAT16, /**< bfloat16, upper half of float32 */
 
   _NNS_END,
 } tensor_type;
@@ -205,6 +207,8 @@ typedef union {
   float _float;
   int64_t _int64_t;
   uint64_t _uint64_t;
+  uint16_t _float16; /**< raw bits of float16 */
+  uint16_t _bfloat16; /**< raw bits of bfloat16 */
 } tensor_element;
 
 typedef uint32_t tensor_dim[NNS_TENSOR_RANK_LIMIT];
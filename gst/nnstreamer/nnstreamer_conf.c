@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 
 #include "nnstreamer_log.h"
 #include "nnstreamer_conf.h"
@@ -66,6 +67,15 @@ static const gchar *subplugin_prefixes[] = {
   [NNSCONF_PATH_END] = NULL
 };
 
+/* Group names of the registry cache */
+static const gchar *registry_groups[NNSCONF_PATH_END] = {
+  [NNSCONF_PATH_FILTERS] = "filter",
+  [NNSCONF_PATH_DECODERS] = "decoder",
+  [NNSCONF_PATH_CUSTOM_FILTERS] = "customfilter",
+  [NNSCONF_PATH_EASY_CUSTOM_FILTERS] = "customfilter", /**< Same as Custom Filters */
+  [NNSCONF_PATH_CONVERTERS] = "converter",
+};
+
 typedef enum
 {
   CONF_SOURCE_ENVVAR = 0,
@@ -94,14 +104,20 @@ typedef struct
   gboolean loaded;            /**< TRUE if loaded at least once */
   gboolean enable_envvar;     /**< TRUE to parse env variables */
   gboolean enable_symlink;    /**< TRUE to allow symbolic link file */
+  gboolean enable_registry;   /**< TRUE to use the registry cache */
 
   gchar *conffile;            /**< Location of conf file. */
+  gchar *registry_file;       /**< Location of the registry cache. */
+  GKeyFile *registry;         /**< The registry cache of sub-plugins */
 
   subplugin_conf conf[NNSCONF_PATH_END];
 } confdata;
 
 static confdata conf = { 0 };
 
+/** @brief Protects the registry cache */
+G_LOCK_DEFINE_STATIC (registry_lock);
+
 /**
  * @brief Parse string to get boolean value.
  */
@@ -313,12 +329,200 @@ _fill_in_vstr (gchar *** fullpath_vstr, gchar *** name_vstr,
   g_slist_free (lstN);
 }
 
+/**
+ * @brief Private function to get the signature of the search paths (directories and their mtime).
+ * @param[in] searchpath The search paths of a sub-plugin type.
+ * @param[out] stable FALSE if a directory is modified in this second, the listing may be changed again with the same mtime.
+ * @return Newly allocated signature string.
+ */
+static gchar *
+_registry_get_signature (gchar * searchpath[CONF_SOURCE_END],
+    gboolean * stable)
+{
+  GString *sig;
+  GStatBuf st;
+  gint64 now, mtime;
+  guint i, j;
+
+  sig = g_string_new (NULL);
+  now = g_get_real_time () / G_USEC_PER_SEC;
+  *stable = TRUE;
+
+  g_string_append_printf (sig, "symlink=%d;", conf.enable_symlink);
+
+  for (i = 0; i < CONF_SOURCE_END; i++) {
+    if (searchpath[i]) {
+      /* skip duplicated paths, same as _fill_in_vstr() */
+      for (j = i + 1; j < CONF_SOURCE_END; j++) {
+        if (searchpath[j] && !g_strcmp0 (searchpath[i], searchpath[j]))
+          break;
+      }
+      if (j < CONF_SOURCE_END)
+        continue;
+
+      mtime = -1;
+      if (g_stat (searchpath[i], &st) == 0) {
+        mtime = (gint64) st.st_mtime;
+        if (mtime >= now)
+          *stable = FALSE;
+      }
+
+      g_string_append_printf (sig, "%s:%" G_GINT64_FORMAT ";", searchpath[i],
+          mtime);
+    }
+  }
+
+  return g_string_free (sig, FALSE);
+}
+
+/**
+ * @brief Private function to get the sub-plugin list from the registry cache.
+ * @return TRUE if the cache is valid and the list is filled in.
+ */
+static gboolean
+_registry_get_list (nnsconf_type_path type, const gchar * signature,
+    gchar *** fullpath_vstr, gchar *** name_vstr)
+{
+  const gchar *group = registry_groups[type];
+  gchar *cached;
+  gchar **files, **names;
+  gboolean valid;
+
+  if (!conf.registry)
+    return FALSE;
+
+  cached = g_key_file_get_string (conf.registry, group, "signature", NULL);
+  valid = (g_strcmp0 (cached, signature) == 0);
+  g_free (cached);
+
+  if (!valid)
+    return FALSE;
+
+  files = g_key_file_get_string_list (conf.registry, group, "files", NULL,
+      NULL);
+  names = g_key_file_get_string_list (conf.registry, group, "names", NULL,
+      NULL);
+
+  /* empty list is not saved in the key file */
+  if (!files)
+    files = g_new0 (gchar *, 1);
+  if (!names)
+    names = g_new0 (gchar *, 1);
+
+  if (g_strv_length (files) != g_strv_length (names)) {
+    g_strfreev (files);
+    g_strfreev (names);
+    return FALSE;
+  }
+
+  *fullpath_vstr = files;
+  *name_vstr = names;
+  return TRUE;
+}
+
+/**
+ * @brief Private function to update the sub-plugin list in the registry cache.
+ */
+static void
+_registry_set_list (nnsconf_type_path type, const gchar * signature,
+    gchar ** fullpath_vstr, gchar ** name_vstr)
+{
+  const gchar *group = registry_groups[type];
+
+  if (!conf.registry)
+    return;
+
+  g_key_file_set_string (conf.registry, group, "signature", signature);
+  g_key_file_set_string_list (conf.registry, group, "files",
+      (const gchar * const *) fullpath_vstr, g_strv_length (fullpath_vstr));
+  g_key_file_set_string_list (conf.registry, group, "names",
+      (const gchar * const *) name_vstr, g_strv_length (name_vstr));
+}
+
+/**
+ * @brief Private function to save the registry cache.
+ */
+static void
+_registry_save (void)
+{
+  gchar *dir;
+  GError *error = NULL;
+
+  if (!conf.registry || !conf.registry_file)
+    return;
+
+  dir = g_path_get_dirname (conf.registry_file);
+  g_mkdir_with_parents (dir, 0755);
+  g_free (dir);
+
+  if (!g_key_file_save_to_file (conf.registry, conf.registry_file, &error)) {
+    ml_logw ("Failed to save the registry cache %s: %s", conf.registry_file,
+        error ? error->message : "unknown");
+    g_clear_error (&error);
+  }
+}
+
+/**
+ * @brief Private function to load the registry cache.
+ */
+static void
+_registry_load (void)
+{
+  if (!conf.enable_registry)
+    return;
+
+  if (conf.registry_file == NULL || conf.registry_file[0] == '\0') {
+    g_free (conf.registry_file);
+    conf.registry_file = g_build_filename (g_get_user_cache_dir (),
+        "nnstreamer", "registry.cache", NULL);
+  }
+
+  conf.registry = g_key_file_new ();
+
+  /* It's ok even if we cannot load it, the cache will be created. */
+  g_key_file_load_from_file (conf.registry, conf.registry_file,
+      G_KEY_FILE_NONE, NULL);
+}
+
+/**
+ * @brief Private function to fill in the sub-plugin list, from the registry cache if it is valid.
+ * @return TRUE if the registry cache is updated.
+ */
+static gboolean
+_fill_in_vstr_cached (gchar *** fullpath_vstr, gchar *** name_vstr,
+    gchar * searchpath[CONF_SOURCE_END], nnsconf_type_path type)
+{
+  gchar *signature;
+  gboolean stable, updated = FALSE;
+
+  if (!conf.registry) {
+    _fill_in_vstr (fullpath_vstr, name_vstr, searchpath, type);
+    return FALSE;
+  }
+
+  signature = _registry_get_signature (searchpath, &stable);
+
+  if (!stable || !_registry_get_list (type, signature, fullpath_vstr,
+          name_vstr)) {
+    _fill_in_vstr (fullpath_vstr, name_vstr, searchpath, type);
+
+    if (stable) {
+      _registry_set_list (type, signature, *fullpath_vstr, *name_vstr);
+      updated = TRUE;
+    }
+  }
+
+  g_free (signature);
+  return updated;
+}
+
 /** @brief Public function defined in the header */
 gboolean
 nnsconf_loadconf (gboolean force_reload)
 {
   const gchar root_path_prefix[] = NNSTREAMER_SYS_ROOT_PATH_PREFIX;
   GKeyFile *key_file = NULL;
+  gboolean updated = FALSE;
   guint i, t;
 
   if (!force_reload && conf.loaded)
@@ -329,6 +533,12 @@ nnsconf_loadconf (gboolean force_reload)
     g_free (conf.conffile);
     conf.conffile = NULL;
 
+    G_LOCK (registry_lock);
+    g_free (conf.registry_file);
+    if (conf.registry)
+      g_key_file_free (conf.registry);
+    G_UNLOCK (registry_lock);
+
     for (t = 0; t < NNSCONF_PATH_END; t++) {
 
       for (i = 0; i < CONF_SOURCE_END; i++) {
@@ -342,6 +552,9 @@ nnsconf_loadconf (gboolean force_reload)
     /* init with 0 */
     memset (&conf, 0, sizeof (confdata));
   }
+
+  /* the registry cache is enabled by default */
+  conf.enable_registry = TRUE;
 #ifndef __TIZEN__
   /** if it's not Tizen, configuration from env-var has a higher priority */
   conf.conffile = _strdup_getenv (NNSTREAMER_ENVVAR_CONF_FILE);
@@ -397,6 +610,15 @@ nnsconf_loadconf (gboolean force_reload)
       conf.enable_symlink = _parse_bool_string (value, FALSE);
       g_free (value);
 
+      value =
+          g_key_file_get_string (key_file, "common", "enable_registry_cache",
+          NULL);
+      conf.enable_registry = _parse_bool_string (value, TRUE);
+      g_free (value);
+
+      conf.registry_file =
+          g_key_file_get_string (key_file, "common", "registry_cache", NULL);
+
       conf.conf[NNSCONF_PATH_FILTERS].path[CONF_SOURCE_INI] =
           g_key_file_get_string (key_file, "filter", "filters", NULL);
       conf.conf[NNSCONF_PATH_DECODERS].path[CONF_SOURCE_INI] =
@@ -416,6 +638,9 @@ nnsconf_loadconf (gboolean force_reload)
     ml_logw ("Failed to load the configuration, no config file found.");
   }
 
+  G_LOCK (registry_lock);
+  _registry_load ();
+
   for (t = 0; t < NNSCONF_PATH_END; t++) {
     if (t == NNSCONF_PATH_EASY_CUSTOM_FILTERS)
       continue;                 /* It does not have its own configuration */
@@ -429,10 +654,15 @@ nnsconf_loadconf (gboolean force_reload)
     conf.conf[t].path[CONF_SOURCE_HARDCODE] = g_strdup (NNSTREAMER_PATH[t]);
 
     /* Fill in conf.files* */
-    _fill_in_vstr (&conf.conf[t].files, &conf.conf[t].names,
-        conf.conf[t].path, t);
+    if (_fill_in_vstr_cached (&conf.conf[t].files, &conf.conf[t].names,
+            conf.conf[t].path, t))
+      updated = TRUE;
   }
 
+  if (updated)
+    _registry_save ();
+  G_UNLOCK (registry_lock);
+
   conf.loaded = TRUE;
   return TRUE;
 }
@@ -501,6 +731,115 @@ nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info)
   return g_strv_length (vstr);
 }
 
+/**
+ * @brief Private function to get the group of sub-plugin in the registry cache and check the file is not changed.
+ * @return Newly allocated group name, NULL if the sub-plugin is not in the search paths.
+ */
+static gchar *
+_registry_get_subplugin_group (nnsconf_type_path type, const gchar * name,
+    const gchar ** path, GStatBuf * st)
+{
+  if (type >= NNSCONF_PATH_END || name == NULL)
+    return NULL;
+
+  *path = nnsconf_get_fullpath (name, type);
+  if (*path == NULL || g_stat (*path, st) != 0)
+    return NULL;
+
+  return g_strdup_printf ("%s:%s", registry_groups[type], name);
+}
+
+/** @brief Public function defined in the header */
+gchar *
+nnsconf_get_subplugin_cache (nnsconf_type_path type, const gchar * name,
+    const gchar * key)
+{
+  const gchar *path = NULL;
+  gchar *group, *cached_path;
+  gchar *value = NULL;
+  GStatBuf st;
+
+  g_return_val_if_fail (key != NULL, NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  group = _registry_get_subplugin_group (type, name, &path, &st);
+  if (!group)
+    return NULL;
+
+  G_LOCK (registry_lock);
+  if (conf.registry && g_key_file_has_group (conf.registry, group)) {
+    cached_path = g_key_file_get_string (conf.registry, group, "path", NULL);
+
+    /* the cached value is valid only if the library is not changed */
+    if (g_strcmp0 (cached_path, path) == 0 &&
+        g_key_file_get_int64 (conf.registry, group, "mtime",
+            NULL) == (gint64) st.st_mtime &&
+        g_key_file_get_int64 (conf.registry, group, "size",
+            NULL) == (gint64) st.st_size) {
+      value = g_key_file_get_string (conf.registry, group, key, NULL);
+    }
+
+    g_free (cached_path);
+  }
+  G_UNLOCK (registry_lock);
+
+  g_free (group);
+  return value;
+}
+
+/** @brief Public function defined in the header */
+void
+nnsconf_set_subplugin_cache (nnsconf_type_path type, const gchar * name,
+    const gchar * key, const gchar * value)
+{
+  const gchar *path = NULL;
+  gchar *group, *cached_path;
+  gint64 now;
+  GStatBuf st;
+
+  g_return_if_fail (key != NULL);
+  g_return_if_fail (value != NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  group = _registry_get_subplugin_group (type, name, &path, &st);
+  if (!group)
+    return;
+
+  /* the library may be changed again with the same mtime */
+  now = g_get_real_time () / G_USEC_PER_SEC;
+  if ((gint64) st.st_mtime >= now)
+    goto done;
+
+  G_LOCK (registry_lock);
+  if (conf.registry) {
+    cached_path = g_key_file_get_string (conf.registry, group, "path", NULL);
+
+    /* remove old values if the library is changed */
+    if (g_strcmp0 (cached_path, path) != 0 ||
+        g_key_file_get_int64 (conf.registry, group, "mtime",
+            NULL) != (gint64) st.st_mtime ||
+        g_key_file_get_int64 (conf.registry, group, "size",
+            NULL) != (gint64) st.st_size) {
+      g_key_file_remove_group (conf.registry, group, NULL);
+      g_key_file_set_string (conf.registry, group, "path", path);
+      g_key_file_set_int64 (conf.registry, group, "mtime",
+          (gint64) st.st_mtime);
+      g_key_file_set_int64 (conf.registry, group, "size", (gint64) st.st_size);
+    }
+
+    g_free (cached_path);
+
+    g_key_file_set_string (conf.registry, group, key, value);
+    _registry_save ();
+  }
+  G_UNLOCK (registry_lock);
+
+done:
+  g_free (group);
+}
+
 /**
  * @brief Internal cache for the custom key-values
  */
@@ -601,6 +940,7 @@ nnsconf_dump (gchar * str, gulong size)
       "[Common]\n"
       "  Enable envvar: %s\n"
       "  Enable sym-linked subplugins: %s\n"
+      "  Registry cache: %s\n"
       "[Filter]\n"
       "  Filter paths from .ini: %s\n"
       "             from envvar: %s\n"
@@ -615,6 +955,7 @@ nnsconf_dump (gchar * str, gulong size)
       NNSTREAMER_CONF_FILE, NNSTREAMER_DEFAULT_CONF_FILE,
       /* 2. [Common] */
       STR_BOOL (conf.enable_envvar), STR_BOOL (conf.enable_symlink),
+      (conf.registry) ? conf.registry_file : "<disabled>",
       /* 3. [Filter] */
       conf.conf[NNSCONF_PATH_FILTERS].path[CONF_SOURCE_INI],
       (conf.enable_envvar) ?
@@ -124,6 +124,28 @@ nnsconf_get_subplugin_name_prefix (nnsconf_type_path type);
 extern guint
 nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info);
 
+/**
+ * @brief Get the cached information of the sub-plugin from the registry cache.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] name The sub-plugin name
+ * @param[in] key The key of the information (e.g., "caps" for converters)
+ * @return The newly allocated string. A caller must free it. NULL if it is not cached or the library is changed after caching.
+ */
+extern gchar *
+nnsconf_get_subplugin_cache (nnsconf_type_path type, const gchar * name, const gchar * key);
+
+/**
+ * @brief Update the information of the sub-plugin in the registry cache.
+ * @detail The information is kept with the path, mtime and size of the library, and invalidated when the library is changed.
+ *         Nothing is cached if the sub-plugin is not in the search paths or the registry cache is disabled.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] name The sub-plugin name
+ * @param[in] key The key of the information
+ * @param[in] value The value to be cached
+ */
+extern void
+nnsconf_set_subplugin_cache (nnsconf_type_path type, const gchar * name, const gchar * key, const gchar * value);
+
 /**
  * @brief Get the custom configuration value from .ini and envvar.
  * @detail For predefined configurations defined in this header,
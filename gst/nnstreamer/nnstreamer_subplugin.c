@@ -71,7 +71,7 @@ static subpluginSearchLogic searchAlgorithm[] = {
   [NNS_SUBPLUGIN_FILTER] = NNS_SEARCH_FILENAME,
   [NNS_SUBPLUGIN_DECODER] = NNS_SEARCH_FILENAME,
   [NNS_EASY_CUSTOM_FILTER] = NNS_SEARCH_FILENAME,
-  [NNS_SUBPLUGIN_CONVERTER] = NNS_SEARCH_GETALL,
+  [NNS_SUBPLUGIN_CONVERTER] = NNS_SEARCH_FILENAME, /**< loaded lazily, matched with the cached caps */
   [NNS_CUSTOM_CONVERTER] = NNS_SEARCH_NO_OP,
   [NNS_CUSTOM_DECODER] = NNS_SEARCH_NO_OP,
   [NNS_IF_CUSTOM] = NNS_SEARCH_NO_OP,
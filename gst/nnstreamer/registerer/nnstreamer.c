@@ -46,6 +46,7 @@
 #endif
 
 #include <gst/gst.h>
+#include <hw_accel.h>
 
 #include <tensor_aggregator/tensor_aggregator.h>
 #include <tensor_converter/tensor_converter.h>
@@ -65,9 +66,12 @@
 #include <tensor_transform/tensor_transform.h>
 #include <tensor_if/gsttensorif.h>
 #include <tensor_rate/gsttensorrate.h>
+#include <tensor_file/tensor_filesink.h>
+#include <tensor_file/tensor_filesrc.h>
 #include <tensor_query/tensor_query_serversrc.h>
 #include <tensor_query/tensor_query_serversink.h>
 #include <tensor_query/tensor_query_client.h>
+#include <tensor_tracer/gsttensortracer.h>
 
 #define NNSTREAMER_INIT(plugin,name,type) \
   do { \
@@ -83,6 +87,9 @@
 static gboolean
 gst_nnstreamer_init (GstPlugin * plugin)
 {
+  /* detect CPU features once, kernels are selected with them */
+  cpu_accel_init ();
+
   NNSTREAMER_INIT (plugin, aggregator, AGGREGATOR);
   NNSTREAMER_INIT (plugin, converter, CONVERTER);
   NNSTREAMER_INIT (plugin, crop, CROP);
@@ -98,6 +105,8 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, transform, TRANSFORM);
   NNSTREAMER_INIT (plugin, if, IF);
   NNSTREAMER_INIT (plugin, rate, RATE);
+  NNSTREAMER_INIT (plugin, filesink, FILESINK);
+  NNSTREAMER_INIT (plugin, filesrc, FILESRC);
   NNSTREAMER_INIT (plugin, query_serversrc, QUERY_SERVERSRC);
   NNSTREAMER_INIT (plugin, query_serversink, QUERY_SERVERSINK);
   NNSTREAMER_INIT (plugin, query_client, QUERY_CLIENT);
@@ -108,6 +117,13 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, src_iio, SRC_IIO);
 #endif
 #endif /* __gnu_linux__ && !__ANDROID__ */
+#if GST_CHECK_VERSION(1, 16, 0)
+  /* the tracer hooks object creation and destruction (GST 1.16+) */
+  if (!gst_tracer_register (plugin, "nnstreamer", GST_TYPE_TENSOR_TRACER)) {
+    GST_ERROR ("Failed to register nnstreamer tracer");
+    return FALSE;
+  }
+#endif
   return TRUE;
 }
 
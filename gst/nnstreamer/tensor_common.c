@@ -40,6 +40,8 @@ static const gchar *tensor_element_typename[] = {
   [_NNS_FLOAT32] = "float32",
   [_NNS_INT64] = "int64",
   [_NNS_UINT64] = "uint64",
+  [_NNS_FLOAT16] = "float16",
+  [_NNS_BFLOAT16] = "bfloat16",
   [_NNS_END] = NULL,
 };
 
@@ -57,6 +59,8 @@ static const guint tensor_element_size[] = {
   [_NNS_FLOAT32] = 4,
   [_NNS_INT64] = 8,
   [_NNS_UINT64] = 8,
+  [_NNS_FLOAT16] = 2,
+  [_NNS_BFLOAT16] = 2,
 
   [_NNS_END] = 0,
 };
@@ -1584,17 +1588,23 @@ gst_tensor_get_type (const gchar * typestr)
       case 64:
         type = _NNS_INT64;
     }
-  } else if (g_regex_match_simple ("^float(32|64)$",
+  } else if (g_regex_match_simple ("^float(16|32|64)$",
           type_string, G_REGEX_CASELESS, 0)) {
     size = (gsize) g_ascii_strtoull (&type_string[5], NULL, 10);
 
     switch (size) {
+      case 16:
+        type = _NNS_FLOAT16;
+        break;
       case 32:
         type = _NNS_FLOAT32;
         break;
       case 64:
         type = _NNS_FLOAT64;
     }
+  } else if (g_regex_match_simple ("^bfloat16$",
+          type_string, G_REGEX_CASELESS, 0)) {
+    type = _NNS_BFLOAT16;
   }
 
   g_free (type_string);
@@ -1855,11 +1865,52 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem)
   return ret;
 }
 
+/**
+ * @brief Internal function to check the memory has writable prefix for the header.
+ */
+static gboolean
+_gst_tensor_meta_info_has_header_prefix (GstMemory * mem, gsize hsize)
+{
+  /* sub-memory with negative offset is available in system memory only */
+  if (!gst_memory_is_type (mem, GST_ALLOCATOR_SYSMEM))
+    return FALSE;
+
+  if (GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE))
+    return FALSE;
+
+  if (mem->offset < hsize)
+    return FALSE;
+
+  /* do not overwrite the prefix if other memory shares the same block */
+  return gst_memory_is_writable (mem);
+}
+
+/**
+ * @brief Internal function to write the header into the prefix of memory.
+ * @return Sub-memory including the header and tensor data, NULL if failed.
+ */
+static GstMemory *
+_gst_tensor_meta_info_prefix_header (GstTensorMetaInfo * meta,
+    GstMemory * mem, gsize hsize)
+{
+  GstMapInfo map;
+
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE))
+    return NULL;
+
+  /* the prefix is the part of same memory block, just before mapped data */
+  gst_tensor_meta_info_update_header (meta, map.data - hsize);
+  gst_memory_unmap (mem, &map);
+
+  return gst_memory_share (mem, -((gssize) hsize), mem->size + hsize);
+}
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
  * @param[in] mem pointer to GstMemory
  * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ * @note If given memory has enough prefix (see gst_tensor_alloc_memory()), this writes the header into the prefix and returns the sub-memory without copying tensor data.
  */
 GstMemory *
 gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
@@ -1871,13 +1922,20 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
   g_return_val_if_fail (mem != NULL, NULL);
   g_return_val_if_fail (gst_tensor_meta_info_validate (meta), NULL);
 
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+
+  if (_gst_tensor_meta_info_has_header_prefix (mem, hsize)) {
+    new_mem = _gst_tensor_meta_info_prefix_header (meta, mem, hsize);
+    if (new_mem)
+      return new_mem;
+  }
+
   if (!gst_memory_map (mem, &old_map, GST_MAP_READ)) {
     nns_loge ("Failed to append header, cannot map the old memory.");
     return NULL;
   }
 
   /* memory size (header + old memory) */
-  hsize = gst_tensor_meta_info_get_header_size (meta);
   msize = hsize + old_map.size;
 
   new_mem = gst_allocator_alloc (NULL, msize, NULL);
@@ -1897,6 +1955,24 @@ gst_tensor_meta_info_append_header (GstTensorMetaInfo * meta, GstMemory * mem)
   return new_mem;
 }
 
+/**
+ * @brief Allocate memory for tensor data, reserving the prefix for tensor header.
+ * @param[in] size the size of tensor data
+ * @return Newly allocated GstMemory (Caller should free returned memory using gst_memory_unref())
+ */
+GstMemory *
+gst_tensor_alloc_memory (gsize size)
+{
+  GstTensorMetaInfo meta;
+  GstAllocationParams params;
+
+  gst_tensor_meta_info_init (&meta);
+  gst_allocation_params_init (&params);
+  params.prefix = gst_tensor_meta_info_get_header_size (&meta);
+
+  return gst_allocator_alloc (NULL, size, &params);
+}
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
@@ -64,6 +64,7 @@ typedef enum
   SYNC_SLOWEST = 1,
   SYNC_BASEPAD = 2,
   SYNC_REFRESH = 3,
+  SYNC_NEAREST = 4,
   SYNC_END,
 } tensor_time_sync_mode;
 
@@ -75,6 +76,13 @@ typedef struct _tensor_sync_basepad_data{
   GstClockTime duration;
 } tensor_sync_basepad_data;
 
+/**
+ * @brief Tensor Merge/Mux sync data for nearest mode
+ */
+typedef struct _tensor_sync_nearest_data{
+  guint queue_size; /**< max number of buffers queued in each pad */
+} tensor_sync_nearest_data;
+
 /**
  * @brief Tensor Merge/Mux time sync data
  */
@@ -83,9 +91,21 @@ typedef struct _tensor_time_sync_data {
   gchar *option;
   union {
     tensor_sync_basepad_data data_basepad;
+    tensor_sync_nearest_data data_nearest;
   };
 } tensor_time_sync_data;
 
+/**
+ * @brief Statistics of Collect Pad for time synchronization (nearest mode)
+ */
+typedef struct
+{
+  guint64 received; /**< the number of received buffers */
+  guint64 dropped; /**< the number of buffers dropped without being collected */
+  GstClockTime latency; /**< the time difference between last collected buffer and base timestamp */
+  GstClockTime max_latency; /**< max value of the time difference */
+} GstTensorCollectPadStats;
+
 /**
  * @brief Internal data structure for Collect Pad in mux / merge
  */
@@ -94,6 +114,8 @@ typedef struct
   GstCollectData collect;
   GstBuffer *buffer;
   GstPad *pad;
+  GQueue queue; /**< buffers ordered by timestamp (nearest mode) */
+  GstTensorCollectPadStats stats;
 } GstTensorCollectPadData;
 
 /**
@@ -107,6 +129,18 @@ typedef struct
   gint nth;
 } GstTensorPad;
 
+/**
+ * @brief Throttling QoS from downstream to skip the frames in producers (e.g., tensor_converter, tensor_src).
+ * @note The overflow QoS event from tensor_filter gives the timestamp of the next frame to be processed.
+ */
+typedef struct
+{
+  GstClockTime earliest; /**< the frames before this timestamp will be dropped in downstream */
+  GstClockTime period; /**< the interval of the frames processed in downstream */
+  GstClockTime expiry; /**< the QoS is ignored after this timestamp until next event */
+  guint64 skipped; /**< the number of skipped frames */
+} GstTensorQoS;
+
 /**
  * @brief Get the corresponding mode from the string value.
  * @param[in] str The string value for the mode.
@@ -163,6 +197,48 @@ gst_tensor_time_sync_flush (GstCollectPads * collect);
 extern gboolean
 gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect, tensor_time_sync_data * sync, GstClockTime current_time, GstBuffer * tensors_buf, GstTensorsConfig * configs, gboolean * is_eos);
 
+/**
+ * @brief Check the sync mode requires to handle the buffer whenever each pad receives new buffer.
+ * @param sync Synchronization Option
+ * @return TRUE if the collect pads should not wait for all pads.
+ */
+extern gboolean
+gst_tensor_time_sync_is_nonblocking (tensor_time_sync_data * sync);
+
+/**
+ * @brief Get the statistics of each pad for time synchronization.
+ * @param collect Collect pad.
+ * @return Newly allocated structure. Caller should free returned structure using gst_structure_free().
+ */
+extern GstStructure *
+gst_tensor_time_sync_get_stats (GstCollectPads * collect);
+
+/**
+ * @brief Reset the throttling QoS.
+ * @param qos The QoS data of the producer.
+ */
+extern void
+gst_tensor_qos_reset (GstTensorQoS * qos);
+
+/**
+ * @brief Update the throttling QoS with the QoS event from downstream.
+ * @param qos The QoS data of the producer.
+ * @param event The QoS event. Only the overflow type is handled.
+ * @param duration The duration of the frame pushed by the producer.
+ * @return TRUE if the QoS is updated.
+ */
+extern gboolean
+gst_tensor_qos_update (GstTensorQoS * qos, GstEvent * event, GstClockTime duration);
+
+/**
+ * @brief Check the frame will be dropped in downstream.
+ * @param qos The QoS data of the producer.
+ * @param timestamp The timestamp of the frame.
+ * @return TRUE if the producer may skip the frame.
+ */
+extern gboolean
+gst_tensor_qos_skip (GstTensorQoS * qos, GstClockTime timestamp);
+
 /**
  * @brief Get pad caps from tensors config and caps of the peer connected to the pad.
  * @param pad GstPad to get possible caps
@@ -21,9 +21,20 @@ static const gchar *gst_tensor_time_sync_mode_string[] = {
   [SYNC_SLOWEST] = "slowest",
   [SYNC_BASEPAD] = "basepad",
   [SYNC_REFRESH] = "refresh",
+  [SYNC_NEAREST] = "nearest",
   [SYNC_END] = NULL
 };
 
+/**
+ * @brief Default max number of buffers queued in each pad (nearest mode).
+ */
+#define DEFAULT_SYNC_QUEUE_SIZE (8U)
+
+/**
+ * @brief The minimum duration to keep the throttling QoS without new event.
+ */
+#define QOS_MIN_EXPIRY (GST_SECOND)
+
 /**
  * @brief Get the corresponding mode from the string value.
  * @param[in] str The string value for the mode.
@@ -89,6 +100,15 @@ gst_tensor_time_sync_set_option_data (tensor_time_sync_data * sync)
       g_strfreev (strv);
       break;
     }
+    case SYNC_NEAREST:
+    {
+      guint queue_size;
+
+      queue_size = (guint) g_ascii_strtoull (sync->option, NULL, 10);
+      sync->data_nearest.queue_size =
+          (queue_size > 0) ? queue_size : DEFAULT_SYNC_QUEUE_SIZE;
+      break;
+    }
     default:
       /* unknown mode */
       GST_WARNING ("Unknown mode = %d", sync->mode);
@@ -128,6 +148,132 @@ _gst_tensor_time_sync_is_eos (GstCollectPads * collect,
   return is_eos;
 }
 
+/**
+ * @brief Internal function to get max number of buffers queued in each pad.
+ */
+static inline guint
+_gst_tensor_time_sync_get_queue_size (tensor_time_sync_data * sync)
+{
+  /* sync-option is not given */
+  if (sync->option == NULL || sync->data_nearest.queue_size == 0)
+    return DEFAULT_SYNC_QUEUE_SIZE;
+
+  return sync->data_nearest.queue_size;
+}
+
+/**
+ * @brief Internal function to move the buffers from collect pads to the queue of each pad (nearest mode).
+ * Collect pads holds one buffer for each pad, popping the buffer does not block the pad which receives the buffers faster than others.
+ */
+static void
+_gst_tensor_time_sync_nearest_fill_queue (GstCollectPads * collect,
+    tensor_time_sync_data * sync)
+{
+  GSList *walk;
+  GstTensorCollectPadData *pad;
+  GstBuffer *buf;
+  guint queue_size;
+
+  queue_size = _gst_tensor_time_sync_get_queue_size (sync);
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    pad = (GstTensorCollectPadData *) walk->data;
+
+    buf = gst_collect_pads_pop (collect, (GstCollectData *) pad);
+    if (buf == NULL)
+      continue;
+
+    pad->stats.received++;
+    g_queue_push_tail (&pad->queue, buf);
+
+    /* bounded queue, drop oldest buffer */
+    while (g_queue_get_length (&pad->queue) > queue_size) {
+      gst_buffer_unref (g_queue_pop_head (&pad->queue));
+      pad->stats.dropped++;
+    }
+  }
+}
+
+/**
+ * @brief Internal function to get the base timestamp from the queue of each pad (nearest mode).
+ * Base timestamp is the latest timestamp that all pads have reached.
+ * @return TRUE if all pads have queued buffers.
+ */
+static gboolean
+_gst_tensor_time_sync_nearest_get_time (GstCollectPads * collect,
+    GstClockTime * current_time, gboolean * is_eos)
+{
+  GSList *walk;
+  GstTensorCollectPadData *pad;
+  GstBuffer *buf;
+  GstClockTime base = GST_CLOCK_TIME_NONE;
+  gboolean ready = TRUE;
+
+  *is_eos = FALSE;
+
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    pad = (GstTensorCollectPadData *) walk->data;
+
+    buf = (GstBuffer *) g_queue_peek_tail (&pad->queue);
+    if (buf == NULL) {
+      /* cannot match the buffers anymore if this pad is already eos */
+      if (GST_COLLECT_PADS_STATE_IS_SET (&pad->collect,
+              GST_COLLECT_PADS_STATE_EOS))
+        *is_eos = TRUE;
+
+      ready = FALSE;
+      continue;
+    }
+
+    if (!GST_CLOCK_TIME_IS_VALID (base) || GST_BUFFER_PTS (buf) < base)
+      base = GST_BUFFER_PTS (buf);
+  }
+
+  if (ready)
+    *current_time = base;
+
+  return ready;
+}
+
+/**
+ * @brief Internal function to pop the buffer nearest to the base timestamp (nearest mode).
+ * The queue is ordered by timestamp, older buffers than selected one are dropped.
+ * @return The buffer (Caller should release returned buffer using gst_buffer_unref())
+ */
+static GstBuffer *
+_gst_tensor_time_sync_nearest_pop (GstTensorCollectPadData * pad,
+    GstClockTime current)
+{
+  GstBuffer *buf, *next;
+  GstClockTime diff;
+
+  buf = (GstBuffer *) g_queue_pop_head (&pad->queue);
+  if (buf == NULL)
+    return NULL;
+
+  diff = ABS (GST_CLOCK_DIFF (current, GST_BUFFER_PTS (buf)));
+
+  while ((next = (GstBuffer *) g_queue_peek_head (&pad->queue)) != NULL) {
+    GstClockTime next_diff;
+
+    next_diff = ABS (GST_CLOCK_DIFF (current, GST_BUFFER_PTS (next)));
+    if (next_diff > diff)
+      break;
+
+    gst_buffer_unref (buf);
+    pad->stats.dropped++;
+
+    buf = (GstBuffer *) g_queue_pop_head (&pad->queue);
+    diff = next_diff;
+  }
+
+  pad->stats.latency = diff;
+  if (pad->stats.max_latency < diff)
+    pad->stats.max_latency = diff;
+
+  return buf;
+}
+
 /**
  * @brief A function call to decide current timestamp among collected pads based on PTS.
  * It will decide current timestamp according to sync option.
@@ -143,6 +289,14 @@ gst_tensor_time_sync_get_current_time (GstCollectPads * collect,
   g_return_val_if_fail (sync != NULL, FALSE);
   g_return_val_if_fail (current_time != NULL, FALSE);
 
+  if (sync->mode == SYNC_NEAREST) {
+    gboolean is_eos;
+
+    _gst_tensor_time_sync_nearest_fill_queue (collect, sync);
+    _gst_tensor_time_sync_nearest_get_time (collect, current_time, &is_eos);
+    return is_eos;
+  }
+
   walk = collect->data;
   count = empty_pad = 0;
 
@@ -203,6 +357,9 @@ gst_tensor_time_sync_flush (GstCollectPads * collect)
       pad->buffer = NULL;
     }
 
+    while (!g_queue_is_empty (&pad->queue))
+      gst_buffer_unref (g_queue_pop_head (&pad->queue));
+
     walk = g_slist_next (walk);
   }
 }
@@ -280,6 +437,16 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   walk = collect->data;
   counting = empty_pad = 0;
 
+  if (sync->mode == SYNC_NEAREST) {
+    /* update the queue and base timestamp, pads not blocked by slow one */
+    _gst_tensor_time_sync_nearest_fill_queue (collect, sync);
+    if (!_gst_tensor_time_sync_nearest_get_time (collect, &current_time,
+            is_eos)) {
+      ml_logd ("Not the all buffers are arrived yet.");
+      return FALSE;
+    }
+  }
+
   if (sync->mode == SYNC_BASEPAD) {
     walk = g_slist_nth (walk, sync->data_basepad.sink_id);
     if (walk == NULL) {
@@ -351,6 +518,10 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
         buf = gst_collect_pads_pop (collect, data);
         is_empty = (buf == NULL);
         break;
+      case SYNC_NEAREST:
+        buf = _gst_tensor_time_sync_nearest_pop (pad, current_time);
+        is_empty = (buf == NULL);
+        break;
       case SYNC_REFRESH:
         buf = gst_collect_pads_pop (collect, data);
         if (buf != NULL) {
@@ -406,3 +577,143 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   *is_eos = _gst_tensor_time_sync_is_eos (collect, sync, empty_pad);
   return !(*is_eos);
 }
+
+/**
+ * @brief Check the sync mode requires to handle the buffer whenever each pad receives new buffer.
+ */
+gboolean
+gst_tensor_time_sync_is_nonblocking (tensor_time_sync_data * sync)
+{
+  g_return_val_if_fail (sync != NULL, FALSE);
+
+  return (sync->mode == SYNC_REFRESH || sync->mode == SYNC_NEAREST);
+}
+
+/**
+ * @brief Get the statistics of each pad for time synchronization.
+ */
+GstStructure *
+gst_tensor_time_sync_get_stats (GstCollectPads * collect)
+{
+  GstStructure *stats;
+  GSList *walk;
+  GstTensorCollectPadData *pad;
+  gchar *name, *field;
+
+  g_return_val_if_fail (collect != NULL, NULL);
+
+  stats = gst_structure_new_empty ("tensor-time-sync-stats");
+
+  GST_COLLECT_PADS_STREAM_LOCK (collect);
+  for (walk = collect->data; walk; walk = g_slist_next (walk)) {
+    pad = (GstTensorCollectPadData *) walk->data;
+    name = gst_pad_get_name (pad->pad);
+
+    field = g_strdup_printf ("%s-received", name);
+    gst_structure_set (stats, field, G_TYPE_UINT64, pad->stats.received, NULL);
+    g_free (field);
+
+    field = g_strdup_printf ("%s-dropped", name);
+    gst_structure_set (stats, field, G_TYPE_UINT64, pad->stats.dropped, NULL);
+    g_free (field);
+
+    field = g_strdup_printf ("%s-latency", name);
+    gst_structure_set (stats, field, G_TYPE_UINT64, pad->stats.latency, NULL);
+    g_free (field);
+
+    field = g_strdup_printf ("%s-max-latency", name);
+    gst_structure_set (stats, field, G_TYPE_UINT64, pad->stats.max_latency,
+        NULL);
+    g_free (field);
+
+    g_free (name);
+  }
+  GST_COLLECT_PADS_STREAM_UNLOCK (collect);
+
+  return stats;
+}
+
+/**
+ * @brief Reset the throttling QoS.
+ */
+void
+gst_tensor_qos_reset (GstTensorQoS * qos)
+{
+  g_return_if_fail (qos != NULL);
+
+  qos->earliest = GST_CLOCK_TIME_NONE;
+  qos->period = 0;
+  qos->expiry = GST_CLOCK_TIME_NONE;
+  qos->skipped = 0;
+}
+
+/**
+ * @brief Update the throttling QoS with the QoS event from downstream.
+ */
+gboolean
+gst_tensor_qos_update (GstTensorQoS * qos, GstEvent * event,
+    GstClockTime duration)
+{
+  GstQOSType type;
+  gdouble proportion;
+  GstClockTimeDiff diff;
+  GstClockTime timestamp;
+
+  g_return_val_if_fail (qos != NULL, FALSE);
+  g_return_val_if_fail (event != NULL, FALSE);
+
+  if (GST_EVENT_TYPE (event) != GST_EVENT_QOS)
+    return FALSE;
+
+  gst_event_parse_qos (event, &type, &proportion, &diff, &timestamp);
+  if (type != GST_QOS_TYPE_OVERFLOW || !GST_CLOCK_TIME_IS_VALID (timestamp))
+    return FALSE;
+
+  /**
+   * The frame at timestamp is dropped, and the next frame will be processed
+   * after -diff. The proportion is the frame duration divided by the delay.
+   */
+  qos->earliest = timestamp + (diff < 0 ? -diff : 0);
+
+  if (proportion > 0.0 && GST_CLOCK_TIME_IS_VALID (duration))
+    qos->period = (GstClockTime) (gst_guint64_to_gdouble (duration) /
+        proportion);
+  else
+    qos->period = 0;
+
+  /* downstream may stop throttling, check it again after expiry */
+  qos->expiry = qos->earliest + MAX (QOS_MIN_EXPIRY, 2 * qos->period);
+  return TRUE;
+}
+
+/**
+ * @brief Check the frame will be dropped in downstream.
+ */
+gboolean
+gst_tensor_qos_skip (GstTensorQoS * qos, GstClockTime timestamp)
+{
+  g_return_val_if_fail (qos != NULL, FALSE);
+
+  if (!GST_CLOCK_TIME_IS_VALID (qos->earliest) ||
+      !GST_CLOCK_TIME_IS_VALID (timestamp))
+    return FALSE;
+
+  if (timestamp >= qos->expiry) {
+    qos->earliest = qos->expiry = GST_CLOCK_TIME_NONE;
+    qos->period = 0;
+    return FALSE;
+  }
+
+  if (timestamp < qos->earliest) {
+    qos->skipped++;
+    return TRUE;
+  }
+
+  /* this frame will be processed, the next one is expected after the period */
+  if (qos->period > 0)
+    qos->earliest = timestamp + qos->period;
+  else
+    qos->earliest = GST_CLOCK_TIME_NONE;
+
+  return FALSE;
+}
@@ -38,7 +38,9 @@ typedef enum {
   GST_VIDEO_FORMAT_BGRA,
   GST_VIDEO_FORMAT_ARGB,
   GST_VIDEO_FORMAT_ABGR,
-  GST_VIDEO_FORMAT_I420
+  GST_VIDEO_FORMAT_I420,
+  GST_VIDEO_FORMAT_NV12,
+  GST_VIDEO_FORMAT_YUY2
 } GstVideoFormat;
 
 #define gst_video_info_init(i) memset (i, 0, sizeof (GstVideoInfo))
@@ -51,5 +53,7 @@ typedef enum {
 #define GST_VIDEO_INFO_SIZE(...) 0
 #define GST_VIDEO_INFO_FPS_N(...) 0
 #define GST_VIDEO_INFO_FPS_D(...) 1
+#define GST_VIDEO_INFO_PLANE_OFFSET(...) 0
+#define GST_VIDEO_INFO_PLANE_STRIDE(...) 0
 
 #endif /* __CONVERTER_MEDIA_INFO_NO_VIDEO_H__ */
@@ -29,8 +29,17 @@
     GST_VIDEO_CAPS_MAKE ("{ RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8 }") \
     ", views = (int) 1, interlace-mode = (string) progressive"
 
-#define append_video_caps_template(caps) \
-    gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR))
+/**
+ * @brief Caps string for video format supported with the pre-processing options
+ */
+#define VIDEO_PREPROC_CAPS_STR \
+    GST_VIDEO_CAPS_MAKE ("{ I420, NV12, YUY2 }") \
+    ", views = (int) 1, interlace-mode = (string) progressive"
+
+#define append_video_caps_template(caps) do { \
+    gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR)); \
+    gst_caps_append (caps, gst_caps_from_string (VIDEO_PREPROC_CAPS_STR)); \
+  } while (0)
 
 #define is_video_supported(...) TRUE
 #endif /* __CONVERTER_MEDIA_INFO_VIDEO_H__ */
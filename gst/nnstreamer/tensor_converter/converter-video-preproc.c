@@ -0,0 +1,713 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer video pre-processing for tensor-converter
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+
+/**
+ * @file  converter-video-preproc.c
+ * @date  18 Oct 2021
+ * @brief Fused color conversion, resize and normalization of a video frame to a tensor
+ * @see https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug No known bugs except for NYI items
+ */
+
+#include <string.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include "converter-video-preproc.h"
+
+/**
+ * @brief BT.601 (limited range) coefficients to convert YUV to RGB.
+ */
+#define YUV_Y_SCALE (1.164383f)
+#define YUV_RV (1.596027f)
+#define YUV_GU (-0.391762f)
+#define YUV_GV (-0.812968f)
+#define YUV_BU (2.017232f)
+
+/**
+ * @brief Coefficients to convert RGB to gray.
+ */
+#define GRAY_R (0.299f)
+#define GRAY_G (0.587f)
+#define GRAY_B (0.114f)
+
+/**
+ * @brief Clamp the value to the range of uint8.
+ */
+#define CLAMP_U8(v) (((v) < 0.0f) ? 0.0f : (((v) > 255.0f) ? 255.0f : (v)))
+
+/**
+ * @brief Initialize the pre-processing options.
+ */
+void
+video_preproc_init (video_preproc_s * vp)
+{
+  guint i;
+
+  g_return_if_fail (vp != NULL);
+
+  memset (vp, 0, sizeof (video_preproc_s));
+  for (i = 0; i < 3; i++)
+    vp->std[i] = 1.0f;
+
+  vp->out_format = VIDEO_PREPROC_FORMAT_NONE;
+  vp->layout = VIDEO_PREPROC_LAYOUT_NHWC;
+  vp->out_type = _NNS_END;
+  vp->src_format = VIDEO_PREPROC_SRC_UNKNOWN;
+  vp->type = _NNS_END;
+}
+
+/**
+ * @brief Free the resources of the pre-processing (options are kept).
+ */
+void
+video_preproc_free (video_preproc_s * vp)
+{
+  guint i;
+
+  g_return_if_fail (vp != NULL);
+
+  for (i = 0; i < 3; i++) {
+    g_free (vp->tables[i].x0);
+    g_free (vp->tables[i].x1);
+    g_free (vp->tables[i].wx);
+    memset (&vp->tables[i], 0, sizeof (video_preproc_table));
+  }
+
+  g_free (vp->rows);
+  vp->rows = NULL;
+  vp->src_format = VIDEO_PREPROC_SRC_UNKNOWN;
+  vp->dst_width = vp->dst_height = 0;
+}
+
+/**
+ * @brief Update the flag to enable the pre-processing.
+ */
+static void
+video_preproc_update (video_preproc_s * vp)
+{
+  vp->enabled = (vp->out_width > 0 || vp->out_format != VIDEO_PREPROC_FORMAT_NONE
+      || vp->layout != VIDEO_PREPROC_LAYOUT_NHWC || vp->out_type != _NNS_END
+      || vp->num_mean > 0 || vp->num_std > 0);
+}
+
+/**
+ * @brief Parse the output size option. ("W:H")
+ */
+gboolean
+video_preproc_set_size (video_preproc_s * vp, const gchar * str)
+{
+  gchar **strv;
+  gint64 w, h;
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail (vp != NULL, FALSE);
+
+  if (!str || *str == '\0') {
+    vp->out_width = vp->out_height = 0;
+    video_preproc_update (vp);
+    return TRUE;
+  }
+
+  strv = g_strsplit (str, ":", -1);
+  if (g_strv_length (strv) == 2) {
+    w = g_ascii_strtoll (strv[0], NULL, 10);
+    h = g_ascii_strtoll (strv[1], NULL, 10);
+
+    if (w > 0 && h > 0 && w <= G_MAXINT && h <= G_MAXINT) {
+      vp->out_width = (guint) w;
+      vp->out_height = (guint) h;
+      ret = TRUE;
+    }
+  }
+  g_strfreev (strv);
+
+  if (!ret)
+    nns_logw ("Invalid output size %s, it should be WIDTH:HEIGHT.", str);
+
+  video_preproc_update (vp);
+  return ret;
+}
+
+/**
+ * @brief Parse the output format option. ("RGB", "BGR" or "GRAY")
+ */
+gboolean
+video_preproc_set_format (video_preproc_s * vp, const gchar * str)
+{
+  g_return_val_if_fail (vp != NULL, FALSE);
+
+  if (!str || *str == '\0')
+    vp->out_format = VIDEO_PREPROC_FORMAT_NONE;
+  else if (g_ascii_strcasecmp (str, "RGB") == 0)
+    vp->out_format = VIDEO_PREPROC_FORMAT_RGB;
+  else if (g_ascii_strcasecmp (str, "BGR") == 0)
+    vp->out_format = VIDEO_PREPROC_FORMAT_BGR;
+  else if (g_ascii_strcasecmp (str, "GRAY") == 0 ||
+      g_ascii_strcasecmp (str, "GRAY8") == 0)
+    vp->out_format = VIDEO_PREPROC_FORMAT_GRAY;
+  else {
+    nns_logw ("Invalid output format %s, it should be RGB, BGR or GRAY.", str);
+    return FALSE;
+  }
+
+  video_preproc_update (vp);
+  return TRUE;
+}
+
+/**
+ * @brief Parse the values of mean or std. ("name:V[:V:V]")
+ */
+static guint
+video_preproc_parse_values (gchar ** strv, gfloat values[3])
+{
+  guint i, num;
+  gchar *end;
+
+  num = g_strv_length (strv) - 1;
+  if (num < 1 || num > 3)
+    return 0;
+
+  for (i = 0; i < num; i++) {
+    values[i] = (gfloat) g_ascii_strtod (strv[i + 1], &end);
+    if (end == strv[i + 1] || *end != '\0')
+      return 0;
+  }
+
+  return num;
+}
+
+/**
+ * @brief Parse the normalization option. ("mean:M[:M:M],std:S[:S:S]")
+ */
+gboolean
+video_preproc_set_normalize (video_preproc_s * vp, const gchar * str)
+{
+  gchar **options, **strv;
+  gfloat mean[3], std[3];
+  guint i, num_mean = 0, num_std = 0;
+  gboolean ret = TRUE;
+
+  g_return_val_if_fail (vp != NULL, FALSE);
+
+  if (str && *str != '\0') {
+    options = g_strsplit (str, ",", -1);
+
+    for (i = 0; ret && options[i]; i++) {
+      strv = g_strsplit (g_strstrip (options[i]), ":", -1);
+
+      if (g_ascii_strcasecmp (strv[0], "mean") == 0) {
+        num_mean = video_preproc_parse_values (strv, mean);
+        ret = (num_mean > 0);
+      } else if (g_ascii_strcasecmp (strv[0], "std") == 0) {
+        guint j;
+
+        num_std = video_preproc_parse_values (strv, std);
+        ret = (num_std > 0);
+
+        for (j = 0; j < num_std; j++) {
+          if (std[j] == 0.0f)
+            ret = FALSE;
+        }
+      } else {
+        ret = FALSE;
+      }
+
+      g_strfreev (strv);
+    }
+
+    g_strfreev (options);
+
+    if (!ret) {
+      nns_logw ("Invalid normalize option %s, "
+          "it should be mean:M[:M:M],std:S[:S:S] (std should not be 0).", str);
+      return FALSE;
+    }
+  }
+
+  vp->num_mean = num_mean;
+  vp->num_std = num_std;
+  for (i = 0; i < 3; i++) {
+    vp->mean[i] = (i < num_mean) ? mean[i] : 0.0f;
+    vp->std[i] = (i < num_std) ? std[i] : 1.0f;
+  }
+
+  video_preproc_update (vp);
+  return TRUE;
+}
+
+/**
+ * @brief Parse the layout option. ("NHWC" or "NCHW")
+ */
+gboolean
+video_preproc_set_layout (video_preproc_s * vp, const gchar * str)
+{
+  g_return_val_if_fail (vp != NULL, FALSE);
+
+  if (!str || *str == '\0' || g_ascii_strcasecmp (str, "NHWC") == 0)
+    vp->layout = VIDEO_PREPROC_LAYOUT_NHWC;
+  else if (g_ascii_strcasecmp (str, "NCHW") == 0)
+    vp->layout = VIDEO_PREPROC_LAYOUT_NCHW;
+  else {
+    nns_logw ("Invalid layout %s, it should be NHWC or NCHW.", str);
+    return FALSE;
+  }
+
+  video_preproc_update (vp);
+  return TRUE;
+}
+
+/**
+ * @brief Parse the output type option. ("uint8" or "float32")
+ */
+gboolean
+video_preproc_set_type (video_preproc_s * vp, const gchar * str)
+{
+  tensor_type type = _NNS_END;
+
+  g_return_val_if_fail (vp != NULL, FALSE);
+
+  if (str && *str != '\0') {
+    type = gst_tensor_get_type (str);
+
+    if (type != _NNS_UINT8 && type != _NNS_FLOAT32) {
+      nns_logw ("Invalid output type %s, it should be uint8 or float32.", str);
+      return FALSE;
+    }
+  }
+
+  vp->out_type = type;
+  video_preproc_update (vp);
+  return TRUE;
+}
+
+/**
+ * @brief Get the option string of the property. Caller should free the returned string.
+ */
+gchar *
+video_preproc_get_option (const video_preproc_s * vp, const gchar * name)
+{
+  GString *str;
+  guint i;
+
+  g_return_val_if_fail (vp != NULL, NULL);
+  g_return_val_if_fail (name != NULL, NULL);
+
+  if (g_str_equal (name, "output-size")) {
+    if (vp->out_width > 0)
+      return g_strdup_printf ("%u:%u", vp->out_width, vp->out_height);
+  } else if (g_str_equal (name, "output-format")) {
+    switch (vp->out_format) {
+      case VIDEO_PREPROC_FORMAT_RGB:
+        return g_strdup ("RGB");
+      case VIDEO_PREPROC_FORMAT_BGR:
+        return g_strdup ("BGR");
+      case VIDEO_PREPROC_FORMAT_GRAY:
+        return g_strdup ("GRAY");
+      default:
+        break;
+    }
+  } else if (g_str_equal (name, "normalize")) {
+    if (vp->num_mean > 0 || vp->num_std > 0) {
+      str = g_string_new (NULL);
+
+      if (vp->num_mean > 0) {
+        g_string_append (str, "mean");
+        for (i = 0; i < vp->num_mean; i++)
+          g_string_append_printf (str, ":%g", vp->mean[i]);
+      }
+
+      if (vp->num_std > 0) {
+        g_string_append (str, (vp->num_mean > 0) ? ",std" : "std");
+        for (i = 0; i < vp->num_std; i++)
+          g_string_append_printf (str, ":%g", vp->std[i]);
+      }
+
+      return g_string_free (str, FALSE);
+    }
+  } else if (g_str_equal (name, "layout")) {
+    return g_strdup ((vp->layout == VIDEO_PREPROC_LAYOUT_NCHW) ?
+        "NCHW" : "NHWC");
+  } else if (g_str_equal (name, "output-type")) {
+    if (vp->out_type != _NNS_END)
+      return g_strdup (gst_tensor_get_type_string (vp->out_type));
+  }
+
+  return g_strdup ("");
+}
+
+/**
+ * @brief Set the components of the source format.
+ * @return The number of components, 0 if the format is not supported.
+ */
+static guint
+video_preproc_set_comps (video_preproc_comp comps[3],
+    video_preproc_src_format format)
+{
+  /* plane, pstride, offset, xshift, yshift */
+  static const video_preproc_comp packed[][3] = {
+    {{0, 3, 0, 0, 0}, {0, 3, 1, 0, 0}, {0, 3, 2, 0, 0}}, /* RGB */
+    {{0, 3, 2, 0, 0}, {0, 3, 1, 0, 0}, {0, 3, 0, 0, 0}}, /* BGR */
+    {{0, 4, 0, 0, 0}, {0, 4, 1, 0, 0}, {0, 4, 2, 0, 0}}, /* RGBx */
+    {{0, 4, 2, 0, 0}, {0, 4, 1, 0, 0}, {0, 4, 0, 0, 0}}, /* BGRx */
+    {{0, 4, 1, 0, 0}, {0, 4, 2, 0, 0}, {0, 4, 3, 0, 0}}, /* xRGB */
+    {{0, 4, 3, 0, 0}, {0, 4, 2, 0, 0}, {0, 4, 1, 0, 0}}, /* xBGR */
+    {{0, 1, 0, 0, 0}, {1, 1, 0, 1, 1}, {2, 1, 0, 1, 1}}, /* I420 */
+    {{0, 1, 0, 0, 0}, {1, 2, 0, 1, 1}, {1, 2, 1, 1, 1}}, /* NV12 */
+    {{0, 2, 0, 0, 0}, {0, 4, 1, 1, 0}, {0, 4, 3, 1, 0}}, /* YUY2 */
+  };
+
+  switch (format) {
+    case VIDEO_PREPROC_SRC_GRAY8:
+      comps[0].plane = comps[0].offset = 0;
+      comps[0].pstride = 1;
+      comps[0].xshift = comps[0].yshift = 0;
+      return 1;
+    case VIDEO_PREPROC_SRC_RGB:
+    case VIDEO_PREPROC_SRC_BGR:
+    case VIDEO_PREPROC_SRC_RGBx:
+    case VIDEO_PREPROC_SRC_BGRx:
+    case VIDEO_PREPROC_SRC_xRGB:
+    case VIDEO_PREPROC_SRC_xBGR:
+    case VIDEO_PREPROC_SRC_I420:
+    case VIDEO_PREPROC_SRC_NV12:
+    case VIDEO_PREPROC_SRC_YUY2:
+      memcpy (comps, packed[format - VIDEO_PREPROC_SRC_RGB],
+          sizeof (video_preproc_comp) * 3);
+      return 3;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Get the sampling position and weight. (align the pixel centers)
+ */
+static inline void
+video_preproc_get_position (guint dst, guint dst_len, guint src_len,
+    guint * p0, guint * p1, gfloat * w)
+{
+  gdouble pos;
+  guint idx;
+
+  pos = (dst + 0.5) * src_len / dst_len - 0.5;
+  if (pos < 0.0)
+    pos = 0.0;
+
+  idx = (guint) pos;
+  if (idx >= src_len - 1) {
+    *p0 = *p1 = src_len - 1;
+    *w = 0.0f;
+  } else {
+    *p0 = idx;
+    *p1 = idx + 1;
+    *w = (gfloat) (pos - idx);
+  }
+}
+
+/**
+ * @brief Configure the pre-processing with the source frame and get the output tensor info.
+ */
+gboolean
+video_preproc_configure (video_preproc_s * vp, video_preproc_src_format format,
+    guint width, guint height, const gsize offset[3], const gsize stride[3],
+    GstTensorInfo * info)
+{
+  video_preproc_format out_format;
+  video_preproc_table *table;
+  video_preproc_comp *comp;
+  guint i, c, ow, oh, cw;
+
+  g_return_val_if_fail (vp != NULL, FALSE);
+  g_return_val_if_fail (info != NULL, FALSE);
+  g_return_val_if_fail (width > 0 && height > 0, FALSE);
+
+  video_preproc_free (vp);
+
+  vp->num_comps = video_preproc_set_comps (vp->comps, format);
+  if (vp->num_comps == 0) {
+    nns_loge ("Unsupported video format for the pre-processing.");
+    return FALSE;
+  }
+
+  out_format = vp->out_format;
+  if (out_format == VIDEO_PREPROC_FORMAT_NONE) {
+    out_format = (format == VIDEO_PREPROC_SRC_GRAY8) ?
+        VIDEO_PREPROC_FORMAT_GRAY : VIDEO_PREPROC_FORMAT_RGB;
+  }
+
+  vp->dst_format = out_format;
+  vp->dst_layout = vp->layout;
+  vp->channels = (out_format == VIDEO_PREPROC_FORMAT_GRAY) ? 1 : 3;
+
+  if ((vp->num_mean > 1 && vp->num_mean != vp->channels) ||
+      (vp->num_std > 1 && vp->num_std != vp->channels)) {
+    nns_loge ("The number of mean and std values should be 1 or %u.",
+        vp->channels);
+    return FALSE;
+  }
+
+  if (vp->out_type != _NNS_END)
+    vp->type = vp->out_type;
+  else
+    vp->type = (vp->num_mean > 0 || vp->num_std > 0) ? _NNS_FLOAT32 : _NNS_UINT8;
+
+  for (c = 0; c < vp->channels; c++) {
+    gfloat m = vp->mean[(vp->num_mean > 1) ? c : 0];
+    gfloat s = vp->std[(vp->num_std > 1) ? c : 0];
+
+    vp->scale[c] = 1.0f / s;
+    vp->bias[c] = -m / s;
+  }
+
+  vp->src_format = format;
+  vp->src_width = width;
+  vp->src_height = height;
+  for (i = 0; i < 3; i++) {
+    vp->plane_offset[i] = offset[i];
+    vp->plane_stride[i] = stride[i];
+  }
+
+  ow = vp->dst_width = (vp->out_width > 0) ? vp->out_width : width;
+  oh = vp->dst_height = (vp->out_height > 0) ? vp->out_height : height;
+
+  /* horizontal sampling tables (byte offsets in the row) */
+  for (c = 0; c < vp->num_comps; c++) {
+    comp = &vp->comps[c];
+    table = &vp->tables[c];
+    cw = (width + (1U << comp->xshift) - 1) >> comp->xshift;
+
+    table->x0 = g_new (guint, ow);
+    table->x1 = g_new (guint, ow);
+    table->wx = g_new (gfloat, ow);
+
+    for (i = 0; i < ow; i++) {
+      guint p0, p1;
+
+      video_preproc_get_position (i, ow, cw, &p0, &p1, &table->wx[i]);
+      table->x0[i] = p0 * comp->pstride + comp->offset;
+      table->x1[i] = p1 * comp->pstride + comp->offset;
+    }
+  }
+
+  vp->rows = g_new (gfloat, ow * 3);
+
+  gst_tensor_info_init (info);
+  info->type = vp->type;
+
+  if (vp->dst_layout == VIDEO_PREPROC_LAYOUT_NCHW) {
+    info->dimension[0] = ow;
+    info->dimension[1] = oh;
+    info->dimension[2] = vp->channels;
+  } else {
+    info->dimension[0] = vp->channels;
+    info->dimension[1] = ow;
+    info->dimension[2] = oh;
+  }
+
+  for (i = 3; i < NNS_TENSOR_RANK_LIMIT; i++)
+    info->dimension[i] = 1;
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the size of an output frame.
+ */
+gsize
+video_preproc_get_frame_size (const video_preproc_s * vp)
+{
+  g_return_val_if_fail (vp != NULL, 0);
+
+  if (vp->rows == NULL)
+    return 0;
+
+  /* the geometry configured with the caps, not the options set later */
+  return (gsize) vp->dst_width * vp->dst_height * vp->channels *
+      gst_tensor_get_element_size (vp->type);
+}
+
+/**
+ * @brief Sample a row of the component with bilinear interpolation.
+ */
+static void
+video_preproc_sample_row (const video_preproc_table * table,
+    const guint8 * r0, const guint8 * r1, gfloat wy, gfloat * row, guint ow)
+{
+  const guint *x0 = table->x0;
+  const guint *x1 = table->x1;
+  const gfloat *wx = table->wx;
+  gfloat a, b;
+  guint i;
+
+  for (i = 0; i < ow; i++) {
+    a = r0[x0[i]] + (r0[x1[i]] - r0[x0[i]]) * wx[i];
+    b = r1[x0[i]] + (r1[x1[i]] - r1[x0[i]]) * wx[i];
+    row[i] = a + (b - a) * wy;
+  }
+}
+
+/**
+ * @brief Convert the sampled YUV rows to RGB (or luma for gray) in place.
+ */
+static void
+video_preproc_yuv_to_rgb (gfloat * y, gfloat * u, gfloat * v, guint ow,
+    gboolean gray)
+{
+  gfloat l, cb, cr;
+  guint i;
+
+  if (gray) {
+    for (i = 0; i < ow; i++) {
+      l = YUV_Y_SCALE * (y[i] - 16.0f);
+      y[i] = CLAMP_U8 (l);
+    }
+    return;
+  }
+
+  for (i = 0; i < ow; i++) {
+    l = YUV_Y_SCALE * (y[i] - 16.0f);
+    cb = u[i] - 128.0f;
+    cr = v[i] - 128.0f;
+
+    y[i] = l + YUV_RV * cr;
+    u[i] = l + YUV_GU * cb + YUV_GV * cr;
+    v[i] = l + YUV_BU * cb;
+
+    y[i] = CLAMP_U8 (y[i]);
+    u[i] = CLAMP_U8 (u[i]);
+    v[i] = CLAMP_U8 (v[i]);
+  }
+}
+
+/**
+ * @brief Convert the RGB rows to gray in place.
+ */
+static void
+video_preproc_rgb_to_gray (gfloat * r, const gfloat * g, const gfloat * b,
+    guint ow)
+{
+  guint i;
+
+  for (i = 0; i < ow; i++)
+    r[i] = GRAY_R * r[i] + GRAY_G * g[i] + GRAY_B * b[i];
+}
+
+/**
+ * @brief Normalize a channel row and write it to the output tensor.
+ */
+static void
+video_preproc_write_row (const gfloat * row, gfloat scale, gfloat bias,
+    tensor_type type, gpointer dest, gsize step, guint ow)
+{
+  guint i;
+
+  if (type == _NNS_FLOAT32) {
+    gfloat *out = (gfloat *) dest;
+
+    if (step == 1) {
+      for (i = 0; i < ow; i++)
+        out[i] = row[i] * scale + bias;
+    } else {
+      for (i = 0; i < ow; i++)
+        out[i * step] = row[i] * scale + bias;
+    }
+  } else {
+    guint8 *out = (guint8 *) dest;
+    gfloat val;
+
+    for (i = 0; i < ow; i++) {
+      val = row[i] * scale + bias;
+      out[i * step] = (guint8) (CLAMP_U8 (val) + 0.5f);
+    }
+  }
+}
+
+/**
+ * @brief Convert a source frame to the output tensor.
+ */
+void
+video_preproc_process (video_preproc_s * vp, const guint8 * src,
+    gpointer dest)
+{
+  static const guint order_rgb[3] = { 0, 1, 2 };
+  static const guint order_bgr[3] = { 2, 1, 0 };
+  static const guint order_gray[3] = { 0, 0, 0 };
+  const guint *order;
+  const video_preproc_comp *comp;
+  const guint8 *plane, *r0, *r1;
+  gboolean is_yuv, gray;
+  guint ow, oh, ch, c, y, y0, y1;
+  gsize esize;
+  gfloat wy;
+
+  g_return_if_fail (vp != NULL && vp->rows != NULL);
+  g_return_if_fail (src != NULL && dest != NULL);
+
+  ow = vp->dst_width;
+  oh = vp->dst_height;
+  esize = gst_tensor_get_element_size (vp->type);
+
+  is_yuv = (vp->src_format == VIDEO_PREPROC_SRC_I420 ||
+      vp->src_format == VIDEO_PREPROC_SRC_NV12 ||
+      vp->src_format == VIDEO_PREPROC_SRC_YUY2);
+  gray = (vp->channels == 1);
+
+  if (vp->num_comps == 1 || gray)
+    order = order_gray;
+  else if (vp->dst_format == VIDEO_PREPROC_FORMAT_BGR)
+    order = order_bgr;
+  else
+    order = order_rgb;
+
+  for (y = 0; y < oh; y++) {
+    /* sample the components of the output row */
+    for (c = 0; c < vp->num_comps; c++) {
+      comp = &vp->comps[c];
+
+      /* skip the chroma if the output is gray */
+      if (c > 0 && gray && is_yuv)
+        break;
+
+      ch = (vp->src_height + (1U << comp->yshift) - 1) >> comp->yshift;
+      video_preproc_get_position (y, oh, ch, &y0, &y1, &wy);
+
+      plane = src + vp->plane_offset[comp->plane];
+      r0 = plane + y0 * vp->plane_stride[comp->plane];
+      r1 = plane + y1 * vp->plane_stride[comp->plane];
+
+      video_preproc_sample_row (&vp->tables[c], r0, r1, wy,
+          vp->rows + c * ow, ow);
+    }
+
+    if (is_yuv) {
+      video_preproc_yuv_to_rgb (vp->rows, vp->rows + ow, vp->rows + 2 * ow,
+          ow, gray);
+    } else if (gray && vp->num_comps == 3) {
+      video_preproc_rgb_to_gray (vp->rows, vp->rows + ow, vp->rows + 2 * ow,
+          ow);
+    }
+
+    /* normalize and write in the layout */
+    for (c = 0; c < vp->channels; c++) {
+      guint8 *out = (guint8 *) dest;
+      gsize step;
+
+      if (vp->dst_layout == VIDEO_PREPROC_LAYOUT_NCHW) {
+        out += ((gsize) c * oh + y) * ow * esize;
+        step = 1;
+      } else {
+        out += ((gsize) y * ow * vp->channels + c) * esize;
+        step = vp->channels;
+      }
+
+      video_preproc_write_row (vp->rows + order[c] * ow, vp->scale[c],
+          vp->bias[c], vp->type, out, step, ow);
+    }
+  }
+}
@@ -0,0 +1,210 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer video pre-processing for tensor-converter
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+
+/**
+ * @file  converter-video-preproc.h
+ * @date  18 Oct 2021
+ * @brief Fused color conversion, resize and normalization of a video frame to a tensor
+ * @see https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug No known bugs except for NYI items
+ *
+ * @details
+ *	The pre-processing converts a video frame in its native format
+ *	(NV12, I420, YUY2, packed RGB or GRAY8) to the model tensor in a
+ *	single pass. Each output row is sampled (bilinear) from the source
+ *	planes, converted to RGB (BT.601 for YUV), normalized and written in
+ *	the requested layout, without intermediate frame buffers.
+ */
+
+#ifndef __CONVERTER_VIDEO_PREPROC_H__
+#define __CONVERTER_VIDEO_PREPROC_H__
+
+#include <glib.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Source formats of the video pre-processing.
+ */
+typedef enum
+{
+  VIDEO_PREPROC_SRC_UNKNOWN = 0,
+  VIDEO_PREPROC_SRC_GRAY8,
+  VIDEO_PREPROC_SRC_RGB,
+  VIDEO_PREPROC_SRC_BGR,
+  VIDEO_PREPROC_SRC_RGBx,
+  VIDEO_PREPROC_SRC_BGRx,
+  VIDEO_PREPROC_SRC_xRGB,
+  VIDEO_PREPROC_SRC_xBGR,
+  VIDEO_PREPROC_SRC_I420,
+  VIDEO_PREPROC_SRC_NV12,
+  VIDEO_PREPROC_SRC_YUY2,
+} video_preproc_src_format;
+
+/**
+ * @brief Color format of the output tensor.
+ */
+typedef enum
+{
+  VIDEO_PREPROC_FORMAT_NONE = 0, /**< not set, same as the source (RGB for YUV) */
+  VIDEO_PREPROC_FORMAT_RGB,
+  VIDEO_PREPROC_FORMAT_BGR,
+  VIDEO_PREPROC_FORMAT_GRAY,
+} video_preproc_format;
+
+/**
+ * @brief Memory layout of the output tensor.
+ */
+typedef enum
+{
+  VIDEO_PREPROC_LAYOUT_NHWC = 0, /**< channel:width:height:frames (default) */
+  VIDEO_PREPROC_LAYOUT_NCHW, /**< width:height:channel:frames */
+} video_preproc_layout;
+
+/**
+ * @brief Component of the source frame (plane, bytes between pixels, byte offset and subsampling).
+ */
+typedef struct
+{
+  guint plane;
+  guint pstride;
+  guint offset;
+  guint xshift;
+  guint yshift;
+} video_preproc_comp;
+
+/**
+ * @brief Horizontal sampling table of the output columns.
+ */
+typedef struct
+{
+  guint *x0; /**< byte offset of the left sample */
+  guint *x1; /**< byte offset of the right sample */
+  gfloat *wx; /**< weight of the right sample */
+} video_preproc_table;
+
+/**
+ * @brief Data structure for the video pre-processing.
+ */
+typedef struct
+{
+  /* options */
+  gboolean enabled; /**< TRUE if any option is set */
+  guint out_width; /**< output width, 0 to keep the source */
+  guint out_height; /**< output height, 0 to keep the source */
+  video_preproc_format out_format; /**< output color format */
+  video_preproc_layout layout; /**< output layout */
+  tensor_type out_type; /**< output type (uint8 or float32), _NNS_END for default */
+  guint num_mean; /**< the number of mean values (1 or channels) */
+  guint num_std; /**< the number of std values (1 or channels) */
+  gfloat mean[3]; /**< mean to be subtracted */
+  gfloat std[3]; /**< std to divide */
+
+  /* configured with the source */
+  video_preproc_src_format src_format; /**< source format */
+  guint src_width; /**< source width */
+  guint src_height; /**< source height */
+  gsize plane_offset[3]; /**< byte offset of each plane */
+  gsize plane_stride[3]; /**< row stride of each plane */
+  guint num_comps; /**< 1 for GRAY8, 3 otherwise */
+  video_preproc_comp comps[3]; /**< R,G,B or Y,U,V components */
+  video_preproc_table tables[3]; /**< sampling table of each component */
+  guint dst_width; /**< the output width */
+  guint dst_height; /**< the output height */
+  video_preproc_format dst_format; /**< the output color format */
+  video_preproc_layout dst_layout; /**< the output layout */
+  guint channels; /**< the number of output channels */
+  tensor_type type; /**< the output type */
+  gfloat scale[3]; /**< 1 / std of each output channel */
+  gfloat bias[3]; /**< -mean / std of each output channel */
+  gfloat *rows; /**< scratch rows for the components */
+} video_preproc_s;
+
+/**
+ * @brief Initialize the pre-processing options.
+ */
+extern void
+video_preproc_init (video_preproc_s * vp);
+
+/**
+ * @brief Free the resources of the pre-processing (options are kept).
+ */
+extern void
+video_preproc_free (video_preproc_s * vp);
+
+/**
+ * @brief Parse the output size option. ("W:H")
+ */
+extern gboolean
+video_preproc_set_size (video_preproc_s * vp, const gchar * str);
+
+/**
+ * @brief Parse the output format option. ("RGB", "BGR" or "GRAY")
+ */
+extern gboolean
+video_preproc_set_format (video_preproc_s * vp, const gchar * str);
+
+/**
+ * @brief Parse the normalization option. ("mean:M[:M:M],std:S[:S:S]")
+ */
+extern gboolean
+video_preproc_set_normalize (video_preproc_s * vp, const gchar * str);
+
+/**
+ * @brief Parse the layout option. ("NHWC" or "NCHW")
+ */
+extern gboolean
+video_preproc_set_layout (video_preproc_s * vp, const gchar * str);
+
+/**
+ * @brief Parse the output type option. ("uint8" or "float32")
+ */
+extern gboolean
+video_preproc_set_type (video_preproc_s * vp, const gchar * str);
+
+/**
+ * @brief Get the option string of the property. Caller should free the returned string.
+ * @param name The option name. ("output-size", "output-format", "normalize", "layout" or "output-type")
+ */
+extern gchar *
+video_preproc_get_option (const video_preproc_s * vp, const gchar * name);
+
+/**
+ * @brief Configure the pre-processing with the source frame and get the output tensor info.
+ * @param[in] vp The pre-processing data.
+ * @param[in] format The source format.
+ * @param[in] width The source width.
+ * @param[in] height The source height.
+ * @param[in] offset The byte offset of each plane in the frame.
+ * @param[in] stride The row stride of each plane.
+ * @param[out] info The output tensor info (a single frame).
+ * @return TRUE if the source and options are supported.
+ */
+extern gboolean
+video_preproc_configure (video_preproc_s * vp, video_preproc_src_format format,
+    guint width, guint height, const gsize offset[3], const gsize stride[3],
+    GstTensorInfo * info);
+
+/**
+ * @brief Get the size of an output frame. The options set after video_preproc_configure() are not applied.
+ */
+extern gsize
+video_preproc_get_frame_size (const video_preproc_s * vp);
+
+/**
+ * @brief Convert a source frame to the output tensor. The options set after video_preproc_configure() are not applied.
+ * @param[in] vp The configured pre-processing data.
+ * @param[in] src The source frame.
+ * @param[out] dest The output tensor, the size should be video_preproc_get_frame_size().
+ */
+extern void
+video_preproc_process (video_preproc_s * vp, const guint8 * src,
+    gpointer dest);
+
+G_END_DECLS
+#endif /* __CONVERTER_VIDEO_PREPROC_H__ */
@@ -60,6 +60,7 @@
 #endif
 #include <nnstreamer_log.h>
 #include <nnstreamer_subplugin.h>
+#include <nnstreamer_conf.h>
 
 /**
  * @brief Caps string for text input
@@ -83,6 +84,12 @@
 #define append_flex_tensor_caps_template(caps) \
     gst_caps_append (caps, gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT))
 
+/**
+ * @brief Caps string for video formats which are supported only with the pre-processing options
+ */
+#define VIDEO_PREPROC_ONLY_CAPS_STR \
+    "video/x-raw, format = (string) { I420, NV12, YUY2 }"
+
 /**
  * @brief Macro for debug mode.
  */
@@ -140,7 +147,12 @@ enum
   PROP_SET_TIMESTAMP,
   PROP_SUBPLUGINS,
   PROP_SILENT,
-  PROP_MODE
+  PROP_MODE,
+  PROP_OUTPUT_SIZE,
+  PROP_OUTPUT_FORMAT,
+  PROP_NORMALIZE,
+  PROP_LAYOUT,
+  PROP_OUTPUT_TYPE
 };
 
 /**
@@ -173,6 +185,8 @@ static gboolean gst_tensor_converter_sink_query (GstPad * pad,
     GstObject * parent, GstQuery * query);
 static gboolean gst_tensor_converter_src_query (GstPad * pad,
     GstObject * parent, GstQuery * query);
+static gboolean gst_tensor_converter_src_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
 static GstFlowReturn gst_tensor_converter_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstStateChangeReturn
@@ -187,6 +201,7 @@ static gboolean gst_tensor_converter_parse_caps (GstTensorConverter * self,
 static void gst_tensor_converter_update_caps (GstTensorConverter * self);
 static const NNStreamerExternalConverter *findExternalConverter (const char
     *media_type_name);
+static GstCaps *gst_tensor_converter_get_subplugin_caps (const gchar * name);
 
 /**
  * @brief Initialize the tensor_converter's class.
@@ -197,10 +212,9 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
   GObjectClass *object_class;
   GstElementClass *element_class;
   GstPadTemplate *pad_template;
-  GstCaps *pad_caps;
+  GstCaps *pad_caps, *caps;
   gchar **str_array;
   guint total, i;
-  const NNStreamerExternalConverter *ex;
 
   GST_DEBUG_CATEGORY_INIT (gst_tensor_converter_debug, "tensor_converter", 0,
       "Element to convert media stream to tensor stream");
@@ -290,6 +304,67 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
           "Converter mode. e.g., mode=custom:<registered callback name>", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorConverter::output-size:
+   *
+   * The size of output tensor (WIDTH:HEIGHT) to resize the video frame.
+   * With one of the pre-processing options (output-size, output-format, normalize, layout and output-type),
+   * GstTensorConverter converts the video frame in its native format (including I420, NV12 and YUY2)
+   * to the output tensor in a single pass. These options cannot be changed above READY state.
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT_SIZE,
+      g_param_spec_string ("output-size", "Output size",
+          "The size of output tensor to resize the video frame, e.g., 224:224",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstTensorConverter::output-format:
+   *
+   * The color format of output tensor from the video frame. (RGB, BGR or GRAY)
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT_FORMAT,
+      g_param_spec_string ("output-format", "Output format",
+          "The color format of output tensor (RGB, BGR or GRAY)", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstTensorConverter::normalize:
+   *
+   * The mean and std to normalize the pixel values of the video frame. ((value - mean) / std)
+   * Set one value for all channels or a value for each channel, e.g., mean:127.5,std:127.5
+   */
+  g_object_class_install_property (object_class, PROP_NORMALIZE,
+      g_param_spec_string ("normalize", "Normalize",
+          "The mean and std to normalize the video frame, e.g., mean:123.7:116.3:103.5,std:58.4:57.1:57.4",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstTensorConverter::layout:
+   *
+   * The layout of output tensor from the video frame.
+   * NHWC (default) is channel:width:height:frames, and NCHW is width:height:channel:frames.
+   */
+  g_object_class_install_property (object_class, PROP_LAYOUT,
+      g_param_spec_string ("layout", "Layout",
+          "The layout of output tensor (NHWC or NCHW)", "NHWC",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstTensorConverter::output-type:
+   *
+   * The type of output tensor from the video frame. (uint8 or float32)
+   * If not set, it is float32 with normalize option, and uint8 otherwise.
+   */
+  g_object_class_install_property (object_class, PROP_OUTPUT_TYPE,
+      g_param_spec_string ("output-type", "Output type",
+          "The type of output tensor (uint8 or float32)", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   /* set src pad template */
   pad_caps =
       gst_caps_from_string (GST_TENSOR_CAP_DEFAULT ";"
@@ -317,9 +392,9 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
     total = g_strv_length (str_array);
 
     for (i = 0; i < total; i++) {
-      ex = nnstreamer_converter_find (str_array[i]);
-      if (ex && ex->query_caps)
-        gst_caps_append (pad_caps, ex->query_caps (NULL));
+      caps = gst_tensor_converter_get_subplugin_caps (str_array[i]);
+      if (caps)
+        gst_caps_append (pad_caps, caps);
     }
 
     g_strfreev (str_array);
@@ -366,6 +441,8 @@ gst_tensor_converter_init (GstTensorConverter * self)
       (GST_ELEMENT_GET_CLASS (self), "src"), "src");
   gst_pad_set_query_function (self->srcpad,
       GST_DEBUG_FUNCPTR (gst_tensor_converter_src_query));
+  gst_pad_set_event_function (self->srcpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_converter_src_event));
   GST_PAD_SET_PROXY_CAPS (self->srcpad);
   gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
 
@@ -382,6 +459,7 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->mode_option = NULL;
   self->custom.func = NULL;
   self->custom.data = NULL;
+  video_preproc_init (&self->preproc);
 
   gst_tensors_info_init (&self->tensors_info);
   gst_tensors_config_init (&self->tensors_config);
@@ -413,6 +491,7 @@ gst_tensor_converter_finalize (GObject * object)
 
   g_free (self->mode_option);
   g_free (self->ext_fw);
+  video_preproc_free (&self->preproc);
   self->custom.func = NULL;
   self->custom.data = NULL;
   if (self->externalConverter && self->externalConverter->close)
@@ -420,6 +499,28 @@ gst_tensor_converter_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Check the pre-processing options can be changed.
+ * The output geometry is fixed with the negotiated caps, so the options are allowed only in NULL or READY state.
+ */
+static gboolean
+gst_tensor_converter_preproc_is_mutable (GstTensorConverter * self)
+{
+  GstState state;
+
+  GST_OBJECT_LOCK (self);
+  state = GST_STATE (self);
+  GST_OBJECT_UNLOCK (self);
+
+  if (state > GST_STATE_READY) {
+    nns_logw ("Cannot change the pre-processing options in %s state.",
+        gst_element_state_get_name (state));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Setter for tensor_converter properties.
  */
@@ -516,6 +617,26 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
 
       break;
     }
+    case PROP_OUTPUT_SIZE:
+      if (gst_tensor_converter_preproc_is_mutable (self))
+        video_preproc_set_size (&self->preproc, g_value_get_string (value));
+      break;
+    case PROP_OUTPUT_FORMAT:
+      if (gst_tensor_converter_preproc_is_mutable (self))
+        video_preproc_set_format (&self->preproc, g_value_get_string (value));
+      break;
+    case PROP_NORMALIZE:
+      if (gst_tensor_converter_preproc_is_mutable (self))
+        video_preproc_set_normalize (&self->preproc, g_value_get_string (value));
+      break;
+    case PROP_LAYOUT:
+      if (gst_tensor_converter_preproc_is_mutable (self))
+        video_preproc_set_layout (&self->preproc, g_value_get_string (value));
+      break;
+    case PROP_OUTPUT_TYPE:
+      if (gst_tensor_converter_preproc_is_mutable (self))
+        video_preproc_set_type (&self->preproc, g_value_get_string (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -588,6 +709,26 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
       g_value_take_string (value, mode_str);
       break;
     }
+    case PROP_OUTPUT_SIZE:
+      g_value_take_string (value,
+          video_preproc_get_option (&self->preproc, "output-size"));
+      break;
+    case PROP_OUTPUT_FORMAT:
+      g_value_take_string (value,
+          video_preproc_get_option (&self->preproc, "output-format"));
+      break;
+    case PROP_NORMALIZE:
+      g_value_take_string (value,
+          video_preproc_get_option (&self->preproc, "normalize"));
+      break;
+    case PROP_LAYOUT:
+      g_value_take_string (value,
+          video_preproc_get_option (&self->preproc, "layout"));
+      break;
+    case PROP_OUTPUT_TYPE:
+      g_value_take_string (value,
+          video_preproc_get_option (&self->preproc, "output-type"));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -662,6 +803,40 @@ gst_tensor_converter_sink_event (GstPad * pad, GstObject * parent,
   return gst_pad_event_default (pad, parent, event);
 }
 
+/**
+ * @brief This function handles src event.
+ */
+static gboolean
+gst_tensor_converter_src_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstTensorConverter *self;
+
+  self = GST_TENSOR_CONVERTER (parent);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_QOS:
+    {
+      GstTensorsConfig *config = &self->tensors_config;
+      GstClockTime duration = GST_CLOCK_TIME_NONE;
+
+      if (config->rate_n > 0 && config->rate_d > 0)
+        duration = gst_util_uint64_scale_int (GST_SECOND, config->rate_d,
+            config->rate_n);
+
+      /* keep the throttling delay, upstream may also handle this event */
+      GST_OBJECT_LOCK (self);
+      gst_tensor_qos_update (&self->qos, event, duration);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
 /**
  * @brief This function handles sink pad query.
  */
@@ -1005,6 +1180,37 @@ _gst_tensor_converter_chain_chunk (GstTensorConverter * self,
   return ret;
 }
 
+/**
+ * @brief Check the incoming buffer will be dropped in downstream (throttling QoS).
+ * @return TRUE if the buffer can be skipped before conversion.
+ */
+static gboolean
+_gst_tensor_converter_chain_qos (GstTensorConverter * self, GstBuffer * buf)
+{
+  gboolean skip;
+
+  switch (self->in_media_type) {
+    case _NNS_AUDIO:
+    case _NNS_OCTET:
+      /* a buffer may have multiple frames */
+      return FALSE;
+    default:
+      break;
+  }
+
+  GST_OBJECT_LOCK (self);
+  skip = gst_tensor_qos_skip (&self->qos, GST_BUFFER_PTS (buf));
+  GST_OBJECT_UNLOCK (self);
+
+  if (skip) {
+    GST_LOG_OBJECT (self, "Skip the buffer %" GST_TIME_FORMAT
+        " (throttling, total %" G_GUINT64_FORMAT ")",
+        GST_TIME_ARGS (GST_BUFFER_PTS (buf)), self->qos.skipped);
+  }
+
+  return skip;
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -1029,6 +1235,12 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   frames_out = self->frames_per_tensor;
   inbuf = buf;
 
+  /* skip the frame before conversion, it will be dropped in downstream */
+  if (frames_out == 1 && _gst_tensor_converter_chain_qos (self, buf)) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_OK;
+  }
+
   /**
    * Supposed 1 frame in buffer (default).
    * Update frame size for each media type.
@@ -1042,6 +1254,38 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       guint color, width, height;
       gsize type;
 
+      /** supposed 1 frame in buffer */
+      g_assert ((buf_size / self->frame_size) == 1);
+
+      if (self->preproc.enabled) {
+        GstMapInfo src_info, dest_info;
+
+        /* color conversion, resize and normalization in a single pass */
+        frame_size = video_preproc_get_frame_size (&self->preproc);
+
+        if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
+          ml_logf ("Cannot map src buffer at tensor_converter/video.\n");
+          goto error;
+        }
+
+        inbuf = gst_buffer_new_and_alloc (frame_size);
+        if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
+          ml_logf ("Cannot map dest buffer at tensor_converter/video.\n");
+          gst_buffer_unmap (buf, &src_info);
+          gst_buffer_unref (inbuf);     /* the new buffer is wasted. */
+          goto error;
+        }
+
+        video_preproc_process (&self->preproc, src_info.data, dest_info.data);
+
+        gst_buffer_unmap (buf, &src_info);
+        gst_buffer_unmap (inbuf, &dest_info);
+
+        /** copy timestamps */
+        gst_buffer_copy_into (inbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+        break;
+      }
+
       color = config->info.info[0].dimension[0];
       width = config->info.info[0].dimension[1];
       height = config->info.info[0].dimension[2];
@@ -1050,9 +1294,6 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       /** colorspace * width * height * type */
       frame_size = color * width * height * type;
 
-      /** supposed 1 frame in buffer */
-      g_assert ((buf_size / self->frame_size) == 1);
-
       if (self->remove_padding) {
         GstMapInfo src_info, dest_info;
         int d0, d1;
@@ -1301,6 +1542,10 @@ gst_tensor_converter_reset (GstTensorConverter * self)
   gst_segment_init (&self->segment, GST_FORMAT_TIME);
 
   self->old_timestamp = GST_CLOCK_TIME_NONE;
+
+  GST_OBJECT_LOCK (self);
+  gst_tensor_qos_reset (&self->qos);
+  GST_OBJECT_UNLOCK (self);
 }
 
 /**
@@ -1353,6 +1598,88 @@ gst_tensor_converter_video_stride (GstVideoFormat format, gint width)
   return FALSE;
 }
 
+/**
+ * @brief Configure the video pre-processing and set the tensors config (internal static function)
+ * @param self this pointer to GstTensorConverter
+ * @param vinfo video info of the media stream
+ * @param config tensors config structure to be filled
+ * @return TRUE if supported format and options
+ */
+static gboolean
+gst_tensor_converter_parse_video_preproc (GstTensorConverter * self,
+    GstVideoInfo * vinfo, GstTensorsConfig * config)
+{
+  GstVideoFormat format;
+  video_preproc_src_format src_format;
+  gsize offset[3], stride[3];
+  guint i;
+
+  format = GST_VIDEO_INFO_FORMAT (vinfo);
+
+  switch (format) {
+    case GST_VIDEO_FORMAT_GRAY8:
+      src_format = VIDEO_PREPROC_SRC_GRAY8;
+      break;
+    case GST_VIDEO_FORMAT_RGB:
+      src_format = VIDEO_PREPROC_SRC_RGB;
+      break;
+    case GST_VIDEO_FORMAT_BGR:
+      src_format = VIDEO_PREPROC_SRC_BGR;
+      break;
+    case GST_VIDEO_FORMAT_RGBx:
+    case GST_VIDEO_FORMAT_RGBA:
+      src_format = VIDEO_PREPROC_SRC_RGBx;
+      break;
+    case GST_VIDEO_FORMAT_BGRx:
+    case GST_VIDEO_FORMAT_BGRA:
+      src_format = VIDEO_PREPROC_SRC_BGRx;
+      break;
+    case GST_VIDEO_FORMAT_xRGB:
+    case GST_VIDEO_FORMAT_ARGB:
+      src_format = VIDEO_PREPROC_SRC_xRGB;
+      break;
+    case GST_VIDEO_FORMAT_xBGR:
+    case GST_VIDEO_FORMAT_ABGR:
+      src_format = VIDEO_PREPROC_SRC_xBGR;
+      break;
+    case GST_VIDEO_FORMAT_I420:
+      src_format = VIDEO_PREPROC_SRC_I420;
+      break;
+    case GST_VIDEO_FORMAT_NV12:
+      src_format = VIDEO_PREPROC_SRC_NV12;
+      break;
+    case GST_VIDEO_FORMAT_YUY2:
+      src_format = VIDEO_PREPROC_SRC_YUY2;
+      break;
+    default:
+      /* unsupported format */
+      GST_WARNING_OBJECT (self, "Unsupported format = %s\n",
+          GST_STR_NULL (gst_video_format_to_string (format)));
+      return FALSE;
+  }
+
+  for (i = 0; i < 3; i++) {
+    offset[i] = GST_VIDEO_INFO_PLANE_OFFSET (vinfo, i);
+    stride[i] = GST_VIDEO_INFO_PLANE_STRIDE (vinfo, i);
+  }
+
+  if (!video_preproc_configure (&self->preproc, src_format,
+          GST_VIDEO_INFO_WIDTH (vinfo), GST_VIDEO_INFO_HEIGHT (vinfo),
+          offset, stride, &config->info.info[0])) {
+    GST_ERROR_OBJECT (self, "Failed to configure the video pre-processing.");
+    return FALSE;
+  }
+
+  config->info.num_tensors = 1;
+  config->rate_n = GST_VIDEO_INFO_FPS_N (vinfo);
+  config->rate_d = GST_VIDEO_INFO_FPS_D (vinfo);
+
+  /* the pre-processing reads the frame with the plane strides */
+  self->remove_padding = FALSE;
+  self->frame_size = GST_VIDEO_INFO_SIZE (vinfo);
+  return TRUE;
+}
+
 /**
  * @brief Set the tensors config structure from video info (internal static function)
  * @param self this pointer to GstTensorConverter
@@ -1385,6 +1712,9 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
     return FALSE;
   }
 
+  if (self->preproc.enabled)
+    return gst_tensor_converter_parse_video_preproc (self, &vinfo, config);
+
   format = GST_VIDEO_INFO_FORMAT (&vinfo);
   width = GST_VIDEO_INFO_WIDTH (&vinfo);
   height = GST_VIDEO_INFO_HEIGHT (&vinfo);
@@ -1764,8 +2094,8 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
 
       switch (type) {
         case _NNS_VIDEO:
-          /* video caps from tensor info */
-          if (is_video_supported (self)
+          /* video caps from tensor info (any size and format with the pre-processing) */
+          if (is_video_supported (self) && !self->preproc.enabled
               && config.info.info[0].type == _NNS_UINT8) {
             GValue supported_formats = G_VALUE_INIT;
             gint colorspace, width, height;
@@ -1889,6 +2219,16 @@ gst_tensor_converter_query_caps (GstTensorConverter * self, GstPad * pad,
   if (pad == self->sinkpad) {
     GstCaps *media_caps;
 
+    /* yuv formats are supported only with the pre-processing */
+    if (!self->preproc.enabled) {
+      GstCaps *yuv_caps = gst_caps_from_string (VIDEO_PREPROC_ONLY_CAPS_STR);
+      GstCaps *tmp = gst_caps_subtract (caps, yuv_caps);
+
+      gst_caps_unref (caps);
+      gst_caps_unref (yuv_caps);
+      caps = tmp;
+    }
+
     media_caps = gst_tensor_converter_get_possible_media_caps (self);
     if (media_caps) {
       /* intersect with pad caps */
@@ -2097,8 +2437,46 @@ unregisterExternalConverter (const char *name)
   unregister_subplugin (NNS_SUBPLUGIN_CONVERTER, name);
 }
 
+/**
+ * @brief Internal static function to get the template caps of converter sub-plugin.
+ * @note The caps is cached in the registry, the sub-plugin is not loaded if the cache is valid.
+ * @return The caps of sub-plugin (transfer full), NULL if not found.
+ */
+static GstCaps *
+gst_tensor_converter_get_subplugin_caps (const gchar * name)
+{
+  const NNStreamerExternalConverter *ex;
+  GstCaps *caps = NULL;
+  gchar *caps_str;
+
+  caps_str = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, name,
+      "caps");
+  if (caps_str) {
+    caps = gst_caps_from_string (caps_str);
+    g_free (caps_str);
+
+    if (caps)
+      return caps;
+  }
+
+  ex = nnstreamer_converter_find (name);
+  if (ex && ex->query_caps) {
+    caps = ex->query_caps (NULL);
+
+    if (caps) {
+      caps_str = gst_caps_to_string (caps);
+      nnsconf_set_subplugin_cache (NNSCONF_PATH_CONVERTERS, name, "caps",
+          caps_str);
+      g_free (caps_str);
+    }
+  }
+
+  return caps;
+}
+
 /**
  * @brief Internal static function to find registered subplugins.
+ * @note Only the matched sub-plugin is loaded, the others are checked with the cached caps.
  */
 static const NNStreamerExternalConverter *
 findExternalConverter (const char *media_type)
@@ -2114,16 +2492,15 @@ findExternalConverter (const char *media_type)
     total = g_strv_length (str_array);
 
     for (i = 0; i < total; i++) {
-      ex = nnstreamer_converter_find (str_array[i]);
-
       if (g_strcmp0 (media_type, str_array[i]) == 0) {
         /* found matched media type */
+        ex = nnstreamer_converter_find (str_array[i]);
         g_strfreev (str_array);
         return ex;
       }
 
-      if (ex && ex->query_caps) {
-        caps = ex->query_caps (NULL);
+      caps = gst_tensor_converter_get_subplugin_caps (str_array[i]);
+      if (caps) {
         caps_size = gst_caps_get_size (caps);
 
         for (j = 0; j < caps_size; j++) {
@@ -2131,6 +2508,7 @@ findExternalConverter (const char *media_type)
           if (g_strcmp0 (media_type, caps_name) == 0) {
             /* found matched media type */
             gst_caps_unref (caps);
+            ex = nnstreamer_converter_find (str_array[i]);
             g_strfreev (str_array);
             return ex;
           }
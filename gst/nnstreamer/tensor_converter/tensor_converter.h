@@ -39,6 +39,7 @@
 #include <tensor_common.h>
 #include "nnstreamer_plugin_api_converter.h"
 #include "tensor_converter_custom.h"
+#include "converter-video-preproc.h"
 
 G_BEGIN_DECLS
 
@@ -100,11 +101,13 @@ struct _GstTensorConverter
   gboolean need_segment; /**< True to handle seg event */
   GstSegment segment; /**< Segment, supposed time format */
   GstClockTime old_timestamp; /**< timestamp at prev buffer */
+  GstTensorQoS qos; /**< throttling QoS from downstream to skip the frames */
 
   tensor_converter_mode mode; /**< tensor converter operating mode */
   gchar *mode_option; /**< tensor converter mode option */
   gchar *ext_fw; /**< tensor converter custom mode framework */
   converter_custom_cb_s custom;
+  video_preproc_s preproc; /**< fused pre-processing of video frames */
 
   void *priv_data; /**< plugin's private data */
 };
@@ -11,6 +11,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include "tensor_data.h"
 #include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
@@ -101,6 +102,12 @@ gst_tensor_data_set (tensor_data_s * td, tensor_type type, gpointer value)
     case _NNS_UINT64:
       td_set_data (td, value, uint64_t);
       break;
+    case _NNS_FLOAT16:
+      td->data._float16 = *((uint16_t *) value);
+      break;
+    case _NNS_BFLOAT16:
+      td->data._bfloat16 = *((uint16_t *) value);
+      break;
     default:
       nns_logw ("Unknown tensor type %d", type);
       return FALSE;
@@ -153,6 +160,12 @@ gst_tensor_data_get (tensor_data_s * td, gpointer value)
     case _NNS_UINT64:
       td_get_data (td, value, uint64_t);
       break;
+    case _NNS_FLOAT16:
+      *((uint16_t *) value) = td->data._float16;
+      break;
+    case _NNS_BFLOAT16:
+      *((uint16_t *) value) = td->data._bfloat16;
+      break;
     default:
       nns_logw ("Unknown tensor type %d", td->type);
       return FALSE;
@@ -171,11 +184,21 @@ gboolean
 gst_tensor_data_typecast (tensor_data_s * td, tensor_type type)
 {
   gboolean is_float;
+  float val;
 
   g_return_val_if_fail (td != NULL, FALSE);
 
   /* do nothing when transform to same type */
   if (td->type != type) {
+    /* 16-bit floating point types are converted via float32 */
+    if (td->type == _NNS_FLOAT16) {
+      td->data._float = gst_tensor_data_float16_to_float (td->data._float16);
+      td->type = _NNS_FLOAT32;
+    } else if (td->type == _NNS_BFLOAT16) {
+      td->data._float = gst_tensor_data_bfloat16_to_float (td->data._bfloat16);
+      td->type = _NNS_FLOAT32;
+    }
+
     is_float = (td->type == _NNS_FLOAT32 || td->type == _NNS_FLOAT64);
 
     switch (type) {
@@ -225,6 +248,18 @@ gst_tensor_data_typecast (tensor_data_s * td, tensor_type type)
         }
         td_typecast (td, uint64_t);
         break;
+      case _NNS_FLOAT16:
+        td_typecast (td, float);
+        val = td->data._float;
+        td->data._int64_t = 0;
+        td->data._float16 = gst_tensor_data_float_to_float16 (val);
+        break;
+      case _NNS_BFLOAT16:
+        td_typecast (td, float);
+        val = td->data._float;
+        td->data._int64_t = 0;
+        td->data._bfloat16 = gst_tensor_data_float_to_bfloat16 (val);
+        break;
       default:
         nns_logw ("Unknown tensor type %d", type);
         return FALSE;
@@ -261,6 +296,446 @@ gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
   return TRUE;
 }
 
+/**
+ * @brief The number of elements (pixels for per-channel) to compute the statistics at once.
+ * The partial results of the blocks are merged (Chan et al.), which keeps the precision.
+ */
+#define TD_STATS_BLOCK (4096)
+
+/**
+ * @brief The number of channels to be processed together.
+ */
+#define TD_STATS_CH_CHUNK (64)
+
+/**
+ * @brief The minimum number of elements for each thread to compute the statistics.
+ */
+#define TD_STATS_MT_THRESHOLD (1 << 20)
+#define TD_STATS_MAX_THREADS (8)
+
+/**
+ * @brief Function to get the mean and the sum of squared deviations of a block.
+ * @param raw pointer of the first element
+ * @param n the number of elements (up to TD_STATS_BLOCK)
+ * @param stride distance of the elements (in elements)
+ */
+typedef void (*td_stats_block_func) (const guint8 * raw, gsize n, gsize stride,
+    gdouble * mean, gdouble * m2);
+
+/**
+ * @brief Macro to define the block statistics of small integer types.
+ * The sum and the sum of squares are exact with integers in a block.
+ */
+#define td_stats_block_int(dtype) \
+static void \
+_td_stats_block_##dtype (const guint8 * raw, gsize n, gsize stride, \
+    gdouble * mean, gdouble * m2) \
+{ \
+  const dtype *d = (const dtype *) raw; \
+  gint64 sum = 0; \
+  guint64 sq = 0; \
+  gsize i; \
+  if (stride == 1) { \
+    for (i = 0; i < n; i++) { \
+      sum += d[i]; \
+      sq += (guint64) ((gint64) d[i] * d[i]); \
+    } \
+  } else { \
+    for (i = 0; i < n; i++) { \
+      dtype v = d[i * stride]; \
+      sum += v; \
+      sq += (guint64) ((gint64) v * v); \
+    } \
+  } \
+  *mean = (gdouble) sum / n; \
+  *m2 = (gdouble) (n * sq - (guint64) (sum * sum)) / n; \
+}
+
+/**
+ * @brief Macro to define the block statistics of the other types.
+ * The block is in the cache, two passes over it keep the precision.
+ * @param name suffix of the function name
+ * @param dtype type of the element
+ * @param cvt conversion of the element to gdouble
+ */
+#define td_stats_block_fp_cvt(name,dtype,cvt) \
+static void \
+_td_stats_block_##name (const guint8 * raw, gsize n, gsize stride, \
+    gdouble * mean, gdouble * m2) \
+{ \
+  const dtype *d = (const dtype *) raw; \
+  gdouble s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0, m, e; \
+  gsize i = 0; \
+  if (stride == 1) { \
+    for (; i + 4 <= n; i += 4) { \
+      s0 += cvt (d[i]); \
+      s1 += cvt (d[i + 1]); \
+      s2 += cvt (d[i + 2]); \
+      s3 += cvt (d[i + 3]); \
+    } \
+  } \
+  for (; i < n; i++) \
+    s0 += cvt (d[i * stride]); \
+  m = (s0 + s1 + s2 + s3) / n; \
+  s0 = s1 = s2 = s3 = 0.0; \
+  i = 0; \
+  if (stride == 1) { \
+    for (; i + 4 <= n; i += 4) { \
+      e = cvt (d[i]) - m; s0 += e * e; \
+      e = cvt (d[i + 1]) - m; s1 += e * e; \
+      e = cvt (d[i + 2]) - m; s2 += e * e; \
+      e = cvt (d[i + 3]) - m; s3 += e * e; \
+    } \
+  } \
+  for (; i < n; i++) { \
+    e = cvt (d[i * stride]) - m; \
+    s0 += e * e; \
+  } \
+  *mean = m; \
+  *m2 = s0 + s1 + s2 + s3; \
+}
+
+#define td_stats_block_fp(dtype) td_stats_block_fp_cvt (dtype, dtype, (gdouble))
+
+td_stats_block_int (int8_t);
+td_stats_block_int (uint8_t);
+td_stats_block_int (int16_t);
+td_stats_block_int (uint16_t);
+td_stats_block_fp (int32_t);
+td_stats_block_fp (uint32_t);
+td_stats_block_fp (int64_t);
+td_stats_block_fp (uint64_t);
+td_stats_block_fp (float);
+td_stats_block_fp (double);
+td_stats_block_fp_cvt (float16, uint16_t, gst_tensor_data_float16_to_float);
+td_stats_block_fp_cvt (bfloat16, uint16_t, gst_tensor_data_bfloat16_to_float);
+
+/**
+ * @brief Get the block statistics function of the type.
+ */
+static td_stats_block_func
+_td_stats_get_block_func (tensor_type type)
+{
+  switch (type) {
+    case _NNS_INT32: return _td_stats_block_int32_t;
+    case _NNS_UINT32: return _td_stats_block_uint32_t;
+    case _NNS_INT16: return _td_stats_block_int16_t;
+    case _NNS_UINT16: return _td_stats_block_uint16_t;
+    case _NNS_INT8: return _td_stats_block_int8_t;
+    case _NNS_UINT8: return _td_stats_block_uint8_t;
+    case _NNS_FLOAT64: return _td_stats_block_double;
+    case _NNS_FLOAT32: return _td_stats_block_float;
+    case _NNS_INT64: return _td_stats_block_int64_t;
+    case _NNS_UINT64: return _td_stats_block_uint64_t;
+    case _NNS_FLOAT16: return _td_stats_block_float16;
+    case _NNS_BFLOAT16: return _td_stats_block_bfloat16;
+    default: break;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Partial statistics of the channels.
+ */
+typedef struct
+{
+  gdouble mean[TD_STATS_CH_CHUNK];      /**< mean of each channel */
+  gdouble m2[TD_STATS_CH_CHUNK];        /**< sum of squared deviations of each channel */
+  gsize count;                          /**< the number of elements of each channel */
+} td_stats_acc;
+
+/**
+ * @brief Merge the statistics of a block (parallel algorithm of Chan et al.).
+ */
+static inline void
+_td_stats_merge (gdouble * mean, gdouble * m2, gsize count,
+    gdouble b_mean, gdouble b_m2, gsize b_count)
+{
+  gdouble n = (gdouble) (count + b_count);
+  gdouble delta = b_mean - *mean;
+
+  *mean += delta * b_count / n;
+  *m2 += b_m2 + delta * delta * ((gdouble) count * b_count / n);
+}
+
+/**
+ * @brief Job to compute the statistics of the channels in a range of pixels.
+ */
+typedef struct
+{
+  const guint8 *raw;            /**< raw tensor data */
+  td_stats_block_func func;     /**< block statistics function of the type */
+  gsize element_size;           /**< element size of the type */
+  gsize channels;               /**< the number of channels (1 for the whole tensor) */
+  gsize ch_start;               /**< the first channel to compute */
+  gsize ch_num;                 /**< the number of channels to compute */
+
+  /* multi-threaded reduction */
+  GMutex lock;                  /**< lock for the remaining tasks */
+  GCond cond;                   /**< signaled when all tasks are done */
+  guint remaining;              /**< the number of remaining tasks */
+} td_stats_job;
+
+/**
+ * @brief Task of a thread to compute the statistics.
+ */
+typedef struct
+{
+  td_stats_job *job;            /**< the job */
+  gsize start;                  /**< the first pixel */
+  gsize end;                    /**< the last pixel (exclusive) */
+  td_stats_acc acc;             /**< the result */
+} td_stats_task;
+
+/**
+ * @brief Compute the statistics of the channels in a range of pixels.
+ */
+static void
+_td_stats_range (const td_stats_job * job, gsize start, gsize end,
+    td_stats_acc * acc)
+{
+  gdouble b_mean, b_m2;
+  gsize p, c, n;
+
+  memset (acc, 0, sizeof (td_stats_acc));
+
+  for (p = start; p < end; p += n) {
+    n = MIN (TD_STATS_BLOCK, end - p);
+
+    for (c = 0; c < job->ch_num; c++) {
+      job->func (job->raw +
+          (p * job->channels + job->ch_start + c) * job->element_size, n,
+          job->channels, &b_mean, &b_m2);
+      _td_stats_merge (&acc->mean[c], &acc->m2[c], acc->count, b_mean, b_m2,
+          n);
+    }
+
+    acc->count += n;
+  }
+}
+
+/**
+ * @brief Thread function of the pool to compute the statistics.
+ */
+static void
+_td_stats_thread (gpointer data, gpointer user_data)
+{
+  td_stats_task *task = (td_stats_task *) data;
+  td_stats_job *job = task->job;
+
+  _td_stats_range (job, task->start, task->end, &task->acc);
+
+  g_mutex_lock (&job->lock);
+  if (--job->remaining == 0)
+    g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Get the shared thread pool to compute the statistics of large tensors.
+ */
+static GThreadPool *
+_td_stats_get_pool (void)
+{
+  static gsize initialized = 0;
+  static GThreadPool *pool = NULL;
+
+  if (g_once_init_enter (&initialized)) {
+    gint max_threads = MIN (g_get_num_processors (), TD_STATS_MAX_THREADS) - 1;
+
+    if (max_threads > 0)
+      pool = g_thread_pool_new (_td_stats_thread, NULL, max_threads, FALSE,
+          NULL);
+    g_once_init_leave (&initialized, 1);
+  }
+
+  return pool;
+}
+
+/**
+ * @brief Compute the statistics of the channels, large tensors are split into the threads.
+ */
+static void
+_td_stats_compute (td_stats_job * job, gsize pixels, td_stats_acc * acc)
+{
+  td_stats_task tasks[TD_STATS_MAX_THREADS];
+  GThreadPool *pool = NULL;
+  guint i, num_tasks = 1;
+  gsize chunk;
+
+  if (pixels * job->ch_num >= 2 * TD_STATS_MT_THRESHOLD)
+    pool = _td_stats_get_pool ();
+
+  if (pool) {
+    num_tasks = (guint) MIN ((pixels * job->ch_num) / TD_STATS_MT_THRESHOLD,
+        (gsize) g_thread_pool_get_max_threads (pool) + 1);
+  }
+
+  if (num_tasks <= 1) {
+    _td_stats_range (job, 0, pixels, acc);
+    return;
+  }
+
+  chunk = (pixels + num_tasks - 1) / num_tasks;
+
+  g_mutex_init (&job->lock);
+  g_cond_init (&job->cond);
+  job->remaining = num_tasks - 1;
+
+  for (i = 0; i < num_tasks; i++) {
+    tasks[i].job = job;
+    tasks[i].start = MIN (chunk * i, pixels);
+    tasks[i].end = MIN (chunk * (i + 1), pixels);
+
+    if (i > 0)
+      g_thread_pool_push (pool, &tasks[i], NULL);
+  }
+
+  /* the caller computes the first chunk */
+  _td_stats_range (job, tasks[0].start, tasks[0].end, acc);
+
+  g_mutex_lock (&job->lock);
+  while (job->remaining > 0)
+    g_cond_wait (&job->cond, &job->lock);
+  g_mutex_unlock (&job->lock);
+
+  g_mutex_clear (&job->lock);
+  g_cond_clear (&job->cond);
+
+  for (i = 1; i < num_tasks; i++) {
+    gsize c;
+
+    if (tasks[i].acc.count == 0)
+      continue;
+
+    for (c = 0; c < job->ch_num; c++)
+      _td_stats_merge (&acc->mean[c], &acc->m2[c], acc->count,
+          tasks[i].acc.mean[c], tasks[i].acc.m2[c], tasks[i].acc.count);
+    acc->count += tasks[i].acc.count;
+  }
+}
+
+/**
+ * @brief Compute the mean and the sum of squared deviations of each channel.
+ * @param[out] means mean of each channel (channels)
+ * @param[out] m2 sum of squared deviations of each channel (nullable, channels)
+ * @return the number of elements of each channel, 0 if failed.
+ */
+static gsize
+_td_stats (gpointer raw, gsize length, tensor_type type, gsize channels,
+    gdouble * means, gdouble * m2)
+{
+  td_stats_job job;
+  td_stats_acc acc;
+  gsize num, pixels, c;
+
+  job.func = _td_stats_get_block_func (type);
+  if (job.func == NULL) {
+    nns_logw ("Unknown tensor type %d", type);
+    return 0;
+  }
+
+  job.raw = (const guint8 *) raw;
+  job.element_size = gst_tensor_get_element_size (type);
+  job.channels = channels;
+
+  num = length / job.element_size;
+  pixels = num / channels;
+  if (pixels == 0)
+    return 0;
+
+  for (c = 0; c < channels; c += TD_STATS_CH_CHUNK) {
+    job.ch_start = c;
+    job.ch_num = MIN (TD_STATS_CH_CHUNK, channels - c);
+
+    _td_stats_compute (&job, pixels, &acc);
+
+    memcpy (means + c, acc.mean, sizeof (gdouble) * job.ch_num);
+    if (m2)
+      memcpy (m2 + c, acc.m2, sizeof (gdouble) * job.ch_num);
+  }
+
+  return pixels;
+}
+
+/**
+ * @brief Get the standard deviation from the sum of squared deviations.
+ */
+static inline gdouble
+_td_stats_std (gdouble m2, gsize count)
+{
+  gdouble std = (m2 > 0.0) ? sqrt (m2 / count) : 0.0;
+
+  return (std != 0.0) ? std : (1e-10);
+}
+
+/**
+ * @brief Calculate the mean and standard deviation of the tensor in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param mean pointer to store the mean value
+ * @param std pointer to store the standard deviation (nullable)
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_mean_std (gpointer raw, gsize length, tensor_type type,
+    gdouble * mean, gdouble * std)
+{
+  gdouble m2;
+  gsize count;
+
+  g_return_val_if_fail (raw != NULL, FALSE);
+  g_return_val_if_fail (length > 0, FALSE);
+  g_return_val_if_fail (type != _NNS_END, FALSE);
+  g_return_val_if_fail (mean != NULL, FALSE);
+
+  count = _td_stats (raw, length, type, 1, mean, &m2);
+  if (count == 0)
+    return FALSE;
+
+  if (std)
+    *std = _td_stats_std (m2, count);
+
+  return TRUE;
+}
+
+/**
+ * @brief Calculate the mean and standard deviation of the tensor per channel (the first dim) in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param dim tensor dimension
+ * @param means array to store the mean value of each channel (dim[0] elements)
+ * @param stds array to store the standard deviation of each channel (dim[0] elements, nullable)
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_mean_std_per_channel (gpointer raw, gsize length,
+    tensor_type type, tensor_dim dim, gdouble * means, gdouble * stds)
+{
+  gsize c, count;
+
+  g_return_val_if_fail (raw != NULL, FALSE);
+  g_return_val_if_fail (length > 0, FALSE);
+  g_return_val_if_fail (dim[0] > 0, FALSE);
+  g_return_val_if_fail (type != _NNS_END, FALSE);
+  g_return_val_if_fail (means != NULL, FALSE);
+
+  /* stds stores the sum of squared deviations first */
+  count = _td_stats (raw, length, type, dim[0], means, stds);
+  if (count == 0)
+    return FALSE;
+
+  if (stds) {
+    for (c = 0; c < dim[0]; c++)
+      stds[c] = _td_stats_std (stds[c], count);
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Calculate average value of the tensor.
  * @param raw pointer of raw tensor data
@@ -273,36 +748,17 @@ gboolean
 gst_tensor_data_raw_average (gpointer raw, gsize length, tensor_type type,
     gdouble ** result)
 {
-  gdouble value, average;
-  gulong i, num;
-  gsize element_size;
-  guint8 *data;
-
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
 
-  element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
-
-  average = 0.0;
   *result = (gdouble *) g_try_malloc0 (sizeof (gdouble));
   if (*result == NULL) {
     nns_loge ("Failed to allocate memory for calculating average");
     return FALSE;
   }
 
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-
-    average = (value - average) / (i + 1) + average;
-  }
-
-  **result = average;
-
-  return TRUE;
+  return gst_tensor_data_raw_mean_std (raw, length, type, *result, NULL);
 }
 
 /**
@@ -318,40 +774,19 @@ gboolean
 gst_tensor_data_raw_average_per_channel (gpointer raw, gsize length,
     tensor_type type, tensor_dim dim, gdouble ** results)
 {
-  gdouble value, average;
-  gulong ch, i, num, offset;
-  gsize element_size;
-  guint8 *data;
-
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
   g_return_val_if_fail (dim[0] > 0, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
 
-  element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
-
-  offset = dim[0];
-  num = num / offset;
-  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * offset);
+  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * dim[0]);
   if (*results == NULL) {
     nns_loge ("Failed to allocate memory for calculating average");
     return FALSE;
   }
 
-  for (ch = 0; ch < offset; ++ch) {
-    average = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      average = (value - average) / (i + 1) + average;
-    }
-
-    (*results)[ch] = average;
-  }
-
-  return TRUE;
+  return gst_tensor_data_raw_mean_std_per_channel (raw, length, type, dim,
+      *results, NULL);
 }
 
 /**
@@ -367,34 +802,26 @@ gboolean
 gst_tensor_data_raw_std (gpointer raw, gsize length, tensor_type type,
     gdouble * average, gdouble ** result)
 {
-  gdouble value, std;
-  gulong i, num;
-  gsize element_size;
-  guint8 *data;
+  gdouble mean, m2, delta;
+  gsize count;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
 
-  element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
   *result = (gdouble *) g_try_malloc0 (sizeof (gdouble));
   if (*result == NULL) {
     nns_loge ("Failed to allocate memory for calculating standard deviation");
     return FALSE;
   }
 
-  std = 0.0;
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-
-    std += pow (value - *average, 2) / num;
-  }
+  count = _td_stats (raw, length, type, 1, &mean, &m2);
+  if (count == 0)
+    return FALSE;
 
-  std = (std != 0.0) ? sqrt (std) : (1e-10);
-  **result = std;
+  /* deviations from the given average */
+  delta = mean - *average;
+  **result = _td_stats_std (m2 + delta * delta * count, count);
 
   return TRUE;
 }
@@ -413,39 +840,32 @@ gboolean
 gst_tensor_data_raw_std_per_channel (gpointer raw, gsize length,
     tensor_type type, tensor_dim dim, gdouble * averages, gdouble ** results)
 {
-  gdouble value, std;
-  gulong ch, i, num, offset;
-  gsize element_size;
-  guint8 *data;
+  gdouble *means, delta;
+  gsize c, count;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
   g_return_val_if_fail (dim[0] > 0, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
 
-  element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
-
-  offset = dim[0];
-  num = num / offset;
-  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * offset);
-  if (*results == NULL) {
+  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * dim[0]);
+  means = (gdouble *) g_try_malloc0 (sizeof (gdouble) * dim[0]);
+  if (*results == NULL || means == NULL) {
     nns_loge ("Failed to allocate memory for calculating standard deviation");
+    g_free (means);
     return FALSE;
   }
 
-  for (ch = 0; ch < offset; ++ch) {
-    std = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      std += pow (value - averages[ch], 2) / num;
+  count = _td_stats (raw, length, type, dim[0], means, *results);
+  if (count > 0) {
+    /* deviations from the given averages */
+    for (c = 0; c < dim[0]; c++) {
+      delta = means[c] - averages[c];
+      (*results)[c] =
+          _td_stats_std ((*results)[c] + delta * delta * count, count);
     }
-
-    std = (std != 0.0) ? sqrt (std) : (1e-10);
-    (*results)[ch] = std;
   }
 
-  return TRUE;
+  g_free (means);
+  return (count > 0);
 }
@@ -14,9 +14,110 @@
 #define __NNS_TENSOR_DATA_H__
 
 #include <glib.h>
+#include <string.h>
 #include <tensor_typedef.h>
 
 G_BEGIN_DECLS
+/**
+ * @brief Macro to check the 16-bit floating point types (stored as raw bits).
+ */
+#define gst_tensor_type_is_half(t) ((t) == _NNS_FLOAT16 || (t) == _NNS_BFLOAT16)
+
+/**
+ * @brief Convert float16 (raw bits) to float32.
+ */
+static inline float
+gst_tensor_data_float16_to_float (uint16_t h)
+{
+  uint32_t sign = ((uint32_t) h & 0x8000U) << 16;
+  uint32_t exp = (h >> 10) & 0x1fU;
+  uint32_t mant = h & 0x3ffU;
+  uint32_t bits;
+  float f;
+
+  if (exp == 0) {
+    /* zero or subnormal, mant * 2^-24 is exact in float32 */
+    f = (float) mant * 5.9604644775390625e-8f;
+    return sign ? -f : f;
+  }
+
+  if (exp == 0x1f)
+    bits = sign | 0x7f800000U | (mant << 13);
+  else
+    bits = sign | ((exp + 112) << 23) | (mant << 13);
+
+  memcpy (&f, &bits, sizeof (f));
+  return f;
+}
+
+/**
+ * @brief Convert float32 to float16 (raw bits), rounding to nearest even.
+ * @note Overflow becomes infinity and NaN becomes a quiet NaN, as F16C and NEON do.
+ */
+static inline uint16_t
+gst_tensor_data_float_to_float16 (float f)
+{
+  uint32_t bits, sign;
+  uint16_t h;
+
+  memcpy (&bits, &f, sizeof (bits));
+  sign = (bits >> 16) & 0x8000U;
+  bits &= 0x7fffffffU;
+
+  if (bits >= 0x47800000U) {
+    /* 65536 or larger, infinity or NaN */
+    h = (bits > 0x7f800000U) ? 0x7e00U : 0x7c00U;
+  } else if (bits < 0x38800000U) {
+    /* subnormal or zero, let the FPU round the shifted mantissa */
+    const uint32_t magic_bits = 0x3f000000U;
+    float v, magic;
+
+    memcpy (&v, &bits, sizeof (v));
+    memcpy (&magic, &magic_bits, sizeof (magic));
+    v += magic;
+    memcpy (&bits, &v, sizeof (bits));
+    h = (uint16_t) (bits - magic_bits);
+  } else {
+    uint32_t odd = (bits >> 13) & 1U;
+
+    bits += 0xc8000fffU + odd;
+    h = (uint16_t) (bits >> 13);
+  }
+
+  return (uint16_t) (h | sign);
+}
+
+/**
+ * @brief Convert bfloat16 (raw bits) to float32.
+ */
+static inline float
+gst_tensor_data_bfloat16_to_float (uint16_t b)
+{
+  uint32_t bits = (uint32_t) b << 16;
+  float f;
+
+  memcpy (&f, &bits, sizeof (f));
+  return f;
+}
+
+/**
+ * @brief Convert float32 to bfloat16 (raw bits), rounding to nearest even.
+ */
+static inline uint16_t
+gst_tensor_data_float_to_bfloat16 (float f)
+{
+  uint32_t bits;
+
+  memcpy (&bits, &f, sizeof (bits));
+
+  /* keep NaN quiet, rounding may carry it to infinity */
+  if ((bits & 0x7fffffffU) > 0x7f800000U)
+    return (uint16_t) ((bits | 0x00400000U) >> 16);
+
+  bits += 0x7fffU + ((bits >> 16) & 1U);
+  return (uint16_t) (bits >> 16);
+}
+
 /**
  * @brief Structure for tensor data.
  */
@@ -66,6 +167,33 @@ extern gboolean
 gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
     gpointer output, tensor_type out_type);
 
+/**
+ * @brief Calculate the mean and standard deviation of the tensor in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param mean pointer to store the mean value
+ * @param std pointer to store the standard deviation (nullable)
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_mean_std (gpointer raw, gsize length, tensor_type type,
+    gdouble * mean, gdouble * std);
+
+/**
+ * @brief Calculate the mean and standard deviation of the tensor per channel (the first dim) in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param dim tensor dimension
+ * @param means array to store the mean value of each channel (dim[0] elements)
+ * @param stds array to store the standard deviation of each channel (dim[0] elements, nullable)
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_mean_std_per_channel (gpointer raw, gsize length,
+    tensor_type type, tensor_dim dim, gdouble * means, gdouble * stds);
+
 /**
  * @brief Calculate average value of the tensor.
  * @param raw pointer of raw tensor data
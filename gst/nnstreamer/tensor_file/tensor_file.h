@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-File
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    tensor_file.h
+ * @date    18 Oct 2021
+ * @brief   Container format of the tensor stream recorded by tensor_filesink
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *	The file is a sequence of chunks, written in the native byte order.
+ *	Each chunk starts at an offset aligned with the alignment in the file
+ *	header, so that the tensor payloads can be used directly from the
+ *	memory-mapped file.
+ *
+ *	HEADER | CAPS | DATA | DATA | ... | DATA | INDX | TAIL
+ *
+ *	- HEADER : tensor_file_header
+ *	- CAPS   : tensor_file_chunk + caps string (null-terminated)
+ *	- DATA   : tensor_file_chunk (pts, duration, the number of memories)
+ *	           + the size of each memory (guint64), then each memory
+ *	           (aligned) of a buffer.
+ *	- INDX   : tensor_file_chunk + tensor_file_index of each frame
+ *	- TAIL   : tensor_file_tail (end of file)
+ *
+ *	INDX and TAIL are written when the recording is finished. If they are
+ *	missing (e.g., the pipeline is killed), the index can be rebuilt by
+ *	walking the DATA chunks.
+ */
+
+#ifndef __GST_TENSOR_FILE_H__
+#define __GST_TENSOR_FILE_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define TENSOR_FILE_MAGIC GST_MAKE_FOURCC ('N', 'N', 'T', 'F')
+#define TENSOR_FILE_VERSION (1U)
+#define TENSOR_FILE_DEFAULT_ALIGNMENT (64U)
+
+#define TENSOR_FILE_CHUNK_CAPS GST_MAKE_FOURCC ('C', 'A', 'P', 'S')
+#define TENSOR_FILE_CHUNK_DATA GST_MAKE_FOURCC ('D', 'A', 'T', 'A')
+#define TENSOR_FILE_CHUNK_INDEX GST_MAKE_FOURCC ('I', 'N', 'D', 'X')
+#define TENSOR_FILE_CHUNK_TAIL GST_MAKE_FOURCC ('T', 'A', 'I', 'L')
+
+/**
+ * @brief Align the size (or offset) with the alignment of the file.
+ */
+#define TENSOR_FILE_ALIGN(size,align) \
+    ((((guint64) (size)) + (align) - 1) / (align) * (align))
+
+/**
+ * @brief File header. (at the beginning of the file)
+ */
+typedef struct
+{
+  guint32 magic; /**< TENSOR_FILE_MAGIC, also used to check the byte order */
+  guint32 version; /**< TENSOR_FILE_VERSION */
+  guint32 alignment; /**< alignment of the chunks and memories */
+  guint32 reserved;
+} tensor_file_header;
+
+/**
+ * @brief Chunk header.
+ */
+typedef struct
+{
+  guint32 id; /**< chunk id (TENSOR_FILE_CHUNK_*) */
+  guint32 num_mems; /**< DATA: the number of memories in a buffer */
+  guint64 size; /**< total size of the chunk, the next chunk starts at offset + size */
+  guint64 pts; /**< DATA: presentation timestamp of the buffer */
+  guint64 duration; /**< DATA: duration of the buffer */
+} tensor_file_chunk;
+
+/**
+ * @brief Index entry of a frame.
+ */
+typedef struct
+{
+  guint64 offset; /**< offset of the DATA chunk */
+  guint64 pts; /**< presentation timestamp of the buffer */
+  guint64 duration; /**< duration of the buffer */
+} tensor_file_index;
+
+/**
+ * @brief File tail. (at the end of the file)
+ */
+typedef struct
+{
+  guint32 id; /**< TENSOR_FILE_CHUNK_TAIL */
+  guint32 reserved;
+  guint64 index_offset; /**< offset of the INDX chunk */
+  guint64 num_frames; /**< the number of frames in the index */
+} tensor_file_tail;
+
+G_END_DECLS
+#endif /* __GST_TENSOR_FILE_H__ */
@@ -0,0 +1,461 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-File
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    tensor_filesink.c
+ * @date    18 Oct 2021
+ * @brief   GStreamer element to record the tensor stream in an indexed file
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:element-tensor_filesink
+ *
+ * tensor_filesink records the tensor stream in a chunked file (see tensor_file.h).
+ * The caps is written once, and the memories of each buffer are written as they are
+ * with the timestamp, aligned so that tensor_filesrc can replay them from the
+ * memory-mapped file without copying. The index of the frames is written at the
+ * end of the recording.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 videotestsrc num-buffers=100 ! video/x-raw,format=RGB,width=224,height=224 ! \
+ *     tensor_converter ! tensor_filesink location=/tmp/video.tensors
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <glib/gstdio.h>
+#include <tensor_typedef.h>
+
+#include "tensor_file.h"
+#include "tensor_filesink.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_filesink_debug);
+#define GST_CAT_DEFAULT gst_tensor_filesink_debug
+
+/**
+ * @brief tensor_filesink properties
+ */
+enum
+{
+  PROP_0,
+  PROP_LOCATION,
+  PROP_ALIGNMENT
+};
+
+#define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT "; " \
+    GST_TENSORS_FLEX_CAP_DEFAULT
+
+/**
+ * @brief The capabilities of the sink pad
+ */
+static GstStaticPadTemplate sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CAPS_STRING));
+
+static void gst_tensor_filesink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_filesink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_filesink_finalize (GObject * object);
+static gboolean gst_tensor_filesink_start (GstBaseSink * sink);
+static gboolean gst_tensor_filesink_stop (GstBaseSink * sink);
+static gboolean gst_tensor_filesink_set_caps (GstBaseSink * sink,
+    GstCaps * caps);
+static GstFlowReturn gst_tensor_filesink_render (GstBaseSink * sink,
+    GstBuffer * buffer);
+
+#define gst_tensor_filesink_parent_class parent_class
+G_DEFINE_TYPE (GstTensorFileSink, gst_tensor_filesink, GST_TYPE_BASE_SINK);
+
+/**
+ * @brief class initialization of tensor_filesink
+ */
+static void
+gst_tensor_filesink_class_init (GstTensorFileSinkClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstBaseSinkClass *basesink_class = GST_BASE_SINK_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_filesink_debug, "tensor_filesink", 0,
+      "Sink element to record the tensor stream in a file");
+
+  gobject_class->set_property = gst_tensor_filesink_set_property;
+  gobject_class->get_property = gst_tensor_filesink_get_property;
+  gobject_class->finalize = gst_tensor_filesink_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_LOCATION,
+      g_param_spec_string ("location", "File Location",
+          "Location of the file to record the tensor stream", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_ALIGNMENT,
+      g_param_spec_uint ("alignment", "Alignment",
+          "Alignment in bytes of the chunks and tensors in the file (power of 2)",
+          8, 65536, TENSOR_FILE_DEFAULT_ALIGNMENT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  basesink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_filesink_start);
+  basesink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_filesink_stop);
+  basesink_class->set_caps = GST_DEBUG_FUNCPTR (gst_tensor_filesink_set_caps);
+  basesink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_filesink_render);
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorFileSink",
+      "Sink/File/Tensor",
+      "Record the tensor stream in an indexed file",
+      "Samsung Electronics Co., Ltd.");
+
+  gst_element_class_add_static_pad_template (element_class, &sink_template);
+}
+
+/**
+ * @brief object initialization of tensor_filesink
+ */
+static void
+gst_tensor_filesink_init (GstTensorFileSink * self)
+{
+  self->location = NULL;
+  self->alignment = TENSOR_FILE_DEFAULT_ALIGNMENT;
+  self->file = NULL;
+  self->offset = 0;
+  self->caps_str = NULL;
+  self->index = g_array_new (FALSE, FALSE, sizeof (tensor_file_index));
+
+  /* record as fast as possible */
+  gst_base_sink_set_sync (GST_BASE_SINK (self), FALSE);
+}
+
+/**
+ * @brief finalize of tensor_filesink
+ */
+static void
+gst_tensor_filesink_finalize (GObject * object)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (object);
+
+  g_free (self->location);
+  g_free (self->caps_str);
+  g_array_free (self->index, TRUE);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief set property of tensor_filesink
+ */
+static void
+gst_tensor_filesink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      if (self->file) {
+        GST_WARNING_OBJECT (self, "Cannot change the location while recording.");
+        break;
+      }
+      g_free (self->location);
+      self->location = g_value_dup_string (value);
+      break;
+    case PROP_ALIGNMENT:
+    {
+      guint alignment = g_value_get_uint (value);
+
+      if (alignment & (alignment - 1)) {
+        GST_WARNING_OBJECT (self, "Invalid alignment %u, it should be power of 2.",
+            alignment);
+        break;
+      }
+      if (self->file) {
+        GST_WARNING_OBJECT (self,
+            "Cannot change the alignment while recording.");
+        break;
+      }
+      self->alignment = alignment;
+      break;
+    }
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief get property of tensor_filesink
+ */
+static void
+gst_tensor_filesink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      g_value_set_string (value, self->location);
+      break;
+    case PROP_ALIGNMENT:
+      g_value_set_uint (value, self->alignment);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Write the data to the file.
+ */
+static gboolean
+gst_tensor_filesink_write (GstTensorFileSink * self, gconstpointer data,
+    gsize size)
+{
+  if (size > 0 && fwrite (data, 1, size, self->file) != size) {
+    GST_ELEMENT_ERROR (self, RESOURCE, WRITE,
+        ("Failed to write to the file %s.", self->location), GST_ERROR_SYSTEM);
+    return FALSE;
+  }
+
+  self->offset += size;
+  return TRUE;
+}
+
+/**
+ * @brief Write zero-padding to align the current offset.
+ */
+static gboolean
+gst_tensor_filesink_write_padding (GstTensorFileSink * self)
+{
+  static const guint8 zeros[256] = { 0, };
+  guint64 padding;
+  gsize len;
+
+  padding = TENSOR_FILE_ALIGN (self->offset, self->alignment) - self->offset;
+
+  while (padding > 0) {
+    len = MIN (padding, sizeof (zeros));
+
+    if (!gst_tensor_filesink_write (self, zeros, len))
+      return FALSE;
+
+    padding -= len;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Write the chunk header and the payload (aligned).
+ */
+static gboolean
+gst_tensor_filesink_write_chunk (GstTensorFileSink * self, guint32 id,
+    gconstpointer data, gsize size)
+{
+  tensor_file_chunk chunk = { 0, };
+
+  chunk.id = id;
+  chunk.size = TENSOR_FILE_ALIGN (sizeof (chunk) + size, self->alignment);
+
+  return gst_tensor_filesink_write (self, &chunk, sizeof (chunk)) &&
+      gst_tensor_filesink_write (self, data, size) &&
+      gst_tensor_filesink_write_padding (self);
+}
+
+/**
+ * @brief start recording, open the file and write the file header.
+ */
+static gboolean
+gst_tensor_filesink_start (GstBaseSink * sink)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (sink);
+  tensor_file_header header = { 0, };
+
+  if (self->location == NULL || self->location[0] == '\0') {
+    GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND,
+        ("No file name specified for writing."), (NULL));
+    return FALSE;
+  }
+
+  self->file = g_fopen (self->location, "wb");
+  if (self->file == NULL) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_WRITE,
+        ("Could not open file \"%s\" for writing.", self->location),
+        GST_ERROR_SYSTEM);
+    return FALSE;
+  }
+
+  self->offset = 0;
+  g_array_set_size (self->index, 0);
+  g_free (self->caps_str);
+  self->caps_str = NULL;
+
+  header.magic = TENSOR_FILE_MAGIC;
+  header.version = TENSOR_FILE_VERSION;
+  header.alignment = self->alignment;
+
+  if (!gst_tensor_filesink_write (self, &header, sizeof (header)) ||
+      !gst_tensor_filesink_write_padding (self)) {
+    fclose (self->file);
+    self->file = NULL;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief stop recording, write the index and close the file.
+ */
+static gboolean
+gst_tensor_filesink_stop (GstBaseSink * sink)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (sink);
+  tensor_file_tail tail = { 0, };
+  gboolean ret = TRUE;
+
+  if (self->file == NULL)
+    return TRUE;
+
+  if (self->caps_str) {
+    tail.id = TENSOR_FILE_CHUNK_TAIL;
+    tail.index_offset = self->offset;
+    tail.num_frames = self->index->len;
+
+    ret = gst_tensor_filesink_write_chunk (self, TENSOR_FILE_CHUNK_INDEX,
+        self->index->data, self->index->len * sizeof (tensor_file_index)) &&
+        gst_tensor_filesink_write (self, &tail, sizeof (tail));
+  }
+
+  if (fclose (self->file) != 0) {
+    GST_ELEMENT_ERROR (self, RESOURCE, CLOSE,
+        ("Error closing file \"%s\".", self->location), GST_ERROR_SYSTEM);
+    ret = FALSE;
+  }
+
+  GST_INFO_OBJECT (self, "Recorded %u frames in %s.", self->index->len,
+      self->location);
+
+  self->file = NULL;
+  return ret;
+}
+
+/**
+ * @brief set caps of tensor_filesink, the caps is written once.
+ */
+static gboolean
+gst_tensor_filesink_set_caps (GstBaseSink * sink, GstCaps * caps)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (sink);
+  gchar *caps_str;
+
+  caps_str = gst_caps_to_string (caps);
+
+  if (self->caps_str) {
+    gboolean same = g_str_equal (self->caps_str, caps_str);
+
+    if (!same) {
+      GST_ELEMENT_ERROR (self, STREAM, FORMAT,
+          ("The caps is changed while recording, it is not supported."),
+          ("old %s, new %s", self->caps_str, caps_str));
+    }
+
+    g_free (caps_str);
+    return same;
+  }
+
+  if (self->file == NULL ||
+      !gst_tensor_filesink_write_chunk (self, TENSOR_FILE_CHUNK_CAPS, caps_str,
+          strlen (caps_str) + 1)) {
+    g_free (caps_str);
+    return FALSE;
+  }
+
+  self->caps_str = caps_str;
+  return TRUE;
+}
+
+/**
+ * @brief render function of tensor_filesink, write a DATA chunk.
+ */
+static GstFlowReturn
+gst_tensor_filesink_render (GstBaseSink * sink, GstBuffer * buffer)
+{
+  GstTensorFileSink *self = GST_TENSOR_FILESINK (sink);
+  tensor_file_chunk chunk = { 0, };
+  tensor_file_index entry;
+  guint64 sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i, num_mems;
+
+  if (self->caps_str == NULL) {
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION,
+        ("No caps is set before the data."), (NULL));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  num_mems = gst_buffer_n_memory (buffer);
+  if (num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT,
+        ("The number of memories %u exceeds the limit %d.", num_mems,
+            NNS_TENSOR_SIZE_LIMIT), (NULL));
+    return GST_FLOW_ERROR;
+  }
+
+  chunk.id = TENSOR_FILE_CHUNK_DATA;
+  chunk.num_mems = num_mems;
+  chunk.pts = GST_BUFFER_PTS (buffer);
+  chunk.duration = GST_BUFFER_DURATION (buffer);
+  chunk.size = TENSOR_FILE_ALIGN (sizeof (chunk) + num_mems * sizeof (guint64),
+      self->alignment);
+
+  for (i = 0; i < num_mems; i++) {
+    sizes[i] = gst_memory_get_sizes (gst_buffer_peek_memory (buffer, i), NULL,
+        NULL);
+    chunk.size += TENSOR_FILE_ALIGN (sizes[i], self->alignment);
+  }
+
+  entry.offset = self->offset;
+  entry.pts = chunk.pts;
+  entry.duration = chunk.duration;
+
+  if (!gst_tensor_filesink_write (self, &chunk, sizeof (chunk)) ||
+      !gst_tensor_filesink_write (self, sizes, num_mems * sizeof (guint64)) ||
+      !gst_tensor_filesink_write_padding (self))
+    return GST_FLOW_ERROR;
+
+  for (i = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      GST_ELEMENT_ERROR (self, RESOURCE, READ,
+          ("Failed to map the memory %u.", i), (NULL));
+      return GST_FLOW_ERROR;
+    }
+
+    if (!gst_tensor_filesink_write (self, map.data, map.size) ||
+        !gst_tensor_filesink_write_padding (self)) {
+      gst_memory_unmap (mem, &map);
+      return GST_FLOW_ERROR;
+    }
+
+    gst_memory_unmap (mem, &map);
+  }
+
+  g_array_append_val (self->index, entry);
+  return GST_FLOW_OK;
+}
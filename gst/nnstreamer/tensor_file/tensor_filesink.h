@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-File
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    tensor_filesink.h
+ * @date    18 Oct 2021
+ * @brief   GStreamer element to record the tensor stream in an indexed file
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_FILESINK_H__
+#define __GST_TENSOR_FILESINK_H__
+
+#include <stdio.h>
+#include <gst/gst.h>
+#include <gst/base/gstbasesink.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_FILESINK \
+  (gst_tensor_filesink_get_type())
+#define GST_TENSOR_FILESINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_FILESINK,GstTensorFileSink))
+#define GST_TENSOR_FILESINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_FILESINK,GstTensorFileSinkClass))
+#define GST_IS_TENSOR_FILESINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_FILESINK))
+#define GST_IS_TENSOR_FILESINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_FILESINK))
+
+typedef struct _GstTensorFileSink GstTensorFileSink;
+typedef struct _GstTensorFileSinkClass GstTensorFileSinkClass;
+
+/**
+ * @brief GstTensorFileSink data structure.
+ *
+ * GstTensorFileSink inherits GstBaseSink.
+ */
+struct _GstTensorFileSink
+{
+  GstBaseSink element; /**< parent object */
+
+  gchar *location; /**< file path to record the stream */
+  guint alignment; /**< alignment of the chunks and memories */
+
+  FILE *file; /**< opened file */
+  guint64 offset; /**< current offset of the file */
+  gchar *caps_str; /**< caps written in the file */
+  GArray *index; /**< index of the recorded frames (tensor_file_index) */
+};
+
+/**
+ * @brief GstTensorFileSinkClass data structure.
+ *
+ * GstTensorFileSink inherits GstBaseSink.
+ */
+struct _GstTensorFileSinkClass
+{
+  GstBaseSinkClass parent_class; /**< parent class */
+};
+
+/**
+ * @brief Function to get type of tensor_filesink.
+ */
+GType gst_tensor_filesink_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_FILESINK_H__ */
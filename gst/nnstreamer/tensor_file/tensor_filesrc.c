@@ -0,0 +1,610 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-File
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    tensor_filesrc.c
+ * @date    18 Oct 2021
+ * @brief   GStreamer element to replay the tensor stream recorded by tensor_filesink
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:element-tensor_filesrc
+ *
+ * tensor_filesrc replays the tensor stream recorded by tensor_filesink.
+ * The file is memory-mapped, and the memories of the output buffers point to
+ * the tensors in the file without copying. The buffers are pushed as fast as
+ * downstream consumes them (not live), with the recorded timestamps.
+ * It supports seeking in time with the index of the frames. If the index is
+ * missing (e.g., the recording is not finished), it is rebuilt from the data chunks.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 tensor_filesrc location=/tmp/video.tensors ! \
+ *     tensor_filter framework=tensorflow-lite model=model.tflite latency=1 ! fakesink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <tensor_typedef.h>
+
+#include "tensor_file.h"
+#include "tensor_filesrc.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_filesrc_debug);
+#define GST_CAT_DEFAULT gst_tensor_filesrc_debug
+
+/**
+ * @brief tensor_filesrc properties
+ */
+enum
+{
+  PROP_0,
+  PROP_LOCATION
+};
+
+#define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT "; " \
+    GST_TENSORS_FLEX_CAP_DEFAULT
+
+/**
+ * @brief The capabilities of the src pad
+ */
+static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CAPS_STRING));
+
+static void gst_tensor_filesrc_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_filesrc_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_filesrc_finalize (GObject * object);
+static gboolean gst_tensor_filesrc_start (GstBaseSrc * src);
+static gboolean gst_tensor_filesrc_stop (GstBaseSrc * src);
+static GstCaps *gst_tensor_filesrc_get_caps (GstBaseSrc * src,
+    GstCaps * filter);
+static gboolean gst_tensor_filesrc_is_seekable (GstBaseSrc * src);
+static gboolean gst_tensor_filesrc_do_seek (GstBaseSrc * src,
+    GstSegment * segment);
+static gboolean gst_tensor_filesrc_query (GstBaseSrc * src, GstQuery * query);
+static GstFlowReturn gst_tensor_filesrc_create (GstBaseSrc * src,
+    guint64 offset, guint size, GstBuffer ** buf);
+
+#define gst_tensor_filesrc_parent_class parent_class
+G_DEFINE_TYPE (GstTensorFileSrc, gst_tensor_filesrc, GST_TYPE_BASE_SRC);
+
+/**
+ * @brief class initialization of tensor_filesrc
+ */
+static void
+gst_tensor_filesrc_class_init (GstTensorFileSrcClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstBaseSrcClass *basesrc_class = GST_BASE_SRC_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_filesrc_debug, "tensor_filesrc", 0,
+      "Source element to replay the tensor stream from a file");
+
+  gobject_class->set_property = gst_tensor_filesrc_set_property;
+  gobject_class->get_property = gst_tensor_filesrc_get_property;
+  gobject_class->finalize = gst_tensor_filesrc_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_LOCATION,
+      g_param_spec_string ("location", "File Location",
+          "Location of the file recorded by tensor_filesink", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  basesrc_class->start = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_start);
+  basesrc_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_stop);
+  basesrc_class->get_caps = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_get_caps);
+  basesrc_class->is_seekable =
+      GST_DEBUG_FUNCPTR (gst_tensor_filesrc_is_seekable);
+  basesrc_class->do_seek = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_do_seek);
+  basesrc_class->query = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_query);
+  basesrc_class->create = GST_DEBUG_FUNCPTR (gst_tensor_filesrc_create);
+
+  gst_element_class_set_static_metadata (element_class,
+      "TensorFileSrc",
+      "Source/File/Tensor",
+      "Replay the tensor stream recorded by tensor_filesink",
+      "Samsung Electronics Co., Ltd.");
+
+  gst_element_class_add_static_pad_template (element_class, &src_template);
+}
+
+/**
+ * @brief object initialization of tensor_filesrc
+ */
+static void
+gst_tensor_filesrc_init (GstTensorFileSrc * self)
+{
+  self->location = NULL;
+  self->mapped = NULL;
+  self->data = NULL;
+  self->size = 0;
+  self->alignment = TENSOR_FILE_DEFAULT_ALIGNMENT;
+  self->caps = NULL;
+  self->index = g_array_new (FALSE, FALSE, sizeof (tensor_file_index));
+  self->current = 0;
+
+  gst_base_src_set_format (GST_BASE_SRC (self), GST_FORMAT_TIME);
+}
+
+/**
+ * @brief finalize of tensor_filesrc
+ */
+static void
+gst_tensor_filesrc_finalize (GObject * object)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (object);
+
+  g_free (self->location);
+  if (self->caps)
+    gst_caps_unref (self->caps);
+  if (self->mapped)
+    g_mapped_file_unref (self->mapped);
+  g_array_free (self->index, TRUE);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief set property of tensor_filesrc
+ */
+static void
+gst_tensor_filesrc_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      if (self->mapped) {
+        GST_WARNING_OBJECT (self, "Cannot change the location while playing.");
+        break;
+      }
+      g_free (self->location);
+      self->location = g_value_dup_string (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief get property of tensor_filesrc
+ */
+static void
+gst_tensor_filesrc_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      g_value_set_string (value, self->location);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Read the chunk header at the offset.
+ * @return TRUE if the chunk is in the range of the file.
+ */
+static gboolean
+gst_tensor_filesrc_read_chunk (GstTensorFileSrc * self, guint64 offset,
+    guint64 limit, tensor_file_chunk * chunk)
+{
+  if (offset > limit || limit - offset < sizeof (tensor_file_chunk))
+    return FALSE;
+
+  memcpy (chunk, self->data + offset, sizeof (tensor_file_chunk));
+
+  return (chunk->size >= sizeof (tensor_file_chunk) &&
+      chunk->size <= limit - offset);
+}
+
+/**
+ * @brief Load the index from the tail of the file.
+ * @return TRUE if the file has a valid index.
+ */
+static gboolean
+gst_tensor_filesrc_load_index (GstTensorFileSrc * self, guint64 data_offset)
+{
+  tensor_file_tail tail;
+  tensor_file_chunk chunk;
+  const tensor_file_index *entries;
+  guint64 i, limit;
+
+  if (self->size < data_offset + sizeof (tail))
+    return FALSE;
+
+  limit = self->size - sizeof (tail);
+  memcpy (&tail, self->data + limit, sizeof (tail));
+
+  if (tail.id != TENSOR_FILE_CHUNK_TAIL || tail.index_offset < data_offset ||
+      !gst_tensor_filesrc_read_chunk (self, tail.index_offset, limit, &chunk) ||
+      chunk.id != TENSOR_FILE_CHUNK_INDEX)
+    return FALSE;
+
+  if (tail.num_frames > (chunk.size - sizeof (chunk)) / sizeof (*entries))
+    return FALSE;
+
+  entries = (const tensor_file_index *) (self->data + tail.index_offset +
+      sizeof (chunk));
+
+  for (i = 0; i < tail.num_frames; i++) {
+    if (entries[i].offset < data_offset ||
+        entries[i].offset >= tail.index_offset)
+      return FALSE;
+  }
+
+  g_array_append_vals (self->index, entries, tail.num_frames);
+  return TRUE;
+}
+
+/**
+ * @brief Rebuild the index by walking the data chunks.
+ */
+static void
+gst_tensor_filesrc_rebuild_index (GstTensorFileSrc * self,
+    guint64 data_offset)
+{
+  tensor_file_chunk chunk;
+  tensor_file_index entry;
+  guint64 offset = data_offset;
+
+  while (gst_tensor_filesrc_read_chunk (self, offset, self->size, &chunk) &&
+      chunk.id == TENSOR_FILE_CHUNK_DATA) {
+    entry.offset = offset;
+    entry.pts = chunk.pts;
+    entry.duration = chunk.duration;
+    g_array_append_val (self->index, entry);
+
+    offset += chunk.size;
+  }
+
+  GST_WARNING_OBJECT (self,
+      "The index is not found in %s (unfinished recording?), rebuilt %u frames.",
+      self->location, self->index->len);
+}
+
+/**
+ * @brief Parse the header, caps and index of the file.
+ */
+static gboolean
+gst_tensor_filesrc_parse (GstTensorFileSrc * self)
+{
+  tensor_file_header header;
+  tensor_file_chunk chunk;
+  const gchar *caps_str;
+  gsize caps_len;
+  guint64 offset;
+
+  if (self->size < sizeof (header))
+    goto invalid_file;
+
+  memcpy (&header, self->data, sizeof (header));
+
+  if (header.magic == GUINT32_SWAP_LE_BE (TENSOR_FILE_MAGIC)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT,
+        ("The file %s is recorded in different byte order.", self->location),
+        (NULL));
+    return FALSE;
+  }
+
+  if (header.magic != TENSOR_FILE_MAGIC)
+    goto invalid_file;
+
+  if (header.version != TENSOR_FILE_VERSION || header.alignment < 8 ||
+      (header.alignment & (header.alignment - 1))) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT,
+        ("The file %s is not supported (version %u, alignment %u).",
+            self->location, header.version, header.alignment), (NULL));
+    return FALSE;
+  }
+
+  self->alignment = header.alignment;
+
+  /* caps chunk */
+  offset = TENSOR_FILE_ALIGN (sizeof (header), self->alignment);
+  if (!gst_tensor_filesrc_read_chunk (self, offset, self->size, &chunk) ||
+      chunk.id != TENSOR_FILE_CHUNK_CAPS)
+    goto invalid_file;
+
+  caps_str = (const gchar *) (self->data + offset + sizeof (chunk));
+  caps_len = chunk.size - sizeof (chunk);
+  if (memchr (caps_str, '\0', caps_len) == NULL)
+    goto invalid_file;
+
+  self->caps = gst_caps_from_string (caps_str);
+  if (self->caps == NULL || !gst_caps_is_fixed (self->caps)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT,
+        ("Invalid caps %s in the file %s.", caps_str, self->location), (NULL));
+    return FALSE;
+  }
+
+  /* index of the frames */
+  offset += chunk.size;
+  if (!gst_tensor_filesrc_load_index (self, offset))
+    gst_tensor_filesrc_rebuild_index (self, offset);
+
+  GST_INFO_OBJECT (self, "Opened %s, caps %" GST_PTR_FORMAT ", %u frames.",
+      self->location, self->caps, self->index->len);
+  return TRUE;
+
+invalid_file:
+  GST_ELEMENT_ERROR (self, STREAM, WRONG_TYPE,
+      ("The file %s is not a tensor file.", self->location), (NULL));
+  return FALSE;
+}
+
+/**
+ * @brief start tensor_filesrc, map the file and load the index.
+ */
+static gboolean
+gst_tensor_filesrc_start (GstBaseSrc * src)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+  GError *error = NULL;
+
+  if (self->location == NULL || self->location[0] == '\0') {
+    GST_ELEMENT_ERROR (self, RESOURCE, NOT_FOUND,
+        ("No file name specified for reading."), (NULL));
+    return FALSE;
+  }
+
+  self->mapped = g_mapped_file_new (self->location, FALSE, &error);
+  if (self->mapped == NULL) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ,
+        ("Could not open file \"%s\" for reading.", self->location),
+        ("%s", error ? error->message : "unknown"));
+    g_clear_error (&error);
+    return FALSE;
+  }
+
+  self->data = (const guint8 *) g_mapped_file_get_contents (self->mapped);
+  self->size = g_mapped_file_get_length (self->mapped);
+  self->current = 0;
+  g_array_set_size (self->index, 0);
+
+  if (!gst_tensor_filesrc_parse (self)) {
+    gst_tensor_filesrc_stop (src);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief stop tensor_filesrc, the output memories keep the mapped file until released.
+ */
+static gboolean
+gst_tensor_filesrc_stop (GstBaseSrc * src)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+
+  if (self->mapped) {
+    g_mapped_file_unref (self->mapped);
+    self->mapped = NULL;
+  }
+
+  if (self->caps) {
+    gst_caps_unref (self->caps);
+    self->caps = NULL;
+  }
+
+  self->data = NULL;
+  self->size = 0;
+  g_array_set_size (self->index, 0);
+  return TRUE;
+}
+
+/**
+ * @brief get caps of tensor_filesrc, the caps recorded in the file.
+ */
+static GstCaps *
+gst_tensor_filesrc_get_caps (GstBaseSrc * src, GstCaps * filter)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+  GstCaps *caps, *result;
+
+  if (self->caps)
+    caps = gst_caps_ref (self->caps);
+  else
+    caps = gst_pad_get_pad_template_caps (GST_BASE_SRC_PAD (src));
+
+  if (filter) {
+    result = gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+    gst_caps_unref (caps);
+  } else {
+    result = caps;
+  }
+
+  return result;
+}
+
+/**
+ * @brief tensor_filesrc supports random access with the index.
+ */
+static gboolean
+gst_tensor_filesrc_is_seekable (GstBaseSrc * src)
+{
+  return TRUE;
+}
+
+/**
+ * @brief Find the first frame of which timestamp is not less than the given time.
+ */
+static guint64
+gst_tensor_filesrc_find_frame (GstTensorFileSrc * self, GstClockTime time)
+{
+  const tensor_file_index *entries;
+  guint64 low, high, mid;
+
+  entries = (const tensor_file_index *) self->index->data;
+  low = 0;
+  high = self->index->len;
+
+  if (high == 0 || !GST_CLOCK_TIME_IS_VALID (entries[0].pts))
+    return 0;
+
+  /* the timestamps are increasing in the recorded stream */
+  while (low < high) {
+    mid = low + (high - low) / 2;
+
+    if (entries[mid].pts < time)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+/**
+ * @brief seek to the frame with the segment.
+ */
+static gboolean
+gst_tensor_filesrc_do_seek (GstBaseSrc * src, GstSegment * segment)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+
+  if (segment->format != GST_FORMAT_TIME || segment->rate < 0.0) {
+    GST_WARNING_OBJECT (self, "Only forward seek in time is supported.");
+    return FALSE;
+  }
+
+  self->current = gst_tensor_filesrc_find_frame (self, segment->start);
+  segment->position = segment->start;
+
+  GST_DEBUG_OBJECT (self, "Seek to %" GST_TIME_FORMAT ", frame %"
+      G_GUINT64_FORMAT, GST_TIME_ARGS (segment->start), self->current);
+  return TRUE;
+}
+
+/**
+ * @brief query function of tensor_filesrc, get the duration from the index.
+ */
+static gboolean
+gst_tensor_filesrc_query (GstBaseSrc * src, GstQuery * query)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+
+  if (GST_QUERY_TYPE (query) == GST_QUERY_DURATION && self->index->len > 0) {
+    const tensor_file_index *first, *last;
+    GstFormat format;
+
+    gst_query_parse_duration (query, &format, NULL);
+
+    if (format == GST_FORMAT_DEFAULT) {
+      gst_query_set_duration (query, format, self->index->len);
+      return TRUE;
+    }
+
+    first = &g_array_index (self->index, tensor_file_index, 0);
+    last = &g_array_index (self->index, tensor_file_index,
+        self->index->len - 1);
+
+    if (format == GST_FORMAT_TIME && GST_CLOCK_TIME_IS_VALID (first->pts) &&
+        GST_CLOCK_TIME_IS_VALID (last->pts)) {
+      GstClockTime duration = last->pts - first->pts;
+
+      if (GST_CLOCK_TIME_IS_VALID (last->duration))
+        duration += last->duration;
+
+      gst_query_set_duration (query, format, duration);
+      return TRUE;
+    }
+  }
+
+  return GST_BASE_SRC_CLASS (parent_class)->query (src, query);
+}
+
+/**
+ * @brief create function of tensor_filesrc, wrap the tensors in the mapped file.
+ */
+static GstFlowReturn
+gst_tensor_filesrc_create (GstBaseSrc * src, guint64 offset, guint size,
+    GstBuffer ** buf)
+{
+  GstTensorFileSrc *self = GST_TENSOR_FILESRC (src);
+  const tensor_file_index *entry;
+  tensor_file_chunk chunk;
+  guint64 sizes[NNS_TENSOR_SIZE_LIMIT];
+  guint64 pos, end;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  guint i;
+
+  if (self->current >= self->index->len)
+    return GST_FLOW_EOS;
+
+  entry = &g_array_index (self->index, tensor_file_index, self->current);
+
+  if (GST_CLOCK_TIME_IS_VALID (src->segment.stop) &&
+      GST_CLOCK_TIME_IS_VALID (entry->pts) && entry->pts >= src->segment.stop)
+    return GST_FLOW_EOS;
+
+  if (!gst_tensor_filesrc_read_chunk (self, entry->offset, self->size, &chunk)
+      || chunk.id != TENSOR_FILE_CHUNK_DATA
+      || chunk.num_mems > NNS_TENSOR_SIZE_LIMIT
+      || chunk.size < sizeof (chunk) + chunk.num_mems * sizeof (guint64))
+    goto invalid_chunk;
+
+  memcpy (sizes, self->data + entry->offset + sizeof (chunk),
+      chunk.num_mems * sizeof (guint64));
+
+  pos = TENSOR_FILE_ALIGN (entry->offset + sizeof (chunk) +
+      chunk.num_mems * sizeof (guint64), self->alignment);
+  end = entry->offset + chunk.size;
+
+  buffer = gst_buffer_new ();
+
+  for (i = 0; i < chunk.num_mems; i++) {
+    if (pos > end || sizes[i] > end - pos) {
+      gst_buffer_unref (buffer);
+      goto invalid_chunk;
+    }
+
+    /* zero-copy, the memory keeps the mapped file */
+    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+        (gpointer) (self->data + pos), sizes[i], 0, sizes[i],
+        g_mapped_file_ref (self->mapped),
+        (GDestroyNotify) g_mapped_file_unref);
+    gst_buffer_append_memory (buffer, mem);
+
+    pos += TENSOR_FILE_ALIGN (sizes[i], self->alignment);
+  }
+
+  GST_BUFFER_PTS (buffer) = chunk.pts;
+  GST_BUFFER_DURATION (buffer) = chunk.duration;
+  GST_BUFFER_OFFSET (buffer) = self->current;
+  GST_BUFFER_OFFSET_END (buffer) = self->current + 1;
+
+  self->current++;
+
+  *buf = buffer;
+  return GST_FLOW_OK;
+
+invalid_chunk:
+  GST_ELEMENT_ERROR (self, STREAM, DECODE,
+      ("Invalid data chunk of frame %" G_GUINT64_FORMAT " in %s.",
+          self->current, self->location), (NULL));
+  return GST_FLOW_ERROR;
+}
@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-File
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    tensor_filesrc.h
+ * @date    18 Oct 2021
+ * @brief   GStreamer element to replay the tensor stream recorded by tensor_filesink
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_FILESRC_H__
+#define __GST_TENSOR_FILESRC_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbasesrc.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_FILESRC \
+  (gst_tensor_filesrc_get_type())
+#define GST_TENSOR_FILESRC(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_FILESRC,GstTensorFileSrc))
+#define GST_TENSOR_FILESRC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_FILESRC,GstTensorFileSrcClass))
+#define GST_IS_TENSOR_FILESRC(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_FILESRC))
+#define GST_IS_TENSOR_FILESRC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_FILESRC))
+
+typedef struct _GstTensorFileSrc GstTensorFileSrc;
+typedef struct _GstTensorFileSrcClass GstTensorFileSrcClass;
+
+/**
+ * @brief GstTensorFileSrc data structure.
+ *
+ * GstTensorFileSrc inherits GstBaseSrc.
+ */
+struct _GstTensorFileSrc
+{
+  GstBaseSrc element; /**< parent object */
+
+  gchar *location; /**< file path to replay */
+
+  GMappedFile *mapped; /**< memory-mapped file, shared with the output memories */
+  const guint8 *data; /**< the contents of the file */
+  gsize size; /**< the size of the file */
+  guint alignment; /**< alignment of the chunks and memories */
+  GstCaps *caps; /**< caps recorded in the file */
+  GArray *index; /**< index of the frames (tensor_file_index) */
+  guint64 current; /**< index of the next frame */
+};
+
+/**
+ * @brief GstTensorFileSrcClass data structure.
+ *
+ * GstTensorFileSrc inherits GstBaseSrc.
+ */
+struct _GstTensorFileSrcClass
+{
+  GstBaseSrcClass parent_class; /**< parent class */
+};
+
+/**
+ * @brief Function to get type of tensor_filesrc.
+ */
+GType gst_tensor_filesrc_get_type (void);
+
+G_END_DECLS
+
+#endif /* __GST_TENSOR_FILESRC_H__ */
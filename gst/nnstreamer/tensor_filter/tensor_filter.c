@@ -61,6 +61,15 @@
  * with more tight QoS requirement. Lastly, 'tensor_filter' also sends QoS events to
  * upstream elements (e.g., tensor_converter, tensor_src) to possibly reduce incoming
  * framerates, which is a better solution than dropping framerates.
+ * The producers (tensor_converter, tensor_src_iio, mqttsrc) skip the frames
+ * before the timestamp given by the QoS event, before converting them.
+ * With 'adaptive-rate', 'tensor_filter' throttles with the measured invoke latency
+ * even without 'tensor_rate', e.g., to follow a live source faster than the model.
+ *
+ * For monitoring, 'latency-stats' gives p50, p90 and p99 of the invoke latency over
+ * the recent 256 inferences and the average latency of each stage (map, invoke,
+ * unmap and wrap). With 'latency-report', the same statistics are posted as an
+ * element message "tensor-filter-latency" periodically.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -239,6 +248,9 @@ gst_tensor_filter_init (GstTensorFilter * self)
   priv = &self->priv;
 
   gst_tensor_filter_common_init_property (priv);
+
+  /* load the new model in background when the model is updated */
+  priv->reload_async = TRUE;
 }
 
 /**
@@ -362,19 +374,53 @@ gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
 static void
 prepare_statistics (GstTensorFilterPrivate * priv)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
+  priv->stat.latest_stage_time = g_get_monotonic_time ();
+  memset (priv->stat.stage, 0, sizeof (priv->stat.stage));
+}
+
+/**
+ * @brief Measure the latency of a stage, the next stage begins now.
+ */
+static void
+record_stage_latency (GstTensorFilterPrivate * priv,
+    GstTensorFilterStatStage stage)
+{
+  gint64 now = g_get_monotonic_time ();
+
+  priv->stat.stage[stage] = now - priv->stat.latest_stage_time;
+  priv->stat.latest_stage_time = now;
+
+  if (stage == GST_TF_STAT_STAGE_MAP)
+    priv->stat.latest_invoke_time = now;
 }
 
 /**
- * @brief Helper function to accumulate latencies
+ * @brief Post the latency statistics if the report interval is elapsed.
  */
 static void
-accumulate_latency (void *data, void *user_data)
+report_statistics (GstTensorFilter * self)
 {
-  gint64 *latency = data;
-  gint64 *total_latency = user_data;
+  GstTensorFilterPrivate *priv = &self->priv;
+  gint64 now = priv->stat.latest_stage_time;
+  GstStructure *s;
+
+  if (priv->latency_report == 0)
+    return;
+
+  if (priv->stat.latest_report_time == 0) {
+    priv->stat.latest_report_time = now;
+    return;
+  }
 
-  *total_latency += *latency;
+  if (now - priv->stat.latest_report_time <
+      (gint64) priv->latency_report * 1000)
+    return;
+
+  priv->stat.latest_report_time = now;
+
+  s = gst_tensor_filter_common_get_latency_stats (priv);
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
 }
 
 #define THRESHOLD_DROP_OLD  (2000)
@@ -384,37 +430,46 @@ accumulate_latency (void *data, void *user_data)
  * @brief Record statistics for performance profiling (e.g, latency, throughput)
  */
 static void
-record_statistics (GstTensorFilterPrivate * priv)
+record_statistics (GstTensorFilter * self)
 {
-  gint64 end_time = g_get_real_time ();
-  gint64 *latency = g_new (gint64, 1);
-  GQueue *recent_latencies = priv->stat.recent_latencies;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterStatistics *stat = &priv->stat;
+  gint64 latency = stat->stage[GST_TF_STAT_STAGE_INVOKE];
+  guint count;
 
-  *latency = end_time - priv->stat.latest_invoke_time;
-  priv->stat.total_invoke_latency += *latency;
+  priv->stat.total_invoke_latency += latency;
   priv->stat.total_invoke_num += 1;
 
-  if (g_queue_get_length (recent_latencies) == GST_TF_STAT_MAX_RECENT)
-    g_free (g_queue_pop_head (recent_latencies));
-  g_queue_push_tail (recent_latencies, latency);
+  /* update the running sum of the recent latencies */
+  if (stat->recent_num == GST_TF_STAT_MAX_RECENT)
+    stat->recent_sum -= stat->recent_latencies[stat->recent_idx];
+  else
+    stat->recent_num++;
 
-  /* the queue should have at least one element */
-  g_assert (g_queue_get_length (recent_latencies) != 0);
+  stat->recent_latencies[stat->recent_idx] = latency;
+  stat->recent_sum += latency;
+  stat->recent_idx = (stat->recent_idx + 1) % GST_TF_STAT_MAX_RECENT;
 
-  if (priv->latency_mode > 0) {
-    gint64 avg_latency = 0;
+  /* write the stage latencies, then publish it */
+  count = (guint) g_atomic_int_get ((gint *) & stat->window_count);
+  memcpy (stat->window[count % GST_TF_STAT_MAX_WINDOW], stat->stage,
+      sizeof (stat->stage));
+  g_atomic_int_inc ((gint *) & stat->window_count);
 
-    g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
-    avg_latency /= g_queue_get_length (recent_latencies);
+  /* the average latency is the throttling delay with adaptive rate */
+  if (priv->latency_mode > 0 || priv->adaptive_rate) {
+    gint64 avg_latency = stat->recent_sum / stat->recent_num;
 
     /* check integer overflow */
     if (avg_latency <= INT32_MAX)
       priv->prop.latency = (gint) avg_latency;
     else
       priv->prop.latency = -1;
+  }
 
+  if (priv->latency_mode > 0) {
     ml_logi ("[%s] Invoke took %.3f ms", priv->prop.model_files[0],
-        (*latency) / 1000.0);
+        latency / 1000.0);
   }
 
   if (priv->throughput_mode > 0) {
@@ -455,6 +510,8 @@ record_statistics (GstTensorFilterPrivate * priv)
       priv->stat.old_total_invoke_num = priv->stat.total_invoke_num;
     }
   }
+
+  report_statistics (self);
 }
 
 /**
@@ -472,7 +529,7 @@ gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
 
   GST_OBJECT_LOCK (trans);
 
-  if (priv->throttling_delay != 0) {
+  if (priv->throttling_delay != 0 || priv->adaptive_rate) {
     GstClockTime curr_ts = GST_BUFFER_PTS (inbuf);
     GstClockTime prev_ts = priv->prev_ts;
 
@@ -613,6 +670,15 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   if (retval != GST_FLOW_OK)
     return retval;
 
+  /* swap the model at the buffer boundary if the new model is ready */
+  if (priv->is_updatable) {
+    GstStructure *s = gst_tensor_filter_common_reload_swap (priv);
+
+    if (s)
+      gst_element_post_message (GST_ELEMENT_CAST (self),
+          gst_message_new_element (GST_OBJECT_CAST (self), s));
+  }
+
   allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
 
   in_flexible =
@@ -620,6 +686,11 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   out_flexible =
       gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
 
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_report > 0 || priv->adaptive_rate);
+  if (need_profiling)
+    prepare_statistics (priv);
+
   /* 1. Get all input tensors from inbuf. */
   /* Internal Logic Error or GST Bug (sinkcap changed!) */
   num_mems = gst_buffer_n_memory (inbuf);
@@ -697,8 +768,13 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
 
     /* allocate memory if allocate_in_invoke is FALSE */
     if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
+      /* reserve the prefix for header if output is static */
+      if (out_flexible)
+        out_mem[i] =
+            gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
+      else
+        out_mem[i] = gst_tensor_alloc_memory (out_tensors[i].size);
+
       if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
         ml_logf ("Cannot map output memory buffer(%d)\n", i);
         goto mem_map_error;
@@ -712,14 +788,13 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
-  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0);
   if (need_profiling)
-    prepare_statistics (priv);
+    record_stage_latency (priv, GST_TF_STAT_STAGE_MAP);
 
   /* 3. Call the filter-subplugin callback, "invoke" */
   GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
   if (need_profiling)
-    record_statistics (priv);
+    record_stage_latency (priv, GST_TF_STAT_STAGE_INVOKE);
 
   /* 4. Free map info and handle error case */
   for (i = 0; i < num_mems; i++)
@@ -733,6 +808,14 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
+  if (need_profiling) {
+    record_stage_latency (priv, GST_TF_STAT_STAGE_UNMAP);
+
+    /* no output to wrap, record it now */
+    if (ret != 0)
+      record_statistics (self);
+  }
+
   /** @todo define enum to indicate status code */
   if (ret < 0) {
     ml_loge ("Tensor-filter invoke failed (error code = %d).\n", ret);
@@ -803,6 +886,11 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     gst_buffer_append_memory (outbuf, out_mem[i]);
   }
 
+  if (need_profiling) {
+    record_stage_latency (priv, GST_TF_STAT_STAGE_WRAP);
+    record_statistics (self);
+  }
+
   return GST_FLOW_OK;
 mem_map_error:
   num_mems = gst_buffer_n_memory (inbuf);
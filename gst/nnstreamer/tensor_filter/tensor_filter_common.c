@@ -23,6 +23,7 @@
  *
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <hw_accel.h>
@@ -90,6 +91,7 @@ static gint _gtfc_setprop_IS_UPDATABLE (GstTensorFilterPrivate * priv,
     GstTensorFilterProperties * prop, const GValue * value);
 static gint _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
     GstTensorFilterProperties * prop, const GValue * value);
+static void _gtfc_reload_cancel (GstTensorFilterPrivate * priv);
 
 /**
  * @brief GstTensorFilter properties.
@@ -119,6 +121,9 @@ enum
   PROP_INPUTCOMBINATION,
   PROP_OUTPUTCOMBINATION,
   PROP_SHARED_TENSOR_FILTER_KEY,
+  PROP_ADAPTIVE_RATE,
+  PROP_LATENCY_REPORT,
+  PROP_LATENCY_STATS,
 };
 
 /**
@@ -577,7 +582,15 @@ gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
   stat->old_total_invoke_num = 0;
   stat->old_total_invoke_latency = 0;
   stat->latest_invoke_time = 0;
-  stat->recent_latencies = g_queue_new ();
+  stat->latest_stage_time = 0;
+  stat->latest_report_time = 0;
+  memset (stat->recent_latencies, 0, sizeof (stat->recent_latencies));
+  stat->recent_sum = 0;
+  stat->recent_idx = 0;
+  stat->recent_num = 0;
+  memset (stat->stage, 0, sizeof (stat->stage));
+  memset (stat->window, 0, sizeof (stat->window));
+  stat->window_count = 0;
 }
 
 /**
@@ -975,6 +988,27 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
           "to declare and share such instances. "
           "If it is NULL, it means the model representations is not shared.",
           NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ADAPTIVE_RATE,
+      g_param_spec_boolean ("adaptive-rate", "Adaptive rate",
+          "Drop the incoming frames faster than the average invoke latency, "
+          "and send QoS events so that upstream elements (e.g., tensor_converter) "
+          "skip them. This turns on the latency profiling. "
+          "The default value is given by adaptive_rate in [filter] of the "
+          "nnstreamer configuration.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_REPORT,
+      g_param_spec_uint ("latency-report", "Latency report interval",
+          "Post an element message \"tensor-filter-latency\" with the "
+          "latency statistics (see latency-stats) periodically, in milliseconds. "
+          "This turns on the performance profiling. 0 means no report.",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_STATS,
+      g_param_spec_boxed ("latency-stats", "Latency statistics",
+          "The statistics of the recent inferences in microseconds: "
+          "p50, p90 and p99 of the invoke latency and the average latency "
+          "of each stage (map, invoke, unmap and wrap). "
+          "This is available if the performance profiling is on.",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -1003,10 +1037,21 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
   gst_tensors_config_init (&priv->out_config);
   priv->prop.shared_tensor_filter_key = NULL;
 
+  priv->latency_report = 0;
+
+  /* init double-buffered model reload */
+  priv->reload_async = FALSE;
+  memset (&priv->reload, 0, sizeof (GstTensorFilterReload));
+  g_mutex_init (&priv->reload.lock);
+  g_cond_init (&priv->reload.cond);
+  priv->reload.state = GST_TF_RELOAD_NONE;
+
   /* init qos properties */
   priv->prev_ts = GST_CLOCK_TIME_NONE;
   priv->throttling_delay = 0;
   priv->throttling_accum = 0;
+  priv->adaptive_rate =
+      nnsconf_get_custom_value_bool ("filter", "adaptive_rate", FALSE);
 }
 
 /**
@@ -1019,6 +1064,10 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
 
   prop = &priv->prop;
 
+  _gtfc_reload_cancel (priv);
+  g_mutex_clear (&priv->reload.lock);
+  g_cond_clear (&priv->reload.cond);
+
   g_free_const (prop->fwname);
   g_free_const (prop->accl_str);
   g_free (prop->hw_list);
@@ -1036,14 +1085,6 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   g_list_free (priv->combi.in_combi);
   g_list_free (priv->combi.out_combi_i);
   g_list_free (priv->combi.out_combi_o);
-
-  if (priv->stat.recent_latencies != NULL) {
-    GQueue *queue = priv->stat.recent_latencies;
-    gint64 *latency;
-    while ((latency = g_queue_pop_tail (queue)) != NULL)
-      g_free (latency);
-    g_queue_free (queue);
-  }
 }
 
 /**
@@ -1359,6 +1400,311 @@ _gtfc_setprop_FRAMEWORK (GstTensorFilterPrivate * priv,
   return 0;
 }
 
+/**
+ * @brief Copy the properties for the reload thread, the model files are not copied.
+ */
+static void
+_gtfc_reload_copy_prop (GstTensorFilterProperties * dest,
+    const GstTensorFilterProperties * src)
+{
+  memcpy (dest, src, sizeof (GstTensorFilterProperties));
+
+  /* the reload thread may outlive the changes of the original properties */
+  dest->fwname = g_strdup (src->fwname);
+  dest->model_files = NULL;
+  dest->num_models = 0;
+
+  gst_tensors_info_init (&dest->input_meta);
+  gst_tensors_info_copy (&dest->input_meta, &src->input_meta);
+  gst_tensors_info_init (&dest->output_meta);
+  gst_tensors_info_copy (&dest->output_meta, &src->output_meta);
+
+  dest->custom_properties = g_strdup (src->custom_properties);
+  dest->hw_list = NULL;
+  if (src->num_hw > 0 && src->hw_list) {
+    dest->hw_list = g_new (accl_hw, src->num_hw);
+    memcpy (dest->hw_list, src->hw_list, sizeof (accl_hw) * src->num_hw);
+  }
+  dest->accl_str = g_strdup (src->accl_str);
+  dest->shared_tensor_filter_key = g_strdup (src->shared_tensor_filter_key);
+}
+
+/**
+ * @brief Free the properties copied for the reload thread.
+ */
+static void
+_gtfc_reload_free_prop (GstTensorFilterProperties * prop)
+{
+  g_free_const (prop->fwname);
+  g_strfreev_const (prop->model_files);
+  gst_tensors_info_free (&prop->input_meta);
+  gst_tensors_info_free (&prop->output_meta);
+  g_free_const (prop->custom_properties);
+  g_free (prop->hw_list);
+  g_free_const (prop->accl_str);
+  g_free (prop->shared_tensor_filter_key);
+
+  memset (prop, 0, sizeof (GstTensorFilterProperties));
+}
+
+/**
+ * @brief Restore the model files of the current instance. (reload lock should be held)
+ */
+static void
+_gtfc_reload_restore_models (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterReload *reload = &priv->reload;
+
+  g_strfreev_const (priv->prop.model_files);
+  priv->prop.model_files = reload->old_model_files;
+  priv->prop.num_models = (reload->old_model_files) ?
+      g_strv_length ((gchar **) reload->old_model_files) : 0;
+  reload->old_model_files = NULL;
+}
+
+/**
+ * @brief Check the tensors info of the new instance with the configured one.
+ */
+static gboolean
+_gtfc_reload_check_info (GstTensorFilterPrivate * priv,
+    GstTensorFilterProperties * prop, void **private_data)
+{
+  GstTensorsInfo in_info, out_info;
+  int res_in = -1, res_out = -1;
+  gboolean compatible = TRUE;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V1 (priv->fw)) {
+    res_in = priv->fw->getModelInfo (priv->fw, prop, *private_data,
+        GET_IN_OUT_INFO, &in_info, &out_info);
+    res_out = res_in;
+  } else {
+    if (priv->fw->getInputDimension)
+      res_in = priv->fw->getInputDimension (prop, private_data, &in_info);
+    if (priv->fw->getOutputDimension)
+      res_out = priv->fw->getOutputDimension (prop, private_data, &out_info);
+  }
+
+  /* the pipeline is already negotiated, the new model should have same tensors. */
+  if (res_in == 0 && prop->input_configured &&
+      !gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
+    ml_loge ("The input tensor of the new model is not compatible.");
+    gst_tensor_filter_compare_tensors (&in_info, &prop->input_meta);
+    compatible = FALSE;
+  }
+
+  if (res_out == 0 && prop->output_configured &&
+      !gst_tensors_info_is_equal (&out_info, &prop->output_meta)) {
+    ml_loge ("The output tensor of the new model is not compatible.");
+    gst_tensor_filter_compare_tensors (&out_info, &prop->output_meta);
+    compatible = FALSE;
+  }
+
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return compatible;
+}
+
+/**
+ * @brief Invoke the new instance once with zero input, to initialize the lazy resources before serving.
+ */
+static void
+_gtfc_reload_warm_up (GstTensorFilterPrivate * priv,
+    GstTensorFilterProperties * prop, void **private_data)
+{
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gboolean allocate_in_invoke = FALSE;
+  guint i;
+  gint ret = -1;
+
+  if (!prop->input_configured || !prop->output_configured)
+    return;
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    allocate_in_invoke = priv->fw->allocate_in_invoke;
+    if (allocate_in_invoke && priv->fw->allocateInInvoke)
+      allocate_in_invoke = (priv->fw->allocateInInvoke (private_data) == 0);
+  } else {
+    allocate_in_invoke = priv->info.allocate_in_invoke;
+  }
+
+  /* cannot release the output allocated by the sub-plugin without the buffer */
+  if (allocate_in_invoke)
+    return;
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_tensors[i].size = gst_tensor_info_get_size (&prop->input_meta.info[i]);
+    in_tensors[i].data = g_malloc0 (in_tensors[i].size);
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    out_tensors[i].size = gst_tensor_info_get_size (&prop->output_meta.info[i]);
+    out_tensors[i].data = g_malloc (out_tensors[i].size);
+  }
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    ret = priv->fw->invoke_NN (prop, private_data, in_tensors, out_tensors);
+  } else {
+    ret = priv->fw->invoke (priv->fw, prop, *private_data, in_tensors,
+        out_tensors);
+  }
+
+  if (ret < 0)
+    ml_logw ("Failed to warm up the new model (%d), keep loading.", ret);
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    g_free (in_tensors[i].data);
+  for (i = 0; i < prop->output_meta.num_tensors; i++)
+    g_free (out_tensors[i].data);
+}
+
+/**
+ * @brief Thread to load the new model while the current instance keeps serving.
+ */
+static gpointer
+_gtfc_reload_thread (gpointer user_data)
+{
+  GstTensorFilterPrivate *priv = (GstTensorFilterPrivate *) user_data;
+  GstTensorFilterReload *reload = &priv->reload;
+  GstTensorFilterProperties *prop = &reload->prop;
+  const gchar **model_files;
+  void *data = NULL;
+  gboolean loaded = FALSE;
+
+  if (priv->fw->open (prop, &data) >= 0) {
+    loaded = _gtfc_reload_check_info (priv, prop, &data);
+
+    if (loaded)
+      _gtfc_reload_warm_up (priv, prop, &data);
+    else
+      priv->fw->close (prop, &data);
+  }
+
+  g_mutex_lock (&reload->lock);
+  reload->privateData = (loaded) ? data : NULL;
+
+  if (reload->state == GST_TF_RELOAD_LOADING) {
+    if (!loaded)
+      ml_loge ("Failed to load the new model, keep the current model.");
+
+    reload->state = (loaded) ? GST_TF_RELOAD_READY : GST_TF_RELOAD_FAILED;
+    reload->ready_time = g_get_monotonic_time ();
+    g_atomic_int_set (&reload->pending, TRUE);
+
+    /* wait for the buffer boundary */
+    while (reload->state == GST_TF_RELOAD_READY)
+      g_cond_wait (&reload->cond, &reload->lock);
+  }
+
+  /* close the old instance after swap, or the new one if cancelled. */
+  if (reload->privateData) {
+    model_files = prop->model_files;
+    if (reload->state == GST_TF_RELOAD_SWAPPED)
+      prop->model_files = reload->old_model_files;
+
+    priv->fw->close (prop, &reload->privateData);
+    prop->model_files = model_files;
+    reload->privateData = NULL;
+  }
+
+  g_mutex_unlock (&reload->lock);
+  return NULL;
+}
+
+/**
+ * @brief Cancel the model reload in progress and wait for the reload thread.
+ */
+static void
+_gtfc_reload_cancel (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterReload *reload = &priv->reload;
+  GThread *thread;
+
+  g_mutex_lock (&reload->lock);
+  thread = reload->thread;
+  reload->thread = NULL;
+
+  switch (reload->state) {
+    case GST_TF_RELOAD_LOADING:
+    case GST_TF_RELOAD_READY:
+    case GST_TF_RELOAD_FAILED:
+      /* keep the current instance */
+      _gtfc_reload_restore_models (priv);
+      reload->state = GST_TF_RELOAD_CANCELLED;
+      g_cond_broadcast (&reload->cond);
+      break;
+    default:
+      break;
+  }
+
+  g_atomic_int_set (&reload->pending, FALSE);
+  g_mutex_unlock (&reload->lock);
+
+  if (thread)
+    g_thread_join (thread);
+
+  g_mutex_lock (&reload->lock);
+  _gtfc_reload_free_prop (&reload->prop);
+  g_strfreev_const (reload->old_model_files);
+  reload->old_model_files = NULL;
+  reload->state = GST_TF_RELOAD_NONE;
+  g_mutex_unlock (&reload->lock);
+}
+
+/**
+ * @brief Start to load the new model in background. The current instance keeps serving until the buffer boundary after the new model is ready.
+ */
+static gint
+_gtfc_reload_start (GstTensorFilterPrivate * priv, const gchar * model_files)
+{
+  GstTensorFilterReload *reload = &priv->reload;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GError *error = NULL;
+
+  /* the latest request wins */
+  _gtfc_reload_cancel (priv);
+
+  g_mutex_lock (&reload->lock);
+
+  /* the reload thread uses a copy of the properties with new model files */
+  _gtfc_reload_copy_prop (&reload->prop, prop);
+  reload->prop.model_files =
+      (const gchar **) g_strsplit_set (model_files, ",", -1);
+  reload->prop.num_models = g_strv_length ((gchar **) reload->prop.model_files);
+  reload->prop.fw_opened = FALSE;
+  reload->privateData = NULL;
+
+  /* the property shows the requested model, restore it if failed. */
+  reload->old_model_files = prop->model_files;
+  prop->model_files =
+      (const gchar **) g_strdupv ((gchar **) reload->prop.model_files);
+  prop->num_models = reload->prop.num_models;
+
+  reload->state = GST_TF_RELOAD_LOADING;
+  reload->request_time = g_get_monotonic_time ();
+  reload->ready_time = 0;
+
+  reload->thread = g_thread_try_new ("tensor_filter_reload",
+      _gtfc_reload_thread, priv, &error);
+  if (!reload->thread) {
+    ml_loge ("Failed to create the thread to reload model: %s",
+        error ? error->message : "unknown");
+    g_clear_error (&error);
+
+    _gtfc_reload_restore_models (priv);
+    _gtfc_reload_free_prop (&reload->prop);
+    reload->state = GST_TF_RELOAD_NONE;
+    g_mutex_unlock (&reload->lock);
+    return -1;
+  }
+
+  g_mutex_unlock (&reload->lock);
+  return 0;
+}
+
 /** @brief Handle "PROP_MODEL" for set-property */
 static gint
 _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
@@ -1372,6 +1718,20 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
     ml_loge ("Invalid model provided to the tensor-filter.");
     return 0;
   }
+
+  /**
+   * Double-buffered reload: the new model is loaded in background and swapped at the buffer boundary.
+   * The shared model instance is reloaded in place, the other filters are using it.
+   * Also the instance allocating the output in invoke is reloaded in place, the output buffers may be alive after closing the old one.
+   */
+  if (prop->fw_opened && priv->is_updatable && priv->reload_async &&
+      prop->shared_tensor_filter_key == NULL &&
+      !gst_tensor_filter_allocate_in_invoke (priv)) {
+    if (_gtfc_reload_start (priv, model_files) != 0)
+      ml_loge ("Fail to reload model\n");
+    return 0;
+  }
+
   _prop.model_files = NULL;
 
   if (prop->fw_opened) {
@@ -1575,8 +1935,12 @@ _gtfc_setprop_CUSTOM (GstTensorFilterPrivate * priv,
       GstTensorFilterFrameworkEventData data;
 
       data.custom_properties = g_value_dup_string (value);
+
+      /* the streaming thread may swap the instance with the reloaded one */
+      g_mutex_lock (&priv->reload.lock);
       status = priv->fw->eventHandler
           (priv->fw, prop, priv->privateData, CUSTOM_PROP, &data);
+      g_mutex_unlock (&priv->reload.lock);
       if (status == 0) {
         g_free_const (prop->custom_properties);
         prop->custom_properties = g_value_dup_string (value);
@@ -1610,8 +1974,10 @@ _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
       data.num_hw = prop->num_hw;
       data.hw_list = prop->hw_list;
 
+      g_mutex_lock (&priv->reload.lock);
       status = priv->fw->eventHandler
           (priv->fw, &_prop, priv->privateData, SET_ACCELERATOR, &data);
+      g_mutex_unlock (&priv->reload.lock);
       if (status == 0) {
         g_free (_prop.hw_list);
       } else {
@@ -1842,6 +2208,20 @@ _gtfc_setprop_OUTPUTCOMBINATION (GstTensorFilterPrivate * priv,
   return ret;
 }
 
+/** @brief Handle "PROP_ADAPTIVE_RATE" for set-property */
+static gint
+_gtfc_setprop_ADAPTIVE_RATE (GstTensorFilterPrivate * priv,
+    const GValue * value)
+{
+  priv->adaptive_rate = g_value_get_boolean (value);
+
+  /* do not keep the latency measured for adaptive rate */
+  if (!priv->adaptive_rate && priv->latency_mode == 0)
+    priv->prop.latency = 0;
+
+  return 0;
+}
+
 /** @brief Handle "PROP_SHARED_TENSOR_FILTER_KEY" for set-property */
 static gint
 _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (GstTensorFilterProperties * prop,
@@ -1932,6 +2312,12 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_SHARED_TENSOR_FILTER_KEY:
       status = _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (prop, value);
       break;
+    case PROP_ADAPTIVE_RATE:
+      status = _gtfc_setprop_ADAPTIVE_RATE (priv, value);
+      break;
+    case PROP_LATENCY_REPORT:
+      priv->latency_report = g_value_get_uint (value);
+      break;
     default:
       return FALSE;
   }
@@ -2133,6 +2519,16 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       else
         g_value_set_string (value, "");
       break;
+    case PROP_ADAPTIVE_RATE:
+      g_value_set_boolean (value, priv->adaptive_rate);
+      break;
+    case PROP_LATENCY_REPORT:
+      g_value_set_uint (value, priv->latency_report);
+      break;
+    case PROP_LATENCY_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_filter_common_get_latency_stats (priv));
+      break;
     default:
       /* unknown property */
       return FALSE;
@@ -2141,6 +2537,126 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
   return TRUE;
 }
 
+/**
+ * @brief Compare function to sort the latencies.
+ */
+static gint
+_gtfc_compare_latency (gconstpointer a, gconstpointer b)
+{
+  gint64 l1 = *((const gint64 *) a);
+  gint64 l2 = *((const gint64 *) b);
+
+  return (l1 > l2) - (l1 < l2);
+}
+
+/**
+ * @brief Get the latency statistics from the recent invokes.
+ */
+GstStructure *
+gst_tensor_filter_common_get_latency_stats (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterStatistics *stat;
+  gint64 invoke[GST_TF_STAT_MAX_WINDOW];
+  gint64 total[GST_TF_STAT_STAGE_END] = { 0, };
+  gint64 p50, p90, p99;
+  guint i, s, count, num;
+
+  g_return_val_if_fail (priv != NULL, NULL);
+
+  stat = &priv->stat;
+  p50 = p90 = p99 = 0;
+
+  /* the window may be updated while copying, it's fine for statistics. */
+  count = (guint) g_atomic_int_get ((gint *) & stat->window_count);
+  num = MIN (count, GST_TF_STAT_MAX_WINDOW);
+
+  for (i = 0; i < num; i++) {
+    guint idx = (count - 1 - i) % GST_TF_STAT_MAX_WINDOW;
+
+    for (s = 0; s < GST_TF_STAT_STAGE_END; s++)
+      total[s] += stat->window[idx][s];
+
+    invoke[i] = stat->window[idx][GST_TF_STAT_STAGE_INVOKE];
+  }
+
+  if (num > 0) {
+    qsort (invoke, num, sizeof (gint64), _gtfc_compare_latency);
+
+    /* nearest-rank percentiles */
+    p50 = invoke[(num * 50 + 99) / 100 - 1];
+    p90 = invoke[(num * 90 + 99) / 100 - 1];
+    p99 = invoke[(num * 99 + 99) / 100 - 1];
+
+    for (s = 0; s < GST_TF_STAT_STAGE_END; s++)
+      total[s] /= num;
+  }
+
+  return gst_structure_new ("tensor-filter-latency",
+      "samples", G_TYPE_UINT, num,
+      "p50", G_TYPE_INT64, p50,
+      "p90", G_TYPE_INT64, p90,
+      "p99", G_TYPE_INT64, p99,
+      "map", G_TYPE_INT64, total[GST_TF_STAT_STAGE_MAP],
+      "invoke", G_TYPE_INT64, total[GST_TF_STAT_STAGE_INVOKE],
+      "unmap", G_TYPE_INT64, total[GST_TF_STAT_STAGE_UNMAP],
+      "wrap", G_TYPE_INT64, total[GST_TF_STAT_STAGE_WRAP], NULL);
+}
+
+/**
+ * @brief Swap the model if the new model is loaded in background. Call this at the buffer boundary.
+ */
+GstStructure *
+gst_tensor_filter_common_reload_swap (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterReload *reload;
+  gboolean success;
+  gint64 start, load_time;
+  gchar *models;
+  void *data;
+  GstStructure *result;
+
+  g_return_val_if_fail (priv != NULL, NULL);
+
+  reload = &priv->reload;
+
+  /* nothing to do in most buffers */
+  if (!g_atomic_int_get (&reload->pending))
+    return NULL;
+
+  start = g_get_monotonic_time ();
+  g_mutex_lock (&reload->lock);
+  g_atomic_int_set (&reload->pending, FALSE);
+
+  if (reload->state == GST_TF_RELOAD_READY) {
+    /* the reload thread closes the old instance */
+    data = priv->privateData;
+    priv->privateData = reload->privateData;
+    reload->privateData = data;
+    reload->state = GST_TF_RELOAD_SWAPPED;
+    g_cond_broadcast (&reload->cond);
+    success = TRUE;
+  } else if (reload->state == GST_TF_RELOAD_FAILED) {
+    _gtfc_reload_restore_models (priv);
+    success = FALSE;
+  } else {
+    g_mutex_unlock (&reload->lock);
+    return NULL;
+  }
+
+  models = g_strjoinv (",", (gchar **) reload->prop.model_files);
+  load_time = reload->ready_time - reload->request_time;
+  g_mutex_unlock (&reload->lock);
+
+  result = gst_structure_new ("tensor-filter-model-reload",
+      "model", G_TYPE_STRING, models,
+      "success", G_TYPE_BOOLEAN, success,
+      "load-time", G_TYPE_INT64, load_time,
+      "swap-latency", G_TYPE_INT64, g_get_monotonic_time () - start, NULL);
+
+  g_free (models);
+  return result;
+}
+
 /**
  * @brief Configure input tensor info with combi option.
  */
@@ -2399,6 +2915,8 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
 void
 gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
 {
+  _gtfc_reload_cancel (priv);
+
   if (priv->prop.fw_opened) {
     if (priv->fw && priv->fw->close) {
       priv->fw->close (&priv->prop, &priv->privateData);
@@ -72,9 +72,23 @@
     } while (0)
 
 #define GST_TF_STAT_MAX_RECENT (10)
+#define GST_TF_STAT_MAX_WINDOW (256) /* power of 2, the window to get percentiles */
+
+/**
+ * @brief Stages of tensor-filter transform for the latency breakdown
+ */
+typedef enum
+{
+  GST_TF_STAT_STAGE_MAP = 0,    /**< map input and prepare output memories */
+  GST_TF_STAT_STAGE_INVOKE,     /**< invoke of the sub-plugin */
+  GST_TF_STAT_STAGE_UNMAP,      /**< unmap memories */
+  GST_TF_STAT_STAGE_WRAP,       /**< wrap the output tensors into the output buffer */
+  GST_TF_STAT_STAGE_END
+} GstTensorFilterStatStage;
 
 /**
  * @brief Structure definition for tensor-filter statistics
+ * @note Only the streaming thread writes the statistics. The window is a ring buffer and other threads read a snapshot of it without a lock.
  */
 typedef struct _GstTensorFilterStatistics
 {
@@ -82,8 +96,18 @@ typedef struct _GstTensorFilterStatistics
   gint64 total_invoke_latency;  /**< accumulated invoke latency (usec) */
   gint64 old_total_invoke_num;      /**< cached value. number of total invokes */
   gint64 old_total_invoke_latency;  /**< cached value. accumulated invoke latency (usec) */
-  gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
-  void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
+  gint64 latest_invoke_time;    /**< the latest invoke time (usec, monotonic) */
+  gint64 latest_stage_time;     /**< the time the current stage began (usec, monotonic) */
+  gint64 latest_report_time;    /**< the time the latest report was posted (usec, monotonic) */
+
+  gint64 recent_latencies[GST_TF_STAT_MAX_RECENT]; /**< ring buffer of the recent invoke latencies (usec) */
+  gint64 recent_sum;            /**< running sum of the recent invoke latencies (usec) */
+  guint recent_idx;             /**< index of recent_latencies to be written next */
+  guint recent_num;             /**< number of valid recent latencies */
+
+  gint64 stage[GST_TF_STAT_STAGE_END]; /**< latency of each stage in the current transform (usec) */
+  gint64 window[GST_TF_STAT_MAX_WINDOW][GST_TF_STAT_STAGE_END]; /**< ring buffer of the stage latencies (usec) */
+  guint window_count;           /**< number of records written to the window (atomic) */
 } GstTensorFilterStatistics;
 
 /**
@@ -99,6 +123,39 @@ typedef struct _GstTensorFilterCombination
   gboolean out_combi_o_defined;/**< True if output combination from model output is defined */
 } GstTensorFilterCombination;
 
+/**
+ * @brief State of the double-buffered model reload
+ */
+typedef enum
+{
+  GST_TF_RELOAD_NONE = 0,       /**< no reload in progress */
+  GST_TF_RELOAD_LOADING,        /**< the new model is being loaded in background */
+  GST_TF_RELOAD_READY,          /**< the new model is ready, waiting for the buffer boundary */
+  GST_TF_RELOAD_FAILED,         /**< failed to load the new model */
+  GST_TF_RELOAD_SWAPPED,        /**< the new model is serving, the old one is being closed */
+  GST_TF_RELOAD_CANCELLED       /**< the reload is cancelled */
+} GstTensorFilterReloadState;
+
+/**
+ * @brief Structure definition for the double-buffered model reload
+ * @note The new instance is opened and warmed up in the reload thread while the current one keeps serving. The streaming thread swaps the instances at a buffer boundary and the reload thread closes the old one.
+ */
+typedef struct _GstTensorFilterReload
+{
+  GMutex lock;                  /**< lock for the reload data */
+  GCond cond;                   /**< signalled when the state is changed */
+  GThread *thread;              /**< the reload thread */
+  GstTensorFilterReloadState state; /**< current state */
+  gint pending;                 /**< TRUE if the streaming thread should check the state (atomic) */
+
+  GstTensorFilterProperties prop; /**< copy of the properties with the model files of the instance */
+  const gchar **old_model_files; /**< model files of the current instance */
+  void *privateData;            /**< private data of the new instance (the old one after swap) */
+
+  gint64 request_time;          /**< the time the reload is requested (usec, monotonic) */
+  gint64 ready_time;            /**< the time the new model is ready (usec, monotonic) */
+} GstTensorFilterReload;
+
 /**
  * @brief Structure definition for common tensor-filter properties.
  */
@@ -118,11 +175,16 @@ typedef struct _GstTensorFilterPrivate
   GstTensorsConfig out_config; /**< output tensor info */
 
   gint latency_mode;     /**< latency profiling mode (0: off, 1: on, ...) */
+  guint latency_report;  /**< interval to post the latency statistics (msec, 0: off) */
   gint throughput_mode;  /**< throughput profiling mode (0: off, 1: on, ...) */
 
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
+  gboolean adaptive_rate; /**< throttle with the average invoke latency without tensor_rate */
+
+  gboolean reload_async; /**< load the new model in background and swap it at the buffer boundary */
+  GstTensorFilterReload reload; /**< double-buffered model reload */
 
   GstTensorFilterCombination combi;
 } GstTensorFilterPrivate;
@@ -187,6 +249,22 @@ extern gboolean
 gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
     guint prop_id, GValue * value, GParamSpec * pspec);
 
+/**
+ * @brief Get the latency statistics from the recent invokes.
+ * @param[in] priv Struct containing the properties of the object
+ * @return Newly allocated structure with the percentiles of the invoke latency and the average latency of each stage (usec). Caller should free it with gst_structure_free().
+ */
+extern GstStructure *
+gst_tensor_filter_common_get_latency_stats (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Swap the model if the new model is loaded in background. Call this at the buffer boundary.
+ * @param[in] priv Struct containing the properties of the object
+ * @return Newly allocated structure with the result of the reload (load-time and swap-latency in usec), or NULL if there is no reload to be completed. Caller should free it with gst_structure_free().
+ */
+extern GstStructure *
+gst_tensor_filter_common_reload_swap (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Configure input tensor info with combi option.
  */
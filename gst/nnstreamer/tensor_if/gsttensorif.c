@@ -42,6 +42,22 @@
  *      tif.src_1 ! queue ! (tensor(s) stream for FALSE action) ...
  * </refsect2>
  *
+ * A condition with several values or reductions of tensors can be
+ * expressed with compared-value=EXPR. The expression is compiled once
+ * with the input caps and evaluated for each buffer without allocation.
+ * The operator and supplied-value are ignored with EXPR.
+ * <refsect2>
+ * <title>Example launch line with an expression</title>
+ * gst-launch ... (some tensor stream) !
+ *      tensor_if name=tif
+ *        compared-value=EXPR
+ *        compared-value-option="max(t[1][0:90]) > 0.6 && t[3][0] >= 1"
+ *        then=PASSTHROUGH
+ *        else=SKIP
+ *      tif.src_0 ! queue ! (tensor(s) stream for TRUE action) ...
+ * </refsect2>
+ * See gsttensorif_expr.h for the syntax of the expression.
+ *
  * However, if the if-condition is complex and cannot be expressed with
  * tensor-if expressions, you may create a corresponding custom filter
  * with tensor-filter, whose output is other/tensors with an additional tensor
@@ -168,6 +184,7 @@ gst_tensor_if_cv_get_type (void)
       {TIFCV_TENSOR_AVERAGE_VALUE, "TENSOR_AVERAGE_VALUE",
           "Decide based on a average value of a specific tensor"},
       {TIFCV_CUSTOM, "CUSTOM", "Decide based on a user defined callback"},
+      {TIFCV_EXPR, "EXPR", "Decide based on an expression of tensor values"},
       {0, NULL, NULL},
     };
     mode_type = g_enum_register_static ("tensor_if_compared_value", mode_types);
@@ -295,6 +312,7 @@ gst_tensor_if_init (GstTensorIf * tensor_if)
   memset (tensor_if->sv, 0, sizeof (tensor_if_sv_s) * 2);
   memset (&tensor_if->custom, 0, sizeof (custom_cb_s));
   tensor_if->custom_configured = FALSE;
+  tensor_if->expr = NULL;
 
   g_mutex_init (&tensor_if->lock);
 }
@@ -333,6 +351,8 @@ gst_tensor_if_dispose (GObject * object)
   tensor_if->custom.func = NULL;
   tensor_if->custom.data = NULL;
   tensor_if->custom_configured = FALSE;
+  gst_tensor_if_expr_free (tensor_if->expr);
+  tensor_if->expr = NULL;
 
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
@@ -421,6 +441,31 @@ gst_tensor_if_configure_custom_prop (GstTensorIf * self)
   }
 }
 
+/**
+ * @brief Compile the expression (compared-value=EXPR) with the input tensors info.
+ * @return TRUE if the expression is compiled or the compared value is not EXPR.
+ */
+static gboolean
+gst_tensor_if_configure_expr (GstTensorIf * self)
+{
+  gboolean ret = TRUE;
+
+  g_mutex_lock (&self->lock);
+  gst_tensor_if_expr_free (self->expr);
+  self->expr = NULL;
+
+  if (self->cv == TIFCV_EXPR &&
+      gst_tensors_info_validate (&self->in_config.info)) {
+    if (self->custom.name)
+      self->expr = gst_tensor_if_expr_compile (self->custom.name,
+          &self->in_config.info);
+    ret = (self->expr != NULL);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return ret;
+}
+
 /**
  * @brief Setter for tensor_if properties.
  */
@@ -434,12 +479,15 @@ gst_tensor_if_set_property (GObject * object, guint prop_id,
     case PROP_CV:
       self->cv = g_value_get_enum (value);
       gst_tensor_if_configure_custom_prop (self);
+      gst_tensor_if_configure_expr (self);
       break;
     case PROP_CV_OPTION:
       g_free (self->custom.name);
       self->custom.name = g_value_dup_string (value);
       gst_tensor_if_configure_custom_prop (self);
-      gst_tensor_if_set_property_glist (value, &self->cv_option, ":,");
+      gst_tensor_if_configure_expr (self);
+      if (self->cv != TIFCV_EXPR)
+        gst_tensor_if_set_property_glist (value, &self->cv_option, ":,");
       break;
     case PROP_OP:
       self->op = g_value_get_enum (value);
@@ -552,7 +600,7 @@ gst_tensor_if_get_property (GObject * object, guint prop_id,
       g_value_set_enum (value, self->cv);
       break;
     case PROP_CV_OPTION:
-      if (self->cv == TIFCV_CUSTOM) {
+      if (self->cv == TIFCV_CUSTOM || self->cv == TIFCV_EXPR) {
         g_value_set_string (value, self->custom.name ? self->custom.name : "");
       } else {
         gst_tensor_if_property_to_string (value, self->cv_option, prop_id);
@@ -651,7 +699,18 @@ gst_tensor_if_parse_caps (GstTensorIf * tensor_if, GstCaps * caps)
   structure = gst_caps_get_structure (caps, 0);
   gst_tensors_config_from_structure (config, structure);
 
-  return gst_tensors_config_validate (config);
+  if (!gst_tensors_config_validate (config))
+    return FALSE;
+
+  /* compile the expression once with new tensors info */
+  if (!gst_tensor_if_configure_expr (tensor_if)) {
+    GST_ERROR_OBJECT (tensor_if,
+        "Failed to compile the expression '%s' for the input tensors.",
+        GST_STR_NULL (tensor_if->custom.name));
+    return FALSE;
+  }
+
+  return TRUE;
 }
 
 /**
@@ -806,6 +865,10 @@ gst_tensor_if_get_comparison_result (GstTensorIf * tensor_if,
   gboolean ret = FALSE;
   tensor_data_s svtc_1, svtc_2;
 
+  /* 16-bit floating point values are compared in float32 */
+  if (gst_tensor_type_is_half (cv->type))
+    gst_tensor_data_typecast (cv, _NNS_FLOAT32);
+
   svtc_1.type = tensor_if->sv->type;
   svtc_1.data = tensor_if->sv->data[0];
   gst_tensor_data_typecast (&svtc_1, cv->type);
@@ -872,7 +935,7 @@ gst_tensor_if_get_tensor_average (GstTensorIf * tensor_if,
 {
   GstMemory *in_mem;
   GstMapInfo in_info;
-  gdouble *avg = NULL;
+  gdouble avg = 0.0;
   tensor_type type = tensor_if->in_config.info.info[nth].type;
 
   in_mem = gst_buffer_peek_memory (buf, nth);
@@ -881,14 +944,13 @@ gst_tensor_if_get_tensor_average (GstTensorIf * tensor_if,
     return FALSE;
   }
 
-  gst_tensor_data_raw_average (in_info.data, in_info.size, type, &avg);
+  gst_tensor_data_raw_mean_std (in_info.data, in_info.size, type, &avg, NULL);
 
   gst_memory_unmap (in_mem, &in_info);
 
-  gst_tensor_data_set (cv, _NNS_FLOAT64, avg);
+  gst_tensor_data_set (cv, _NNS_FLOAT64, &avg);
   gst_tensor_data_typecast (cv, type);
 
-  g_free (avg);
   return TRUE;
 }
 
@@ -1028,7 +1090,49 @@ gst_tensor_if_check_condition (GstTensorIf * tensor_if, GstBuffer * buf,
 {
   gboolean ret = FALSE;
 
-  if (tensor_if->cv == TIFCV_CUSTOM) {
+  if (tensor_if->cv == TIFCV_EXPR) {
+    GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
+    GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+    GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+    guint32 used;
+    guint i;
+
+    g_mutex_lock (&tensor_if->lock);
+    if (!tensor_if->expr) {
+      g_mutex_unlock (&tensor_if->lock);
+      nns_loge ("expression of the tensor_if is not configured.");
+      return FALSE;
+    }
+
+    /* map the tensors used in the expression only */
+    used = gst_tensor_if_expr_get_used_tensors (tensor_if->expr);
+    memset (in_tensors, 0, sizeof (in_tensors));
+
+    for (i = 0; i < tensor_if->in_config.info.num_tensors; i++) {
+      in_mem[i] = NULL;
+      if (!(used & (1U << i)))
+        continue;
+
+      in_mem[i] = gst_buffer_peek_memory (buf, i);
+      if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+        GST_WARNING_OBJECT (tensor_if, "Cannot map input memory buffer(%d)\n",
+            i);
+        in_mem[i] = NULL;
+        break;
+      }
+      in_tensors[i].data = in_info[i].data;
+      in_tensors[i].size = in_info[i].size;
+    }
+
+    if (i == tensor_if->in_config.info.num_tensors)
+      ret = gst_tensor_if_expr_eval (tensor_if->expr, in_tensors, result);
+
+    while (i-- > 0) {
+      if (in_mem[i])
+        gst_memory_unmap (in_mem[i], &in_info[i]);
+    }
+    g_mutex_unlock (&tensor_if->lock);
+  } else if (tensor_if->cv == TIFCV_CUSTOM) {
     GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
     GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
     GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
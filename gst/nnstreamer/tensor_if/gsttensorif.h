@@ -23,6 +23,7 @@
 #include <tensor_common.h>
 #include <tensor_data.h>
 #include <tensor_if.h>
+#include "gsttensorif_expr.h"
 
 G_BEGIN_DECLS
 
@@ -51,6 +52,7 @@ typedef enum {
   TIFCV_ALL_TENSORS_AVERAGE_VALUE = 4,	/**< Decide based on a average value of
 					     tensors or a specific tensor */
   TIFCV_CUSTOM = 5,    /**< Decide based on a user defined condition */
+  TIFCV_EXPR = 6,      /**< Decide based on an expression of tensors values */
   TIFCV_END,
 } tensor_if_compared_value;
 
@@ -140,7 +142,8 @@ struct _GstTensorIf
   GList *else_option;
 
   gboolean custom_configured;
-  custom_cb_s custom;
+  custom_cb_s custom; /**< name is the raw compared-value-option (also the expression of EXPR) */
+  tensor_if_expr *expr; /**< compiled expression of EXPR (with the input tensors info) */
 
   GMutex lock; /**< Lock for custom callback */
 };
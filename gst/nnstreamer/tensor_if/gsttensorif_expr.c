@@ -0,0 +1,872 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-IF
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	gsttensorif_expr.c
+ * @date	18 Oct 2021
+ * @brief	Expression engine of tensor_if (compared-value=EXPR)
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ *
+ * @details
+ *	The parser is a recursive descent parser emitting the instructions of
+ *	a stack machine in postfix order. The tensor indices and the element
+ *	ranges are validated with the tensors info at compile time, so that the
+ *	evaluation does not check anything but the memory size.
+ */
+
+#include <string.h>
+#include <nnstreamer_log.h>
+#include <tensor_common.h>
+#include <tensor_data.h>
+#include "gsttensorif_expr.h"
+
+/**
+ * @brief Max depth of the stack to evaluate an expression.
+ */
+#define TIF_EXPR_STACK_SIZE (32)
+
+/**
+ * @brief Max nesting depth of the parentheses and unary operators, not to overflow the stack in parsing.
+ */
+#define TIF_EXPR_MAX_NESTING (64)
+
+/**
+ * @brief Opcodes of the expression.
+ */
+typedef enum
+{
+  TIF_EXPR_CONST = 0, /**< push value */
+  TIF_EXPR_LOAD, /**< push the element of a tensor */
+  TIF_EXPR_MAX, /**< push max of the range */
+  TIF_EXPR_MIN, /**< push min of the range */
+  TIF_EXPR_SUM, /**< push sum of the range */
+  TIF_EXPR_MEAN, /**< push mean of the range */
+  TIF_EXPR_ARGMAX, /**< push the index of max in the range (from start) */
+  TIF_EXPR_ARGMIN, /**< push the index of min in the range (from start) */
+  TIF_EXPR_COUNT, /**< push the number of elements satisfying the condition */
+  TIF_EXPR_ANY, /**< push 1 if any element satisfies the condition */
+  TIF_EXPR_ALL, /**< push 1 if all elements satisfy the condition */
+  TIF_EXPR_NEG, /**< unary - */
+  TIF_EXPR_NOT, /**< unary ! */
+  TIF_EXPR_ADD, /**< + */
+  TIF_EXPR_SUB, /**< - */
+  TIF_EXPR_MUL, /**< * */
+  TIF_EXPR_DIV, /**< / */
+  TIF_EXPR_EQ, /**< == */
+  TIF_EXPR_NE, /**< != */
+  TIF_EXPR_LT, /**< < */
+  TIF_EXPR_LE, /**< <= */
+  TIF_EXPR_GT, /**< > */
+  TIF_EXPR_GE, /**< >= */
+  TIF_EXPR_AND, /**< if top is zero, jump (short-circuit), else pop */
+  TIF_EXPR_OR, /**< if top is not zero, set 1 and jump (short-circuit), else pop */
+  TIF_EXPR_BOOL, /**< top = (top != 0) */
+} tif_expr_opcode;
+
+/**
+ * @brief An instruction of the expression.
+ */
+typedef struct
+{
+  tif_expr_opcode op; /**< opcode */
+  tif_expr_opcode cmp; /**< comparison of count, any and all */
+  guint nth; /**< index of the tensor */
+  tensor_type type; /**< type of the tensor */
+  gsize start; /**< first element */
+  gsize end; /**< last element + 1 */
+  gdouble value; /**< constant or threshold */
+  guint jump; /**< index of the next instruction for short-circuit */
+} tif_expr_inst;
+
+/**
+ * @brief Compiled expression.
+ */
+struct _tensor_if_expr
+{
+  tif_expr_inst *insts; /**< instructions */
+  guint num_insts; /**< number of instructions */
+  guint32 used_tensors; /**< bitmask of the tensors used */
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT]; /**< size of each tensor in bytes */
+};
+
+/**
+ * @brief Parser data.
+ */
+typedef struct
+{
+  const gchar *str; /**< expression string */
+  const gchar *pos; /**< current position */
+  const GstTensorsInfo *info; /**< input tensors info */
+  GArray *insts; /**< emitted instructions */
+  guint32 used_tensors; /**< bitmask of the tensors used */
+  gint depth; /**< current stack depth */
+  gint max_depth; /**< max stack depth */
+  gint nesting; /**< current nesting depth in parsing */
+  gboolean failed; /**< TRUE if an error is found */
+} tif_expr_parser;
+
+static void _expr_parse_or (tif_expr_parser * p);
+
+/**
+ * @brief Report a parse error with the position.
+ */
+static void
+_expr_error (tif_expr_parser * p, const gchar * msg)
+{
+  if (!p->failed)
+    nns_loge ("tensor_if: invalid expression '%s' at %d: %s", p->str,
+        (gint) (p->pos - p->str), msg);
+  p->failed = TRUE;
+}
+
+/**
+ * @brief Skip white spaces.
+ */
+static void
+_expr_skip_space (tif_expr_parser * p)
+{
+  while (g_ascii_isspace (*p->pos))
+    p->pos++;
+}
+
+/**
+ * @brief Consume the token if it matches.
+ */
+static gboolean
+_expr_accept (tif_expr_parser * p, const gchar * token)
+{
+  gsize len = strlen (token);
+
+  _expr_skip_space (p);
+  if (strncmp (p->pos, token, len) != 0)
+    return FALSE;
+
+  /* do not split '<=' into '<' and '=' */
+  if (len == 1 && strchr ("<>=!", token[0]) && p->pos[1] == '=')
+    return FALSE;
+
+  p->pos += len;
+  return TRUE;
+}
+
+/**
+ * @brief Consume the token, or report an error.
+ */
+static void
+_expr_expect (tif_expr_parser * p, const gchar * token)
+{
+  if (!_expr_accept (p, token)) {
+    gchar *msg = g_strdup_printf ("'%s' is expected", token);
+    _expr_error (p, msg);
+    g_free (msg);
+  }
+}
+
+/**
+ * @brief Emit an instruction and track the stack depth.
+ */
+static guint
+_expr_emit (tif_expr_parser * p, const tif_expr_inst * inst, gint delta)
+{
+  g_array_append_val (p->insts, *inst);
+
+  p->depth += delta;
+  if (p->depth > p->max_depth)
+    p->max_depth = p->depth;
+  if (p->max_depth > TIF_EXPR_STACK_SIZE)
+    _expr_error (p, "expression is too complex");
+
+  return p->insts->len - 1;
+}
+
+/**
+ * @brief Emit an instruction without operand.
+ */
+static guint
+_expr_emit_op (tif_expr_parser * p, tif_expr_opcode op, gint delta)
+{
+  tif_expr_inst inst;
+
+  memset (&inst, 0, sizeof (inst));
+  inst.op = op;
+  return _expr_emit (p, &inst, delta);
+}
+
+/**
+ * @brief Parse an unsigned integer.
+ */
+static gboolean
+_expr_parse_index (tif_expr_parser * p, guint64 * val)
+{
+  gchar *endptr = NULL;
+
+  _expr_skip_space (p);
+  if (!g_ascii_isdigit (*p->pos))
+    return FALSE;
+
+  *val = g_ascii_strtoull (p->pos, &endptr, 10);
+  p->pos = endptr;
+  return TRUE;
+}
+
+/**
+ * @brief Parse a number.
+ */
+static gboolean
+_expr_parse_number (tif_expr_parser * p, gdouble * val)
+{
+  gchar *endptr = NULL;
+  const gchar *start;
+
+  _expr_skip_space (p);
+  start = p->pos;
+  if (*start == '-' || *start == '+')
+    start++;
+  if (!g_ascii_isdigit (*start) && *start != '.')
+    return FALSE;
+
+  *val = g_ascii_strtod (p->pos, &endptr);
+  if (endptr == p->pos)
+    return FALSE;
+
+  p->pos = endptr;
+  return TRUE;
+}
+
+/**
+ * @brief Parse a tensor reference, t[N] or t[N][INDEX] or t[N][START:END].
+ * @param is_range TRUE if a range is allowed.
+ */
+static void
+_expr_parse_tensor (tif_expr_parser * p, gboolean is_range,
+    tif_expr_inst * inst)
+{
+  guint64 nth, start, end;
+  gsize count;
+  const GstTensorInfo *info;
+
+  _expr_expect (p, "t");
+  _expr_expect (p, "[");
+  if (p->failed)
+    return;
+
+  if (!_expr_parse_index (p, &nth)) {
+    _expr_error (p, "index of the tensor is expected");
+    return;
+  }
+
+  if (nth >= p->info->num_tensors) {
+    _expr_error (p, "index of the tensor is out of range");
+    return;
+  }
+  _expr_expect (p, "]");
+
+  info = &p->info->info[nth];
+  count = gst_tensor_get_element_count (info->dimension);
+  start = 0;
+  end = count;
+
+  if (_expr_accept (p, "[")) {
+    gboolean has_start = _expr_parse_index (p, &start);
+
+    if (_expr_accept (p, ":")) {
+      if (!is_range) {
+        _expr_error (p, "range is allowed in the functions only");
+        return;
+      }
+      if (!_expr_parse_index (p, &end))
+        end = count;
+    } else if (has_start) {
+      end = start + 1;
+    } else {
+      _expr_error (p, "index of the element is expected");
+      return;
+    }
+    _expr_expect (p, "]");
+  } else if (!is_range) {
+    _expr_error (p, "index of the element is expected");
+    return;
+  }
+
+  if (start >= end || end > count) {
+    _expr_error (p, "index of the element is out of range");
+    return;
+  }
+
+  inst->nth = (guint) nth;
+  inst->type = info->type;
+  inst->start = (gsize) start;
+  inst->end = (gsize) end;
+  p->used_tensors |= (1U << nth);
+}
+
+/**
+ * @brief Parse a comparison operator.
+ */
+static gboolean
+_expr_parse_cmp_op (tif_expr_parser * p, tif_expr_opcode * op)
+{
+  if (_expr_accept (p, "=="))
+    *op = TIF_EXPR_EQ;
+  else if (_expr_accept (p, "!="))
+    *op = TIF_EXPR_NE;
+  else if (_expr_accept (p, "<="))
+    *op = TIF_EXPR_LE;
+  else if (_expr_accept (p, ">="))
+    *op = TIF_EXPR_GE;
+  else if (_expr_accept (p, "<"))
+    *op = TIF_EXPR_LT;
+  else if (_expr_accept (p, ">"))
+    *op = TIF_EXPR_GT;
+  else
+    return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * @brief Parse a function call.
+ */
+static void
+_expr_parse_func (tif_expr_parser * p, const gchar * name, gsize len)
+{
+  static const struct
+  {
+    const gchar *name;
+    tif_expr_opcode op;
+    gboolean pred;
+  } funcs[] = {
+    {"max", TIF_EXPR_MAX, FALSE},
+    {"min", TIF_EXPR_MIN, FALSE},
+    {"sum", TIF_EXPR_SUM, FALSE},
+    {"mean", TIF_EXPR_MEAN, FALSE},
+    {"argmax", TIF_EXPR_ARGMAX, FALSE},
+    {"argmin", TIF_EXPR_ARGMIN, FALSE},
+    {"count", TIF_EXPR_COUNT, TRUE},
+    {"any", TIF_EXPR_ANY, TRUE},
+    {"all", TIF_EXPR_ALL, TRUE},
+  };
+  tif_expr_inst inst;
+  guint i;
+
+  memset (&inst, 0, sizeof (inst));
+
+  for (i = 0; i < G_N_ELEMENTS (funcs); i++) {
+    if (strlen (funcs[i].name) == len && strncmp (funcs[i].name, name, len) == 0)
+      break;
+  }
+
+  if (i == G_N_ELEMENTS (funcs)) {
+    _expr_error (p, "unknown function");
+    return;
+  }
+
+  inst.op = funcs[i].op;
+  _expr_expect (p, "(");
+  _expr_parse_tensor (p, TRUE, &inst);
+
+  if (funcs[i].pred) {
+    if (!_expr_parse_cmp_op (p, &inst.cmp)) {
+      _expr_error (p, "comparison operator is expected");
+      return;
+    }
+    if (!_expr_parse_number (p, &inst.value)) {
+      _expr_error (p, "number is expected");
+      return;
+    }
+  }
+
+  _expr_expect (p, ")");
+  _expr_emit (p, &inst, 1);
+}
+
+/**
+ * @brief Parse a primary expression.
+ */
+static void
+_expr_parse_primary (tif_expr_parser * p)
+{
+  tif_expr_inst inst;
+  const gchar *name;
+  gsize len = 0;
+
+  if (p->failed)
+    return;
+
+  memset (&inst, 0, sizeof (inst));
+  _expr_skip_space (p);
+
+  if (_expr_accept (p, "(")) {
+    _expr_parse_or (p);
+    _expr_expect (p, ")");
+    return;
+  }
+
+  if (g_ascii_isdigit (*p->pos) || *p->pos == '.') {
+    inst.op = TIF_EXPR_CONST;
+    if (!_expr_parse_number (p, &inst.value))
+      _expr_error (p, "invalid number");
+    else
+      _expr_emit (p, &inst, 1);
+    return;
+  }
+
+  name = p->pos;
+  while (g_ascii_isalpha (name[len]))
+    len++;
+
+  if (len == 0) {
+    _expr_error (p, "unexpected character");
+  } else if (len == 1 && name[0] == 't') {
+    inst.op = TIF_EXPR_LOAD;
+    _expr_parse_tensor (p, FALSE, &inst);
+    _expr_emit (p, &inst, 1);
+  } else {
+    p->pos += len;
+    _expr_parse_func (p, name, len);
+  }
+}
+
+/**
+ * @brief Parse an unary expression.
+ */
+static void
+_expr_parse_unary (tif_expr_parser * p)
+{
+  if (p->failed)
+    return;
+
+  /* each parenthesis and unary operator comes here recursively */
+  if (p->nesting >= TIF_EXPR_MAX_NESTING) {
+    _expr_error (p, "too deeply nested");
+    return;
+  }
+  p->nesting++;
+
+  if (_expr_accept (p, "-")) {
+    _expr_parse_unary (p);
+    _expr_emit_op (p, TIF_EXPR_NEG, 0);
+  } else if (_expr_accept (p, "!")) {
+    _expr_parse_unary (p);
+    _expr_emit_op (p, TIF_EXPR_NOT, 0);
+  } else {
+    _expr_parse_primary (p);
+  }
+
+  p->nesting--;
+}
+
+/**
+ * @brief Parse a product.
+ */
+static void
+_expr_parse_prod (tif_expr_parser * p)
+{
+  tif_expr_opcode op;
+
+  _expr_parse_unary (p);
+  while (!p->failed) {
+    if (_expr_accept (p, "*"))
+      op = TIF_EXPR_MUL;
+    else if (_expr_accept (p, "/"))
+      op = TIF_EXPR_DIV;
+    else
+      break;
+
+    _expr_parse_unary (p);
+    _expr_emit_op (p, op, -1);
+  }
+}
+
+/**
+ * @brief Parse a sum.
+ */
+static void
+_expr_parse_sum (tif_expr_parser * p)
+{
+  tif_expr_opcode op;
+
+  _expr_parse_prod (p);
+  while (!p->failed) {
+    if (_expr_accept (p, "+"))
+      op = TIF_EXPR_ADD;
+    else if (_expr_accept (p, "-"))
+      op = TIF_EXPR_SUB;
+    else
+      break;
+
+    _expr_parse_prod (p);
+    _expr_emit_op (p, op, -1);
+  }
+}
+
+/**
+ * @brief Parse a comparison.
+ */
+static void
+_expr_parse_cmp (tif_expr_parser * p)
+{
+  tif_expr_opcode op;
+
+  _expr_parse_sum (p);
+  if (!p->failed && _expr_parse_cmp_op (p, &op)) {
+    _expr_parse_sum (p);
+    _expr_emit_op (p, op, -1);
+  }
+}
+
+/**
+ * @brief Parse a logical and.
+ */
+static void
+_expr_parse_and (tif_expr_parser * p)
+{
+  guint jump;
+
+  _expr_parse_cmp (p);
+  while (!p->failed && _expr_accept (p, "&&")) {
+    jump = _expr_emit_op (p, TIF_EXPR_AND, -1);
+    _expr_parse_cmp (p);
+    _expr_emit_op (p, TIF_EXPR_BOOL, 0);
+    g_array_index (p->insts, tif_expr_inst, jump).jump = p->insts->len;
+  }
+}
+
+/**
+ * @brief Parse a logical or.
+ */
+static void
+_expr_parse_or (tif_expr_parser * p)
+{
+  guint jump;
+
+  _expr_parse_and (p);
+  while (!p->failed && _expr_accept (p, "||")) {
+    jump = _expr_emit_op (p, TIF_EXPR_OR, -1);
+    _expr_parse_and (p);
+    _expr_emit_op (p, TIF_EXPR_BOOL, 0);
+    g_array_index (p->insts, tif_expr_inst, jump).jump = p->insts->len;
+  }
+}
+
+/**
+ * @brief Compile the expression for the input tensors.
+ */
+tensor_if_expr *
+gst_tensor_if_expr_compile (const gchar * str, const GstTensorsInfo * info)
+{
+  tif_expr_parser parser;
+  tensor_if_expr *expr;
+  guint i;
+
+  g_return_val_if_fail (str != NULL, NULL);
+  g_return_val_if_fail (info != NULL, NULL);
+
+  memset (&parser, 0, sizeof (parser));
+  parser.str = parser.pos = str;
+  parser.info = info;
+  parser.insts = g_array_new (FALSE, TRUE, sizeof (tif_expr_inst));
+
+  _expr_parse_or (&parser);
+
+  _expr_skip_space (&parser);
+  if (!parser.failed && *parser.pos != '\0')
+    _expr_error (&parser, "unexpected token");
+  if (!parser.failed && parser.insts->len == 0)
+    _expr_error (&parser, "empty expression");
+
+  if (parser.failed) {
+    g_array_free (parser.insts, TRUE);
+    return NULL;
+  }
+
+  expr = g_new0 (tensor_if_expr, 1);
+  expr->num_insts = parser.insts->len;
+  expr->insts = (tif_expr_inst *) g_array_free (parser.insts, FALSE);
+  expr->used_tensors = parser.used_tensors;
+
+  for (i = 0; i < info->num_tensors; i++)
+    expr->sizes[i] = gst_tensor_info_get_size (&info->info[i]);
+
+  return expr;
+}
+
+/**
+ * @brief Free the compiled expression.
+ */
+void
+gst_tensor_if_expr_free (tensor_if_expr * expr)
+{
+  if (expr == NULL)
+    return;
+
+  g_free (expr->insts);
+  g_free (expr);
+}
+
+/**
+ * @brief Get the bitmask of the tensors used in the expression.
+ */
+guint32
+gst_tensor_if_expr_get_used_tensors (const tensor_if_expr * expr)
+{
+  g_return_val_if_fail (expr != NULL, 0);
+
+  return expr->used_tensors;
+}
+
+/**
+ * @brief Count the elements satisfying the comparison.
+ */
+#define expr_count(ld,cmp,th,p,n,c) do { \
+  gsize _i; \
+  switch (cmp) { \
+    case TIF_EXPR_EQ: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) == th); break; \
+    case TIF_EXPR_NE: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) != th); break; \
+    case TIF_EXPR_LT: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) < th); break; \
+    case TIF_EXPR_LE: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) <= th); break; \
+    case TIF_EXPR_GT: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) > th); break; \
+    case TIF_EXPR_GE: for (_i = 0; _i < n; _i++) c += ((gdouble) ld (p[_i]) >= th); break; \
+    default: break; \
+  } \
+} while (0)
+
+/**
+ * @brief Reduce the range of the tensor with the type.
+ * @param ctype type of the element
+ * @param vtype type of the value to be compared
+ * @param ld conversion of the element to vtype
+ */
+#define expr_reduce_ld(ctype,vtype,ld,inst,data,ret) do { \
+  const ctype *_p = ((const ctype *) (data)) + (inst)->start; \
+  const gsize _n = (inst)->end - (inst)->start; \
+  gsize _i, _idx = 0; \
+  switch ((inst)->op) { \
+    case TIF_EXPR_LOAD: \
+      ret = (gdouble) ld (_p[0]); \
+      break; \
+    case TIF_EXPR_MAX: \
+    case TIF_EXPR_ARGMAX: \
+    { \
+      vtype _m = ld (_p[0]), _v; \
+      for (_i = 1; _i < _n; _i++) \
+        if ((_v = ld (_p[_i])) > _m) { _m = _v; _idx = _i; } \
+      ret = ((inst)->op == TIF_EXPR_MAX) ? (gdouble) _m : (gdouble) _idx; \
+      break; \
+    } \
+    case TIF_EXPR_MIN: \
+    case TIF_EXPR_ARGMIN: \
+    { \
+      vtype _m = ld (_p[0]), _v; \
+      for (_i = 1; _i < _n; _i++) \
+        if ((_v = ld (_p[_i])) < _m) { _m = _v; _idx = _i; } \
+      ret = ((inst)->op == TIF_EXPR_MIN) ? (gdouble) _m : (gdouble) _idx; \
+      break; \
+    } \
+    case TIF_EXPR_SUM: \
+    case TIF_EXPR_MEAN: \
+    { \
+      gdouble _s = 0.0; \
+      for (_i = 0; _i < _n; _i++) \
+        _s += (gdouble) ld (_p[_i]); \
+      ret = ((inst)->op == TIF_EXPR_SUM) ? _s : _s / (gdouble) _n; \
+      break; \
+    } \
+    case TIF_EXPR_COUNT: \
+    case TIF_EXPR_ANY: \
+    case TIF_EXPR_ALL: \
+    { \
+      gsize _c = 0; \
+      expr_count (ld, (inst)->cmp, (inst)->value, _p, _n, _c); \
+      if ((inst)->op == TIF_EXPR_COUNT) \
+        ret = (gdouble) _c; \
+      else if ((inst)->op == TIF_EXPR_ANY) \
+        ret = (_c > 0) ? 1.0 : 0.0; \
+      else \
+        ret = (_c == _n) ? 1.0 : 0.0; \
+      break; \
+    } \
+    default: \
+      break; \
+  } \
+} while (0)
+
+#define expr_reduce(ctype,inst,data,ret) \
+    expr_reduce_ld (ctype, ctype, (ctype), inst, data, ret)
+
+/**
+ * @brief Evaluate an instruction reading the tensor.
+ */
+static gdouble
+_expr_eval_tensor (const tif_expr_inst * inst, gconstpointer data)
+{
+  gdouble ret = 0.0;
+
+  switch (inst->type) {
+    case _NNS_INT32:
+      expr_reduce (int32_t, inst, data, ret);
+      break;
+    case _NNS_UINT32:
+      expr_reduce (uint32_t, inst, data, ret);
+      break;
+    case _NNS_INT16:
+      expr_reduce (int16_t, inst, data, ret);
+      break;
+    case _NNS_UINT16:
+      expr_reduce (uint16_t, inst, data, ret);
+      break;
+    case _NNS_INT8:
+      expr_reduce (int8_t, inst, data, ret);
+      break;
+    case _NNS_UINT8:
+      expr_reduce (uint8_t, inst, data, ret);
+      break;
+    case _NNS_FLOAT64:
+      expr_reduce (double, inst, data, ret);
+      break;
+    case _NNS_FLOAT32:
+      expr_reduce (float, inst, data, ret);
+      break;
+    case _NNS_INT64:
+      expr_reduce (int64_t, inst, data, ret);
+      break;
+    case _NNS_UINT64:
+      expr_reduce (uint64_t, inst, data, ret);
+      break;
+    case _NNS_FLOAT16:
+      expr_reduce_ld (uint16_t, float, gst_tensor_data_float16_to_float, inst,
+          data, ret);
+      break;
+    case _NNS_BFLOAT16:
+      expr_reduce_ld (uint16_t, float, gst_tensor_data_bfloat16_to_float, inst,
+          data, ret);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Evaluate the compiled expression.
+ */
+gboolean
+gst_tensor_if_expr_eval (const tensor_if_expr * expr,
+    const GstTensorMemory * tensors, gboolean * result)
+{
+  gdouble stack[TIF_EXPR_STACK_SIZE];
+  const tif_expr_inst *inst;
+  gint top = -1;
+  guint pc, i;
+
+  g_return_val_if_fail (expr != NULL, FALSE);
+  g_return_val_if_fail (tensors != NULL, FALSE);
+  g_return_val_if_fail (result != NULL, FALSE);
+
+  /* the tensors should be same with the info given at compile time */
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if ((expr->used_tensors & (1U << i)) &&
+        (tensors[i].data == NULL || tensors[i].size < expr->sizes[i])) {
+      nns_loge ("tensor_if: invalid memory of the tensor %u.", i);
+      return FALSE;
+    }
+  }
+
+  pc = 0;
+  while (pc < expr->num_insts) {
+    inst = &expr->insts[pc++];
+
+    switch (inst->op) {
+      case TIF_EXPR_CONST:
+        stack[++top] = inst->value;
+        break;
+      case TIF_EXPR_LOAD:
+      case TIF_EXPR_MAX:
+      case TIF_EXPR_MIN:
+      case TIF_EXPR_SUM:
+      case TIF_EXPR_MEAN:
+      case TIF_EXPR_ARGMAX:
+      case TIF_EXPR_ARGMIN:
+      case TIF_EXPR_COUNT:
+      case TIF_EXPR_ANY:
+      case TIF_EXPR_ALL:
+        stack[++top] = _expr_eval_tensor (inst, tensors[inst->nth].data);
+        break;
+      case TIF_EXPR_NEG:
+        stack[top] = -stack[top];
+        break;
+      case TIF_EXPR_NOT:
+        stack[top] = (stack[top] == 0.0) ? 1.0 : 0.0;
+        break;
+      case TIF_EXPR_BOOL:
+        stack[top] = (stack[top] != 0.0) ? 1.0 : 0.0;
+        break;
+      case TIF_EXPR_AND:
+        if (stack[top] == 0.0)
+          pc = inst->jump;
+        else
+          top--;
+        break;
+      case TIF_EXPR_OR:
+        if (stack[top] != 0.0) {
+          stack[top] = 1.0;
+          pc = inst->jump;
+        } else {
+          top--;
+        }
+        break;
+      default:
+      {
+        gdouble b = stack[top--];
+        gdouble a = stack[top];
+
+        switch (inst->op) {
+          case TIF_EXPR_ADD:
+            a = a + b;
+            break;
+          case TIF_EXPR_SUB:
+            a = a - b;
+            break;
+          case TIF_EXPR_MUL:
+            a = a * b;
+            break;
+          case TIF_EXPR_DIV:
+            a = a / b;
+            break;
+          case TIF_EXPR_EQ:
+            a = (a == b);
+            break;
+          case TIF_EXPR_NE:
+            a = (a != b);
+            break;
+          case TIF_EXPR_LT:
+            a = (a < b);
+            break;
+          case TIF_EXPR_LE:
+            a = (a <= b);
+            break;
+          case TIF_EXPR_GT:
+            a = (a > b);
+            break;
+          case TIF_EXPR_GE:
+            a = (a >= b);
+            break;
+          default:
+            nns_loge ("tensor_if: unknown opcode %d.", inst->op);
+            return FALSE;
+        }
+
+        stack[top] = a;
+        break;
+      }
+    }
+  }
+
+  *result = (top == 0 && stack[0] != 0.0);
+  return (top == 0);
+}
@@ -0,0 +1,83 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-IF
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	gsttensorif_expr.h
+ * @date	18 Oct 2021
+ * @brief	Expression engine of tensor_if (compared-value=EXPR)
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs except for NYI items
+ *
+ * @details
+ *	An expression is compiled once with the input tensors info into a
+ *	bytecode, and evaluated for each buffer without memory allocation.
+ *
+ *	expr    := or
+ *	or      := and ( '||' and )*
+ *	and     := cmp ( '&&' cmp )*
+ *	cmp     := sum ( ( '==' | '!=' | '<' | '<=' | '>' | '>=' ) sum )?
+ *	sum     := prod ( ( '+' | '-' ) prod )*
+ *	prod    := unary ( ( '*' | '/' ) unary )*
+ *	unary   := ( '-' | '!' ) unary | primary
+ *	primary := NUMBER | '(' expr ')' | element | func '(' range ')'
+ *	         | pred '(' range cmp-op NUMBER ')'
+ *	element := 't' '[' N ']' '[' INDEX ']'
+ *	range   := 't' '[' N ']' ( '[' START? ':' END? ']' )?
+ *	func    := max | min | sum | mean | argmax | argmin
+ *	pred    := count | any | all
+ *
+ *	N is the index of the tensor, and INDEX, START and END are the flat
+ *	element indices of the tensor (innermost dimension first). A range is
+ *	half-open [START, END). The values are evaluated in double, and the
+ *	condition is TRUE if the result is not zero.
+ *
+ *	e.g., "max(t[1][0:90]) > 0.6 && t[3][0] >= 1"
+ *	      "count(t[0] > 0.5) >= 3"
+ */
+#ifndef __GST_TENSOR_IF_EXPR_H__
+#define __GST_TENSOR_IF_EXPR_H__
+
+#include <glib.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+typedef struct _tensor_if_expr tensor_if_expr;
+
+/**
+ * @brief Compile the expression for the input tensors.
+ * @param[in] str The expression string.
+ * @param[in] info The input tensors info.
+ * @return Newly allocated compiled expression, or NULL if the expression is invalid. Free it with gst_tensor_if_expr_free().
+ */
+extern tensor_if_expr *
+gst_tensor_if_expr_compile (const gchar * str, const GstTensorsInfo * info);
+
+/**
+ * @brief Free the compiled expression.
+ */
+extern void
+gst_tensor_if_expr_free (tensor_if_expr * expr);
+
+/**
+ * @brief Get the bitmask of the tensors used in the expression (nth bit for nth tensor).
+ */
+extern guint32
+gst_tensor_if_expr_get_used_tensors (const tensor_if_expr * expr);
+
+/**
+ * @brief Evaluate the compiled expression.
+ * @param[in] expr The compiled expression.
+ * @param[in] tensors The input tensors. Only the tensors used in the expression should be valid.
+ * @param[out] result TRUE if the result of the expression is not zero.
+ * @return TRUE if no error.
+ */
+extern gboolean
+gst_tensor_if_expr_eval (const tensor_if_expr * expr,
+    const GstTensorMemory * tensors, gboolean * result);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_IF_EXPR_H__ */
@@ -89,6 +89,7 @@ enum
   PROP_SYNC_MODE,
   PROP_SYNC_OPTION,
   PROP_SILENT,
+  PROP_SYNC_STATS,
 };
 
 static const gchar *gst_tensor_merge_mode_string[] = {
@@ -133,6 +134,9 @@ static gboolean gst_tensor_merge_sink_event (GstCollectPads * pads,
     GstCollectData * data, GstEvent * event, GstTensorMerge * tensor_merge);
 static GstFlowReturn gst_tensor_merge_collected (GstCollectPads * pads,
     GstTensorMerge * tensor_merge);
+static GstFlowReturn gst_tensor_merge_do_clip (GstCollectPads * pads,
+    GstCollectData * data, GstBuffer * buffer, GstBuffer ** out,
+    GstTensorMerge * tensor_merge);
 
 static void gst_tensor_merge_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -189,6 +193,12 @@ gst_tensor_merge_class_init (GstTensorMergeClass * klass)
       g_param_spec_string ("sync-option", "Sync Option",
           "Option for the time synchronization mode", "", G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_SYNC_STATS,
+      g_param_spec_boxed ("sync-stats", "Sync Stats",
+          "Statistics of each sink pad for the time synchronization "
+          "(the number of received and dropped buffers, latency)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_tensor_merge_request_new_pad);
   gstelement_class->change_state =
@@ -232,6 +242,9 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   gst_collect_pads_set_function (tensor_merge->collect,
       (GstCollectPadsFunction) GST_DEBUG_FUNCPTR (gst_tensor_merge_collected),
       tensor_merge);
+  gst_collect_pads_set_clip_function (tensor_merge->collect,
+      (GstCollectPadsClipFunction) GST_DEBUG_FUNCPTR (gst_tensor_merge_do_clip),
+      tensor_merge);
 
   tensor_merge->silent = TRUE;
   tensor_merge->sync.mode = SYNC_NOSYNC;
@@ -320,10 +333,22 @@ gst_tensor_merge_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
   if (newpad) {
     GstTensorCollectPadData *tensormergepad;
+    gboolean locked, waiting;
+
+    locked = waiting = TRUE;
+
+    /* refresh mode keeps the locked pads, only nearest mode does not wait */
+    if (tensor_merge->sync.mode == SYNC_NEAREST) {
+      locked = waiting = FALSE;
+    }
 
     tensormergepad = (GstTensorCollectPadData *)
         gst_collect_pads_add_pad (tensor_merge->collect, newpad,
-        sizeof (GstTensorCollectPadData), NULL, TRUE);
+        sizeof (GstTensorCollectPadData), NULL, locked);
+
+    /* NOTE: if locked is TRUE, waiting flag is not effective */
+    gst_collect_pads_set_waiting (tensor_merge->collect,
+        (GstCollectData *) tensormergepad, waiting);
 
     tensormergepad->pad = newpad;
     gst_pad_set_element_private (newpad, tensormergepad);
@@ -353,6 +378,23 @@ gst_tensor_merge_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
   return gst_pad_event_default (pad, parent, event);
 }
 
+/**
+ * @brief set pads waiting property (nearest mode only)
+ */
+static void
+gst_tensor_merge_set_waiting (GstTensorMerge * tensor_merge, gboolean waiting)
+{
+  if (tensor_merge->sync.mode == SYNC_NEAREST) {
+    GstCollectPads *pads = tensor_merge->collect;
+    GSList *walk = pads->data;
+
+    while (walk) {
+      gst_collect_pads_set_waiting (pads, walk->data, waiting);
+      walk = g_slist_next (walk);
+    }
+  }
+}
+
 /**
  * @brief sink event vmethod
  */
@@ -368,6 +410,9 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
       tensor_merge->need_set_time = TRUE;
       gst_tensor_time_sync_flush (tensor_merge->collect);
       break;
+    case GST_EVENT_EOS:
+      gst_tensor_merge_set_waiting (tensor_merge, FALSE);
+      break;
     default:
       break;
   }
@@ -499,7 +544,7 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
     outSize += mInfo[i].size;
   }
 
-  outMem = gst_allocator_alloc (NULL, outSize, NULL);
+  outMem = gst_tensor_alloc_memory (outSize);
   if (!gst_memory_map (outMem, &outInfo, GST_MAP_WRITE)) {
     gst_allocator_free (NULL, outMem);
     ml_logf ("Cannot map output memory buffer\n");
@@ -675,6 +720,7 @@ gst_tensor_merge_collected (GstCollectPads * pads,
   GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *tensors_buf, *tensor_buf;
   gboolean isEOS = FALSE;
+  gboolean buf_collected = FALSE;
 
   GST_DEBUG_OBJECT (tensor_merge, " all pads are collected ");
 
@@ -691,7 +737,12 @@ gst_tensor_merge_collected (GstCollectPads * pads,
     return GST_FLOW_ERROR;
   }
 
-  if (!gst_tensor_merge_collect_buffer (tensor_merge, tensors_buf, &isEOS)) {
+  buf_collected =
+      gst_tensor_merge_collect_buffer (tensor_merge, tensors_buf, &isEOS);
+
+  gst_tensor_merge_set_waiting (tensor_merge, TRUE);
+
+  if (!buf_collected) {
     if (isEOS) {
       gst_pad_push_event (tensor_merge->srcpad, gst_event_new_eos ());
       ret = GST_FLOW_EOS;
@@ -728,6 +779,18 @@ beach:
   return ret;
 }
 
+/**
+ * @brief Gst Clip Pads Function which is called right after a buffer is received for each pad.
+ */
+static GstFlowReturn
+gst_tensor_merge_do_clip (GstCollectPads * pads, GstCollectData * data,
+    GstBuffer * buffer, GstBuffer ** out, GstTensorMerge * tensor_merge)
+{
+  gst_tensor_merge_set_waiting (tensor_merge, FALSE);
+  *out = buffer;
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Ready --> Pasuse State Change
  */
@@ -765,6 +828,8 @@ gst_tensor_merge_change_state (GstElement * element, GstStateChange transition)
     return ret;
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* drop the queued buffers, not to replay old buffers when restarting */
+      gst_tensor_time_sync_flush (tensor_merge->collect);
       break;
     default:
       break;
@@ -880,6 +945,10 @@ gst_tensor_merge_get_property (GObject * object, guint prop_id,
     case PROP_SYNC_OPTION:
       g_value_set_string (value, tensor_merge->sync.option);
       break;
+    case PROP_SYNC_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_time_sync_get_stats (tensor_merge->collect));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
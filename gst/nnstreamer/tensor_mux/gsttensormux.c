@@ -89,6 +89,7 @@ enum
   PROP_SILENT,
   PROP_SYNC_MODE,
   PROP_SYNC_OPTION,
+  PROP_SYNC_STATS,
 };
 
 /**
@@ -173,6 +174,12 @@ gst_tensor_mux_class_init (GstTensorMuxClass * klass)
       g_param_spec_string ("sync-option", "Sync Option",
           "Option for the time synchronization mode ?", "", G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_SYNC_STATS,
+      g_param_spec_boxed ("sync-stats", "Sync Stats",
+          "Statistics of each sink pad for the time synchronization "
+          "(the number of received and dropped buffers, latency)",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_tensor_mux_request_new_pad);
   gstelement_class->change_state =
@@ -280,7 +287,7 @@ gst_tensor_mux_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
     locked = waiting = TRUE;
 
-    if (tensor_mux->sync.mode == SYNC_REFRESH) {
+    if (gst_tensor_time_sync_is_nonblocking (&tensor_mux->sync)) {
       locked = waiting = FALSE;
     }
 
@@ -326,7 +333,7 @@ gst_tensor_mux_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 static void
 gst_tensor_mux_set_waiting (GstTensorMux * tensor_mux, gboolean waiting)
 {
-  if (tensor_mux->sync.mode == SYNC_REFRESH) {
+  if (gst_tensor_time_sync_is_nonblocking (&tensor_mux->sync)) {
     GstCollectPads *pads = tensor_mux->collect;
     GSList *walk = pads->data;
 
@@ -465,7 +472,7 @@ gst_tensor_mux_chain_flex_tensor (GstTensorMux * tensor_mux, GstBuffer * buf)
     if (gst_tensor_info_is_flexible (&info->info[i])) {
       mem = gst_memory_ref (mem);
     } else {
-      /* append header */
+      /* append header, tensor data is shared if memory has the prefix */
       gst_tensor_info_convert_to_meta (&info->info[i], &meta);
       mem = gst_tensor_meta_info_append_header (&meta, mem);
     }
@@ -593,6 +600,8 @@ gst_tensor_mux_change_state (GstElement * element, GstStateChange transition)
     return ret;
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* drop the queued buffers, not to replay old buffers when restarting */
+      gst_tensor_time_sync_flush (tensor_mux->collect);
       break;
     default:
       break;
@@ -653,6 +662,10 @@ gst_tensor_mux_get_property (GObject * object, guint prop_id,
     case PROP_SYNC_OPTION:
       g_value_set_string (value, tensor_mux->sync.option);
       break;
+    case PROP_SYNC_STATS:
+      g_value_take_boxed (value,
+          gst_tensor_time_sync_get_stats (tensor_mux->collect));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
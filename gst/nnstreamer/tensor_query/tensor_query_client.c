@@ -24,6 +24,48 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_client_debug);
  */
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_DEFAULT ";" GST_TENSORS_FLEX_CAP_DEFAULT
 
+/**
+ * @brief Default max number of requests waiting for the responses.
+ */
+#define DEFAULT_MAX_IN_FLIGHT 4
+
+/**
+ * @brief Default timeout (msec) of a request not responded.
+ */
+#define DEFAULT_TIMEOUT 10000
+
+/**
+ * @brief Time to wait for the remaining responses at EOS.
+ */
+#define EOS_TIMEOUT (10 * G_TIME_SPAN_SECOND)
+
+/**
+ * @brief Properties.
+ */
+enum
+{
+  PROP_0,
+  PROP_HOST,
+  PROP_PORT,
+  PROP_PROTOCOL,
+  PROP_MAX_IN_FLIGHT,
+  PROP_TIMEOUT,
+  PROP_LATENCY,
+  PROP_MAX_LATENCY
+};
+
+/**
+ * @brief Information of the request to restore it in the response.
+ */
+typedef struct
+{
+  GstClockTime pts; /**< presentation timestamp */
+  GstClockTime dts; /**< decoding timestamp */
+  GstClockTime duration; /**< duration */
+  guint64 offset; /**< offset */
+  gint64 sent_time; /**< monotonic time (usec) when the request is sent */
+} QueryRequest;
+
 /**
  * @brief the capabilities of the inputs.
  */
@@ -42,7 +84,7 @@ static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
 
 #define gst_tensor_query_client_parent_class parent_class
 G_DEFINE_TYPE (GstTensorQueryClient, gst_tensor_query_client,
-    GST_TYPE_BASE_TRANSFORM);
+    GST_TYPE_ELEMENT);
 
 /* GObject vmethod implementations */
 static void gst_tensor_query_client_set_property (GObject * object,
@@ -51,6 +93,17 @@ static void gst_tensor_query_client_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 static void gst_tensor_query_client_finalize (GObject * object);
 
+static GstStateChangeReturn gst_tensor_query_client_change_state (GstElement *
+    element, GstStateChange transition);
+static gboolean gst_tensor_query_client_sink_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+static gboolean gst_tensor_query_client_sink_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static gboolean gst_tensor_query_client_src_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static GstFlowReturn gst_tensor_query_client_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buf);
+
 /**
  * @brief initialize the class
  */
@@ -59,17 +112,44 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
 {
   GObjectClass *gobject_class;
   GstElementClass *gstelement_class;
-  GstBaseTransformClass *trans_class;
 
-  trans_class = (GstBaseTransformClass *) klass;
-  gstelement_class = (GstElementClass *) trans_class;
+  gstelement_class = (GstElementClass *) klass;
   gobject_class = (GObjectClass *) gstelement_class;
 
   gobject_class->set_property = gst_tensor_query_client_set_property;
   gobject_class->get_property = gst_tensor_query_client_get_property;
   gobject_class->finalize = gst_tensor_query_client_finalize;
 
-  /** install property goes here */
+  g_object_class_install_property (gobject_class, PROP_HOST,
+      g_param_spec_string ("host", "Host", "The hostname of the server",
+          DEFAULT_QUERY_HOST, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_PORT,
+      g_param_spec_uint ("port", "Port", "The port of the server",
+          0, 65535, DEFAULT_QUERY_PORT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_PROTOCOL,
+      g_param_spec_string ("protocol", "Protocol",
+          "The network protocol to send requests (tcp)",
+          DEFAULT_QUERY_PROTOCOL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_IN_FLIGHT,
+      g_param_spec_uint ("max-in-flight", "Max in-flight",
+          "The max number of requests sent without waiting for the responses",
+          1, G_MAXUINT, DEFAULT_MAX_IN_FLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_TIMEOUT,
+      g_param_spec_uint ("timeout", "Timeout",
+          "The time (msec) to wait for the response of a request, "
+          "the request is dropped after the timeout (0 to wait infinitely)",
+          0, G_MAXUINT, DEFAULT_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY,
+      g_param_spec_uint64 ("latency", "Latency",
+          "The average round-trip latency of the requests in microseconds",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_LATENCY,
+      g_param_spec_uint64 ("max-latency", "Max latency",
+          "The max round-trip latency of the requests in microseconds",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -81,7 +161,8 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
       "Handle querying tensor data through the network",
       "Samsung Electronics Co., Ltd.");
 
-  /** method override goes here */
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_change_state);
 
   GST_DEBUG_CATEGORY_INIT (gst_tensor_query_client_debug, "tensor_query_client",
       0, "Tensor Query Client");
@@ -93,7 +174,32 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
 static void
 gst_tensor_query_client_init (GstTensorQueryClient * self)
 {
-  return;
+  self->sinkpad = gst_pad_new_from_static_template (&sinktemplate, "sink");
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_sink_event));
+  gst_pad_set_query_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_sink_query));
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_chain));
+  gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
+
+  self->srcpad = gst_pad_new_from_static_template (&srctemplate, "src");
+  gst_pad_set_query_function (self->srcpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_query_client_src_query));
+  gst_pad_use_fixed_caps (self->srcpad);
+  gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
+
+  self->host = g_strdup (DEFAULT_QUERY_HOST);
+  self->port = DEFAULT_QUERY_PORT;
+  self->protocol = QUERY_PROTOCOL_TCP;
+  self->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+  self->timeout = DEFAULT_TIMEOUT;
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  self->requests = g_hash_table_new_full (g_int64_hash, g_int64_equal,
+      g_free, g_free);
+  self->last_ret = GST_FLOW_OK;
 }
 
 /**
@@ -102,6 +208,17 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
 static void
 gst_tensor_query_client_finalize (GObject * object)
 {
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (object);
+
+  g_free (self->host);
+  g_hash_table_destroy (self->requests);
+  gst_caps_replace (&self->in_caps, NULL);
+  gst_caps_replace (&self->out_caps, NULL);
+  gst_event_replace (&self->segment, NULL);
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -112,7 +229,49 @@ static void
 gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
-  return;
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (object);
+
+  switch (prop_id) {
+    case PROP_HOST:
+      if (!g_value_get_string (value)) {
+        GST_WARNING_OBJECT (self, "host property cannot be NULL");
+        break;
+      }
+      g_free (self->host);
+      self->host = g_value_dup_string (value);
+      break;
+    case PROP_PORT:
+      self->port = g_value_get_uint (value);
+      break;
+    case PROP_PROTOCOL:
+    {
+      tensor_query_protocol protocol;
+
+      protocol = gst_tensor_query_get_protocol (g_value_get_string (value));
+      if (protocol == QUERY_PROTOCOL_END) {
+        GST_WARNING_OBJECT (self, "Invalid protocol '%s'",
+            g_value_get_string (value));
+        break;
+      }
+      self->protocol = protocol;
+      break;
+    }
+    case PROP_MAX_IN_FLIGHT:
+      g_mutex_lock (&self->lock);
+      self->max_in_flight = g_value_get_uint (value);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_TIMEOUT:
+      g_mutex_lock (&self->lock);
+      self->timeout = g_value_get_uint (value);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 /**
@@ -122,5 +281,566 @@ static void
 gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
 {
-  return;
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (object);
+
+  switch (prop_id) {
+    case PROP_HOST:
+      g_value_set_string (value, self->host);
+      break;
+    case PROP_PORT:
+      g_value_set_uint (value, self->port);
+      break;
+    case PROP_PROTOCOL:
+      g_value_set_string (value,
+          gst_tensor_query_get_protocol_string (self->protocol));
+      break;
+    case PROP_MAX_IN_FLIGHT:
+      g_value_set_uint (value, self->max_in_flight);
+      break;
+    case PROP_TIMEOUT:
+      g_value_set_uint (value, self->timeout);
+      break;
+    case PROP_LATENCY:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint64 (value, (self->num_responses > 0) ?
+          self->total_latency / self->num_responses : 0);
+      g_mutex_unlock (&self->lock);
+      break;
+    case PROP_MAX_LATENCY:
+      g_mutex_lock (&self->lock);
+      g_value_set_uint64 (value, self->max_latency);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Push the caps and the pending segment of the responses.
+ */
+static void
+_push_caps (GstTensorQueryClient * self, GstCaps * caps)
+{
+  GstEvent *segment;
+
+  g_mutex_lock (&self->lock);
+  if (self->out_caps && gst_caps_is_equal (self->out_caps, caps)) {
+    g_mutex_unlock (&self->lock);
+    return;
+  }
+
+  gst_caps_replace (&self->out_caps, caps);
+  segment = self->segment;
+  self->segment = NULL;
+  g_mutex_unlock (&self->lock);
+
+  /* downstream may query the caps, do not hold the lock */
+  gst_pad_push_event (self->srcpad, gst_event_new_caps (caps));
+  if (segment)
+    gst_pad_push_event (self->srcpad, segment);
+}
+
+/**
+ * @brief Check whether the request is sent before the given one.
+ */
+static gboolean
+_is_former_request (gpointer key, gpointer value, gpointer user_data)
+{
+  return *((guint64 *) key) < *((guint64 *) user_data);
+}
+
+/**
+ * @brief Drop the requests not responded until the timeout (locked).
+ * @return the earliest deadline (monotonic time) of the remaining requests, or 0 if there is no deadline.
+ */
+static gint64
+_expire_requests (GstTensorQueryClient * self)
+{
+  GHashTableIter iter;
+  QueryRequest *req;
+  gint64 now, deadline, next = 0;
+  guint expired = 0;
+
+  if (self->timeout == 0)
+    return 0;
+
+  now = g_get_monotonic_time ();
+
+  g_hash_table_iter_init (&iter, self->requests);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer *) & req)) {
+    deadline = req->sent_time + (gint64) self->timeout * G_TIME_SPAN_MILLISECOND;
+
+    if (deadline <= now) {
+      g_hash_table_iter_remove (&iter);
+      expired++;
+    } else if (next == 0 || deadline < next) {
+      next = deadline;
+    }
+  }
+
+  if (expired > 0) {
+    GST_WARNING_OBJECT (self, "%u requests are not responded in %u msec, "
+        "dropped.", expired, self->timeout);
+    g_cond_broadcast (&self->cond);
+  }
+
+  return next;
+}
+
+/**
+ * @brief Thread to receive the responses and push them.
+ */
+static gpointer
+_receive_thread (gpointer data)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (data);
+  TensorQueryConnection *conn = self->conn;
+  TensorQueryCommand cmd;
+  QueryRequest *req;
+  GstBuffer *buffer;
+  GstFlowReturn ret;
+  guint64 seq;
+  gint64 latency = 0;
+  gboolean negotiated, closed;
+
+  while (TRUE) {
+    buffer = NULL;
+    ret = gst_tensor_query_receive (conn, &cmd, &seq, &buffer);
+    if (ret != GST_FLOW_OK)
+      break;
+
+    if (cmd == TENSOR_QUERY_CMD_CAPS) {
+      _push_caps (self, conn->caps);
+      continue;
+    }
+
+    g_mutex_lock (&self->lock);
+    req = g_hash_table_lookup (self->requests, &seq);
+    if (req) {
+      guint retired;
+
+      /* the responses arrive in order, the former requests are dropped in the server */
+      retired = g_hash_table_foreach_remove (self->requests,
+          _is_former_request, &seq);
+      if (retired > 0) {
+        GST_WARNING_OBJECT (self, "%u requests before %" G_GUINT64_FORMAT
+            " are not responded, dropped in the server.", retired, seq);
+        g_cond_broadcast (&self->cond);
+      }
+
+      GST_BUFFER_PTS (buffer) = req->pts;
+      GST_BUFFER_DTS (buffer) = req->dts;
+      GST_BUFFER_DURATION (buffer) = req->duration;
+      GST_BUFFER_OFFSET (buffer) = req->offset;
+
+      latency = g_get_monotonic_time () - req->sent_time;
+      self->num_responses++;
+      self->total_latency += latency;
+      if ((guint64) latency > self->max_latency)
+        self->max_latency = latency;
+    }
+    negotiated = (self->out_caps != NULL);
+    g_mutex_unlock (&self->lock);
+
+    if (!req) {
+      /* flushed or unknown request */
+      GST_DEBUG_OBJECT (self, "Drop the response %" G_GUINT64_FORMAT, seq);
+      gst_buffer_unref (buffer);
+      continue;
+    }
+
+    GST_LOG_OBJECT (self, "Response %" G_GUINT64_FORMAT ", latency %"
+        G_GINT64_FORMAT " usec", seq, latency);
+
+    if (negotiated) {
+      ret = gst_pad_push (self->srcpad, buffer);
+    } else {
+      GST_WARNING_OBJECT (self, "Received data before caps, drop it.");
+      gst_buffer_unref (buffer);
+      ret = GST_FLOW_OK;
+    }
+
+    /* the request is done after pushing the response, EOS waits for it */
+    g_mutex_lock (&self->lock);
+    g_hash_table_remove (self->requests, &seq);
+    if (ret != GST_FLOW_OK && ret != GST_FLOW_FLUSHING)
+      self->last_ret = ret;
+    g_cond_broadcast (&self->cond);
+    g_mutex_unlock (&self->lock);
+
+    if (ret != GST_FLOW_OK) {
+      GST_DEBUG_OBJECT (self, "Failed to push the response: %s",
+          gst_flow_get_name (ret));
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  closed = (!self->flushing && ret != GST_FLOW_FLUSHING);
+  if (closed)
+    self->last_ret = GST_FLOW_ERROR;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  if (closed) {
+    GST_ELEMENT_ERROR (self, RESOURCE, READ,
+        ("The connection to the server is closed."), (NULL));
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Connect to the server.
+ */
+static gboolean
+_connect (GstTensorQueryClient * self)
+{
+  if (self->protocol != QUERY_PROTOCOL_TCP) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("Protocol '%s' is not supported yet.",
+            gst_tensor_query_get_protocol_string (self->protocol)), (NULL));
+    return FALSE;
+  }
+
+  self->conn = gst_tensor_query_connect (self->host, self->port);
+  if (!self->conn) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_WRITE,
+        ("Failed to connect to %s:%u.", self->host, self->port), (NULL));
+    return FALSE;
+  }
+
+  self->seq = 0;
+  self->flushing = FALSE;
+  self->last_ret = GST_FLOW_OK;
+  self->num_responses = self->total_latency = self->max_latency = 0;
+
+  self->thread = g_thread_new ("query-response", _receive_thread, self);
+  return TRUE;
+}
+
+/**
+ * @brief Wake up the waiting threads and close the connection.
+ */
+static void
+_close (GstTensorQueryClient * self)
+{
+  g_mutex_lock (&self->lock);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  if (self->conn)
+    gst_tensor_query_connection_close (self->conn);
+}
+
+/**
+ * @brief Release the connection and the requests.
+ */
+static void
+_cleanup (GstTensorQueryClient * self)
+{
+  if (self->thread) {
+    g_thread_join (self->thread);
+    self->thread = NULL;
+  }
+
+  if (self->conn) {
+    gst_tensor_query_connection_unref (self->conn);
+    self->conn = NULL;
+  }
+
+  g_hash_table_remove_all (self->requests);
+  gst_caps_replace (&self->in_caps, NULL);
+  gst_caps_replace (&self->out_caps, NULL);
+  gst_event_replace (&self->segment, NULL);
+}
+
+/**
+ * @brief Change state of the element.
+ */
+static GstStateChangeReturn
+gst_tensor_query_client_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (element);
+  GstStateChangeReturn ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      if (!_connect (self))
+        return GST_STATE_CHANGE_FAILURE;
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      _close (self);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      if (ret == GST_STATE_CHANGE_FAILURE) {
+        _close (self);
+        _cleanup (self);
+      }
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      _cleanup (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Wait for the responses of all requests.
+ */
+static void
+_wait_responses (GstTensorQueryClient * self)
+{
+  gint64 end_time = g_get_monotonic_time () + EOS_TIMEOUT;
+  gint64 deadline;
+
+  g_mutex_lock (&self->lock);
+  while (!self->flushing && self->last_ret == GST_FLOW_OK &&
+      g_hash_table_size (self->requests) > 0) {
+    deadline = _expire_requests (self);
+    if (g_hash_table_size (self->requests) == 0)
+      break;
+
+    if (deadline == 0 || deadline > end_time)
+      deadline = end_time;
+
+    if (!g_cond_wait_until (&self->cond, &self->lock, deadline) &&
+        g_get_monotonic_time () >= end_time) {
+      GST_WARNING_OBJECT (self, "Timeout, %u responses are not received.",
+          g_hash_table_size (self->requests));
+      break;
+    }
+  }
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Handle the events of the requests.
+ */
+static gboolean
+gst_tensor_query_client_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (parent);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+
+      /* caps of the requests is sent to the server, the server gives the caps of the responses */
+      gst_event_parse_caps (event, &caps);
+      g_mutex_lock (&self->lock);
+      gst_caps_replace (&self->in_caps, caps);
+      g_mutex_unlock (&self->lock);
+      gst_event_unref (event);
+      return TRUE;
+    }
+    case GST_EVENT_SEGMENT:
+      g_mutex_lock (&self->lock);
+      if (!self->out_caps) {
+        /* push it after the caps of the responses */
+        gst_event_replace (&self->segment, event);
+        g_mutex_unlock (&self->lock);
+        gst_event_unref (event);
+        return TRUE;
+      }
+      g_mutex_unlock (&self->lock);
+      break;
+    case GST_EVENT_EOS:
+      _wait_responses (self);
+      break;
+    case GST_EVENT_FLUSH_START:
+      g_mutex_lock (&self->lock);
+      self->flushing = TRUE;
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&self->lock);
+      self->flushing = FALSE;
+      self->last_ret = GST_FLOW_OK;
+      /* the responses of the flushed requests are dropped */
+      g_hash_table_remove_all (self->requests);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+/**
+ * @brief Handle the queries of the sink pad. The caps of the requests are independent of the responses.
+ */
+static gboolean
+gst_tensor_query_client_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *caps, *filter;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_pad_get_pad_template_caps (pad);
+      if (filter) {
+        GstCaps *intersection;
+
+        intersection =
+            gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = intersection;
+      }
+
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    case GST_QUERY_ACCEPT_CAPS:
+    {
+      GstCaps *caps, *template_caps;
+
+      gst_query_parse_accept_caps (query, &caps);
+      template_caps = gst_pad_get_pad_template_caps (pad);
+      gst_query_set_accept_caps_result (query,
+          gst_caps_can_intersect (caps, template_caps));
+      gst_caps_unref (template_caps);
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/**
+ * @brief Handle the queries of the src pad.
+ */
+static gboolean
+gst_tensor_query_client_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (parent);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *caps, *filter;
+
+      gst_query_parse_caps (query, &filter);
+
+      g_mutex_lock (&self->lock);
+      caps = self->out_caps ? gst_caps_ref (self->out_caps) :
+          gst_pad_get_pad_template_caps (pad);
+      g_mutex_unlock (&self->lock);
+
+      if (filter) {
+        GstCaps *intersection;
+
+        intersection =
+            gst_caps_intersect_full (filter, caps, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = intersection;
+      }
+
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_query_default (pad, parent, query);
+}
+
+/**
+ * @brief Send the request, responses are pushed by the receiving thread.
+ */
+static GstFlowReturn
+gst_tensor_query_client_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buf)
+{
+  GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (parent);
+  QueryRequest *req;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstCaps *caps;
+  guint64 *key;
+  guint64 seq;
+
+  g_mutex_lock (&self->lock);
+  /* pipelining, the requests are sent without waiting for the responses up to max-in-flight */
+  while (!self->flushing && self->last_ret == GST_FLOW_OK &&
+      g_hash_table_size (self->requests) >= self->max_in_flight) {
+    gint64 deadline = _expire_requests (self);
+
+    if (g_hash_table_size (self->requests) < self->max_in_flight)
+      break;
+
+    if (deadline > 0)
+      g_cond_wait_until (&self->cond, &self->lock, deadline);
+    else
+      g_cond_wait (&self->cond, &self->lock);
+  }
+
+  if (self->flushing)
+    ret = GST_FLOW_FLUSHING;
+  else if (self->last_ret != GST_FLOW_OK)
+    ret = self->last_ret;
+
+  if (ret != GST_FLOW_OK || !self->in_caps) {
+    g_mutex_unlock (&self->lock);
+    gst_buffer_unref (buf);
+    return (ret != GST_FLOW_OK) ? ret : GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  seq = self->seq++;
+
+  req = g_new0 (QueryRequest, 1);
+  req->pts = GST_BUFFER_PTS (buf);
+  req->dts = GST_BUFFER_DTS (buf);
+  req->duration = GST_BUFFER_DURATION (buf);
+  req->offset = GST_BUFFER_OFFSET (buf);
+  req->sent_time = g_get_monotonic_time ();
+
+  key = g_new (guint64, 1);
+  *key = seq;
+  g_hash_table_insert (self->requests, key, req);
+  caps = gst_caps_ref (self->in_caps);
+  g_mutex_unlock (&self->lock);
+
+  /* caps is sent once per connection, or when it is changed */
+  if (!gst_tensor_query_send_caps (self->conn, caps) ||
+      !gst_tensor_query_send_buffer (self->conn, seq, buf)) {
+    g_mutex_lock (&self->lock);
+    g_hash_table_remove (self->requests, &seq);
+    ret = self->flushing ? GST_FLOW_FLUSHING : GST_FLOW_ERROR;
+    g_mutex_unlock (&self->lock);
+
+    if (ret == GST_FLOW_ERROR) {
+      GST_ELEMENT_ERROR (self, RESOURCE, WRITE,
+          ("Failed to send the request to the server."), (NULL));
+    }
+  }
+
+  gst_caps_unref (caps);
+
+  gst_buffer_unref (buf);
+  return ret;
 }
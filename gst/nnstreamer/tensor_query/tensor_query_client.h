@@ -14,8 +14,8 @@
 #define __GST_TENSOR_QUERY_CLIENT_H__
 
 #include <gst/gst.h>
-#include <gst/base/gstbasetransform.h>
 #include <tensor_common.h>
+#include "tensor_query_common.h"
 
 G_BEGIN_DECLS
 
@@ -39,7 +39,34 @@ typedef struct _GstTensorQueryClientClass GstTensorQueryClientClass;
  */
 struct _GstTensorQueryClient
 {
-  GstBaseTransform element; /**< parent object */
+  GstElement element; /**< parent object */
+
+  GstPad *sinkpad; /**< sink pad, requests */
+  GstPad *srcpad; /**< src pad, responses */
+
+  gchar *host; /**< host of the server */
+  guint16 port; /**< port of the server */
+  tensor_query_protocol protocol; /**< network protocol */
+  guint max_in_flight; /**< max number of requests waiting for the responses */
+  guint timeout; /**< timeout (msec) of a request not responded, 0 to wait infinitely */
+
+  TensorQueryConnection *conn; /**< persistent connection to the server */
+  GThread *thread; /**< thread to receive the responses */
+
+  GMutex lock; /**< lock for the requests */
+  GCond cond; /**< signaled when a response is received */
+  GHashTable *requests; /**< requests waiting for the responses (seq to request info) */
+  guint64 seq; /**< sequence number of the next request */
+  gboolean flushing; /**< flushing state */
+  GstFlowReturn last_ret; /**< last flow return of the responses */
+
+  GstCaps *in_caps; /**< caps of the requests */
+  GstCaps *out_caps; /**< caps of the responses, given by the server */
+  GstEvent *segment; /**< segment event pushed after the caps of the responses */
+
+  guint64 num_responses; /**< the number of the responses received */
+  guint64 total_latency; /**< sum of the latency (usec) */
+  guint64 max_latency; /**< max latency (usec) */
 };
 
 /**
@@ -47,7 +74,7 @@ struct _GstTensorQueryClient
  */
 struct _GstTensorQueryClientClass
 {
-  GstBaseTransformClass parent_class; /**< parent class */
+  GstElementClass parent_class; /**< parent class */
 };
 
 GType gst_tensor_query_client_get_type (void);
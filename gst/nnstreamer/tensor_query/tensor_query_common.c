@@ -15,6 +15,10 @@
 #include "config.h"
 #endif
 
+#include <string.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
 #include "nnstreamer_log.h"
 #include "tensor_query_common.h"
 
@@ -22,18 +26,141 @@
 #define MAX_READ_SIZE 4096
 
 /**
- * @brief Create requested socket.
- * @param[in] hostname the hostname.
- * @param[in] port a port number.
- * @param[in] cancellable (nullable) GCancellable
- * @return Newly created socket or NULL on error.
- * @note Caller is responsible for unreferring the returned object with g_object_unref().
+ * @brief Max size of a memory in the message, not to allocate a huge memory with an invalid size.
  */
-GSocket *
-gst_tensor_query_socket_new (const gchar * hostname, guint16 port,
+#define MAX_MEM_SIZE (256U * 1024U * 1024U)
+
+/**
+ * @brief Connections which can be found by id, to route responses.
+ */
+static GMutex conn_lock;
+static GHashTable *conn_table = NULL;
+static guint32 conn_last_id = 0;
+
+/**
+ * @brief Define tensor_query meta data type to register.
+ */
+GType
+gst_meta_query_api_get_type (void)
+{
+  static volatile GType type;
+  /* no tags, so that the meta is kept while transforming the buffer */
+  static const gchar *tags[] = { NULL };
+  if (g_once_init_enter (&type)) {
+    GType _type;
+    const GstMetaInfo *meta_info = gst_meta_get_info ("GstMetaQuery");
+    if (meta_info) {
+      _type = meta_info->api;
+    } else {
+      _type = gst_meta_api_type_register ("GstMetaQueryAPI", tags);
+    }
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+/**
+ * @brief tensor_query meta data init
+ */
+static gboolean
+gst_meta_query_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
+{
+  GstMetaQuery *emeta = (GstMetaQuery *) meta;
+  emeta->client_id = 0;
+  emeta->seq = 0;
+  return TRUE;
+}
+
+/**
+ * @brief tensor_query meta data transform (source to dest)
+ */
+static gboolean
+gst_meta_query_transform (GstBuffer * transbuf, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  GstMetaQuery *dest_meta = gst_buffer_add_meta_query (transbuf);
+  GstMetaQuery *src_meta = (GstMetaQuery *) meta;
+  dest_meta->client_id = src_meta->client_id;
+  dest_meta->seq = src_meta->seq;
+  return TRUE;
+}
+
+/**
+ * @brief Get tensor_query meta data info.
+ * @return GstMetaInfo
+ */
+const GstMetaInfo *
+gst_meta_query_get_info (void)
+{
+  static const GstMetaInfo *meta_info = NULL;
+  if (g_once_init_enter (&meta_info)) {
+    const GstMetaInfo *mi = gst_meta_register (GST_META_QUERY_API_TYPE,
+        "GstMetaQuery",
+        sizeof (GstMetaQuery),
+        (GstMetaInitFunction) gst_meta_query_init,
+        (GstMetaFreeFunction) NULL,
+        (GstMetaTransformFunction) gst_meta_query_transform);
+    g_once_init_leave (&meta_info, mi);
+  }
+  return meta_info;
+}
+
+/**
+ * @brief Add tensor_query meta data in buffer.
+ * @return GstMetaQuery
+ */
+GstMetaQuery *
+gst_buffer_add_meta_query (GstBuffer * buffer)
+{
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+  return (GstMetaQuery *) gst_buffer_add_meta (buffer, GST_META_QUERY_INFO,
+      NULL);
+}
+
+/**
+ * @brief Get protocol from a given string.
+ */
+tensor_query_protocol
+gst_tensor_query_get_protocol (const gchar * str)
+{
+  if (!str)
+    return QUERY_PROTOCOL_END;
+
+  if (g_ascii_strcasecmp (str, "tcp") == 0)
+    return QUERY_PROTOCOL_TCP;
+  if (g_ascii_strcasecmp (str, "udp") == 0)
+    return QUERY_PROTOCOL_UDP;
+  if (g_ascii_strcasecmp (str, "mqtt") == 0)
+    return QUERY_PROTOCOL_MQTT;
+
+  return QUERY_PROTOCOL_END;
+}
+
+/**
+ * @brief Get the string of a given protocol.
+ */
+const gchar *
+gst_tensor_query_get_protocol_string (tensor_query_protocol protocol)
+{
+  switch (protocol) {
+    case QUERY_PROTOCOL_TCP:
+      return "tcp";
+    case QUERY_PROTOCOL_UDP:
+      return "udp";
+    case QUERY_PROTOCOL_MQTT:
+      return "mqtt";
+    default:
+      return NULL;
+  }
+}
+
+/**
+ * @brief Resolve the socket address of given host and port.
+ */
+static GSocketAddress *
+_resolve_address (const gchar * hostname, guint16 port,
     GCancellable * cancellable)
 {
-  GSocket *socket;
   GError *err = NULL;
   GInetAddress *addr;
   GSocketAddress *saddr;
@@ -67,12 +194,40 @@ gst_tensor_query_socket_new (const gchar * hostname, guint16 port,
   saddr = g_inet_socket_address_new (addr, port);
   g_object_unref (addr);
 
+  return saddr;
+}
+
+/**
+ * @brief Create requested socket.
+ * @param[in] hostname the hostname.
+ * @param[in] port a port number.
+ * @param[in] cancellable (nullable) GCancellable
+ * @return Newly created socket or NULL on error.
+ * @note Caller is responsible for unreferring the returned object with g_object_unref().
+ */
+GSocket *
+gst_tensor_query_socket_new (const gchar * hostname, guint16 port,
+    GCancellable * cancellable)
+{
+  GSocket *socket;
+  GError *err = NULL;
+  GSocketAddress *saddr;
+
+  saddr = _resolve_address (hostname, port, cancellable);
+  if (!saddr)
+    return NULL;
+
   /* create sending client socket */
   /** @todo Support UDP protocol */
   socket =
       g_socket_new (g_socket_address_get_family (saddr), G_SOCKET_TYPE_STREAM,
       G_SOCKET_PROTOCOL_TCP, &err);
+  if (!socket) {
+    nns_loge ("Failed to create socket: %s", err->message);
+    g_clear_error (&err);
+  }
 
+  g_object_unref (saddr);
   return socket;
 }
 
@@ -186,3 +341,512 @@ select_error:
     return ret;
   }
 }
+
+/**
+ * @brief Set the options of a connected socket.
+ */
+static void
+_set_socket_options (GSocket * socket)
+{
+  GError *err = NULL;
+
+  /* requests are small and pipelined, do not wait to coalesce them */
+  if (!g_socket_set_option (socket, IPPROTO_TCP, TCP_NODELAY, 1, &err)) {
+    nns_logw ("Failed to set TCP_NODELAY: %s", err->message);
+    g_clear_error (&err);
+  }
+}
+
+/**
+ * @brief Connect to the server and create a persistent connection.
+ */
+TensorQueryConnection *
+gst_tensor_query_connect (const gchar * hostname, guint16 port)
+{
+  GSocket *socket;
+  GSocketAddress *saddr;
+  GError *err = NULL;
+
+  g_return_val_if_fail (hostname != NULL, NULL);
+
+  saddr = _resolve_address (hostname, port, NULL);
+  if (!saddr)
+    return NULL;
+
+  socket = g_socket_new (g_socket_address_get_family (saddr),
+      G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP, &err);
+  if (!socket) {
+    nns_loge ("Failed to create socket: %s", err->message);
+    goto error;
+  }
+
+  if (!g_socket_connect (socket, saddr, NULL, &err)) {
+    nns_loge ("Failed to connect to %s:%u: %s", hostname, port, err->message);
+    g_object_unref (socket);
+    goto error;
+  }
+
+  g_object_unref (saddr);
+  return gst_tensor_query_connection_new (socket);
+
+error:
+  g_clear_error (&err);
+  g_object_unref (saddr);
+  return NULL;
+}
+
+/**
+ * @brief Create a listening socket of the server.
+ */
+GSocket *
+gst_tensor_query_listen (const gchar * hostname, guint16 * port)
+{
+  GSocket *socket;
+  GSocketAddress *saddr, *bound;
+  GError *err = NULL;
+
+  g_return_val_if_fail (hostname != NULL, NULL);
+  g_return_val_if_fail (port != NULL, NULL);
+
+  saddr = _resolve_address (hostname, *port, NULL);
+  if (!saddr)
+    return NULL;
+
+  socket = g_socket_new (g_socket_address_get_family (saddr),
+      G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP, &err);
+  if (!socket) {
+    nns_loge ("Failed to create socket: %s", err->message);
+    goto error;
+  }
+
+  if (!g_socket_bind (socket, saddr, TRUE, &err) ||
+      !g_socket_listen (socket, &err)) {
+    nns_loge ("Failed to listen on %s:%u: %s", hostname, *port, err->message);
+    g_object_unref (socket);
+    goto error;
+  }
+  g_object_unref (saddr);
+
+  /* get the bound port if it is a random port */
+  bound = g_socket_get_local_address (socket, NULL);
+  if (bound) {
+    *port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (bound));
+    g_object_unref (bound);
+  }
+
+  return socket;
+
+error:
+  g_clear_error (&err);
+  g_object_unref (saddr);
+  return NULL;
+}
+
+/**
+ * @brief Create a connection of an accepted socket.
+ */
+TensorQueryConnection *
+gst_tensor_query_connection_new (GSocket * socket)
+{
+  TensorQueryConnection *conn;
+
+  g_return_val_if_fail (G_IS_SOCKET (socket), NULL);
+
+  _set_socket_options (socket);
+
+  conn = g_new0 (TensorQueryConnection, 1);
+  conn->refcount = 1;
+  conn->socket = socket;
+  conn->cancellable = g_cancellable_new ();
+  g_mutex_init (&conn->lock);
+
+  g_mutex_lock (&conn_lock);
+  if (!conn_table)
+    conn_table = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  do {
+    conn->id = ++conn_last_id;
+  } while (conn->id == 0 ||
+      g_hash_table_contains (conn_table, GUINT_TO_POINTER (conn->id)));
+
+  g_hash_table_insert (conn_table, GUINT_TO_POINTER (conn->id), conn);
+  g_mutex_unlock (&conn_lock);
+
+  return conn;
+}
+
+/**
+ * @brief Find the connection with given id.
+ */
+TensorQueryConnection *
+gst_tensor_query_connection_find (guint32 id)
+{
+  TensorQueryConnection *conn = NULL;
+
+  g_mutex_lock (&conn_lock);
+  if (conn_table)
+    conn = g_hash_table_lookup (conn_table, GUINT_TO_POINTER (id));
+  if (conn)
+    g_atomic_int_inc (&conn->refcount);
+  g_mutex_unlock (&conn_lock);
+
+  return conn;
+}
+
+/**
+ * @brief Increase the reference count of the connection.
+ */
+TensorQueryConnection *
+gst_tensor_query_connection_ref (TensorQueryConnection * conn)
+{
+  g_return_val_if_fail (conn != NULL, NULL);
+
+  g_atomic_int_inc (&conn->refcount);
+  return conn;
+}
+
+/**
+ * @brief Decrease the reference count and free the connection if it is the last.
+ */
+void
+gst_tensor_query_connection_unref (TensorQueryConnection * conn)
+{
+  g_return_if_fail (conn != NULL);
+
+  /* the table lookup increases refcount under the lock */
+  g_mutex_lock (&conn_lock);
+  if (!g_atomic_int_dec_and_test (&conn->refcount)) {
+    g_mutex_unlock (&conn_lock);
+    return;
+  }
+
+  if (conn_table &&
+      g_hash_table_lookup (conn_table, GUINT_TO_POINTER (conn->id)) == conn)
+    g_hash_table_remove (conn_table, GUINT_TO_POINTER (conn->id));
+  g_mutex_unlock (&conn_lock);
+
+  g_socket_close (conn->socket, NULL);
+  g_object_unref (conn->socket);
+  g_object_unref (conn->cancellable);
+
+  if (conn->caps)
+    gst_caps_unref (conn->caps);
+  if (conn->sent_caps)
+    gst_caps_unref (conn->sent_caps);
+
+  g_mutex_clear (&conn->lock);
+  g_free (conn);
+}
+
+/**
+ * @brief Cancel the blocking calls of the connection and shutdown the socket.
+ */
+void
+gst_tensor_query_connection_close (TensorQueryConnection * conn)
+{
+  g_return_if_fail (conn != NULL);
+
+  /* remove it from the table, responses for this connection are dropped */
+  g_mutex_lock (&conn_lock);
+  if (conn_table &&
+      g_hash_table_lookup (conn_table, GUINT_TO_POINTER (conn->id)) == conn)
+    g_hash_table_remove (conn_table, GUINT_TO_POINTER (conn->id));
+  g_mutex_unlock (&conn_lock);
+
+  g_cancellable_cancel (conn->cancellable);
+  g_socket_shutdown (conn->socket, TRUE, TRUE, NULL);
+}
+
+/**
+ * @brief Send all vectors. Sending a large message may be partial.
+ */
+static gboolean
+_send_vectors (TensorQueryConnection * conn, GOutputVector * vec, guint num)
+{
+  GError *err = NULL;
+  gssize sent;
+  guint i = 0;
+
+  while (i < num) {
+    sent = g_socket_send_message (conn->socket, NULL, &vec[i], num - i,
+        NULL, 0, 0, conn->cancellable, &err);
+    if (sent < 0) {
+      if (!g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        nns_loge ("Failed to send a message: %s", err->message);
+      g_clear_error (&err);
+      return FALSE;
+    }
+
+    /* skip the vectors sent completely and move the rest */
+    while (i < num && (gsize) sent >= vec[i].size) {
+      sent -= vec[i].size;
+      i++;
+    }
+    if (i < num) {
+      vec[i].buffer = (const guint8 *) vec[i].buffer + sent;
+      vec[i].size -= sent;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Fill the message header.
+ */
+static void
+_init_header (TensorQueryHeader * header, TensorQueryCommand cmd,
+    guint64 seq, guint32 num_mems)
+{
+  memset (header, 0, sizeof (TensorQueryHeader));
+  header->magic = GUINT32_TO_LE (TENSOR_QUERY_MAGIC);
+  header->cmd = GUINT32_TO_LE ((guint32) cmd);
+  header->seq = GUINT64_TO_LE (seq);
+  header->num_mems = GUINT32_TO_LE (num_mems);
+}
+
+/**
+ * @brief Send the caps if it differs from the caps sent before.
+ */
+gboolean
+gst_tensor_query_send_caps (TensorQueryConnection * conn, GstCaps * caps)
+{
+  TensorQueryHeader header;
+  GOutputVector vec[3];
+  guint64 size;
+  gchar *str;
+  gboolean ret = TRUE;
+
+  g_return_val_if_fail (conn != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_CAPS (caps), FALSE);
+
+  g_mutex_lock (&conn->lock);
+  if (conn->sent_caps && gst_caps_is_equal (conn->sent_caps, caps))
+    goto done;
+
+  str = gst_caps_to_string (caps);
+  size = strlen (str) + 1;
+
+  _init_header (&header, TENSOR_QUERY_CMD_CAPS, 0, 1);
+  size = GUINT64_TO_LE (size);
+
+  vec[0].buffer = &header;
+  vec[0].size = sizeof (header);
+  vec[1].buffer = &size;
+  vec[1].size = sizeof (size);
+  vec[2].buffer = str;
+  vec[2].size = strlen (str) + 1;
+
+  ret = _send_vectors (conn, vec, 3);
+  if (ret)
+    gst_caps_replace (&conn->sent_caps, caps);
+
+  g_free (str);
+
+done:
+  g_mutex_unlock (&conn->lock);
+  return ret;
+}
+
+/**
+ * @brief Send the memories of the buffer in a message without copying them.
+ */
+gboolean
+gst_tensor_query_send_buffer (TensorQueryConnection * conn, guint64 seq,
+    GstBuffer * buffer)
+{
+  TensorQueryHeader header;
+  GOutputVector vec[NNS_TENSOR_SIZE_LIMIT + 2];
+  guint64 sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mem;
+  guint i, num_mems;
+  gboolean ret;
+
+  g_return_val_if_fail (conn != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
+
+  num_mems = gst_buffer_n_memory (buffer);
+  if (num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Failed to send the buffer, too many memories (%u).", num_mems);
+    return FALSE;
+  }
+
+  _init_header (&header, TENSOR_QUERY_CMD_DATA, seq, num_mems);
+  vec[0].buffer = &header;
+  vec[0].size = sizeof (header);
+  vec[1].buffer = sizes;
+  vec[1].size = sizeof (guint64) * num_mems;
+
+  for (i = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+    if (!gst_memory_map (mem, &map[i], GST_MAP_READ)) {
+      nns_loge ("Failed to map the memory %u to send.", i);
+      num_mems = i;
+      ret = FALSE;
+      goto done;
+    }
+
+    sizes[i] = GUINT64_TO_LE ((guint64) map[i].size);
+    vec[i + 2].buffer = map[i].data;
+    vec[i + 2].size = map[i].size;
+  }
+
+  g_mutex_lock (&conn->lock);
+  ret = _send_vectors (conn, vec, num_mems + 2);
+  g_mutex_unlock (&conn->lock);
+
+done:
+  for (i = 0; i < num_mems; i++)
+    gst_memory_unmap (gst_buffer_peek_memory (buffer, i), &map[i]);
+
+  return ret;
+}
+
+/**
+ * @brief Receive the given size of data.
+ */
+static GstFlowReturn
+_receive_all (TensorQueryConnection * conn, gpointer data, gsize size)
+{
+  GError *err = NULL;
+  gssize received;
+  gsize offset = 0;
+
+  while (offset < size) {
+    received = g_socket_receive (conn->socket, (gchar *) data + offset,
+        size - offset, conn->cancellable, &err);
+
+    if (received == 0) {
+      nns_logd ("Connection closed");
+      return GST_FLOW_EOS;
+    }
+
+    if (received < 0) {
+      if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        nns_logd ("Cancelled receiving data");
+        g_clear_error (&err);
+        return GST_FLOW_FLUSHING;
+      }
+
+      nns_loge ("Failed to receive data: %s", err->message);
+      g_clear_error (&err);
+      return GST_FLOW_ERROR;
+    }
+
+    offset += received;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Receive a message. Caps is stored in the connection.
+ */
+GstFlowReturn
+gst_tensor_query_receive (TensorQueryConnection * conn,
+    TensorQueryCommand * cmd, guint64 * seq, GstBuffer ** buffer)
+{
+  TensorQueryHeader header;
+  guint64 sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstFlowReturn ret;
+  GstBuffer *outbuf = NULL;
+  guint i, num_mems;
+
+  g_return_val_if_fail (conn != NULL, GST_FLOW_ERROR);
+  g_return_val_if_fail (cmd != NULL, GST_FLOW_ERROR);
+
+  ret = _receive_all (conn, &header, sizeof (header));
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  num_mems = GUINT32_FROM_LE (header.num_mems);
+  *cmd = (TensorQueryCommand) GUINT32_FROM_LE (header.cmd);
+
+  if (GUINT32_FROM_LE (header.magic) != TENSOR_QUERY_MAGIC ||
+      *cmd >= TENSOR_QUERY_CMD_END || num_mems > NNS_TENSOR_SIZE_LIMIT ||
+      (*cmd == TENSOR_QUERY_CMD_CAPS && num_mems != 1)) {
+    nns_loge ("Received an invalid message header.");
+    return GST_FLOW_ERROR;
+  }
+
+  if (seq)
+    *seq = GUINT64_FROM_LE (header.seq);
+
+  ret = _receive_all (conn, sizes, sizeof (guint64) * num_mems);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  if (*cmd == TENSOR_QUERY_CMD_CAPS) {
+    gchar *str;
+    GstCaps *caps;
+    gsize size = (gsize) GUINT64_FROM_LE (sizes[0]);
+
+    if (size == 0 || size > MAX_READ_SIZE) {
+      nns_loge ("Received an invalid caps size (%zu).", size);
+      return GST_FLOW_ERROR;
+    }
+
+    str = g_malloc0 (size + 1);
+    ret = _receive_all (conn, str, size);
+    if (ret == GST_FLOW_OK) {
+      caps = gst_caps_from_string (str);
+      if (caps) {
+        gst_caps_take (&conn->caps, caps);
+      } else {
+        nns_loge ("Received an invalid caps '%s'.", str);
+        ret = GST_FLOW_ERROR;
+      }
+    }
+
+    g_free (str);
+    return ret;
+  }
+
+  outbuf = gst_buffer_new ();
+  for (i = 0; i < num_mems; i++) {
+    GstMemory *mem;
+    GstMapInfo map;
+    guint64 size = GUINT64_FROM_LE (sizes[i]);
+
+    if (size > MAX_MEM_SIZE) {
+      nns_loge ("Received an invalid memory size (%" G_GUINT64_FORMAT ").",
+          size);
+      ret = GST_FLOW_ERROR;
+      break;
+    }
+
+    mem = gst_allocator_alloc (NULL, (gsize) size, NULL);
+    if (!mem) {
+      nns_loge ("Failed to allocate memory (%" G_GUINT64_FORMAT " bytes).",
+          size);
+      ret = GST_FLOW_ERROR;
+      break;
+    }
+
+    if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      gst_memory_unref (mem);
+      ret = GST_FLOW_ERROR;
+      break;
+    }
+
+    ret = _receive_all (conn, map.data, (gsize) size);
+    gst_memory_unmap (mem, &map);
+    gst_buffer_append_memory (outbuf, mem);
+
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (outbuf);
+    return ret;
+  }
+
+  if (buffer)
+    *buffer = outbuf;
+  else
+    gst_buffer_unref (outbuf);
+
+  return GST_FLOW_OK;
+}
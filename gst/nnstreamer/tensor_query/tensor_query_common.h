@@ -18,6 +18,7 @@
 #include <gst/gst.h>
 #include <gio/gio.h>
 #include <gio/gsocket.h>
+#include <tensor_typedef.h>
 
 G_BEGIN_DECLS
 
@@ -32,6 +33,102 @@ typedef enum
   QUERY_PROTOCOL_END,
 } tensor_query_protocol;
 
+/**
+ * @brief Default protocol, host and port of tensor query
+ */
+#define DEFAULT_QUERY_PROTOCOL "tcp"
+#define DEFAULT_QUERY_HOST "localhost"
+#define DEFAULT_QUERY_PORT 3001
+
+/**
+ * @brief Commands of the tensor query message.
+ */
+typedef enum
+{
+  TENSOR_QUERY_CMD_CAPS = 0, /**< caps string, sent once per connection or when changed */
+  TENSOR_QUERY_CMD_DATA = 1, /**< memories of a request or a response */
+  TENSOR_QUERY_CMD_END,
+} TensorQueryCommand;
+
+/**
+ * @brief Header of the tensor query message (little-endian).
+ *
+ * A message is the header, num_mems sizes (guint64) and the payloads.
+ * For TENSOR_QUERY_CMD_CAPS, the payload is a caps string (num_mems is 1).
+ * For TENSOR_QUERY_CMD_DATA, each payload is a memory of the buffer and
+ * seq correlates a response with its request.
+ */
+typedef struct
+{
+  guint32 magic;    /**< TENSOR_QUERY_MAGIC */
+  guint32 cmd;      /**< TensorQueryCommand */
+  guint64 seq;      /**< sequence number of the request */
+  guint32 num_mems; /**< the number of payloads (up to NNS_TENSOR_SIZE_LIMIT) */
+  guint32 reserved; /**< reserved for future use */
+} TensorQueryHeader;
+
+#define TENSOR_QUERY_MAGIC (0x5153534eU) /* "NSSQ" */
+
+/**
+ * @brief A persistent connection of tensor query.
+ */
+typedef struct
+{
+  gint refcount;        /**< reference count */
+  guint32 id;           /**< unique id in the process */
+  GSocket *socket;      /**< connected socket */
+  GCancellable *cancellable; /**< cancellable to stop blocking calls */
+  GMutex lock;          /**< lock to send a message atomically */
+  GstCaps *caps;        /**< caps received from the peer */
+  GstCaps *sent_caps;   /**< caps sent to the peer */
+} TensorQueryConnection;
+
+/**
+ * @brief GstMetaQuery meta structure to route a response to its client.
+ */
+typedef struct
+{
+  GstMeta meta;
+  guint32 client_id; /**< id of the connection the request is received */
+  guint64 seq;       /**< sequence number of the request */
+} GstMetaQuery;
+
+/**
+ * @brief Define tensor_query meta data type to register.
+ */
+GType gst_meta_query_api_get_type (void);
+#define GST_META_QUERY_API_TYPE (gst_meta_query_api_get_type())
+
+/**
+ * @brief Get tensor_query meta data info.
+ */
+const GstMetaInfo *gst_meta_query_get_info (void);
+#define GST_META_QUERY_INFO ((GstMetaInfo*) gst_meta_query_get_info())
+
+/**
+ * @brief Macro of get tensor_query meta data.
+ */
+#define gst_buffer_get_meta_query(b) \
+  ((GstMetaQuery*) gst_buffer_get_meta((b), GST_META_QUERY_API_TYPE))
+
+/**
+ * @brief Add tensor_query meta data in buffer.
+ */
+GstMetaQuery *gst_buffer_add_meta_query (GstBuffer * buffer);
+
+/**
+ * @brief Get protocol from a given string.
+ * @return the protocol or QUERY_PROTOCOL_END if invalid.
+ */
+extern tensor_query_protocol
+gst_tensor_query_get_protocol (const gchar * str);
+
+/**
+ * @brief Get the string of a given protocol.
+ */
+extern const gchar *
+gst_tensor_query_get_protocol_string (tensor_query_protocol protocol);
+
 /**
  * @brief Create requested socket.
  * @param[in] hostname the hostname
@@ -55,5 +152,83 @@ extern GstFlowReturn
 gst_tensor_query_socket_receive (GSocket * socket, GCancellable * cancellable,
     gsize * bytes_received, GstBuffer * outbuf);
 
+/**
+ * @brief Connect to the server and create a persistent connection.
+ * @param[in] hostname the hostname of the server.
+ * @param[in] port a port number.
+ * @return Newly created connection or NULL on error. Release it with gst_tensor_query_connection_unref().
+ */
+extern TensorQueryConnection *
+gst_tensor_query_connect (const gchar * hostname, guint16 port);
+
+/**
+ * @brief Create a listening socket of the server.
+ * @param[in] hostname the hostname to listen.
+ * @param[in/out] port a port number to listen (0 for a random available port). Updated to the bound port.
+ * @return Newly created socket or NULL on error.
+ */
+extern GSocket *
+gst_tensor_query_listen (const gchar * hostname, guint16 * port);
+
+/**
+ * @brief Create a connection of an accepted socket. The connection can be found by its id.
+ * @param[in] socket the connected socket. The connection takes the reference.
+ * @return Newly created connection. Release it with gst_tensor_query_connection_unref().
+ */
+extern TensorQueryConnection *
+gst_tensor_query_connection_new (GSocket * socket);
+
+/**
+ * @brief Find the connection with given id.
+ * @return The connection with increased reference count or NULL if closed.
+ */
+extern TensorQueryConnection *
+gst_tensor_query_connection_find (guint32 id);
+
+/**
+ * @brief Increase the reference count of the connection.
+ */
+extern TensorQueryConnection *
+gst_tensor_query_connection_ref (TensorQueryConnection * conn);
+
+/**
+ * @brief Decrease the reference count and free the connection if it is the last.
+ */
+extern void
+gst_tensor_query_connection_unref (TensorQueryConnection * conn);
+
+/**
+ * @brief Cancel the blocking calls of the connection and shutdown the socket.
+ */
+extern void
+gst_tensor_query_connection_close (TensorQueryConnection * conn);
+
+/**
+ * @brief Send the caps if it differs from the caps sent before.
+ * @return TRUE if there is no error.
+ */
+extern gboolean
+gst_tensor_query_send_caps (TensorQueryConnection * conn, GstCaps * caps);
+
+/**
+ * @brief Send the memories of the buffer in a message without copying them.
+ * @return TRUE if there is no error.
+ */
+extern gboolean
+gst_tensor_query_send_buffer (TensorQueryConnection * conn, guint64 seq,
+    GstBuffer * buffer);
+
+/**
+ * @brief Receive a message. Caps is stored in the connection.
+ * @param[in] conn the connection.
+ * @param[out] cmd the command of the received message.
+ * @param[out] seq the sequence number of the received data.
+ * @param[out] buffer newly allocated buffer of the received data (TENSOR_QUERY_CMD_DATA only).
+ * @return GST_FLOW_OK if there is no error, GST_FLOW_EOS if the connection is closed.
+ */
+extern GstFlowReturn
+gst_tensor_query_receive (TensorQueryConnection * conn,
+    TensorQueryCommand * cmd, guint64 * seq, GstBuffer ** buffer);
+
 G_END_DECLS
 #endif /* __GST_TENSOR_QUERY_COMMON_H__ */
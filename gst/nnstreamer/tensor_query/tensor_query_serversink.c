@@ -19,23 +19,26 @@
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversink_debug);
 #define GST_CAT_DEFAULT gst_tensor_query_serversink_debug
 
+#define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT "; " GST_TENSORS_FLEX_CAP_DEFAULT
+
 /**
- * @brief the capabilities of the inputs and outputs.
+ * @brief the capabilities of the inputs.
  */
-static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
-    GST_PAD_SRC,
+static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS (GST_TENSORS_FLEX_CAP_DEFAULT));
+    GST_STATIC_CAPS (CAPS_STRING));
 
 #define gst_tensor_query_serversink_parent_class parent_class
 G_DEFINE_TYPE (GstTensorQueryServerSink, gst_tensor_query_serversink,
     GST_TYPE_BASE_SINK);
 
-static void gst_tensor_query_serversink_set_property (GObject * object,
-    guint prop_id, const GValue * value, GParamSpec * pspec);
-static void gst_tensor_query_serversink_get_property (GObject * object,
-    guint prop_id, GValue * value, GParamSpec * pspec);
 static void gst_tensor_query_serversink_finalize (GObject * object);
+static gboolean gst_tensor_query_serversink_set_caps (GstBaseSink * bsink,
+    GstCaps * caps);
+static gboolean gst_tensor_query_serversink_stop (GstBaseSink * bsink);
+static GstFlowReturn gst_tensor_query_serversink_render (GstBaseSink * bsink,
+    GstBuffer * buf);
 
 /**
  * @brief initialize the class
@@ -51,21 +54,21 @@ gst_tensor_query_serversink_class_init (GstTensorQueryServerSinkClass * klass)
   gstelement_class = (GstElementClass *) gstbasesink_class;
   gobject_class = (GObjectClass *) gstelement_class;
 
-  gobject_class->set_property = gst_tensor_query_serversink_set_property;
-  gobject_class->get_property = gst_tensor_query_serversink_get_property;
   gobject_class->finalize = gst_tensor_query_serversink_finalize;
 
-  /** install property goes here */
-
   gst_element_class_add_pad_template (gstelement_class,
-      gst_static_pad_template_get (&srctemplate));
+      gst_static_pad_template_get (&sinktemplate));
 
   gst_element_class_set_static_metadata (gstelement_class,
       "TensorQueryServerSink", "Sink/Tensor/Query",
       "Send tensor data as a server over the network",
       "Samsung Electronics Co., Ltd.");
 
-  /** method override goes here */
+  gstbasesink_class->set_caps =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversink_set_caps);
+  gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_query_serversink_stop);
+  gstbasesink_class->render =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversink_render);
 
   GST_DEBUG_CATEGORY_INIT (gst_tensor_query_serversink_debug,
       "tensor_query_serversink", 0, "Tensor Query Server Sink");
@@ -77,7 +80,9 @@ gst_tensor_query_serversink_class_init (GstTensorQueryServerSinkClass * klass)
 static void
 gst_tensor_query_serversink_init (GstTensorQueryServerSink * self)
 {
-  return;
+  /* send the responses as soon as possible */
+  gst_base_sink_set_sync (GST_BASE_SINK (self), FALSE);
+  self->caps = NULL;
 }
 
 /**
@@ -86,25 +91,68 @@ gst_tensor_query_serversink_init (GstTensorQueryServerSink * self)
 static void
 gst_tensor_query_serversink_finalize (GObject * object)
 {
+  GstTensorQueryServerSink *self = GST_TENSOR_QUERY_SERVERSINK (object);
+
+  gst_caps_replace (&self->caps, NULL);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
 /**
- * @brief set property
+ * @brief Set the caps of the responses.
  */
-static void
-gst_tensor_query_serversink_set_property (GObject * object, guint prop_id,
-    const GValue * value, GParamSpec * pspec)
+static gboolean
+gst_tensor_query_serversink_set_caps (GstBaseSink * bsink, GstCaps * caps)
 {
-  return;
+  GstTensorQueryServerSink *self = GST_TENSOR_QUERY_SERVERSINK (bsink);
+
+  gst_caps_replace (&self->caps, caps);
+  return TRUE;
 }
 
 /**
- * @brief get property
+ * @brief Release the caps.
  */
-static void
-gst_tensor_query_serversink_get_property (GObject * object, guint prop_id,
-    GValue * value, GParamSpec * pspec)
+static gboolean
+gst_tensor_query_serversink_stop (GstBaseSink * bsink)
+{
+  GstTensorQueryServerSink *self = GST_TENSOR_QUERY_SERVERSINK (bsink);
+
+  gst_caps_replace (&self->caps, NULL);
+  return TRUE;
+}
+
+/**
+ * @brief Send the response to the client of the request.
+ */
+static GstFlowReturn
+gst_tensor_query_serversink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
-  return;
+  GstTensorQueryServerSink *self = GST_TENSOR_QUERY_SERVERSINK (bsink);
+  TensorQueryConnection *conn;
+  GstMetaQuery *meta;
+
+  meta = gst_buffer_get_meta_query (buf);
+  if (!meta) {
+    GST_WARNING_OBJECT (self,
+        "Cannot find the client of the buffer, tensor_query_serversrc meta is missing.");
+    return GST_FLOW_OK;
+  }
+
+  conn = gst_tensor_query_connection_find (meta->client_id);
+  if (!conn) {
+    /* the client is disconnected */
+    GST_DEBUG_OBJECT (self, "Client %u is closed, drop the response %"
+        G_GUINT64_FORMAT ".", meta->client_id, meta->seq);
+    return GST_FLOW_OK;
+  }
+
+  /* caps is sent once per connection, or when it is changed */
+  if (!gst_tensor_query_send_caps (conn, self->caps) ||
+      !gst_tensor_query_send_buffer (conn, meta->seq, buf)) {
+    GST_WARNING_OBJECT (self, "Failed to send the response %" G_GUINT64_FORMAT
+        " to the client %u.", meta->seq, meta->client_id);
+  }
+
+  gst_tensor_query_connection_unref (conn);
+  return GST_FLOW_OK;
 }
@@ -16,6 +16,7 @@
 #include <gst/gst.h>
 #include <gst/base/gstbasesink.h>
 #include <tensor_common.h>
+#include "tensor_query_common.h"
 
 G_BEGIN_DECLS
 
@@ -40,6 +41,8 @@ typedef struct _GstTensorQueryServerSinkClass GstTensorQueryServerSinkClass;
 struct _GstTensorQueryServerSink
 {
   GstBaseSink element; /**< parent object */
+
+  GstCaps *caps; /**< caps of the responses */
 };
 
 /**
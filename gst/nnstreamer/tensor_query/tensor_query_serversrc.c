@@ -19,13 +19,51 @@
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversrc_debug);
 #define GST_CAT_DEFAULT gst_tensor_query_serversrc_debug
 
+#define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT "; " GST_TENSORS_FLEX_CAP_DEFAULT
+
+/**
+ * @brief The number of requests to be queued. Receiving threads are blocked if the queue is full.
+ */
+#define DEFAULT_QUEUE_SIZE 16
+
+/**
+ * @brief Properties.
+ */
+enum
+{
+  PROP_0,
+  PROP_HOST,
+  PROP_PORT,
+  PROP_PROTOCOL
+};
+
+/**
+ * @brief A client connected to the server.
+ */
+typedef struct
+{
+  GstTensorQueryServerSrc *src; /**< the element */
+  TensorQueryConnection *conn; /**< connection of the client */
+  GThread *thread; /**< thread to receive the requests */
+  gint done; /**< the thread is finished */
+} QueryServerClient;
+
+/**
+ * @brief A queued request with the caps of the client.
+ */
+typedef struct
+{
+  GstDataQueueItem item; /**< parent, object is the buffer */
+  GstCaps *caps; /**< caps of the request */
+} QueryServerItem;
+
 /**
- * @brief the capabilities of the inputs and outputs.
+ * @brief the capabilities of the outputs.
  */
-static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
-    GST_PAD_SINK,
+static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS (GST_TENSORS_FLEX_CAP_DEFAULT));
+    GST_STATIC_CAPS (CAPS_STRING));
 
 #define gst_tensor_query_serversrc_parent_class parent_class
 G_DEFINE_TYPE (GstTensorQueryServerSrc, gst_tensor_query_serversrc,
@@ -37,6 +75,14 @@ static void gst_tensor_query_serversrc_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 static void gst_tensor_query_serversrc_finalize (GObject * object);
 
+static gboolean gst_tensor_query_serversrc_start (GstBaseSrc * bsrc);
+static gboolean gst_tensor_query_serversrc_stop (GstBaseSrc * bsrc);
+static gboolean gst_tensor_query_serversrc_unlock (GstBaseSrc * bsrc);
+static gboolean gst_tensor_query_serversrc_unlock_stop (GstBaseSrc * bsrc);
+static gboolean gst_tensor_query_serversrc_negotiate (GstBaseSrc * bsrc);
+static GstFlowReturn gst_tensor_query_serversrc_create (GstPushSrc * psrc,
+    GstBuffer ** buf);
+
 /**
  * @brief initialize the class
  */
@@ -57,29 +103,84 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
   gobject_class->get_property = gst_tensor_query_serversrc_get_property;
   gobject_class->finalize = gst_tensor_query_serversrc_finalize;
 
-  /** install property goes here */
+  g_object_class_install_property (gobject_class, PROP_HOST,
+      g_param_spec_string ("host", "Host", "The hostname to listen as",
+          DEFAULT_QUERY_HOST, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_PORT,
+      g_param_spec_uint ("port", "Port",
+          "The port to listen to (0 = random available port)",
+          0, 65535, DEFAULT_QUERY_PORT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_PROTOCOL,
+      g_param_spec_string ("protocol", "Protocol",
+          "The network protocol to receive requests (tcp)",
+          DEFAULT_QUERY_PROTOCOL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
-      gst_static_pad_template_get (&sinktemplate));
+      gst_static_pad_template_get (&srctemplate));
 
   gst_element_class_set_static_metadata (gstelement_class,
       "TensorQueryServerSrc", "Source/Tensor/Query",
       "Receive tensor data as a server over the network",
       "Samsung Electronics Co., Ltd.");
 
-  /** method override goes here */
+  gstbasesrc_class->start = GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_start);
+  gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_stop);
+  gstbasesrc_class->unlock =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_unlock);
+  gstbasesrc_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_unlock_stop);
+  gstbasesrc_class->negotiate =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_negotiate);
+  gstpushsrc_class->create =
+      GST_DEBUG_FUNCPTR (gst_tensor_query_serversrc_create);
 
   GST_DEBUG_CATEGORY_INIT (gst_tensor_query_serversrc_debug,
       "tensor_query_serversrc", 0, "Tensor Query Server Source");
 }
 
+/**
+ * @brief Check the queue is full.
+ */
+static gboolean
+_queue_check_full (GstDataQueue * queue, guint visible, guint bytes,
+    guint64 time, gpointer checkdata)
+{
+  return (visible >= DEFAULT_QUEUE_SIZE);
+}
+
+/**
+ * @brief Free the queued request.
+ */
+static void
+_queue_item_free (gpointer data)
+{
+  QueryServerItem *qitem = (QueryServerItem *) data;
+
+  if (qitem->item.object)
+    gst_mini_object_unref (qitem->item.object);
+  if (qitem->caps)
+    gst_caps_unref (qitem->caps);
+  g_free (qitem);
+}
+
 /**
  * @brief initialize the new element
  */
 static void
 gst_tensor_query_serversrc_init (GstTensorQueryServerSrc * self)
 {
-  return;
+  self->host = g_strdup (DEFAULT_QUERY_HOST);
+  self->port = DEFAULT_QUERY_PORT;
+  self->protocol = QUERY_PROTOCOL_TCP;
+
+  g_mutex_init (&self->lock);
+  self->queue = gst_data_queue_new (_queue_check_full, NULL, NULL, NULL);
+
+  /* requests arrive in real time */
+  gst_base_src_set_format (GST_BASE_SRC (self), GST_FORMAT_TIME);
+  gst_base_src_set_live (GST_BASE_SRC (self), TRUE);
+  gst_base_src_set_do_timestamp (GST_BASE_SRC (self), TRUE);
 }
 
 /**
@@ -88,6 +189,17 @@ gst_tensor_query_serversrc_init (GstTensorQueryServerSrc * self)
 static void
 gst_tensor_query_serversrc_finalize (GObject * object)
 {
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (object);
+
+  g_free (self->host);
+  gst_data_queue_flush (self->queue);
+  g_object_unref (self->queue);
+
+  if (self->caps)
+    gst_caps_unref (self->caps);
+
+  g_mutex_clear (&self->lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -98,7 +210,36 @@ static void
 gst_tensor_query_serversrc_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
-  return;
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (object);
+
+  switch (prop_id) {
+    case PROP_HOST:
+      if (!g_value_get_string (value)) {
+        GST_WARNING_OBJECT (self, "host property cannot be NULL");
+        break;
+      }
+      g_free (self->host);
+      self->host = g_value_dup_string (value);
+      break;
+    case PROP_PORT:
+      self->port = g_value_get_uint (value);
+      break;
+    case PROP_PROTOCOL:
+    {
+      tensor_query_protocol protocol;
+
+      protocol = gst_tensor_query_get_protocol (g_value_get_string (value));
+      if (protocol == QUERY_PROTOCOL_END) {
+        GST_WARNING_OBJECT (self, "Invalid protocol '%s'", g_value_get_string (value));
+        break;
+      }
+      self->protocol = protocol;
+      break;
+    }
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 /**
@@ -108,5 +249,291 @@ static void
 gst_tensor_query_serversrc_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
 {
-  return;
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (object);
+
+  switch (prop_id) {
+    case PROP_HOST:
+      g_value_set_string (value, self->host);
+      break;
+    case PROP_PORT:
+      g_value_set_uint (value, self->port);
+      break;
+    case PROP_PROTOCOL:
+      g_value_set_string (value,
+          gst_tensor_query_get_protocol_string (self->protocol));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Thread to receive the requests of a client.
+ */
+static gpointer
+_client_thread (gpointer data)
+{
+  QueryServerClient *client = (QueryServerClient *) data;
+  GstTensorQueryServerSrc *self = client->src;
+  TensorQueryConnection *conn = client->conn;
+  TensorQueryCommand cmd;
+  QueryServerItem *qitem;
+  GstMetaQuery *meta;
+  GstBuffer *buffer;
+  GstFlowReturn ret;
+  guint64 seq;
+
+  GST_DEBUG_OBJECT (self, "Client %u connected.", conn->id);
+
+  while (TRUE) {
+    buffer = NULL;
+    ret = gst_tensor_query_receive (conn, &cmd, &seq, &buffer);
+    if (ret != GST_FLOW_OK)
+      break;
+
+    if (cmd == TENSOR_QUERY_CMD_CAPS) {
+      GST_DEBUG_OBJECT (self, "Client %u caps: %" GST_PTR_FORMAT, conn->id,
+          conn->caps);
+      continue;
+    }
+
+    if (!conn->caps) {
+      GST_WARNING_OBJECT (self, "Client %u sent data before caps, drop it.",
+          conn->id);
+      gst_buffer_unref (buffer);
+      continue;
+    }
+
+    /* the response is routed to the client with this meta */
+    meta = gst_buffer_add_meta_query (buffer);
+    meta->client_id = conn->id;
+    meta->seq = seq;
+
+    qitem = g_new0 (QueryServerItem, 1);
+    qitem->item.object = GST_MINI_OBJECT (buffer);
+    qitem->item.size = gst_buffer_get_size (buffer);
+    qitem->item.visible = TRUE;
+    qitem->item.destroy = _queue_item_free;
+    qitem->caps = gst_caps_ref (conn->caps);
+
+    if (!gst_data_queue_push (self->queue, (GstDataQueueItem *) qitem)) {
+      _queue_item_free (qitem);
+      break;
+    }
+  }
+
+  GST_DEBUG_OBJECT (self, "Client %u disconnected.", conn->id);
+
+  /* close it so that the responses to the client are dropped */
+  gst_tensor_query_connection_close (conn);
+  g_atomic_int_set (&client->done, 1);
+  return NULL;
+}
+
+/**
+ * @brief Join the thread and free the client.
+ */
+static void
+_client_free (gpointer data)
+{
+  QueryServerClient *client = (QueryServerClient *) data;
+
+  gst_tensor_query_connection_close (client->conn);
+  g_thread_join (client->thread);
+  gst_tensor_query_connection_unref (client->conn);
+  g_free (client);
+}
+
+/**
+ * @brief Thread to accept the clients.
+ */
+static gpointer
+_accept_thread (gpointer data)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (data);
+  QueryServerClient *client;
+  GSocket *socket;
+  GError *err = NULL;
+  GList *l, *next;
+
+  while (TRUE) {
+    socket = g_socket_accept (self->server_socket, self->cancellable, &err);
+    if (!socket) {
+      if (!g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        GST_ERROR_OBJECT (self, "Failed to accept: %s", err->message);
+      g_clear_error (&err);
+      break;
+    }
+
+    client = g_new0 (QueryServerClient, 1);
+    client->src = self;
+    client->conn = gst_tensor_query_connection_new (socket);
+    client->thread = g_thread_new ("query-client", _client_thread, client);
+
+    g_mutex_lock (&self->lock);
+    /* release the clients already disconnected */
+    for (l = self->clients; l; l = next) {
+      QueryServerClient *c = (QueryServerClient *) l->data;
+
+      next = l->next;
+      if (g_atomic_int_get (&c->done)) {
+        _client_free (c);
+        self->clients = g_list_delete_link (self->clients, l);
+      }
+    }
+
+    self->clients = g_list_append (self->clients, client);
+    g_mutex_unlock (&self->lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Start the server to receive the requests.
+ */
+static gboolean
+gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (bsrc);
+  guint16 port = self->port;
+
+  if (self->protocol != QUERY_PROTOCOL_TCP) {
+    GST_ELEMENT_ERROR (self, RESOURCE, SETTINGS,
+        ("Protocol '%s' is not supported yet.",
+            gst_tensor_query_get_protocol_string (self->protocol)), (NULL));
+    return FALSE;
+  }
+
+  self->server_socket = gst_tensor_query_listen (self->host, &port);
+  if (!self->server_socket) {
+    GST_ELEMENT_ERROR (self, RESOURCE, OPEN_READ,
+        ("Failed to listen on %s:%u.", self->host, self->port), (NULL));
+    return FALSE;
+  }
+
+  if (self->port != port) {
+    self->port = port;
+    g_object_notify (G_OBJECT (self), "port");
+  }
+
+  GST_INFO_OBJECT (self, "Listening on %s:%u", self->host, self->port);
+
+  gst_data_queue_set_flushing (self->queue, FALSE);
+  self->cancellable = g_cancellable_new ();
+  self->accept_thread = g_thread_new ("query-accept", _accept_thread, self);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the server and disconnect the clients.
+ */
+static gboolean
+gst_tensor_query_serversrc_stop (GstBaseSrc * bsrc)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (bsrc);
+
+  gst_data_queue_set_flushing (self->queue, TRUE);
+
+  if (self->accept_thread) {
+    g_cancellable_cancel (self->cancellable);
+    g_thread_join (self->accept_thread);
+    self->accept_thread = NULL;
+  }
+
+  g_mutex_lock (&self->lock);
+  g_list_free_full (self->clients, _client_free);
+  self->clients = NULL;
+  g_mutex_unlock (&self->lock);
+
+  gst_data_queue_flush (self->queue);
+
+  if (self->server_socket) {
+    g_socket_close (self->server_socket, NULL);
+    g_object_unref (self->server_socket);
+    self->server_socket = NULL;
+  }
+
+  if (self->cancellable) {
+    g_object_unref (self->cancellable);
+    self->cancellable = NULL;
+  }
+
+  gst_caps_replace (&self->caps, NULL);
+  return TRUE;
+}
+
+/**
+ * @brief Unblock the create function.
+ */
+static gboolean
+gst_tensor_query_serversrc_unlock (GstBaseSrc * bsrc)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (bsrc);
+
+  gst_data_queue_set_flushing (self->queue, TRUE);
+  return TRUE;
+}
+
+/**
+ * @brief Clear the flushing state.
+ */
+static gboolean
+gst_tensor_query_serversrc_unlock_stop (GstBaseSrc * bsrc)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (bsrc);
+
+  gst_data_queue_set_flushing (self->queue, FALSE);
+  return TRUE;
+}
+
+/**
+ * @brief Negotiate the caps. The caps is given by the clients.
+ */
+static gboolean
+gst_tensor_query_serversrc_negotiate (GstBaseSrc * bsrc)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (bsrc);
+
+  /* caps is set when the first request is received */
+  if (!self->caps)
+    return TRUE;
+
+  return gst_base_src_set_caps (bsrc, self->caps);
+}
+
+/**
+ * @brief Push the received request.
+ */
+static GstFlowReturn
+gst_tensor_query_serversrc_create (GstPushSrc * psrc, GstBuffer ** buf)
+{
+  GstTensorQueryServerSrc *self = GST_TENSOR_QUERY_SERVERSRC (psrc);
+  GstDataQueueItem *item = NULL;
+  QueryServerItem *qitem;
+
+  if (!gst_data_queue_pop (self->queue, &item))
+    return GST_FLOW_FLUSHING;
+
+  qitem = (QueryServerItem *) item;
+
+  /* requests of the clients may have different caps */
+  if (!self->caps || !gst_caps_is_equal (self->caps, qitem->caps)) {
+    gst_caps_replace (&self->caps, qitem->caps);
+
+    if (!gst_base_src_set_caps (GST_BASE_SRC (self), self->caps)) {
+      GST_ELEMENT_ERROR (self, CORE, NEGOTIATION,
+          ("Failed to set caps %" GST_PTR_FORMAT, self->caps), (NULL));
+      _queue_item_free (qitem);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+  }
+
+  *buf = GST_BUFFER (qitem->item.object);
+  qitem->item.object = NULL;
+  _queue_item_free (qitem);
+
+  return GST_FLOW_OK;
 }
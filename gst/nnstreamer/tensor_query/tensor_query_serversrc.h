@@ -15,7 +15,9 @@
 
 #include <gst/gst.h>
 #include <gst/base/gstpushsrc.h>
+#include <gst/base/gstdataqueue.h>
 #include <tensor_common.h>
+#include "tensor_query_common.h"
 
 G_BEGIN_DECLS
 
@@ -40,6 +42,20 @@ typedef struct _GstTensorQueryServerSrcClass GstTensorQueryServerSrcClass;
 struct _GstTensorQueryServerSrc
 {
   GstPushSrc element; /**< parent object */
+
+  gchar *host; /**< host to listen */
+  guint16 port; /**< port to listen, 0 for a random port */
+  tensor_query_protocol protocol; /**< network protocol */
+
+  GSocket *server_socket; /**< listening socket */
+  GCancellable *cancellable; /**< cancellable to stop accepting clients */
+  GThread *accept_thread; /**< thread to accept clients */
+
+  GMutex lock; /**< lock for clients */
+  GList *clients; /**< connected clients, each has a receiving thread */
+
+  GstDataQueue *queue; /**< received requests */
+  GstCaps *caps; /**< caps of the last request */
 };
 
 /**
@@ -32,8 +32,18 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
+#include <unistd.h>
 #include "tensor_sink.h"
 
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#define HAVE_TENSOR_SINK_EVENTFD 1
+#elif defined(G_OS_UNIX)
+#include <fcntl.h>
+#include <glib-unix.h>
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -69,6 +79,10 @@ enum
   SIGNAL_NEW_DATA,
   SIGNAL_STREAM_START,
   SIGNAL_EOS,
+  SIGNAL_PULL,
+  SIGNAL_TRY_PULL,
+  SIGNAL_PULL_BATCH,
+  SIGNAL_CREATE_SOURCE,
   LAST_SIGNAL
 };
 
@@ -80,7 +94,11 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_EMIT_SIGNAL,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_MAX_BUFFERS,
+  PROP_RING_POLICY,
+  PROP_FD,
+  PROP_DROPPED
 };
 
 /**
@@ -98,6 +116,21 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Max number of buffers in the ring (Default 0, pull-mode disabled).
+ */
+#define DEFAULT_MAX_BUFFERS 0
+
+/**
+ * @brief Limit of the ring size.
+ */
+#define MAX_RING_BUFFERS 1024
+
+/**
+ * @brief Default policy when the ring is full.
+ */
+#define DEFAULT_RING_POLICY TENSOR_SINK_RING_DROP_OLDEST
+
 /**
  * @brief Flag for qos event.
  *
@@ -131,10 +164,27 @@ static GstFlowReturn gst_tensor_sink_render (GstBaseSink * sink,
     GstBuffer * buffer);
 static GstFlowReturn gst_tensor_sink_render_list (GstBaseSink * sink,
     GstBufferList * buffer_list);
+static gboolean gst_tensor_sink_start (GstBaseSink * sink);
+static gboolean gst_tensor_sink_stop (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock_stop (GstBaseSink * sink);
+
+/** action signals */
+static GstBuffer *gst_tensor_sink_pull (GstTensorSink * self);
+static GstBuffer *gst_tensor_sink_try_pull (GstTensorSink * self,
+    GstClockTime timeout);
+static GstBufferList *gst_tensor_sink_pull_batch (GstTensorSink * self,
+    guint num, GstClockTime timeout);
+static GSource *gst_tensor_sink_create_source (GstTensorSink * self);
 
 /** internal functions */
-static void gst_tensor_sink_render_buffer (GstTensorSink * self,
+static GstFlowReturn gst_tensor_sink_render_buffer (GstTensorSink * self,
+    GstBuffer * buffer);
+static GstFlowReturn gst_tensor_sink_ring_push (GstTensorSink * self,
     GstBuffer * buffer);
+static void gst_tensor_sink_ring_clear (GstTensorSink * self);
+static void gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint max);
+static guint gst_tensor_sink_get_max_buffers (GstTensorSink * self);
 static void gst_tensor_sink_set_last_render_time (GstTensorSink * self,
     GstClockTime now);
 static GstClockTime gst_tensor_sink_get_last_render_time (GstTensorSink * self);
@@ -149,6 +199,31 @@ static gboolean gst_tensor_sink_get_silent (GstTensorSink * self);
 #define gst_tensor_sink_parent_class parent_class
 G_DEFINE_TYPE (GstTensorSink, gst_tensor_sink, GST_TYPE_BASE_SINK);
 
+#define GST_TYPE_TENSOR_SINK_RING_POLICY (gst_tensor_sink_ring_policy_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'ring-policy' property
+ *        to a GType and return it
+ */
+static GType
+gst_tensor_sink_ring_policy_get_type (void)
+{
+  static GType policy_type = 0;
+
+  if (policy_type == 0) {
+    static GEnumValue policy_types[] = {
+      {TENSOR_SINK_RING_DROP_OLDEST, "Drop the oldest buffer if the ring is full",
+          "drop-oldest"},
+      {TENSOR_SINK_RING_BLOCK, "Block the streaming thread if the ring is full",
+          "block"},
+      {0, NULL, NULL},
+    };
+    policy_type = g_enum_register_static ("tensor_sink_ring_policy",
+        policy_types);
+  }
+
+  return policy_type;
+}
+
 /**
  * @brief Initialize tensor_sink class.
  */
@@ -207,6 +282,53 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSink::max-buffers:
+   *
+   * The max number of buffers in the ring for the pull-mode (Default 0, MAX 1024).
+   * If max-buffers is larger than 0, GstTensorSink keeps the received buffers in a bounded ring
+   * and does not emit the signal new-data. An application gets the buffers with the action signals
+   * pull, try-pull and pull-batch, without blocking the streaming thread.
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint ("max-buffers", "Max buffers",
+          "The max number of buffers in the ring for the pull-mode (0 to disable)",
+          0, MAX_RING_BUFFERS, DEFAULT_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::ring-policy:
+   *
+   * The policy when the ring is full.
+   * drop-oldest (default) drops the oldest buffer in the ring, and block waits until the application pulls a buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_RING_POLICY,
+      g_param_spec_enum ("ring-policy", "Ring policy",
+          "The policy when the ring is full", GST_TYPE_TENSOR_SINK_RING_POLICY,
+          DEFAULT_RING_POLICY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::fd:
+   *
+   * The file descriptor which is readable while the ring has buffers or the end-of-stream is reached.
+   * An application may poll this to integrate the pull-mode with its own main loop (-1 if not supported).
+   * Do not read or close the fd.
+   */
+  g_object_class_install_property (gobject_class, PROP_FD,
+      g_param_spec_int ("fd", "File descriptor",
+          "The fd readable while the ring has buffers or eos", -1, G_MAXINT,
+          -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::dropped:
+   *
+   * The number of buffers dropped from the ring.
+   */
+  g_object_class_install_property (gobject_class, PROP_DROPPED,
+      g_param_spec_uint64 ("dropped", "Dropped",
+          "The number of buffers dropped from the ring", 0, G_MAXUINT64, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorSink::new-data:
    *
@@ -239,6 +361,55 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       G_STRUCT_OFFSET (GstTensorSinkClass, eos), NULL, NULL, NULL,
       G_TYPE_NONE, 0, G_TYPE_NONE);
 
+  /**
+   * GstTensorSink::pull:
+   *
+   * Action signal to pull a buffer from the ring.
+   * This function blocks until a buffer is available, and returns NULL if the end-of-stream is reached or the element is stopped.
+   */
+  _tensor_sink_signals[SIGNAL_PULL] =
+      g_signal_new ("pull", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, pull), NULL, NULL, NULL,
+      GST_TYPE_BUFFER, 0, G_TYPE_NONE);
+
+  /**
+   * GstTensorSink::try-pull:
+   *
+   * Action signal to pull a buffer from the ring, waiting at most timeout nanoseconds.
+   * Returns NULL if no buffer is available in time.
+   */
+  _tensor_sink_signals[SIGNAL_TRY_PULL] =
+      g_signal_new ("try-pull", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, try_pull), NULL, NULL, NULL,
+      GST_TYPE_BUFFER, 1, GST_TYPE_CLOCK_TIME);
+
+  /**
+   * GstTensorSink::pull-batch:
+   *
+   * Action signal to pull up to num buffers (0 for all buffers in the ring), waiting at most timeout nanoseconds for the first one.
+   * The buffers are not copied. Returns NULL if no buffer is available in time.
+   */
+  _tensor_sink_signals[SIGNAL_PULL_BATCH] =
+      g_signal_new ("pull-batch", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, pull_batch), NULL, NULL, NULL,
+      GST_TYPE_BUFFER_LIST, 2, G_TYPE_UINT, GST_TYPE_CLOCK_TIME);
+
+  /**
+   * GstTensorSink::create-source:
+   *
+   * Action signal to create a GSource which is dispatched while the ring has buffers or the end-of-stream is reached.
+   * Set the callback (GSourceFunc) with g_source_set_callback() and attach it to the main context of the application.
+   * The callback should pull the buffers, and return G_SOURCE_REMOVE when the pull returns NULL.
+   */
+  _tensor_sink_signals[SIGNAL_CREATE_SOURCE] =
+      g_signal_new ("create-source", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, create_source), NULL, NULL, NULL,
+      G_TYPE_SOURCE, 0, G_TYPE_NONE);
+
   gst_element_class_set_static_metadata (element_class,
       "TensorSink",
       "Sink/Tensor",
@@ -257,6 +428,16 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
   bsink_class->query = GST_DEBUG_FUNCPTR (gst_tensor_sink_query);
   bsink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_sink_render);
   bsink_class->render_list = GST_DEBUG_FUNCPTR (gst_tensor_sink_render_list);
+  bsink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_sink_start);
+  bsink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_stop);
+  bsink_class->unlock = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock);
+  bsink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock_stop);
+
+  /** actions */
+  klass->pull = gst_tensor_sink_pull;
+  klass->try_pull = gst_tensor_sink_try_pull;
+  klass->pull_batch = gst_tensor_sink_pull_batch;
+  klass->create_source = gst_tensor_sink_create_source;
 }
 
 /**
@@ -270,6 +451,7 @@ gst_tensor_sink_init (GstTensorSink * self)
   bsink = GST_BASE_SINK (self);
 
   g_mutex_init (&self->mutex);
+  g_cond_init (&self->cond);
 
   /** init properties */
   self->silent = DEFAULT_SILENT;
@@ -277,6 +459,30 @@ gst_tensor_sink_init (GstTensorSink * self)
   self->signal_rate = DEFAULT_SIGNAL_RATE;
   self->last_render_time = GST_CLOCK_TIME_NONE;
 
+  /** init ring buffer */
+  self->ring = NULL;
+  self->ring_size = DEFAULT_MAX_BUFFERS;
+  self->ring_head = self->ring_count = 0;
+  self->ring_policy = DEFAULT_RING_POLICY;
+  self->dropped = 0;
+  self->flushing = TRUE;
+  self->is_eos = FALSE;
+  self->fd_signaled = FALSE;
+  self->fd[0] = self->fd[1] = -1;
+
+#if defined(HAVE_TENSOR_SINK_EVENTFD)
+  self->fd[0] = self->fd[1] = eventfd (0, EFD_CLOEXEC | EFD_NONBLOCK);
+#elif defined(G_OS_UNIX)
+  if (g_unix_open_pipe (self->fd, FD_CLOEXEC, NULL)) {
+    g_unix_set_fd_nonblocking (self->fd[0], TRUE, NULL);
+    g_unix_set_fd_nonblocking (self->fd[1], TRUE, NULL);
+  } else {
+    self->fd[0] = self->fd[1] = -1;
+  }
+#endif
+  if (self->fd[0] < 0)
+    GST_WARNING_OBJECT (self, "Failed to create the fd to notify new data.");
+
   /** enable qos */
   gst_base_sink_set_qos_enabled (bsink, DEFAULT_QOS);
 
@@ -310,6 +516,17 @@ gst_tensor_sink_set_property (GObject * object, guint prop_id,
       gst_tensor_sink_set_silent (self, g_value_get_boolean (value));
       break;
 
+    case PROP_MAX_BUFFERS:
+      gst_tensor_sink_set_max_buffers (self, g_value_get_uint (value));
+      break;
+
+    case PROP_RING_POLICY:
+      g_mutex_lock (&self->mutex);
+      self->ring_policy = g_value_get_enum (value);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -342,6 +559,26 @@ gst_tensor_sink_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value, gst_tensor_sink_get_silent (self));
       break;
 
+    case PROP_MAX_BUFFERS:
+      g_value_set_uint (value, gst_tensor_sink_get_max_buffers (self));
+      break;
+
+    case PROP_RING_POLICY:
+      g_mutex_lock (&self->mutex);
+      g_value_set_enum (value, self->ring_policy);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_FD:
+      g_value_set_int (value, self->fd[0]);
+      break;
+
+    case PROP_DROPPED:
+      g_mutex_lock (&self->mutex);
+      g_value_set_uint64 (value, self->dropped);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -360,11 +597,413 @@ gst_tensor_sink_finalize (GObject * object)
 
   self = GST_TENSOR_SINK (object);
 
+  gst_tensor_sink_ring_clear (self);
+  g_free (self->ring);
+  self->ring = NULL;
+
+  if (self->fd[0] >= 0)
+    close (self->fd[0]);
+  if (self->fd[1] >= 0 && self->fd[1] != self->fd[0])
+    close (self->fd[1]);
+  self->fd[0] = self->fd[1] = -1;
+
+  g_cond_clear (&self->cond);
   g_mutex_clear (&self->mutex);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Make the fd readable while the ring has buffers or eos is reached.
+ * @note Call this with the mutex locked.
+ */
+static void
+gst_tensor_sink_update_fd (GstTensorSink * self)
+{
+  gboolean readable;
+  ssize_t res = 0;
+
+  readable = (self->ring_count > 0 || self->is_eos);
+  if (self->fd[0] < 0 || readable == self->fd_signaled)
+    return;
+
+#if defined(HAVE_TENSOR_SINK_EVENTFD)
+  {
+    guint64 val = 1;
+
+    if (readable)
+      res = write (self->fd[1], &val, sizeof (val));
+    else
+      res = read (self->fd[0], &val, sizeof (val));
+  }
+#elif defined(G_OS_UNIX)
+  {
+    guint8 val = 1;
+
+    if (readable)
+      res = write (self->fd[1], &val, sizeof (val));
+    else
+      res = read (self->fd[0], &val, sizeof (val));
+  }
+#endif
+
+  if (res < 0 && errno != EAGAIN) {
+    GST_WARNING_OBJECT (self, "Failed to update the fd (%d).", errno);
+    return;
+  }
+
+  self->fd_signaled = readable;
+}
+
+/**
+ * @brief Release all buffers in the ring.
+ */
+static void
+gst_tensor_sink_ring_clear (GstTensorSink * self)
+{
+  g_mutex_lock (&self->mutex);
+  while (self->ring_count > 0) {
+    gst_buffer_unref (self->ring[self->ring_head]);
+    self->ring[self->ring_head] = NULL;
+    self->ring_head = (self->ring_head + 1) % self->ring_size;
+    self->ring_count--;
+  }
+  self->ring_head = 0;
+  gst_tensor_sink_update_fd (self);
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Push a buffer into the ring. The ring holds a reference of the buffer (no copy).
+ * @return GST_FLOW_FLUSHING if the element is stopped while waiting for the ring.
+ */
+static GstFlowReturn
+gst_tensor_sink_ring_push (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&self->mutex);
+
+  while (self->ring_size > 0 && self->ring_count >= self->ring_size &&
+      self->ring_policy == TENSOR_SINK_RING_BLOCK && !self->flushing) {
+    g_cond_wait (&self->cond, &self->mutex);
+  }
+
+  if (self->flushing) {
+    ret = GST_FLOW_FLUSHING;
+    goto done;
+  }
+
+  /* pull-mode is disabled while waiting */
+  if (self->ring_size == 0)
+    goto done;
+
+  if (self->ring_count >= self->ring_size) {
+    /* drop the oldest buffer */
+    gst_buffer_unref (self->ring[self->ring_head]);
+    self->ring[self->ring_head] = NULL;
+    self->ring_head = (self->ring_head + 1) % self->ring_size;
+    self->ring_count--;
+    self->dropped++;
+
+    silent_debug ("The ring is full, drop the oldest buffer (total %"
+        G_GUINT64_FORMAT ").", self->dropped);
+  }
+
+  self->ring[(self->ring_head + self->ring_count) % self->ring_size] =
+      gst_buffer_ref (buffer);
+  self->ring_count++;
+
+  gst_tensor_sink_update_fd (self);
+  g_cond_broadcast (&self->cond);
+
+done:
+  g_mutex_unlock (&self->mutex);
+  return ret;
+}
+
+/**
+ * @brief Pop up to num buffers from the ring, waiting at most timeout for the first one.
+ * @param num the max number of buffers (0 for all buffers in the ring)
+ * @param timeout the time to wait in nanoseconds (GST_CLOCK_TIME_NONE to wait until available)
+ * @param list (nullable) the list to append the buffers. If NULL, this returns a buffer.
+ * @return the first buffer if list is NULL, otherwise NULL.
+ */
+static GstBuffer *
+gst_tensor_sink_ring_pop (GstTensorSink * self, guint num,
+    GstClockTime timeout, GstBufferList * list)
+{
+  GstBuffer *buffer = NULL;
+  gint64 end_time = 0;
+
+  if (GST_CLOCK_TIME_IS_VALID (timeout))
+    end_time = g_get_monotonic_time () + timeout / GST_USECOND;
+
+  g_mutex_lock (&self->mutex);
+
+  while (self->ring_count == 0 && !self->is_eos && !self->flushing) {
+    if (!GST_CLOCK_TIME_IS_VALID (timeout)) {
+      g_cond_wait (&self->cond, &self->mutex);
+    } else if (!g_cond_wait_until (&self->cond, &self->mutex, end_time)) {
+      break;
+    }
+  }
+
+  if (num == 0 || num > self->ring_count)
+    num = self->ring_count;
+
+  while (num > 0) {
+    buffer = self->ring[self->ring_head];
+    self->ring[self->ring_head] = NULL;
+    self->ring_head = (self->ring_head + 1) % self->ring_size;
+    self->ring_count--;
+    num--;
+
+    if (list) {
+      gst_buffer_list_add (list, buffer);
+      buffer = NULL;
+    } else {
+      break;
+    }
+  }
+
+  gst_tensor_sink_update_fd (self);
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  return buffer;
+}
+
+/**
+ * @brief Pull a buffer, block until a buffer is available.
+ */
+static GstBuffer *
+gst_tensor_sink_pull (GstTensorSink * self)
+{
+  return gst_tensor_sink_ring_pop (self, 1, GST_CLOCK_TIME_NONE, NULL);
+}
+
+/**
+ * @brief Pull a buffer, waiting at most timeout.
+ */
+static GstBuffer *
+gst_tensor_sink_try_pull (GstTensorSink * self, GstClockTime timeout)
+{
+  return gst_tensor_sink_ring_pop (self, 1, timeout, NULL);
+}
+
+/**
+ * @brief Pull up to num buffers, waiting at most timeout for the first one.
+ */
+static GstBufferList *
+gst_tensor_sink_pull_batch (GstTensorSink * self, guint num,
+    GstClockTime timeout)
+{
+  GstBufferList *list;
+
+  list = gst_buffer_list_new ();
+  gst_tensor_sink_ring_pop (self, num, timeout, list);
+
+  if (gst_buffer_list_length (list) == 0) {
+    gst_buffer_list_unref (list);
+    list = NULL;
+  }
+
+  return list;
+}
+
+/**
+ * @brief GSource dispatched while the ring of tensor_sink has buffers.
+ */
+typedef struct
+{
+  GSource source; /**< parent source */
+  GstTensorSink *sink; /**< tensor_sink (reference) */
+} GstTensorSinkSource;
+
+/**
+ * @brief Check the ring of tensor_sink has buffers or eos is reached.
+ */
+static gboolean
+gst_tensor_sink_source_is_ready (GstTensorSink * self)
+{
+  gboolean ready;
+
+  g_mutex_lock (&self->mutex);
+  ready = (self->ring_count > 0 || self->is_eos);
+  g_mutex_unlock (&self->mutex);
+
+  return ready;
+}
+
+/**
+ * @brief GSourceFuncs::prepare of the tensor_sink source.
+ */
+static gboolean
+gst_tensor_sink_source_prepare (GSource * source, gint * timeout)
+{
+  GstTensorSinkSource *tsource = (GstTensorSinkSource *) source;
+
+  /* poll the ring periodically if fd is not available */
+  *timeout = (tsource->sink->fd[0] < 0) ? 10 : -1;
+  return gst_tensor_sink_source_is_ready (tsource->sink);
+}
+
+/**
+ * @brief GSourceFuncs::check of the tensor_sink source.
+ */
+static gboolean
+gst_tensor_sink_source_check (GSource * source)
+{
+  GstTensorSinkSource *tsource = (GstTensorSinkSource *) source;
+
+  return gst_tensor_sink_source_is_ready (tsource->sink);
+}
+
+/**
+ * @brief GSourceFuncs::dispatch of the tensor_sink source.
+ */
+static gboolean
+gst_tensor_sink_source_dispatch (GSource * source, GSourceFunc callback,
+    gpointer user_data)
+{
+  if (!callback) {
+    g_warning ("tensor_sink source dispatched without callback.");
+    return G_SOURCE_REMOVE;
+  }
+
+  return callback (user_data);
+}
+
+/**
+ * @brief GSourceFuncs::finalize of the tensor_sink source.
+ */
+static void
+gst_tensor_sink_source_finalize (GSource * source)
+{
+  GstTensorSinkSource *tsource = (GstTensorSinkSource *) source;
+
+  gst_object_unref (tsource->sink);
+  tsource->sink = NULL;
+}
+
+/**
+ * @brief GSourceFuncs of the tensor_sink source.
+ */
+static GSourceFuncs gst_tensor_sink_source_funcs = {
+  gst_tensor_sink_source_prepare,
+  gst_tensor_sink_source_check,
+  gst_tensor_sink_source_dispatch,
+  gst_tensor_sink_source_finalize,
+  NULL, NULL
+};
+
+/**
+ * @brief Create a GSource dispatched while the ring has buffers or eos is reached.
+ */
+static GSource *
+gst_tensor_sink_create_source (GstTensorSink * self)
+{
+  GSource *source;
+  GstTensorSinkSource *tsource;
+
+  source = g_source_new (&gst_tensor_sink_source_funcs,
+      sizeof (GstTensorSinkSource));
+  tsource = (GstTensorSinkSource *) source;
+  tsource->sink = gst_object_ref (self);
+
+  g_source_set_name (source, "tensor_sink");
+#if defined(G_OS_UNIX)
+  if (self->fd[0] >= 0)
+    g_source_add_unix_fd (source, self->fd[0], G_IO_IN);
+#endif
+
+  return source;
+}
+
+/**
+ * @brief Start the element (prepare to receive the buffers).
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_start (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  self->is_eos = FALSE;
+  self->dropped = 0;
+  gst_tensor_sink_update_fd (self);
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the element. Release the buffers and unblock the waiting threads.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  self->is_eos = FALSE;
+  g_mutex_unlock (&self->mutex);
+
+  gst_tensor_sink_ring_clear (self);
+  return TRUE;
+}
+
+/**
+ * @brief Unblock the streaming thread waiting for the ring.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the unlock state.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
 /**
  * @brief Handle events.
  *
@@ -384,6 +1023,11 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
 
   switch (type) {
     case GST_EVENT_STREAM_START:
+      g_mutex_lock (&self->mutex);
+      self->is_eos = FALSE;
+      gst_tensor_sink_update_fd (self);
+      g_mutex_unlock (&self->mutex);
+
       if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug ("Emit signal for stream start");
 
@@ -392,6 +1036,13 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       break;
 
     case GST_EVENT_EOS:
+      /* wake up the threads waiting for the ring */
+      g_mutex_lock (&self->mutex);
+      self->is_eos = TRUE;
+      gst_tensor_sink_update_fd (self);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->mutex);
+
       if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug ("Emit signal for eos");
 
@@ -399,6 +1050,15 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       }
       break;
 
+    case GST_EVENT_FLUSH_STOP:
+      /* drop the buffers received before flushing */
+      g_mutex_lock (&self->mutex);
+      self->is_eos = FALSE;
+      g_mutex_unlock (&self->mutex);
+
+      gst_tensor_sink_ring_clear (self);
+      break;
+
     default:
       break;
   }
@@ -449,9 +1109,7 @@ gst_tensor_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   GstTensorSink *self;
 
   self = GST_TENSOR_SINK (sink);
-  gst_tensor_sink_render_buffer (self, buffer);
-
-  return GST_FLOW_OK;
+  return gst_tensor_sink_render_buffer (self, buffer);
 }
 
 /**
@@ -464,34 +1122,36 @@ gst_tensor_sink_render_list (GstBaseSink * sink, GstBufferList * buffer_list)
 {
   GstTensorSink *self;
   GstBuffer *buffer;
+  GstFlowReturn ret = GST_FLOW_OK;
   guint i;
   guint num_buffers;
 
   self = GST_TENSOR_SINK (sink);
   num_buffers = gst_buffer_list_length (buffer_list);
 
-  for (i = 0; i < num_buffers; i++) {
+  for (i = 0; i < num_buffers && ret == GST_FLOW_OK; i++) {
     buffer = gst_buffer_list_get (buffer_list, i);
-    gst_tensor_sink_render_buffer (self, buffer);
+    ret = gst_tensor_sink_render_buffer (self, buffer);
   }
 
-  return GST_FLOW_OK;
+  return ret;
 }
 
 /**
  * @brief Handle buffer data.
- * @return None
+ * @return GST_FLOW_OK if the buffer is handled
  * @param self pointer to GstTensorSink
  * @param buffer pointer to GstBuffer to be handled
  */
-static void
+static GstFlowReturn
 gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
 {
   GstClockTime now = GST_CLOCK_TIME_NONE;
   guint signal_rate;
   gboolean notify = FALSE;
+  GstFlowReturn ret = GST_FLOW_OK;
 
-  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), GST_FLOW_ERROR);
 
   signal_rate = gst_tensor_sink_get_signal_rate (self);
 
@@ -525,7 +1185,10 @@ gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
   if (notify) {
     gst_tensor_sink_set_last_render_time (self, now);
 
-    if (gst_tensor_sink_get_emit_signal (self)) {
+    if (gst_tensor_sink_get_max_buffers (self) > 0) {
+      /* pull-mode, keep the buffer in the ring instead of the signal */
+      ret = gst_tensor_sink_ring_push (self, buffer);
+    } else if (gst_tensor_sink_get_emit_signal (self)) {
       silent_debug ("Emit signal for new data [%" GST_TIME_FORMAT "] rate [%d]",
           GST_TIME_ARGS (now), signal_rate);
 
@@ -534,6 +1197,7 @@ gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
   }
 
   silent_debug_timestamp (buffer);
+  return ret;
 }
 
 /**
@@ -650,3 +1314,59 @@ gst_tensor_sink_get_silent (GstTensorSink * self)
 
   return self->silent;
 }
+
+/**
+ * @brief Setter for value max_buffers. Resize the ring and keep the newest buffers.
+ */
+static void
+gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint max)
+{
+  GstBuffer **ring = NULL;
+  guint i, count;
+
+  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+
+  GST_INFO_OBJECT (self, "set max_buffers to %u", max);
+  g_mutex_lock (&self->mutex);
+
+  if (max > 0)
+    ring = g_new0 (GstBuffer *, max);
+
+  /* drop the oldest buffers not fitting in the new ring */
+  while (self->ring_count > max) {
+    gst_buffer_unref (self->ring[self->ring_head]);
+    self->ring_head = (self->ring_head + 1) % self->ring_size;
+    self->ring_count--;
+    self->dropped++;
+  }
+
+  count = self->ring_count;
+  for (i = 0; i < count; i++)
+    ring[i] = self->ring[(self->ring_head + i) % self->ring_size];
+
+  g_free (self->ring);
+  self->ring = ring;
+  self->ring_size = max;
+  self->ring_head = 0;
+
+  gst_tensor_sink_update_fd (self);
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Getter for value max_buffers.
+ */
+static guint
+gst_tensor_sink_get_max_buffers (GstTensorSink * self)
+{
+  guint max;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), 0);
+
+  g_mutex_lock (&self->mutex);
+  max = self->ring_size;
+  g_mutex_unlock (&self->mutex);
+
+  return max;
+}
@@ -47,6 +47,15 @@ G_BEGIN_DECLS
 typedef struct _GstTensorSink GstTensorSink;
 typedef struct _GstTensorSinkClass GstTensorSinkClass;
 
+/**
+ * @brief Policy of the ring buffer when it is full.
+ */
+typedef enum
+{
+  TENSOR_SINK_RING_DROP_OLDEST = 0, /**< drop the oldest buffer in the ring */
+  TENSOR_SINK_RING_BLOCK, /**< block the streaming thread until a buffer is pulled */
+} tensor_sink_ring_policy;
+
 /**
  * @brief GstTensorSink data structure.
  *
@@ -61,6 +70,19 @@ struct _GstTensorSink
   gboolean emit_signal; /**< true to emit signal for new data, eos */
   guint signal_rate; /**< new data signals per second */
   GstClockTime last_render_time; /**< buffer rendered time */
+
+  /** ring buffer for the pull-mode */
+  GCond cond; /**< condition to wait for the ring */
+  GstBuffer **ring; /**< bounded ring of the received buffers */
+  guint ring_size; /**< max number of buffers in the ring (0 to disable) */
+  guint ring_head; /**< index of the oldest buffer */
+  guint ring_count; /**< number of buffers in the ring */
+  tensor_sink_ring_policy ring_policy; /**< policy when the ring is full */
+  guint64 dropped; /**< number of buffers dropped from the ring */
+  gboolean flushing; /**< true to unblock the waiting threads */
+  gboolean is_eos; /**< true if end-of-stream reached */
+  gint fd[2]; /**< fd readable while the ring has data or eos, fd[1] to signal (same as fd[0] for eventfd) */
+  gboolean fd_signaled; /**< true if the fd is readable */
 };
 
 /**
@@ -76,6 +98,12 @@ struct _GstTensorSinkClass
   void (*new_data) (GstElement * element, GstBuffer * buffer); /**< signal when new data received */
   void (*stream_start) (GstElement * element); /**< signal when stream started */
   void (*eos) (GstElement * element); /**< signal when end of stream reached */
+
+  /** actions */
+  GstBuffer *(*pull) (GstTensorSink * sink); /**< pull a buffer from the ring, block until available */
+  GstBuffer *(*try_pull) (GstTensorSink * sink, GstClockTime timeout); /**< pull a buffer with timeout */
+  GstBufferList *(*pull_batch) (GstTensorSink * sink, guint num, GstClockTime timeout); /**< pull up to num buffers */
+  GSource *(*create_source) (GstTensorSink * sink); /**< create a source dispatched while the ring has data */
 };
 
 /**
@@ -473,6 +473,7 @@ gst_tensor_src_iio_init (GstTensorSrcIIO * self)
   self->default_buffer_capacity = 0;
   self->default_trigger = NULL;
   self->poll_timeout = DEFAULT_POLL_TIMEOUT;
+  gst_tensor_qos_reset (&self->qos);
 
   /**
    * format of the source since IIO device as a source is live and operates
@@ -2145,10 +2146,64 @@ gst_tensor_src_iio_stop (GstBaseSrc * src)
 static gboolean
 gst_tensor_src_iio_event (GstBaseSrc * src, GstEvent * event)
 {
-  /** No events to be handled yet */
+  GstTensorSrcIIO *self = GST_TENSOR_SRC_IIO (src);
+  GstClockTime duration = GST_CLOCK_TIME_NONE;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_QOS:
+      /** duration of a buffer with buffer_capacity scans */
+      if (self->sampling_frequency > 0)
+        duration = gst_util_uint64_scale (GST_SECOND, self->buffer_capacity,
+            self->sampling_frequency);
+
+      GST_OBJECT_LOCK (self);
+      gst_tensor_qos_update (&self->qos, event, duration);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      GST_OBJECT_LOCK (self);
+      gst_tensor_qos_reset (&self->qos);
+      GST_OBJECT_UNLOCK (self);
+      break;
+    default:
+      break;
+  }
+
   return GST_BASE_SRC_CLASS (parent_class)->event (src, event);
 }
 
+/**
+ * @brief check the data read now will be dropped in downstream (throttling QoS)
+ * @note the buffer is timestamped with the running time after create
+ */
+static gboolean
+gst_tensor_src_iio_check_qos (GstTensorSrcIIO * self)
+{
+  GstClock *clock;
+  GstClockTime now = GST_CLOCK_TIME_NONE;
+  gboolean skip;
+
+  GST_OBJECT_LOCK (self);
+  skip = GST_CLOCK_TIME_IS_VALID (self->qos.earliest);
+  GST_OBJECT_UNLOCK (self);
+
+  if (!skip)
+    return FALSE;
+
+  clock = gst_element_get_clock (GST_ELEMENT (self));
+  if (clock) {
+    now = GST_CLOCK_DIFF (gst_element_get_base_time (GST_ELEMENT (self)),
+        gst_clock_get_time (clock));
+    gst_object_unref (clock);
+  }
+
+  GST_OBJECT_LOCK (self);
+  skip = gst_tensor_qos_skip (&self->qos, now);
+  GST_OBJECT_UNLOCK (self);
+
+  return skip;
+}
+
 /**
  * @brief set new caps
  */
@@ -2563,6 +2618,14 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset,
           errno, status, bytes_to_read);
       goto error_data_free;
     }
+
+    /** skip parsing the scans which will be dropped in downstream */
+    if (gst_tensor_src_iio_check_qos (self)) {
+      GST_LOG_OBJECT (self, "Skip the scans (throttling, total %"
+          G_GUINT64_FORMAT ")", self->qos.skipped);
+      time_to_end = g_get_real_time () + self->poll_timeout * 1000;
+      continue;
+    }
     break;
   }
 
@@ -130,6 +130,7 @@ struct _GstTensorSrcIIO
   guint default_buffer_capacity; /**< size of the buffer */
   gchar *default_trigger; /**< default set value of sampling frequency */
   gint poll_timeout; /**< timeout for polling the fifo file */
+  GstTensorQoS qos; /**< throttling QoS from downstream to skip the scans */
 
   /** Only first element is filled when is_tensor is true */
   GstTensorsConfig *tensors_config; /**< tensors for storing data config */
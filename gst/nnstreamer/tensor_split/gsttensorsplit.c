@@ -38,6 +38,13 @@
  * ! tensor_split name=split tensorseg=2:100:100,1:100:100 split.src_0 ! queue ! filesink location=src0.log
  * split.src_1 ! queue ! filesink location=src1.log
  * ]|
+ * With split-dim, the tensor is split along the given dimension and the
+ * others of each segment are the same as the incoming tensor.
+ * e.g., to split the channels of RGB:
+ * |[
+ * ... ! tensor_converter ! tensor_split name=split split-dim=0 tensorseg=1:100:100,1:100:100,1:100:100 ...
+ * ]|
+ * A contiguous segment shares the memory of the incoming buffer (zero-copy).
  *
  * </refsect2>
  *
@@ -63,9 +70,21 @@ enum
   PROP_0,
   PROP_SILENT,
   PROP_TENSORPICK,
-  PROP_TENSORSEG
+  PROP_TENSORSEG,
+  PROP_SPLIT_DIM,
+  PROP_ZERO_COPY
 };
 
+/**
+ * @brief Default dimension to split along (split the byte stream).
+ */
+#define DEFAULT_SPLIT_DIM (-1)
+
+/**
+ * @brief Default value to share the memory of contiguous segments.
+ */
+#define DEFAULT_ZERO_COPY TRUE
+
 /**
  * @brief Template caps string.
  */
@@ -134,6 +153,20 @@ gst_tensor_split_class_init (GstTensorSplitClass * klass)
       g_param_spec_string ("tensorseg", "TensorSeg",
           "How to split tensor ?", "", G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_SPLIT_DIM,
+      g_param_spec_int ("split-dim", "Split dimension",
+          "The dimension (rank index) to split along. "
+          "The other dimensions of each tensorseg should be the same as the "
+          "incoming tensor. -1 splits the byte stream in order.",
+          -1, NNS_TENSOR_RANK_LIMIT - 1, DEFAULT_SPLIT_DIM,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_ZERO_COPY,
+      g_param_spec_boolean ("zero-copy", "Zero copy",
+          "Share the memory of the incoming buffer if the split tensor is "
+          "contiguous, instead of copying it.", DEFAULT_ZERO_COPY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_tensor_split_change_state);
 
@@ -170,12 +203,25 @@ gst_tensor_split_init (GstTensorSplit * split)
   split->silent = TRUE;
   split->tensorpick = NULL;
   split->tensorseg = NULL;
+  split->split_dim = DEFAULT_SPLIT_DIM;
+  split->zero_copy = DEFAULT_ZERO_COPY;
+  split->segments = NULL;
   split->have_group_id = FALSE;
   split->group_id = G_MAXUINT;
   split->srcpads = NULL;
   gst_tensors_config_init (&split->sink_tensor_conf);
 }
 
+/**
+ * @brief Clear the precomputed layout, it will be updated with next buffer.
+ */
+static void
+gst_tensor_split_reset_segments (GstTensorSplit * split)
+{
+  g_free (split->segments);
+  split->segments = NULL;
+}
+
 /**
  * @brief function to remove srcpad list
  */
@@ -192,6 +238,7 @@ gst_tensor_split_remove_src_pads (GstTensorSplit * split)
   split->num_tensors = 0;
   split->num_srcpads = 0;
   gst_tensors_config_free (&split->sink_tensor_conf);
+  gst_tensor_split_reset_segments (split);
 }
 
 /**
@@ -221,6 +268,7 @@ gst_tensor_split_get_capsparam (GstTensorSplit * split, GstCaps * caps)
   GstStructure *st;
 
   st = gst_caps_get_structure (caps, 0);
+  gst_tensor_split_reset_segments (split);
 
   return gst_tensors_config_from_structure (&split->sink_tensor_conf, st);
 }
@@ -401,6 +449,94 @@ done:
   return ret;
 }
 
+/**
+ * @brief Compute the byte layout of each tensorseg in the incoming buffer.
+ * @param split TensorSplit Object
+ * @return TRUE if tensorseg is valid with the incoming tensor
+ */
+static gboolean
+gst_tensor_split_prepare_segments (GstTensorSplit * split)
+{
+  GstTensorInfo *in_info;
+  GstTensorSplitSegment *segments;
+  tensor_dim *dim;
+  gsize esize, inner, outer, offset, limit;
+  guint i, d, axis;
+
+  if (split->sink_tensor_conf.info.num_tensors < 1 ||
+      !gst_tensor_info_validate (&split->sink_tensor_conf.info.info[0])) {
+    GST_ERROR_OBJECT (split, "The incoming tensor is not configured.");
+    return FALSE;
+  }
+
+  in_info = &split->sink_tensor_conf.info.info[0];
+  esize = gst_tensor_get_element_size (in_info->type);
+  segments = g_new0 (GstTensorSplitSegment, split->tensorseg->len);
+  offset = 0;
+
+  if (split->split_dim < 0) {
+    /* split the byte stream in order */
+    for (i = 0; i < split->tensorseg->len; i++) {
+      dim = g_array_index (split->tensorseg, tensor_dim *, i);
+
+      segments[i].offset = offset;
+      segments[i].size = gst_tensor_get_element_count (*dim) * esize;
+      segments[i].block = segments[i].stride = segments[i].size;
+      segments[i].num_blocks = 1;
+      offset += segments[i].size;
+    }
+
+    limit = gst_tensor_info_get_size (in_info);
+  } else {
+    axis = (guint) split->split_dim;
+    inner = esize;
+    outer = 1;
+
+    for (d = 0; d < axis; d++)
+      inner *= in_info->dimension[d];
+    for (d = axis + 1; d < NNS_TENSOR_RANK_LIMIT; d++)
+      outer *= in_info->dimension[d];
+
+    for (i = 0; i < split->tensorseg->len; i++) {
+      dim = g_array_index (split->tensorseg, tensor_dim *, i);
+
+      for (d = 0; d < NNS_TENSOR_RANK_LIMIT; d++) {
+        if (d != axis && (*dim)[d] != in_info->dimension[d]) {
+          GST_ERROR_OBJECT (split,
+              "The %u-th tensorseg differs from the incoming tensor in the "
+              "dimension %u (%u vs %u).", i, d, (*dim)[d],
+              in_info->dimension[d]);
+          g_free (segments);
+          return FALSE;
+        }
+      }
+
+      /* the segment is contiguous if all outer dimensions are 1 */
+      segments[i].offset = offset;
+      segments[i].block = inner * (*dim)[axis];
+      segments[i].stride = inner * in_info->dimension[axis];
+      segments[i].num_blocks = outer;
+      segments[i].size = segments[i].block * outer;
+      offset += segments[i].block;
+    }
+
+    limit = inner * in_info->dimension[axis];
+  }
+
+  if (offset > limit) {
+    GST_ERROR_OBJECT (split,
+        "The total size of tensorseg (%" G_GSIZE_FORMAT
+        ") exceeds the incoming tensor (%" G_GSIZE_FORMAT ").",
+        offset, limit);
+    g_free (segments);
+    return FALSE;
+  }
+
+  g_free (split->segments);
+  split->segments = segments;
+  return TRUE;
+}
+
 /**
  * @brief Make Splited Tensor
  * @param split TensorSplit Object
@@ -412,35 +548,52 @@ static GstMemory *
 gst_tensor_split_get_splited (GstTensorSplit * split, GstBuffer * buffer,
     gint nth)
 {
+  GstTensorSplitSegment *seg;
   GstMemory *mem;
-  tensor_dim *dim;
-  int i;
-  gsize size, offset;
   GstMapInfo src_info, dest_info;
+  guint idx, length;
+  gsize skip, b, end;
+  guint8 *src, *dest;
+
+  seg = &split->segments[nth];
+  end = seg->offset + (seg->num_blocks - 1) * seg->stride + seg->block;
+  if (end > gst_buffer_get_size (buffer)) {
+    ml_loge ("The incoming buffer is smaller than the tensorseg at tensor-split.\n");
+    return NULL;
+  }
 
-  dim = g_array_index (split->tensorseg, tensor_dim *, nth);
-  size = gst_tensor_get_element_count (*dim) *
-      gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  if (split->zero_copy && seg->num_blocks == 1 &&
+      gst_buffer_find_memory (buffer, seg->offset, seg->size, &idx, &length,
+          &skip) && length == 1) {
+    mem = gst_memory_share (gst_buffer_peek_memory (buffer, idx), skip,
+        seg->size);
+    if (mem)
+      return mem;
+    /* the memory cannot be shared, fall back to copy */
+  }
 
-  mem = gst_allocator_alloc (NULL, size, NULL);
+  mem = gst_allocator_alloc (NULL, seg->size, NULL);
   if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
     ml_logf ("Cannot map memory for destination buffer.\n");
+    gst_memory_unref (mem);
     return NULL;
   }
   if (!gst_buffer_map (buffer, &src_info, GST_MAP_READ)) {
     ml_logf ("Cannot map src-memory to gst buffer at tensor-split.\n");
     gst_memory_unmap (mem, &dest_info);
+    gst_memory_unref (mem);
     return NULL;
   }
 
-  offset = 0;
-  for (i = 0; i < nth; i++) {
-    dim = g_array_index (split->tensorseg, tensor_dim *, i);
-    offset += gst_tensor_get_element_count (*dim) *
-        gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  /* copy the blocks along the split dimension */
+  src = src_info.data + seg->offset;
+  dest = dest_info.data;
+  for (b = 0; b < seg->num_blocks; b++) {
+    nns_memcpy (dest, src, seg->block);
+    dest += seg->block;
+    src += seg->stride;
   }
 
-  nns_memcpy (dest_info.data, src_info.data + offset, size);
   gst_buffer_unmap (buffer, &src_info);
   gst_memory_unmap (mem, &dest_info);
 
@@ -467,6 +620,13 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return GST_FLOW_ERROR;
   }
 
+  if (split->segments == NULL && !gst_tensor_split_prepare_segments (split)) {
+    GST_ELEMENT_ERROR (split, STREAM, WRONG_TYPE,
+        ("The tensorseg does not match the incoming tensor."), NULL);
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
   for (i = 0; i < num_tensors; i++) {
     GstTensorPad *srcpad;
     GstBuffer *outbuf;
@@ -489,8 +649,14 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     srcpad = gst_tensor_split_get_tensor_pad (split, buf, &created, i);
 
-    outbuf = gst_buffer_new ();
     mem = gst_tensor_split_get_splited (split, buf, i);
+    if (mem == NULL) {
+      GST_ERROR_OBJECT (split, "Failed to split the %d-th tensor.", i);
+      res = GST_FLOW_ERROR;
+      break;
+    }
+
+    outbuf = gst_buffer_new ();
     gst_buffer_append_memory (outbuf, mem);
     ts = GST_BUFFER_TIMESTAMP (buf);
 
@@ -613,8 +779,16 @@ gst_tensor_split_set_property (GObject * object, guint prop_id,
         g_strfreev (p);
       }
       g_strfreev (strv);
+      gst_tensor_split_reset_segments (split);
       break;
     }
+    case PROP_SPLIT_DIM:
+      split->split_dim = g_value_get_int (value);
+      gst_tensor_split_reset_segments (split);
+      break;
+    case PROP_ZERO_COPY:
+      split->zero_copy = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -696,6 +870,12 @@ gst_tensor_split_get_property (GObject * object, guint prop_id,
       }
       break;
     }
+    case PROP_SPLIT_DIM:
+      g_value_set_int (value, split->split_dim);
+      break;
+    case PROP_ZERO_COPY:
+      g_value_set_boolean (value, split->zero_copy);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -44,6 +44,18 @@ G_BEGIN_DECLS
 typedef struct _GstTensorSplit GstTensorSplit;
 typedef struct _GstTensorSplitClass GstTensorSplitClass;
 
+/**
+ * @brief Byte layout of a split tensor in the incoming buffer
+ */
+typedef struct
+{
+  gsize offset; /**< byte offset of the first block */
+  gsize size; /**< byte size of the split tensor */
+  gsize block; /**< byte size of a contiguous block */
+  gsize stride; /**< bytes between the blocks */
+  gsize num_blocks; /**< the number of blocks (1 if contiguous) */
+} GstTensorSplitSegment;
+
 /**
  * @brief Tensor Spliter data structure
  */
@@ -58,6 +70,9 @@ struct _GstTensorSplit
   guint32 num_srcpads;
   GList *tensorpick;
   GArray *tensorseg;
+  gint split_dim; /**< the dimension to split along, -1 to split the byte stream */
+  gboolean zero_copy; /**< share the memory of contiguous segments */
+  GstTensorSplitSegment *segments; /**< precomputed layout of tensorseg */
   gboolean have_group_id;
   guint group_id;
   GstTensorsConfig sink_tensor_conf;
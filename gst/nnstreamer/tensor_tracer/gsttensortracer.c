@@ -0,0 +1,782 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-Tracer
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    gsttensortracer.c
+ * @date    18 Oct 2021
+ * @brief   GStreamer tracer to profile the elements of nnstreamer pipelines
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:tracer-nnstreamer
+ *
+ * The tracer hooks pad push and pull of the nnstreamer elements (and queues)
+ * and records the processing time, the queue wait, the bytes in/out and the
+ * number of allocated buffers and memories of each element.
+ * The processing time of an element is the time spent in the element while
+ * a buffer is pushed into it, excluding the time spent in the downstream elements.
+ *
+ * The report of a pipeline is written when the pipeline posts EOS,
+ * or the application can get it with the action signal "get-report".
+ *
+ * Parameters (comma separated):
+ * - format : "text" (default) or "json"
+ * - file : the file to append the report, stdout if not given
+ * - all : "true" to trace all elements in the pipeline
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * GST_TRACERS="nnstreamer(format=json,file=/tmp/report.json)" gst-launch-1.0 \
+ *     videotestsrc num-buffers=100 ! tensor_converter ! queue ! tensor_filter framework=... ! fakesink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <stdio.h>
+#include <glib/gstdio.h>
+
+#include "gsttensortracer.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_tracer_debug);
+#define GST_CAT_DEFAULT gst_tensor_tracer_debug
+
+#define _do_init \
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_tracer_debug, "nnstreamer_tracer", 0, \
+      "nnstreamer tracer to profile the elements");
+#define gst_tensor_tracer_parent_class parent_class
+G_DEFINE_TYPE_WITH_CODE (GstTensorTracer, gst_tensor_tracer, GST_TYPE_TRACER,
+    _do_init);
+
+/**
+ * @brief Signals of the tracer.
+ */
+enum
+{
+  SIGNAL_GET_REPORT,
+  LAST_SIGNAL
+};
+
+static guint gst_tensor_tracer_signals[LAST_SIGNAL] = { 0 };
+
+/**
+ * @brief Statistics of an element.
+ */
+typedef struct
+{
+  guint order;                  /**< the order the element is found */
+  gboolean traced;              /**< TRUE if the element is traced */
+  gboolean is_queue;            /**< TRUE if the element queues the buffers */
+
+  guint64 buffers_in;           /**< the number of incoming buffers */
+  guint64 buffers_out;          /**< the number of outgoing buffers */
+  guint64 bytes_in;             /**< incoming bytes */
+  guint64 bytes_out;            /**< outgoing bytes */
+  GstClockTime proc_time;       /**< accumulated processing time */
+  guint64 proc_num;             /**< the number of processing */
+  GstClockTime wait_time;       /**< accumulated time the buffers wait in the queue */
+  guint64 wait_num;             /**< the number of buffers out of the queue */
+  guint64 allocs;               /**< the number of allocated buffers and memories */
+
+  GHashTable *queued;           /**< the time the buffers entered the queue */
+} TensorTracerStats;
+
+/**
+ * @brief An element processing the data in a thread.
+ */
+typedef struct
+{
+  GstElement *element;          /**< the element, NULL for ghost and proxy pads */
+  GstClockTime resume;          /**< the time the element (re)started processing */
+} TensorTracerFrame;
+
+/**
+ * @brief Per-thread data of the tracer.
+ */
+typedef struct
+{
+  GArray *frames;               /**< stack of the elements processing the data */
+  guint64 pending_allocs;       /**< allocations before a source element pushes */
+} TensorTracerThread;
+
+/**
+ * @brief Free the per-thread data.
+ */
+static void
+_free_thread_data (gpointer data)
+{
+  TensorTracerThread *td = (TensorTracerThread *) data;
+
+  g_array_free (td->frames, TRUE);
+  g_free (td);
+}
+
+static GPrivate thread_data = G_PRIVATE_INIT (_free_thread_data);
+
+/**
+ * @brief Get the per-thread data.
+ */
+static TensorTracerThread *
+_get_thread_data (void)
+{
+  TensorTracerThread *td = g_private_get (&thread_data);
+
+  if (td == NULL) {
+    td = g_new0 (TensorTracerThread, 1);
+    td->frames = g_array_new (FALSE, FALSE, sizeof (TensorTracerFrame));
+    g_private_set (&thread_data, td);
+  }
+
+  return td;
+}
+
+/**
+ * @brief Free the statistics of an element.
+ */
+static void
+_free_stats (gpointer data)
+{
+  TensorTracerStats *stats = (TensorTracerStats *) data;
+
+  if (stats->queued)
+    g_hash_table_destroy (stats->queued);
+  g_free (stats);
+}
+
+/**
+ * @brief Get the element of the pad. Ghost and proxy pads are skipped.
+ */
+static GstElement *
+_get_pad_element (GstPad * pad)
+{
+  GstObject *parent;
+
+  if (pad == NULL || GST_IS_PROXY_PAD (pad))
+    return NULL;
+
+  parent = GST_OBJECT_PARENT (pad);
+  return GST_IS_ELEMENT (parent) ? GST_ELEMENT_CAST (parent) : NULL;
+}
+
+/**
+ * @brief Check whether the element is an nnstreamer element.
+ */
+static gboolean
+_is_nnstreamer_element (GstElement * element)
+{
+  GstElementFactory *factory = gst_element_get_factory (element);
+  const gchar *name;
+
+  if (factory == NULL)
+    return FALSE;
+
+  name = gst_plugin_feature_get_plugin_name (GST_PLUGIN_FEATURE (factory));
+  if (g_strcmp0 (name, "nnstreamer") == 0)
+    return TRUE;
+
+  name = gst_plugin_feature_get_name (GST_PLUGIN_FEATURE (factory));
+  return g_str_has_prefix (name, "tensor_");
+}
+
+/**
+ * @brief Get the statistics of the element. Caller should hold the lock.
+ */
+static TensorTracerStats *
+_get_stats (GstTensorTracer * self, GstElement * element)
+{
+  TensorTracerStats *stats;
+
+  stats = g_hash_table_lookup (self->elements, element);
+  if (stats == NULL) {
+    stats = g_new0 (TensorTracerStats, 1);
+    stats->order = g_hash_table_size (self->elements);
+    stats->is_queue = (g_object_class_find_property (G_OBJECT_GET_CLASS
+            (element), "max-size-buffers") != NULL);
+    stats->traced = (self->all || stats->is_queue ||
+        _is_nnstreamer_element (element));
+
+    if (stats->traced && stats->is_queue)
+      stats->queued = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+          NULL, g_free);
+
+    g_hash_table_insert (self->elements, element, stats);
+  }
+
+  return stats;
+}
+
+/**
+ * @brief Add the processing time of the frame. Caller should hold the lock.
+ */
+static void
+_add_proc_time (GstTensorTracer * self, TensorTracerFrame * frame,
+    GstClockTime ts)
+{
+  TensorTracerStats *stats;
+
+  if (frame->element == NULL || ts < frame->resume)
+    return;
+
+  stats = _get_stats (self, frame->element);
+  if (stats->traced)
+    stats->proc_time += ts - frame->resume;
+}
+
+/**
+ * @brief Start processing the data in the element. The element in the top of the stack is paused.
+ */
+static void
+_enter_element (GstTensorTracer * self, GstClockTime ts, GstElement * element)
+{
+  TensorTracerThread *td = _get_thread_data ();
+  TensorTracerFrame frame;
+
+  if (td->frames->len > 0) {
+    g_mutex_lock (&self->lock);
+    _add_proc_time (self, &g_array_index (td->frames, TensorTracerFrame,
+            td->frames->len - 1), ts);
+    g_mutex_unlock (&self->lock);
+  }
+
+  frame.element = element;
+  frame.resume = ts;
+  g_array_append_val (td->frames, frame);
+}
+
+/**
+ * @brief Finish processing the data in the element. The element in the top of the stack is resumed.
+ */
+static void
+_leave_element (GstTensorTracer * self, GstClockTime ts)
+{
+  TensorTracerThread *td = _get_thread_data ();
+  TensorTracerFrame *frame;
+
+  /* the tracer is started while pushing */
+  if (td->frames->len == 0)
+    return;
+
+  frame = &g_array_index (td->frames, TensorTracerFrame, td->frames->len - 1);
+
+  g_mutex_lock (&self->lock);
+  _add_proc_time (self, frame, ts);
+  g_mutex_unlock (&self->lock);
+
+  g_array_set_size (td->frames, td->frames->len - 1);
+
+  if (td->frames->len > 0) {
+    frame = &g_array_index (td->frames, TensorTracerFrame,
+        td->frames->len - 1);
+    frame->resume = ts;
+  }
+}
+
+/**
+ * @brief Update the statistics of the data from the sender to the receiver.
+ */
+static void
+_update_transfer (GstTensorTracer * self, GstClockTime ts,
+    GstElement * sender, GstElement * receiver, GstBuffer * buffer,
+    guint num, gsize size)
+{
+  TensorTracerThread *td = _get_thread_data ();
+  TensorTracerStats *stats;
+  gpointer entered;
+
+  g_mutex_lock (&self->lock);
+
+  if (sender) {
+    stats = _get_stats (self, sender);
+
+    if (stats->traced) {
+      stats->buffers_out += num;
+      stats->bytes_out += size;
+
+      /* allocated in a source element before pushing */
+      if (td->frames->len == 0)
+        stats->allocs += td->pending_allocs;
+
+      if (stats->queued && buffer &&
+          (entered = g_hash_table_lookup (stats->queued, buffer)) != NULL) {
+        GstClockTime in_ts = *((GstClockTime *) entered);
+
+        if (ts >= in_ts) {
+          stats->wait_time += ts - in_ts;
+          stats->wait_num++;
+        }
+        g_hash_table_remove (stats->queued, buffer);
+      }
+    }
+  }
+
+  if (td->frames->len == 0)
+    td->pending_allocs = 0;
+
+  if (receiver) {
+    stats = _get_stats (self, receiver);
+
+    if (stats->traced) {
+      stats->buffers_in += num;
+      stats->bytes_in += size;
+      stats->proc_num++;
+
+      if (stats->queued && buffer) {
+        GstClockTime *in_ts = g_new (GstClockTime, 1);
+
+        *in_ts = ts;
+        g_hash_table_insert (stats->queued, buffer, in_ts);
+      }
+    }
+  }
+
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Hook "pad-push-pre".
+ */
+static void
+do_push_buffer_pre (GstTensorTracer * self, GstClockTime ts, GstPad * pad,
+    GstBuffer * buffer)
+{
+  GstElement *receiver = _get_pad_element (GST_PAD_PEER (pad));
+
+  _update_transfer (self, ts, _get_pad_element (pad), receiver, buffer, 1,
+      gst_buffer_get_size (buffer));
+  _enter_element (self, ts, receiver);
+}
+
+/**
+ * @brief Hook "pad-push-list-pre".
+ */
+static void
+do_push_list_pre (GstTensorTracer * self, GstClockTime ts, GstPad * pad,
+    GstBufferList * list)
+{
+  GstElement *receiver = _get_pad_element (GST_PAD_PEER (pad));
+
+  _update_transfer (self, ts, _get_pad_element (pad), receiver, NULL,
+      gst_buffer_list_length (list), gst_buffer_list_calculate_size (list));
+  _enter_element (self, ts, receiver);
+}
+
+/**
+ * @brief Hook "pad-push-post" and "pad-push-list-post".
+ */
+static void
+do_push_post (GstTensorTracer * self, GstClockTime ts, GstPad * pad,
+    GstFlowReturn res)
+{
+  _leave_element (self, ts);
+}
+
+/**
+ * @brief Hook "pad-pull-range-pre". The upstream element produces the data.
+ */
+static void
+do_pull_range_pre (GstTensorTracer * self, GstClockTime ts, GstPad * pad,
+    guint64 offset, guint size)
+{
+  _enter_element (self, ts, _get_pad_element (GST_PAD_PEER (pad)));
+}
+
+/**
+ * @brief Hook "pad-pull-range-post".
+ */
+static void
+do_pull_range_post (GstTensorTracer * self, GstClockTime ts, GstPad * pad,
+    GstBuffer * buffer, GstFlowReturn res)
+{
+  _leave_element (self, ts);
+
+  if (res == GST_FLOW_OK && buffer) {
+    _update_transfer (self, ts, _get_pad_element (GST_PAD_PEER (pad)),
+        _get_pad_element (pad), NULL, 1, gst_buffer_get_size (buffer));
+  }
+}
+
+/**
+ * @brief Hook "mini-object-created". Count the buffers and memories allocated in the element.
+ */
+static void
+do_mini_object_created (GstTensorTracer * self, GstClockTime ts,
+    GstMiniObject * object)
+{
+  TensorTracerThread *td;
+  TensorTracerFrame *frame;
+  TensorTracerStats *stats;
+
+  if (!GST_IS_BUFFER (object) &&
+      GST_MINI_OBJECT_TYPE (object) != GST_TYPE_MEMORY)
+    return;
+
+  td = _get_thread_data ();
+  if (td->frames->len == 0) {
+    td->pending_allocs++;
+    return;
+  }
+
+  frame = &g_array_index (td->frames, TensorTracerFrame, td->frames->len - 1);
+  if (frame->element == NULL)
+    return;
+
+  g_mutex_lock (&self->lock);
+  stats = _get_stats (self, frame->element);
+  if (stats->traced)
+    stats->allocs++;
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Hook "object-destroyed".
+ */
+static void
+do_object_destroyed (GstTensorTracer * self, GstClockTime ts,
+    GstObject * object)
+{
+  g_mutex_lock (&self->lock);
+  g_hash_table_remove (self->elements, object);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Get the pipeline (top-level bin) of the element.
+ * @note This does not lock the objects, the hooks may be called with the object lock.
+ */
+static GstObject *
+_get_toplevel (GstElement * element)
+{
+  GstObject *obj = GST_OBJECT_CAST (element);
+
+  while (GST_OBJECT_PARENT (obj) != NULL)
+    obj = GST_OBJECT_PARENT (obj);
+
+  return obj;
+}
+
+/**
+ * @brief Statistics of an element in the report.
+ */
+typedef struct
+{
+  GstElement *element;          /**< the element */
+  TensorTracerStats stats;      /**< copy of the statistics */
+} TensorTracerEntry;
+
+/**
+ * @brief Compare the entries with the order the elements are found.
+ */
+static gint
+_compare_entry (gconstpointer a, gconstpointer b)
+{
+  const TensorTracerEntry *e1 = (const TensorTracerEntry *) a;
+  const TensorTracerEntry *e2 = (const TensorTracerEntry *) b;
+
+  return (e1->stats.order > e2->stats.order) -
+      (e1->stats.order < e2->stats.order);
+}
+
+/**
+ * @brief Get the report of the pipeline.
+ */
+static gchar *
+_get_report (GstTensorTracer * self, GstElement * pipeline,
+    tensor_tracer_format format)
+{
+  GArray *entries;
+  GHashTableIter iter;
+  gpointer key, value;
+  GString *report;
+  guint i;
+
+  entries = g_array_new (FALSE, FALSE, sizeof (TensorTracerEntry));
+
+  g_mutex_lock (&self->lock);
+  g_hash_table_iter_init (&iter, self->elements);
+  while (g_hash_table_iter_next (&iter, &key, &value)) {
+    TensorTracerEntry entry;
+
+    entry.element = GST_ELEMENT_CAST (key);
+    entry.stats = *((TensorTracerStats *) value);
+
+    if (!entry.stats.traced || entry.element == pipeline ||
+        _get_toplevel (entry.element) != GST_OBJECT_CAST (pipeline))
+      continue;
+
+    g_array_append_val (entries, entry);
+  }
+  g_mutex_unlock (&self->lock);
+
+  g_array_sort (entries, _compare_entry);
+
+  report = g_string_new (NULL);
+
+  if (format == TENSOR_TRACER_FORMAT_JSON) {
+    gchar *name = g_strescape (GST_OBJECT_NAME (pipeline), NULL);
+
+    g_string_append_printf (report, "{\"pipeline\": \"%s\", \"elements\": [",
+        name);
+    g_free (name);
+  } else {
+    g_string_append_printf (report,
+        "nnstreamer tracer report of %s\n"
+        "%-24s %-20s %10s %10s %14s %14s %12s %12s %12s %10s\n",
+        GST_OBJECT_NAME (pipeline), "element", "factory", "buf-in",
+        "buf-out", "bytes-in", "bytes-out", "proc-total", "proc-avg",
+        "wait-avg", "allocs");
+  }
+
+  for (i = 0; i < entries->len; i++) {
+    TensorTracerEntry *entry =
+        &g_array_index (entries, TensorTracerEntry, i);
+    TensorTracerStats *stats = &entry->stats;
+    GstElementFactory *factory = gst_element_get_factory (entry->element);
+    const gchar *fname = factory ?
+        gst_plugin_feature_get_name (GST_PLUGIN_FEATURE (factory)) : "";
+    guint64 proc_total = GST_TIME_AS_USECONDS (stats->proc_time);
+    guint64 proc_avg = stats->proc_num ? proc_total / stats->proc_num : 0;
+    guint64 wait_avg = stats->wait_num ?
+        GST_TIME_AS_USECONDS (stats->wait_time) / stats->wait_num : 0;
+
+    if (format == TENSOR_TRACER_FORMAT_JSON) {
+      gchar *name = g_strescape (GST_OBJECT_NAME (entry->element), NULL);
+
+      g_string_append_printf (report,
+          "%s{\"name\": \"%s\", \"factory\": \"%s\", "
+          "\"buffers_in\": %" G_GUINT64_FORMAT ", "
+          "\"buffers_out\": %" G_GUINT64_FORMAT ", "
+          "\"bytes_in\": %" G_GUINT64_FORMAT ", "
+          "\"bytes_out\": %" G_GUINT64_FORMAT ", "
+          "\"proc_total_us\": %" G_GUINT64_FORMAT ", "
+          "\"proc_avg_us\": %" G_GUINT64_FORMAT ", "
+          "\"queue_wait_avg_us\": %" G_GUINT64_FORMAT ", "
+          "\"allocs\": %" G_GUINT64_FORMAT "}",
+          (i > 0) ? ", " : "", name, fname, stats->buffers_in,
+          stats->buffers_out, stats->bytes_in, stats->bytes_out, proc_total,
+          proc_avg, wait_avg, stats->allocs);
+      g_free (name);
+    } else {
+      g_string_append_printf (report,
+          "%-24s %-20s %10" G_GUINT64_FORMAT " %10" G_GUINT64_FORMAT
+          " %14" G_GUINT64_FORMAT " %14" G_GUINT64_FORMAT
+          " %10" G_GUINT64_FORMAT "us %10" G_GUINT64_FORMAT
+          "us %10" G_GUINT64_FORMAT "us %10" G_GUINT64_FORMAT "\n",
+          GST_OBJECT_NAME (entry->element), fname, stats->buffers_in,
+          stats->buffers_out, stats->bytes_in, stats->bytes_out, proc_total,
+          proc_avg, wait_avg, stats->allocs);
+    }
+  }
+
+  if (format == TENSOR_TRACER_FORMAT_JSON)
+    g_string_append (report, "]}\n");
+
+  g_array_free (entries, TRUE);
+  return g_string_free (report, FALSE);
+}
+
+/**
+ * @brief Write the report of the pipeline.
+ */
+static void
+_write_report (GstTensorTracer * self, GstElement * pipeline)
+{
+  gchar *report = _get_report (self, pipeline, self->format);
+
+  if (self->file) {
+    FILE *fp = g_fopen (self->file, "a");
+
+    if (fp) {
+      fputs (report, fp);
+      fclose (fp);
+    } else {
+      GST_WARNING_OBJECT (self, "Failed to open the report file %s.",
+          self->file);
+    }
+  } else {
+    g_print ("%s", report);
+  }
+
+  g_free (report);
+}
+
+/**
+ * @brief Hook "element-post-message-pre". Write the report when the pipeline posts EOS.
+ */
+static void
+do_post_message_pre (GstTensorTracer * self, GstClockTime ts,
+    GstElement * element, GstMessage * message)
+{
+  if (GST_MESSAGE_TYPE (message) == GST_MESSAGE_EOS &&
+      GST_OBJECT_PARENT (element) == NULL && GST_IS_BIN (element))
+    _write_report (self, element);
+}
+
+/**
+ * @brief Get the format from the string.
+ */
+static tensor_tracer_format
+_get_format (const gchar * str)
+{
+  if (str && g_ascii_strcasecmp (str, "json") == 0)
+    return TENSOR_TRACER_FORMAT_JSON;
+
+  return TENSOR_TRACER_FORMAT_TEXT;
+}
+
+/**
+ * @brief Default handler of the action signal "get-report".
+ */
+static gchar *
+gst_tensor_tracer_get_report (GstTensorTracer * self, GstElement * pipeline,
+    const gchar * format)
+{
+  g_return_val_if_fail (GST_IS_ELEMENT (pipeline), NULL);
+
+  return _get_report (self, pipeline,
+      format ? _get_format (format) : self->format);
+}
+
+/**
+ * @brief Parse the parameters of the tracer.
+ */
+static void
+gst_tensor_tracer_parse_params (GstTensorTracer * self)
+{
+  gchar *params = NULL;
+  gchar **options;
+  guint i, num;
+
+  g_object_get (self, "params", &params, NULL);
+  if (params == NULL)
+    return;
+
+  options = g_strsplit (params, ",", -1);
+  num = g_strv_length (options);
+
+  for (i = 0; i < num; i++) {
+    gchar **option = g_strsplit (options[i], "=", 2);
+
+    if (g_strv_length (option) == 2) {
+      g_strstrip (option[0]);
+      g_strstrip (option[1]);
+
+      if (g_ascii_strcasecmp (option[0], "format") == 0) {
+        self->format = _get_format (option[1]);
+      } else if (g_ascii_strcasecmp (option[0], "file") == 0) {
+        g_free (self->file);
+        self->file = g_strdup (option[1]);
+      } else if (g_ascii_strcasecmp (option[0], "all") == 0) {
+        self->all = (g_ascii_strcasecmp (option[1], "true") == 0);
+      } else {
+        GST_WARNING_OBJECT (self, "Unknown option %s.", option[0]);
+      }
+    } else {
+      GST_WARNING_OBJECT (self, "Invalid option %s.", options[i]);
+    }
+
+    g_strfreev (option);
+  }
+
+  g_strfreev (options);
+  g_free (params);
+}
+
+/**
+ * @brief Constructed function of the tracer, the parameters are available.
+ */
+static void
+gst_tensor_tracer_constructed (GObject * object)
+{
+  GstTensorTracer *self = GST_TENSOR_TRACER (object);
+  GstTracer *tracer = GST_TRACER (object);
+
+  G_OBJECT_CLASS (parent_class)->constructed (object);
+
+  gst_tensor_tracer_parse_params (self);
+
+  gst_tracing_register_hook (tracer, "pad-push-pre",
+      G_CALLBACK (do_push_buffer_pre));
+  gst_tracing_register_hook (tracer, "pad-push-post",
+      G_CALLBACK (do_push_post));
+  gst_tracing_register_hook (tracer, "pad-push-list-pre",
+      G_CALLBACK (do_push_list_pre));
+  gst_tracing_register_hook (tracer, "pad-push-list-post",
+      G_CALLBACK (do_push_post));
+  gst_tracing_register_hook (tracer, "pad-pull-range-pre",
+      G_CALLBACK (do_pull_range_pre));
+  gst_tracing_register_hook (tracer, "pad-pull-range-post",
+      G_CALLBACK (do_pull_range_post));
+  gst_tracing_register_hook (tracer, "mini-object-created",
+      G_CALLBACK (do_mini_object_created));
+  gst_tracing_register_hook (tracer, "object-destroyed",
+      G_CALLBACK (do_object_destroyed));
+  gst_tracing_register_hook (tracer, "element-post-message-pre",
+      G_CALLBACK (do_post_message_pre));
+}
+
+/**
+ * @brief Finalize function of the tracer.
+ */
+static void
+gst_tensor_tracer_finalize (GObject * object)
+{
+  GstTensorTracer *self = GST_TENSOR_TRACER (object);
+
+  g_hash_table_destroy (self->elements);
+  g_mutex_clear (&self->lock);
+  g_free (self->file);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of the tracer.
+ */
+static void
+gst_tensor_tracer_class_init (GstTensorTracerClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  gobject_class->constructed = gst_tensor_tracer_constructed;
+  gobject_class->finalize = gst_tensor_tracer_finalize;
+
+  klass->get_report = gst_tensor_tracer_get_report;
+
+  /**
+   * GstTensorTracer::get-report:
+   * @tracer: the tracer
+   * @pipeline: the pipeline to get the report
+   * @format: (nullable): "text" or "json", NULL for the format of the parameter
+   *
+   * Get the report of the pipeline. Caller should free the returned string.
+   */
+  gst_tensor_tracer_signals[SIGNAL_GET_REPORT] =
+      g_signal_new ("get-report", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorTracerClass, get_report), NULL, NULL, NULL,
+      G_TYPE_STRING, 2, GST_TYPE_ELEMENT, G_TYPE_STRING);
+}
+
+/**
+ * @brief Initialize the tracer.
+ */
+static void
+gst_tensor_tracer_init (GstTensorTracer * self)
+{
+  g_mutex_init (&self->lock);
+  self->elements = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, _free_stats);
+
+  self->all = FALSE;
+  self->format = TENSOR_TRACER_FORMAT_TEXT;
+  self->file = NULL;
+}
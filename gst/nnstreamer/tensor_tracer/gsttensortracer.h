@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * GStreamer/NNStreamer Tensor-Tracer
+ * Copyright (C) 2021 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file    gsttensortracer.h
+ * @date    18 Oct 2021
+ * @brief   GStreamer tracer to profile the elements of nnstreamer pipelines
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_TRACER_H__
+#define __GST_TENSOR_TRACER_H__
+
+#ifndef GST_USE_UNSTABLE_API
+#define GST_USE_UNSTABLE_API
+#endif
+
+#include <gst/gst.h>
+#include <gst/gsttracer.h>
+
+G_BEGIN_DECLS
+#define GST_TYPE_TENSOR_TRACER (gst_tensor_tracer_get_type ())
+#define GST_TENSOR_TRACER(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_TENSOR_TRACER, GstTensorTracer))
+#define GST_TENSOR_TRACER_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST ((klass), GST_TYPE_TENSOR_TRACER, GstTensorTracerClass))
+#define GST_IS_TENSOR_TRACER(obj) (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_TENSOR_TRACER))
+#define GST_IS_TENSOR_TRACER_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass), GST_TYPE_TENSOR_TRACER))
+#define GST_TENSOR_TRACER_CAST(obj) ((GstTensorTracer *) (obj))
+typedef struct _GstTensorTracer GstTensorTracer;
+typedef struct _GstTensorTracerClass GstTensorTracerClass;
+
+/**
+ * @brief Report formats of the tracer.
+ */
+typedef enum
+{
+  TENSOR_TRACER_FORMAT_TEXT = 0,
+  TENSOR_TRACER_FORMAT_JSON,
+} tensor_tracer_format;
+
+/**
+ * @brief Tensor Tracer data structure.
+ */
+struct _GstTensorTracer
+{
+  GstTracer parent;             /**< This is the parent object */
+
+  GMutex lock;                  /**< lock for the statistics */
+  GHashTable *elements;         /**< statistics of the elements (GstElement * to stats) */
+
+  /** Parameters */
+  gboolean all;                 /**< trace all elements, not only nnstreamer and queues */
+  tensor_tracer_format format;  /**< format of the report */
+  gchar *file;                  /**< file to write the report, stdout if NULL */
+};
+
+/**
+ * @brief GstTensorTracerClass data structure.
+ */
+struct _GstTensorTracerClass
+{
+  GstTracerClass parent_class;  /**< parent class */
+
+  /** Action signal to get the report of a pipeline */
+  gchar *(*get_report) (GstTensorTracer * self, GstElement * pipeline,
+      const gchar * format);
+};
+
+/**
+ * @brief Function to get type of tensor_tracer.
+ */
+GType gst_tensor_tracer_get_type (void);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_TRACER_H__ */
@@ -93,14 +93,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
 #define GST_CAT_DEFAULT gst_tensor_transform_debug
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_DEFAULT ";" GST_TENSORS_FLEX_CAP_DEFAULT
 #define REGEX_DIMCHG_OPTION "^([0-3]):([0-3])$"
-#define REGEX_TYPECAST_OPTION "(^[u]?int(8|16|32|64)$|^float(32|64)$)"
+#define REGEX_TYPECAST_OPTION "(^[u]?int(8|16|32|64)$|^float(16|32|64)$|^bfloat16$)"
 #define REGEX_TRANSPOSE_OPTION "^(?:([0-2]):(?!.*\\1)){3}3$"
-#define REGEX_STAND_OPTION "^(default|dc-average)(:([u]?int(8|16|32|64)|float(32|64)))?(,per-channel:(true|false))?$"
+#define REGEX_STAND_OPTION "^(default|dc-average)(:([u]?int(8|16|32|64)|float(16|32|64)|bfloat16))?(,per-channel:(true|false))?$"
 #define REGEX_CLAMP_OPTION "^((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))):"\
     "((([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)))$"
-#define REGEX_ARITH_OPTION "^(typecast:([u]?int(8|16|32|64)|float(32|64)),)?"\
+#define REGEX_ARITH_OPTION "^(typecast:([u]?int(8|16|32|64)|float(16|32|64)|bfloat16),)?"\
     "(((add|mul|div)(:([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))+)(,|))+$"
-#define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(32|64)))"
+#define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)|bfloat16))"
+#define REGEX_QUANT_PARAMS ",scale(:[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)+"\
+    "(,zero-point(:[-+]?[0-9]+)+)?$"
+#define REGEX_QUANTIZE_OPTION "^[u]?int(8|16)" REGEX_QUANT_PARAMS
+#define REGEX_DEQUANTIZE_OPTION "^float(32|64)" REGEX_QUANT_PARAMS
 
 /**
  * @brief tensor_transform properties
@@ -212,6 +216,14 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_CLAMP, "Mode for clamping all elements of tensor into the range, "
             "option=CLAMP_MIN:CLAMP_MAX",
           "clamp"},
+      {GTT_QUANTIZE, "Mode for affine quantization of tensor, "
+            "q = round(x / scale) + zero-point with saturation, "
+            "option=(u)int(8|16),scale:NUMBER...[,zero-point:INTEGER...]",
+          "quantize"},
+      {GTT_DEQUANTIZE, "Mode for affine dequantization of tensor, "
+            "x = (q - zero-point) * scale, "
+            "option=float(32|64),scale:NUMBER...[,zero-point:INTEGER...]",
+          "dequantize"},
       {GTT_UNKNOWN, "Unknown or not-implemented-yet mode",
           "unknown"},
       {0, NULL, NULL},
@@ -305,6 +317,7 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->loaded = FALSE;
   filter->operators = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
+  filter->accel = transform_accel_get ();
   filter->apply = NULL;
 
   gst_tensors_config_init (&filter->in_config);
@@ -343,7 +356,7 @@ gst_tensor_transform_get_stand_mode (const gchar * str)
 
 #ifdef HAVE_ORC
 /* define macros for orc */
-/** @todo support 64bit integer and remove below line */
+/* orc does not support 64bit integer, typed loops and CPU-specific kernels handle it. */
 #define type_64bit_integer(t) ((t) == _NNS_INT64 || (t) == _NNS_UINT64)
 #define orc_supported(f,itype,otype) ((f)->acceleration && !(type_64bit_integer (itype) || type_64bit_integer (otype)))
 
@@ -394,26 +407,13 @@ gst_tensor_transform_get_stand_mode (const gchar * str)
     } \
   } while (0)
 
-#define orc_operator_div_loop(i,n,val,typename) do { \
-    gsize idx_div; \
-    typename *data_in = (typename *) (i); \
-    for (idx_div = 0; idx_div < (n); ++idx_div) { \
-      data_in[idx_div] = data_in[idx_div] / (val); \
-    } \
-  } while (0)
-
+/* integer division is done with the precomputed reciprocal (see transform_accel_div) */
 #define orc_operator(i,n,v,op) do { \
     switch (op) { \
       case GTT_OP_ADD: orc_operator_func (i, n, v, orc_func_add); break; \
       case GTT_OP_MUL: orc_operator_func (i, n, v, orc_func_mul); break; \
       case GTT_OP_DIV: \
         switch ((v)->type) { \
-          case _NNS_INT32: orc_operator_div_loop (i, n, (v)->data._int32_t, int32_t); break; \
-          case _NNS_UINT32: orc_operator_div_loop (i, n, (v)->data._uint32_t, uint32_t); break; \
-          case _NNS_INT16: orc_operator_div_loop (i, n, (v)->data._int16_t, int16_t); break; \
-          case _NNS_UINT16: orc_operator_div_loop (i, n, (v)->data._uint16_t, uint16_t); break; \
-          case _NNS_INT8: orc_operator_div_loop (i, n, (v)->data._int8_t, int8_t); break; \
-          case _NNS_UINT8: orc_operator_div_loop (i, n, (v)->data._uint8_t, uint8_t); break; \
           case _NNS_FLOAT64: orc_func_div (f64) ((gpointer) i, (v)->data._double, n); break; \
           case _NNS_FLOAT32: orc_func_div (f32) ((gpointer) i, (v)->data._float, n); break; \
           default: GST_ERROR_OBJECT (filter, "Unsupported type %d", (v)->type); g_assert (0); break; \
@@ -425,85 +425,229 @@ gst_tensor_transform_get_stand_mode (const gchar * str)
 #endif /* HAVE_ORC */
 
 /**
- * @brief Macro for operator
+ * @brief The number of elements processed at once in arithmetic mode.
+ * All operators are applied to a block while it stays in the cache, instead of one pass over the tensor per operator.
  */
-#define handle_operator(d,v,oper,vtype) do { \
-    switch (oper) { \
-      case GTT_OP_ADD: \
-        (d)->data._##vtype += (v)->data._##vtype; \
-        break; \
-      case GTT_OP_MUL: \
-        (d)->data._##vtype *= (v)->data._##vtype; \
-        break; \
-      case GTT_OP_DIV: \
-        if ((v)->data._##vtype == 0) { \
-          GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0."); \
-          return FALSE; \
-        } \
-        (d)->data._##vtype /= (v)->data._##vtype; \
-        break; \
-      default: \
-        GST_ERROR_OBJECT (filter, "Unknown operator %d", oper); \
-        return FALSE; \
+#define GTT_BLOCK_SIZE (2048)
+
+/**
+ * @brief Macros for the typed loops (without the conversion of each element with tensor_data_s)
+ */
+#define typed_typecast_loop(i,o,n,itype,otype) do { \
+    const itype *_src = (const itype *) (i); \
+    otype *_dst = (otype *) (o); \
+    gsize _k; \
+    for (_k = 0; _k < (n); ++_k) \
+      _dst[_k] = (otype) _src[_k]; \
+  } while (0)
+
+#define typed_typecast_to(i,o,n,itype,otype) do { \
+    switch (otype) { \
+      case _NNS_INT32: typed_typecast_loop (i, o, n, itype, int32_t); break; \
+      case _NNS_UINT32: typed_typecast_loop (i, o, n, itype, uint32_t); break; \
+      case _NNS_INT16: typed_typecast_loop (i, o, n, itype, int16_t); break; \
+      case _NNS_UINT16: typed_typecast_loop (i, o, n, itype, uint16_t); break; \
+      case _NNS_INT8: typed_typecast_loop (i, o, n, itype, int8_t); break; \
+      case _NNS_UINT8: typed_typecast_loop (i, o, n, itype, uint8_t); break; \
+      case _NNS_FLOAT64: typed_typecast_loop (i, o, n, itype, double); break; \
+      case _NNS_FLOAT32: typed_typecast_loop (i, o, n, itype, float); break; \
+      case _NNS_INT64: typed_typecast_loop (i, o, n, itype, int64_t); break; \
+      case _NNS_UINT64: typed_typecast_loop (i, o, n, itype, uint64_t); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported output type %d", otype); g_assert (0); break; \
+    } \
+  } while (0)
+
+#define typed_typecast(i,o,n,itype,otype) do { \
+    switch (itype) { \
+      case _NNS_INT32: typed_typecast_to (i, o, n, int32_t, otype); break; \
+      case _NNS_UINT32: typed_typecast_to (i, o, n, uint32_t, otype); break; \
+      case _NNS_INT16: typed_typecast_to (i, o, n, int16_t, otype); break; \
+      case _NNS_UINT16: typed_typecast_to (i, o, n, uint16_t, otype); break; \
+      case _NNS_INT8: typed_typecast_to (i, o, n, int8_t, otype); break; \
+      case _NNS_UINT8: typed_typecast_to (i, o, n, uint8_t, otype); break; \
+      case _NNS_FLOAT64: typed_typecast_to (i, o, n, double, otype); break; \
+      case _NNS_FLOAT32: typed_typecast_to (i, o, n, float, otype); break; \
+      case _NNS_INT64: typed_typecast_to (i, o, n, int64_t, otype); break; \
+      case _NNS_UINT64: typed_typecast_to (i, o, n, uint64_t, otype); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported input type %d", itype); g_assert (0); break; \
+    } \
+  } while (0)
+
+#define typed_operator_loop(d,n,v,ctype,op) do { \
+    ctype *_data = (ctype *) (d); \
+    const ctype _val = (v)->data._##ctype; \
+    gsize _k; \
+    for (_k = 0; _k < (n); ++_k) \
+      _data[_k] = _data[_k] op _val; \
+  } while (0)
+
+#define typed_operator(d,n,v,op) do { \
+    switch ((v)->type) { \
+      case _NNS_INT32: typed_operator_loop (d, n, v, int32_t, op); break; \
+      case _NNS_UINT32: typed_operator_loop (d, n, v, uint32_t, op); break; \
+      case _NNS_INT16: typed_operator_loop (d, n, v, int16_t, op); break; \
+      case _NNS_UINT16: typed_operator_loop (d, n, v, uint16_t, op); break; \
+      case _NNS_INT8: typed_operator_loop (d, n, v, int8_t, op); break; \
+      case _NNS_UINT8: typed_operator_loop (d, n, v, uint8_t, op); break; \
+      case _NNS_FLOAT64: typed_operator_loop (d, n, v, double, op); break; \
+      case _NNS_FLOAT32: typed_operator_loop (d, n, v, float, op); break; \
+      case _NNS_INT64: typed_operator_loop (d, n, v, int64_t, op); break; \
+      case _NNS_UINT64: typed_operator_loop (d, n, v, uint64_t, op); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported type %d", (v)->type); g_assert (0); break; \
     } \
   } while (0)
 
 /**
- * @brief Handle operators for tensor value
- * @param filter "this" pointer
- * @param desc struct for tensor value
- * @param val struct for tensor value
- * @param op operator for given tensor value
- * @return TRUE if no error
+ * @brief Internal data structure for an operator with the operand converted to the data type.
  */
-static gboolean
-gst_tensor_transform_do_operator (GstTensorTransform * filter,
-    tensor_data_s * desc, const tensor_data_s * val,
-    tensor_transform_operator op)
+typedef struct
 {
-  g_return_val_if_fail (desc != NULL, FALSE);
-  g_return_val_if_fail (val != NULL, FALSE);
-  g_return_val_if_fail (desc->type == val->type, FALSE);
+  tensor_transform_operator op;
+  tensor_data_s value; /**< operand in the data type */
+  gboolean use_div; /**< TRUE to divide the integers with the precomputed reciprocal */
+  transform_accel_divisor div; /**< reciprocal of the integer operand */
+} tensor_transform_step_s;
 
-  switch (desc->type) {
-    case _NNS_INT32:
-      handle_operator (desc, val, op, int32_t);
-      break;
-    case _NNS_UINT32:
-      handle_operator (desc, val, op, uint32_t);
-      break;
-    case _NNS_INT16:
-      handle_operator (desc, val, op, int16_t);
-      break;
-    case _NNS_UINT16:
-      handle_operator (desc, val, op, uint16_t);
-      break;
+/**
+ * @brief Get the range of the quantized type.
+ * @return FALSE if the type is not supported for quantization.
+ */
+static gboolean
+gst_tensor_transform_get_quant_range (tensor_type type, gint64 * qmin,
+    gint64 * qmax)
+{
+  switch (type) {
     case _NNS_INT8:
-      handle_operator (desc, val, op, int8_t);
+      *qmin = G_MININT8;
+      *qmax = G_MAXINT8;
       break;
     case _NNS_UINT8:
-      handle_operator (desc, val, op, uint8_t);
-      break;
-    case _NNS_FLOAT64:
-      handle_operator (desc, val, op, double);
+      *qmin = 0;
+      *qmax = G_MAXUINT8;
       break;
-    case _NNS_FLOAT32:
-      handle_operator (desc, val, op, float);
+    case _NNS_INT16:
+      *qmin = G_MININT16;
+      *qmax = G_MAXINT16;
       break;
-    case _NNS_INT64:
-      handle_operator (desc, val, op, int64_t);
+    case _NNS_UINT16:
+      *qmin = 0;
+      *qmax = G_MAXUINT16;
       break;
-    case _NNS_UINT64:
-      handle_operator (desc, val, op, uint64_t);
+    case _NNS_INT32:
+      *qmin = G_MININT32;
+      *qmax = G_MAXINT32;
       break;
     default:
-      GST_ERROR_OBJECT (filter, "Unknown tensor type %d", desc->type);
       return FALSE;
   }
 
   return TRUE;
 }
 
+/**
+ * @brief Parse the option of quantize and dequantize mode.
+ *        option=TYPE,scale:S1[:S2...][,zero-point:Z1[:Z2...]]
+ * @param[in/out] filter "this" pointer
+ * @param[in] filter_name the name of the element for the error message
+ * @return TRUE if the scales and zero-points are loaded.
+ */
+static gboolean
+gst_tensor_transform_set_quant_option (GstTensorTransform * filter,
+    const gchar * filter_name)
+{
+  const gboolean quantize = (filter->mode == GTT_QUANTIZE);
+  gchar **options, **strv;
+  gdouble *scale = NULL;
+  gint32 *zero_point = NULL;
+  tensor_type type;
+  guint i, num_scales = 0, num_zero_points = 0;
+  gint64 qmin, qmax;
+  gboolean ret = FALSE;
+
+  if (!g_regex_match_simple (quantize ? REGEX_QUANTIZE_OPTION :
+          REGEX_DEQUANTIZE_OPTION, filter->option, G_REGEX_CASELESS, 0)) {
+    ml_loge
+        ("%s: %s: \'%s\' is not valid option string: it should be in the form of %s,scale:NUMBER...[,zero-point:INTEGER...]\n",
+        filter_name, quantize ? "quantize" : "dequantize", filter->option,
+        quantize ? "(u)int(8|16)" : "float(32|64)");
+    return FALSE;
+  }
+
+  options = g_strsplit (filter->option, ",", -1);
+  type = gst_tensor_get_type (options[0]);
+
+  /* the zero-point should be in the range of the quantized type */
+  if (!quantize || !gst_tensor_transform_get_quant_range (type, &qmin, &qmax))
+    gst_tensor_transform_get_quant_range (_NNS_INT32, &qmin, &qmax);
+
+  /* scales, float32 kernels use the scale in float32 precision */
+  strv = g_strsplit (options[1], ":", -1);
+  num_scales = g_strv_length (strv) - 1;
+  scale = g_new (gdouble, num_scales);
+
+  for (i = 0; i < num_scales; i++) {
+    gdouble val = g_ascii_strtod (strv[i + 1], NULL);
+
+    if (!(val >= G_MINFLOAT) || val > G_MAXFLOAT) {
+      ml_loge ("%s: scale %s is out of range\n", filter_name, strv[i + 1]);
+      g_strfreev (strv);
+      goto done;
+    }
+
+    scale[i] = val;
+  }
+  g_strfreev (strv);
+
+  /* zero-points, 0 if not given */
+  if (options[2]) {
+    strv = g_strsplit (options[2], ":", -1);
+    num_zero_points = g_strv_length (strv) - 1;
+    zero_point = g_new (gint32, num_zero_points);
+
+    for (i = 0; i < num_zero_points; i++) {
+      gint64 val = g_ascii_strtoll (strv[i + 1], NULL, 10);
+
+      if (val < qmin || val > qmax) {
+        ml_loge ("%s: zero-point %s is out of range of %s\n", filter_name,
+            strv[i + 1], quantize ? options[0] : "int32");
+        g_strfreev (strv);
+        goto done;
+      }
+
+      zero_point[i] = (gint32) val;
+    }
+    g_strfreev (strv);
+  } else {
+    num_zero_points = 1;
+    zero_point = g_new0 (gint32, 1);
+  }
+
+  if (num_scales > 1 && num_zero_points > 1 && num_scales != num_zero_points) {
+    ml_loge
+        ("%s: the number of scales (%u) and zero-points (%u) should be same for per-channel parameters\n",
+        filter_name, num_scales, num_zero_points);
+    goto done;
+  }
+
+  g_free (filter->quant_scale);
+  g_free (filter->quant_zero_point);
+  filter->quant_scale = scale;
+  filter->quant_zero_point = zero_point;
+  scale = NULL;
+  zero_point = NULL;
+
+  filter->data_quant.type = type;
+  filter->data_quant.num_scales = num_scales;
+  filter->data_quant.num_zero_points = num_zero_points;
+  ret = TRUE;
+
+done:
+  g_free (scale);
+  g_free (zero_point);
+  g_strfreev (options);
+  return ret;
+}
+
 /**
  * @brief Setup internal data (data_* in GstTensorTransform)
  * @param[in/out] filter "this" pointer. mode & option MUST BE set already.
@@ -781,6 +925,11 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       ret = filter->loaded = TRUE;
       break;
     }
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+      ret = filter->loaded =
+          gst_tensor_transform_set_quant_option (filter, filter_name);
+      break;
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = FALSE;
@@ -929,6 +1078,14 @@ gst_tensor_transform_finalize (GObject * object)
     filter->operators = NULL;
   }
 
+  g_free (filter->stats);
+  filter->stats = NULL;
+
+  g_free (filter->quant_scale);
+  filter->quant_scale = NULL;
+  g_free (filter->quant_zero_point);
+  filter->quant_zero_point = NULL;
+
   if (filter->apply) {
     g_list_free (filter->apply);
     filter->apply = NULL;
@@ -1019,6 +1176,142 @@ gst_tensor_transform_dimchg (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+static void gst_tensor_transform_typecast_array (GstTensorTransform * filter,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num);
+
+/**
+ * @brief Convert the array of 16-bit floating point type (float16 or bfloat16) to float32.
+ */
+static void
+gst_tensor_transform_half_to_float (GstTensorTransform * filter,
+    tensor_type type, const uint8_t * inptr, gfloat * outptr, gsize num)
+{
+  const uint16_t *src = (const uint16_t *) inptr;
+  transform_accel_typecast_func kernel;
+  gsize i;
+
+  kernel = (type == _NNS_FLOAT16) ?
+      filter->accel->typecast_f16_f32 : filter->accel->typecast_bf16_f32;
+  if (kernel) {
+    kernel (inptr, outptr, num);
+    return;
+  }
+
+  if (type == _NNS_FLOAT16) {
+    for (i = 0; i < num; i++)
+      outptr[i] = gst_tensor_data_float16_to_float (src[i]);
+  } else {
+    for (i = 0; i < num; i++)
+      outptr[i] = gst_tensor_data_bfloat16_to_float (src[i]);
+  }
+}
+
+/**
+ * @brief Convert the array of float32 to 16-bit floating point type (float16 or bfloat16).
+ */
+static void
+gst_tensor_transform_float_to_half (GstTensorTransform * filter,
+    tensor_type type, const gfloat * inptr, uint8_t * outptr, gsize num)
+{
+  uint16_t *dst = (uint16_t *) outptr;
+  transform_accel_typecast_func kernel;
+  gsize i;
+
+  kernel = (type == _NNS_FLOAT16) ?
+      filter->accel->typecast_f32_f16 : filter->accel->typecast_f32_bf16;
+  if (kernel) {
+    kernel (inptr, outptr, num);
+    return;
+  }
+
+  if (type == _NNS_FLOAT16) {
+    for (i = 0; i < num; i++)
+      dst[i] = gst_tensor_data_float_to_float16 (inptr[i]);
+  } else {
+    for (i = 0; i < num; i++)
+      dst[i] = gst_tensor_data_float_to_bfloat16 (inptr[i]);
+  }
+}
+
+/**
+ * @brief Convert the array from or to 16-bit floating point type, other types are converted via float32 for each block.
+ */
+static void
+gst_tensor_transform_typecast_half (GstTensorTransform * filter,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num)
+{
+  gfloat block[GTT_BLOCK_SIZE];
+  gsize in_element_size, out_element_size;
+  gulong offset, len;
+
+  if (out_type == _NNS_FLOAT32) {
+    gst_tensor_transform_half_to_float (filter, in_type, inptr,
+        (gfloat *) outptr, num);
+    return;
+  }
+
+  if (in_type == _NNS_FLOAT32) {
+    gst_tensor_transform_float_to_half (filter, out_type,
+        (const gfloat *) inptr, outptr, num);
+    return;
+  }
+
+  in_element_size = gst_tensor_get_element_size (in_type);
+  out_element_size = gst_tensor_get_element_size (out_type);
+
+  for (offset = 0; offset < num; offset += len) {
+    len = MIN (GTT_BLOCK_SIZE, num - offset);
+
+    gst_tensor_transform_typecast_array (filter, in_type, _NNS_FLOAT32,
+        inptr + in_element_size * offset, (uint8_t *) block, len);
+    gst_tensor_transform_typecast_array (filter, _NNS_FLOAT32, out_type,
+        (const uint8_t *) block, outptr + out_element_size * offset, len);
+  }
+}
+
+/**
+ * @brief Convert the array type. If in/out type is same, this will copy the input array to output.
+ * @param[in] filter "this" pointer
+ * @param[in] in_type input type
+ * @param[in] out_type output type
+ * @param[in] inptr input array
+ * @param[out] outptr output array
+ * @param[in] num the number of elements
+ */
+static void
+gst_tensor_transform_typecast_array (GstTensorTransform * filter,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num)
+{
+  if (in_type == out_type) {
+    nns_memcpy (outptr, inptr, num * gst_tensor_get_element_size (in_type));
+    return;
+  }
+
+  if (gst_tensor_type_is_half (in_type) || gst_tensor_type_is_half (out_type)) {
+    gst_tensor_transform_typecast_half (filter, in_type, out_type, inptr,
+        outptr, num);
+    return;
+  }
+
+  if (in_type == _NNS_UINT8 && out_type == _NNS_FLOAT32 &&
+      filter->accel->typecast_u8_f32) {
+    filter->accel->typecast_u8_f32 (inptr, outptr, num);
+    return;
+  }
+
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_type, out_type)) {
+    orc_typecast (inptr, outptr, num, in_type, out_type);
+    return;
+  }
+#endif
+
+  typed_typecast (inptr, outptr, num, in_type, out_type);
+}
+
 /**
  * @brief subrouting for tensor-tranform, "typecast" case.
  * @param[in/out] filter "this" pointer
@@ -1033,28 +1326,135 @@ gst_tensor_transform_typecast (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  gulong i, num;
-  gsize in_element_size, out_element_size;
+  gulong num;
 
   num = gst_tensor_get_element_count (in_info->dimension);
 
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
-    return GST_FLOW_OK;
+  gst_tensor_transform_typecast_array (filter, in_info->type, out_info->type,
+      inptr, outptr, num);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Convert the operands to the data type and precompute the reciprocal for integer division.
+ * @param[in] filter "this" pointer
+ * @param[in] type the data type (output type of arithmetic mode)
+ * @param[out] steps the operators to be applied (the number of operators at most)
+ * @return the number of operators to be applied
+ */
+static guint
+gst_tensor_transform_prepare_steps (GstTensorTransform * filter,
+    tensor_type type, tensor_transform_step_s * steps)
+{
+  tensor_transform_operator_s *op_s;
+  tensor_transform_step_s *step;
+  GSList *walk;
+  guint num = 0;
+
+  for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+    op_s = (tensor_transform_operator_s *) walk->data;
+
+    /* typecast is located at the first, the data is already converted. */
+    if (op_s->op == GTT_OP_TYPECAST)
+      continue;
+
+    step = &steps[num];
+    step->op = op_s->op;
+    step->value = op_s->value;
+    step->use_div = FALSE;
+    gst_tensor_data_typecast (&step->value, type);
+
+    if (step->op == GTT_OP_DIV) {
+      if (type == _NNS_FLOAT32 || type == _NNS_FLOAT64) {
+        if ((type == _NNS_FLOAT32 && step->value.data._float == 0) ||
+            (type == _NNS_FLOAT64 && step->value.data._double == 0)) {
+          GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0.");
+          continue;
+        }
+      } else if (transform_accel_divisor_init (&step->div, type,
+              &step->value.data)) {
+        step->use_div = TRUE;
+      } else {
+        GST_ERROR_OBJECT (filter, "Invalid state, denominator is 0.");
+        continue;
+      }
+    }
+
+    num++;
   }
-#endif
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
+  return num;
+}
 
-  for (i = 0; i < num; ++i) {
-    gst_tensor_data_raw_typecast (
-        (gpointer) (inptr + in_element_size * i), in_info->type,
-        (gpointer) (outptr + out_element_size * i), out_info->type);
+/**
+ * @brief Apply an operator to the array in place.
+ * @param[in] filter "this" pointer
+ * @param[in] step the operator with the operand in the data type
+ * @param[in/out] data the array
+ * @param[in] num the number of elements
+ */
+static void
+gst_tensor_transform_apply_step (GstTensorTransform * filter,
+    const tensor_transform_step_s * step, uint8_t * data, gsize num)
+{
+  const transform_accel_funcs *accel = filter->accel;
+  tensor_type type = step->value.type;
+  gboolean is_s64 = (type == _NNS_INT64 || type == _NNS_UINT64);
+
+  switch (step->op) {
+    case GTT_OP_ADD:
+      if (type == _NNS_FLOAT32 && accel->add_f32) {
+        accel->add_f32 ((float *) data, step->value.data._float, num);
+        return;
+      }
+      if (is_s64 && accel->add_s64) {
+        accel->add_s64 ((gint64 *) data, step->value.data._int64_t, num);
+        return;
+      }
+      break;
+    case GTT_OP_MUL:
+      if (type == _NNS_FLOAT32 && accel->mul_f32) {
+        accel->mul_f32 ((float *) data, step->value.data._float, num);
+        return;
+      }
+      if (is_s64 && accel->mul_s64) {
+        accel->mul_s64 ((gint64 *) data, step->value.data._int64_t, num);
+        return;
+      }
+      break;
+    case GTT_OP_DIV:
+      if (step->use_div) {
+        transform_accel_div (data, &step->div, num);
+        return;
+      }
+      break;
+    default:
+      GST_ERROR_OBJECT (filter, "Unknown operator %d", step->op);
+      return;
   }
 
-  return GST_FLOW_OK;
+#ifdef HAVE_ORC
+  if (orc_supported (filter, type, type)) {
+    orc_operator (data, num, &step->value, step->op);
+    return;
+  }
+#endif
+
+  switch (step->op) {
+    case GTT_OP_ADD:
+      typed_operator (data, num, &step->value, +);
+      break;
+    case GTT_OP_MUL:
+      typed_operator (data, num, &step->value, *);
+      break;
+    case GTT_OP_DIV:
+      typed_operator (data, num, &step->value, /);
+      break;
+    default:
+      g_assert (0);
+      break;
+  }
 }
 
 /**
@@ -1071,77 +1471,52 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  gulong i, num;
-  guint in_element_size, out_element_size;
-
-  GSList *walk;
-  tensor_transform_operator_s *op_s;
-  tensor_data_s value;
+  gfloat block[GTT_BLOCK_SIZE];
+  gulong num, offset, len;
+  gsize in_element_size, out_element_size;
+  tensor_transform_step_s *steps;
+  guint i, num_steps;
+  gboolean is_half;
 
   num = gst_tensor_get_element_count (in_info->dimension);
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
 
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    walk = filter->operators;
-
-    /**
-     * Typecast should be called at the first.
-     * Do the typecast. If in/out type is same, this will copy the input array to output.
-     */
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
-
-    while (walk) {
-      op_s = (tensor_transform_operator_s *) walk->data;
+  /* 16-bit floating point types are computed in float32 for each block */
+  is_half = gst_tensor_type_is_half (out_info->type);
 
-      if (op_s->op != GTT_OP_TYPECAST) {
-        gst_tensor_data_typecast (&op_s->value, out_info->type);
-        orc_operator (outptr, num, &op_s->value, op_s->op);
-      }
+  steps = g_newa (tensor_transform_step_s, g_slist_length (filter->operators));
+  num_steps = gst_tensor_transform_prepare_steps (filter,
+      is_half ? _NNS_FLOAT32 : out_info->type, steps);
 
-      walk = g_slist_next (walk);
-    }
+  /**
+   * Typecast should be called at the first, then the operators are applied to the output.
+   * Run the chain for each block, the data is read from and written to memory once.
+   */
+  for (offset = 0; offset < num; offset += len) {
+    const uint8_t *in = inptr + in_element_size * offset;
+    uint8_t *out = outptr + out_element_size * offset;
 
-    return GST_FLOW_OK;
-  }
-#endif
+    len = MIN (GTT_BLOCK_SIZE, num - offset);
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
+    if (is_half) {
+      gst_tensor_transform_typecast_array (filter, in_info->type,
+          _NNS_FLOAT32, in, (uint8_t *) block, len);
 
-  for (i = 0; i < num; ++i) {
-    /* init value with input tensor type */
-    gst_tensor_data_set (&value, in_info->type,
-        (gpointer) (inptr + in_element_size * i));
-
-    walk = filter->operators;
-    while (walk) {
-      op_s = (tensor_transform_operator_s *) walk->data;
-
-      /**
-       * @todo add more options
-       */
-      switch (op_s->op) {
-        case GTT_OP_TYPECAST:
-          gst_tensor_data_typecast (&value, op_s->value.type);
-          break;
-        case GTT_OP_ADD:
-        case GTT_OP_MUL:
-        case GTT_OP_DIV:
-          gst_tensor_data_typecast (&op_s->value, value.type);
-          gst_tensor_transform_do_operator (filter, &value, &op_s->value,
-              op_s->op);
-          break;
-        default:
-          g_assert (0);
-          return GST_FLOW_ERROR;
-      }
+      for (i = 0; i < num_steps; i++)
+        gst_tensor_transform_apply_step (filter, &steps[i], (uint8_t *) block,
+            len);
 
-      walk = g_slist_next (walk);
+      gst_tensor_transform_typecast_array (filter, _NNS_FLOAT32,
+          out_info->type, (const uint8_t *) block, out, len);
+      continue;
     }
 
-    /* set output value */
-    g_assert (out_info->type == value.type);
-    gst_tensor_data_get (&value, outptr + out_element_size * i);
+    gst_tensor_transform_typecast_array (filter, in_info->type,
+        out_info->type, in, out, len);
+
+    for (i = 0; i < num_steps; i++)
+      gst_tensor_transform_apply_step (filter, &steps[i], out, len);
   }
 
   return GST_FLOW_OK;
@@ -1253,6 +1628,7 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
   gsize in_element_size, out_element_size, data_size, ch_size;
   gulong i, num, data_idx, ch;
   gdouble tmp, *average, *std;
+  gboolean need_std;
 
   in_element_size = gst_tensor_get_element_size (in_info->type);
   out_element_size = gst_tensor_get_element_size (out_info->type);
@@ -1261,22 +1637,26 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
   data_size = gst_tensor_info_get_size (in_info);
   ch_size = in_info->dimension[0];
 
-  /* calc average and std */
-  average = std = NULL;
+  /* calc average and std (only for default mode) in a single pass */
+  if (!filter->data_stand.per_channel)
+    ch_size = 1;
+
+  if (filter->stats_len < ch_size) {
+    g_free (filter->stats);
+    filter->stats = g_new0 (gdouble, ch_size * 2);
+    filter->stats_len = ch_size;
+  }
+
+  average = filter->stats;
+  std = filter->stats + ch_size;
+  need_std = (filter->data_stand.mode == STAND_DEFAULT);
+
   if (filter->data_stand.per_channel) {
-    gst_tensor_data_raw_average_per_channel ((gpointer) inptr, data_size,
-        in_info->type, in_info->dimension, &average);
-    /* calculate std only for default mode */
-    if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std_per_channel ((gpointer) inptr, data_size,
-          in_info->type, in_info->dimension, average, &std);
+    gst_tensor_data_raw_mean_std_per_channel ((gpointer) inptr, data_size,
+        in_info->type, in_info->dimension, average, need_std ? std : NULL);
   } else {
-    gst_tensor_data_raw_average ((gpointer) inptr, data_size,
-        in_info->type, &average);
-    /* calculate std only for default mode */
-    if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std ((gpointer) inptr, data_size, in_info->type,
-          average, &std);
+    gst_tensor_data_raw_mean_std ((gpointer) inptr, data_size,
+        in_info->type, average, need_std ? std : NULL);
   }
 
   switch (filter->data_stand.mode) {
@@ -1347,9 +1727,6 @@ gst_tensor_transform_stand (GstTensorTransform * filter,
       ret = GST_FLOW_ERROR;
   }
 
-  g_free (average);
-  g_free (std);
-
   return ret;
 }
 
@@ -1377,6 +1754,13 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   out_element_size = gst_tensor_get_element_size (out_info->type);
   num = gst_tensor_get_element_count (in_info->dimension);
 
+  if (in_info->type == _NNS_FLOAT32 && out_info->type == _NNS_FLOAT32 &&
+      filter->accel->clamp_f32) {
+    filter->accel->clamp_f32 ((const float *) inptr, (float *) outptr,
+        (float) filter->data_clamp.min, (float) filter->data_clamp.max, num);
+    return GST_FLOW_OK;
+  }
+
   for (i = 0; i < num; ++i) {
     data_idx = in_element_size * i;
     gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
@@ -1392,6 +1776,187 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Macro to quantize the float32 array with the per-channel parameters (channel is the first dimension).
+ */
+#define quantize_loop(i,o,n,offset,ctype,qmin,qmax) do { \
+    const gdouble *_scale = filter->quant_scale; \
+    const gint32 *_zp = filter->quant_zero_point; \
+    const guint _ns = filter->data_quant.num_scales; \
+    const guint _nz = filter->data_quant.num_zero_points; \
+    ctype *_dst = (ctype *) (o); \
+    guint _cs = (offset) % _ns, _cz = (offset) % _nz; \
+    gsize _k; \
+    for (_k = 0; _k < (n); ++_k) { \
+      _dst[_k] = (ctype) (transform_accel_quantize_value ((i)[_k], (gfloat) _scale[_cs], \
+          (gfloat) ((qmin) - _zp[_cz]), (gfloat) ((qmax) - _zp[_cz])) + _zp[_cz]); \
+      if (++_cs == _ns) _cs = 0; \
+      if (++_cz == _nz) _cz = 0; \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to dequantize the integer array with the per-channel parameters (channel is the first dimension).
+ */
+#define dequantize_loop(i,o,n,itype,otype) do { \
+    const gdouble *_scale = filter->quant_scale; \
+    const gint32 *_zp = filter->quant_zero_point; \
+    const guint _ns = filter->data_quant.num_scales; \
+    const guint _nz = filter->data_quant.num_zero_points; \
+    const itype *_src = (const itype *) (i); \
+    otype *_dst = (otype *) (o); \
+    guint _cs = 0, _cz = 0; \
+    gsize _k; \
+    for (_k = 0; _k < (n); ++_k) { \
+      _dst[_k] = (otype) ((gint64) _src[_k] - _zp[_cz]) * (otype) _scale[_cs]; \
+      if (++_cs == _ns) _cs = 0; \
+      if (++_cz == _nz) _cz = 0; \
+    } \
+  } while (0)
+
+#define dequantize_loop_to(i,o,n,itype,otype) do { \
+    switch (otype) { \
+      case _NNS_FLOAT32: dequantize_loop (i, o, n, itype, float); break; \
+      case _NNS_FLOAT64: dequantize_loop (i, o, n, itype, double); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported output type %d", otype); g_assert (0); break; \
+    } \
+  } while (0)
+
+/**
+ * @brief subrouting for tensor-tranform, "quantize" case.
+ *        : q = saturate (round (x / scale) + zero_point)
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_quantize (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  gfloat block[GTT_BLOCK_SIZE];
+  transform_accel_quantize_func kernel = NULL;
+  gulong num, offset, len;
+  gsize in_element_size, out_element_size;
+  const gfloat *in;
+  uint8_t *out;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  if (filter->data_quant.num_scales == 1 &&
+      filter->data_quant.num_zero_points == 1) {
+    if (out_info->type == _NNS_UINT8)
+      kernel = filter->accel->quantize_f32_u8;
+    else if (out_info->type == _NNS_INT8)
+      kernel = filter->accel->quantize_f32_s8;
+  }
+
+  /* other types are converted to float32 for each block in the cache */
+  for (offset = 0; offset < num; offset += len) {
+    len = MIN (GTT_BLOCK_SIZE, num - offset);
+    out = outptr + out_element_size * offset;
+
+    if (in_info->type == _NNS_FLOAT32) {
+      in = (const gfloat *) (inptr + in_element_size * offset);
+    } else {
+      gst_tensor_transform_typecast_array (filter, in_info->type, _NNS_FLOAT32,
+          inptr + in_element_size * offset, (uint8_t *) block, len);
+      in = block;
+    }
+
+    if (kernel) {
+      kernel (in, out, (gfloat) filter->quant_scale[0],
+          filter->quant_zero_point[0], len);
+      continue;
+    }
+
+    switch (out_info->type) {
+      case _NNS_INT8:
+        quantize_loop (in, out, len, offset, int8_t, G_MININT8, G_MAXINT8);
+        break;
+      case _NNS_UINT8:
+        quantize_loop (in, out, len, offset, uint8_t, 0, G_MAXUINT8);
+        break;
+      case _NNS_INT16:
+        quantize_loop (in, out, len, offset, int16_t, G_MININT16, G_MAXINT16);
+        break;
+      case _NNS_UINT16:
+        quantize_loop (in, out, len, offset, uint16_t, 0, G_MAXUINT16);
+        break;
+      default:
+        GST_ERROR_OBJECT (filter, "Unsupported output type %d",
+            out_info->type);
+        return GST_FLOW_ERROR;
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "dequantize" case.
+ *        : x = (q - zero_point) * scale
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_dequantize (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  transform_accel_dequantize_func kernel = NULL;
+  gulong num;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  if (filter->data_quant.num_scales == 1 &&
+      filter->data_quant.num_zero_points == 1 &&
+      out_info->type == _NNS_FLOAT32) {
+    if (in_info->type == _NNS_UINT8)
+      kernel = filter->accel->dequantize_u8_f32;
+    else if (in_info->type == _NNS_INT8)
+      kernel = filter->accel->dequantize_s8_f32;
+  }
+
+  if (kernel) {
+    kernel (inptr, (gfloat *) outptr, (gfloat) filter->quant_scale[0],
+        filter->quant_zero_point[0], num);
+    return GST_FLOW_OK;
+  }
+
+  switch (in_info->type) {
+    case _NNS_INT8:
+      dequantize_loop_to (inptr, outptr, num, int8_t, out_info->type);
+      break;
+    case _NNS_UINT8:
+      dequantize_loop_to (inptr, outptr, num, uint8_t, out_info->type);
+      break;
+    case _NNS_INT16:
+      dequantize_loop_to (inptr, outptr, num, int16_t, out_info->type);
+      break;
+    case _NNS_UINT16:
+      dequantize_loop_to (inptr, outptr, num, uint16_t, out_info->type);
+      break;
+    case _NNS_INT32:
+      dequantize_loop_to (inptr, outptr, num, int32_t, out_info->type);
+      break;
+    default:
+      GST_ERROR_OBJECT (filter, "Unsupported input type %d", in_info->type);
+      return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  * @param[in/out] trans "super" pointer
@@ -1489,7 +2054,11 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       buf_size += hsize;
     }
 
-    out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    /* reserve the prefix for header if output is static */
+    if (out_flexible)
+      out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    else
+      out_mem[i] = gst_tensor_alloc_memory (buf_size);
     gst_buffer_append_memory (outbuf, out_mem[i]);
 
     if (!gst_memory_map (out_mem[i], &out_map[i], GST_MAP_WRITE)) {
@@ -1529,6 +2098,14 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
         res = gst_tensor_transform_clamp (filter, in_info, out_info,
             inptr, outptr);
         break;
+      case GTT_QUANTIZE:
+        res = gst_tensor_transform_quantize (filter, in_info, out_info,
+            inptr, outptr);
+        break;
+      case GTT_DEQUANTIZE:
+        res = gst_tensor_transform_dequantize (filter, in_info, out_info,
+            inptr, outptr);
+        break;
       default:
         ml_loge ("Not supported tensor transform mode");
         res = GST_FLOW_NOT_SUPPORTED;
@@ -1685,6 +2262,32 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
       /* same tensors info, do nothing. */
       break;
 
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+    {
+      guint num_ch = MAX (filter->data_quant.num_scales,
+          filter->data_quant.num_zero_points);
+      gint64 qmin, qmax;
+
+      /* per-channel parameters for each element of the first dimension */
+      if (num_ch > 1 && in_info->dimension[0] > 0 &&
+          in_info->dimension[0] != num_ch)
+        return FALSE;
+
+      if (direction == GST_PAD_SINK) {
+        /* dequantize an integer tensor only */
+        if (filter->mode == GTT_DEQUANTIZE &&
+            !gst_tensor_transform_get_quant_range (in_info->type, &qmin, &qmax))
+          return FALSE;
+
+        out_info->type = filter->data_quant.type;
+      } else {
+        /* cannot get the incoming data type on sink pad */
+        out_info->type = _NNS_END;
+      }
+      break;
+    }
+
     default:
       return FALSE;
   }
@@ -36,6 +36,7 @@
 #include <gst/base/gstbasetransform.h>
 #include <tensor_common.h>
 #include <tensor_data.h>
+#include "transform-accel.h"
 
 G_BEGIN_DECLS
 
@@ -62,6 +63,8 @@ typedef enum _tensor_transform_mode
   GTT_TRANSPOSE,      /* Transpose. "transpose" */
   GTT_STAND,          /* Standardization. "stand" */
   GTT_CLAMP,          /* Clamp, "clamp" */
+  GTT_QUANTIZE,       /* Affine quantization, "quantize" */
+  GTT_DEQUANTIZE,     /* Affine dequantization, "dequantize" */
 
   GTT_UNKNOWN = -1,   /* Unknown/Not-implemented-yet Mode. "unknown" */
 } tensor_transform_mode;
@@ -137,6 +140,16 @@ typedef struct _tensor_transform_clamp {
   double min, max;
 } tensor_transform_clamp;
 
+/**
+ * @brief Internal data structure for quantize and dequantize mode.
+ * The scales and zero-points are stored in quant_scale and quant_zero_point of GstTensorTransform.
+ */
+typedef struct _tensor_transform_quant {
+  tensor_type type; /**< quantized type (quantize) or float type (dequantize) of the output */
+  guint num_scales; /**< 1 for per-tensor, the number of channels (dimension[0]) for per-channel */
+  guint num_zero_points; /**< 1 for per-tensor, the number of channels (dimension[0]) for per-channel */
+} tensor_transform_quant;
+
 /**
  * @brief Internal data structure for tensor_transform instances.
  */
@@ -154,14 +167,20 @@ struct _GstTensorTransform
     tensor_transform_transpose data_transpose; /**< Parsed option value for "transpose" mode. */
     tensor_transform_stand data_stand; /**< Parsed option value for "stand" mode. */
     tensor_transform_clamp data_clamp; /**< Parsed option value for "clamp" mode. */
+    tensor_transform_quant data_quant; /**< Parsed option value for "quantize" and "dequantize" mode. */
   };
   gboolean loaded; /**< TRUE if mode & option are loaded */
   gboolean acceleration; /**< TRUE to set orc acceleration */
+  const transform_accel_funcs *accel; /**< CPU-specific kernels selected at runtime */
   GSList *operators; /**< operators list */
 
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
   GList *apply; /**< Select the tensors to apply transformation */
+  gdouble *stats; /**< Storage for the mean and std of each channel ("stand" mode) */
+  gsize stats_len; /**< The number of channels in stats */
+  gdouble *quant_scale; /**< Scales ("quantize" and "dequantize" mode) */
+  gint32 *quant_zero_point; /**< Zero-points ("quantize" and "dequantize" mode) */
 };
 
 /**
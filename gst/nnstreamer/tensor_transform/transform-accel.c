@@ -0,0 +1,1374 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file	transform-accel.c
+ * @date	18 Oct 2021
+ * @brief	CPU-specific kernels of tensor_transform selected at runtime
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs.
+ *
+ * The kernels are built for all supported instruction sets in one binary
+ * and registered in the dispatch registry of hw_accel. The best one for the
+ * CPU features (and the override in nnstreamer.ini) is selected once.
+ */
+
+#include <string.h>
+#include <hw_accel.h>
+#include <tensor_data.h>
+#include "transform-accel.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TRANSFORM_ACCEL_X86
+#include <immintrin.h>
+#define ACCEL_TARGET(t) __attribute__ ((target (t)))
+#endif
+
+#if defined(__aarch64__) || (defined(__arm__) && defined(__ARM_NEON))
+#define TRANSFORM_ACCEL_NEON
+#include <arm_neon.h>
+#endif
+
+#define KERNEL_TYPECAST_U8_F32 "transform_typecast_u8_f32"
+#define KERNEL_ADD_F32 "transform_add_f32"
+#define KERNEL_MUL_F32 "transform_mul_f32"
+#define KERNEL_CLAMP_F32 "transform_clamp_f32"
+#define KERNEL_ADD_S64 "transform_add_s64"
+#define KERNEL_MUL_S64 "transform_mul_s64"
+#define KERNEL_QUANTIZE_F32_U8 "transform_quantize_f32_u8"
+#define KERNEL_QUANTIZE_F32_S8 "transform_quantize_f32_s8"
+#define KERNEL_DEQUANTIZE_U8_F32 "transform_dequantize_u8_f32"
+#define KERNEL_DEQUANTIZE_S8_F32 "transform_dequantize_s8_f32"
+#define KERNEL_TYPECAST_F16_F32 "transform_typecast_f16_f32"
+#define KERNEL_TYPECAST_F32_F16 "transform_typecast_f32_f16"
+#define KERNEL_TYPECAST_BF16_F32 "transform_typecast_bf16_f32"
+#define KERNEL_TYPECAST_F32_BF16 "transform_typecast_f32_bf16"
+
+/**
+ * @brief The range of the 8-bit integer types minus the zero-point (see transform_accel_quantize_value).
+ */
+#define QUANT_U8_LO(zp) ((float) (0 - (zp)))
+#define QUANT_U8_HI(zp) ((float) (255 - (zp)))
+#define QUANT_S8_LO(zp) ((float) (-128 - (zp)))
+#define QUANT_S8_HI(zp) ((float) (127 - (zp)))
+
+/**
+ * @brief Kernels selected for the CPU features.
+ */
+static transform_accel_funcs accel_funcs;
+
+#if defined(TRANSFORM_ACCEL_X86)
+/**
+ * @brief uint8 to float32 (SSE4.2)
+ */
+ACCEL_TARGET ("sse4.2")
+static void
+_typecast_u8_f32_sse42 (const void *in, void *out, gsize num)
+{
+  const guint8 *src = (const guint8 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  gint32 v;
+
+  for (; i + 4 <= num; i += 4) {
+    memcpy (&v, src + i, sizeof (v));
+    _mm_storeu_ps (dst + i,
+        _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (_mm_cvtsi32_si128 (v))));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (float) src[i];
+}
+
+/**
+ * @brief uint8 to float32 (AVX2)
+ */
+ACCEL_TARGET ("avx2")
+static void
+_typecast_u8_f32_avx2 (const void *in, void *out, gsize num)
+{
+  const guint8 *src = (const guint8 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  __m128i v;
+
+  for (; i + 8 <= num; i += 8) {
+    v = _mm_loadl_epi64 ((const __m128i *) (src + i));
+    _mm256_storeu_ps (dst + i, _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (v)));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (float) src[i];
+}
+
+/**
+ * @brief uint8 to float32 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_typecast_u8_f32_avx512 (const void *in, void *out, gsize num)
+{
+  const guint8 *src = (const guint8 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  __m128i v;
+
+  for (; i + 16 <= num; i += 16) {
+    v = _mm_loadu_si128 ((const __m128i *) (src + i));
+    _mm512_storeu_ps (dst + i, _mm512_cvtepi32_ps (_mm512_cvtepu8_epi32 (v)));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (float) src[i];
+}
+
+/**
+ * @brief Define the kernels of an operator with a constant value.
+ */
+#define DEFINE_OPERATOR_X86(name,op) \
+ACCEL_TARGET ("sse4.2") \
+static void \
+_ ## name ## _f32_sse42 (float *data, float value, gsize num) \
+{ \
+  __m128 v = _mm_set1_ps (value); \
+  gsize i = 0; \
+  for (; i + 4 <= num; i += 4) \
+    _mm_storeu_ps (data + i, _mm_ ## name ## _ps (_mm_loadu_ps (data + i), v)); \
+  for (; i < num; i++) \
+    data[i] = data[i] op value; \
+} \
+ACCEL_TARGET ("avx2") \
+static void \
+_ ## name ## _f32_avx2 (float *data, float value, gsize num) \
+{ \
+  __m256 v = _mm256_set1_ps (value); \
+  gsize i = 0; \
+  for (; i + 8 <= num; i += 8) \
+    _mm256_storeu_ps (data + i, \
+        _mm256_ ## name ## _ps (_mm256_loadu_ps (data + i), v)); \
+  for (; i < num; i++) \
+    data[i] = data[i] op value; \
+} \
+ACCEL_TARGET ("avx512f") \
+static void \
+_ ## name ## _f32_avx512 (float *data, float value, gsize num) \
+{ \
+  __m512 v = _mm512_set1_ps (value); \
+  gsize i = 0; \
+  for (; i + 16 <= num; i += 16) \
+    _mm512_storeu_ps (data + i, \
+        _mm512_ ## name ## _ps (_mm512_loadu_ps (data + i), v)); \
+  for (; i < num; i++) \
+    data[i] = data[i] op value; \
+}
+
+DEFINE_OPERATOR_X86 (add, +)
+DEFINE_OPERATOR_X86 (mul, *)
+
+/**
+ * @brief clamp float32 (SSE4.2)
+ * @note max(min, x) and min(max, x) keep NaN as CLAMP() does.
+ */
+ACCEL_TARGET ("sse4.2")
+static void
+_clamp_f32_sse42 (const float *in, float *out, float min, float max,
+    gsize num)
+{
+  __m128 vmin = _mm_set1_ps (min);
+  __m128 vmax = _mm_set1_ps (max);
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4) {
+    _mm_storeu_ps (out + i,
+        _mm_min_ps (vmax, _mm_max_ps (vmin, _mm_loadu_ps (in + i))));
+  }
+
+  for (; i < num; i++)
+    out[i] = CLAMP (in[i], min, max);
+}
+
+/**
+ * @brief clamp float32 (AVX2)
+ */
+ACCEL_TARGET ("avx2")
+static void
+_clamp_f32_avx2 (const float *in, float *out, float min, float max,
+    gsize num)
+{
+  __m256 vmin = _mm256_set1_ps (min);
+  __m256 vmax = _mm256_set1_ps (max);
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    _mm256_storeu_ps (out + i,
+        _mm256_min_ps (vmax, _mm256_max_ps (vmin, _mm256_loadu_ps (in + i))));
+  }
+
+  for (; i < num; i++)
+    out[i] = CLAMP (in[i], min, max);
+}
+
+/**
+ * @brief clamp float32 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_clamp_f32_avx512 (const float *in, float *out, float min, float max,
+    gsize num)
+{
+  __m512 vmin = _mm512_set1_ps (min);
+  __m512 vmax = _mm512_set1_ps (max);
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    _mm512_storeu_ps (out + i,
+        _mm512_min_ps (vmax, _mm512_max_ps (vmin, _mm512_loadu_ps (in + i))));
+  }
+
+  for (; i < num; i++)
+    out[i] = CLAMP (in[i], min, max);
+}
+
+/**
+ * @brief add a constant to int64 (SSE4.2)
+ */
+ACCEL_TARGET ("sse4.2")
+static void
+_add_s64_sse42 (gint64 * data, gint64 value, gsize num)
+{
+  __m128i v = _mm_set1_epi64x (value);
+  gsize i = 0;
+
+  for (; i + 2 <= num; i += 2) {
+    _mm_storeu_si128 ((__m128i *) (data + i),
+        _mm_add_epi64 (_mm_loadu_si128 ((const __m128i *) (data + i)), v));
+  }
+
+  for (; i < num; i++)
+    data[i] = (gint64) ((guint64) data[i] + (guint64) value);
+}
+
+/**
+ * @brief add a constant to int64 (AVX2)
+ */
+ACCEL_TARGET ("avx2")
+static void
+_add_s64_avx2 (gint64 * data, gint64 value, gsize num)
+{
+  __m256i v = _mm256_set1_epi64x (value);
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4) {
+    _mm256_storeu_si256 ((__m256i *) (data + i),
+        _mm256_add_epi64 (_mm256_loadu_si256 ((const __m256i *) (data + i)),
+            v));
+  }
+
+  for (; i < num; i++)
+    data[i] = (gint64) ((guint64) data[i] + (guint64) value);
+}
+
+/**
+ * @brief add a constant to int64 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_add_s64_avx512 (gint64 * data, gint64 value, gsize num)
+{
+  __m512i v = _mm512_set1_epi64 (value);
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    _mm512_storeu_si512 ((void *) (data + i),
+        _mm512_add_epi64 (_mm512_loadu_si512 ((const void *) (data + i)), v));
+  }
+
+  for (; i < num; i++)
+    data[i] = (gint64) ((guint64) data[i] + (guint64) value);
+}
+
+/**
+ * @brief multiply a constant to int64 (AVX-512)
+ * @note There is no 64-bit multiply below AVX-512, the compiler emits the 32-bit partial products.
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_mul_s64_avx512 (gint64 * data, gint64 value, gsize num)
+{
+  __m512i v = _mm512_set1_epi64 (value);
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    _mm512_storeu_si512 ((void *) (data + i),
+        _mm512_mullox_epi64 (_mm512_loadu_si512 ((const void *) (data + i)),
+            v));
+  }
+
+  for (; i < num; i++)
+    data[i] = (gint64) ((guint64) data[i] * (guint64) value);
+}
+
+/**
+ * @brief Define the quantize kernels of an 8-bit integer type.
+ * @note cvtps rounds to the nearest even as rintf() does, and the values are saturated before the conversion.
+ */
+#define DEFINE_QUANTIZE_X86(name,ctype,LO,HI,pack16) \
+ACCEL_TARGET ("sse4.2") \
+static void \
+_quantize_f32_ ## name ## _sse42 (const float *in, void *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  ctype *dst = (ctype *) out; \
+  const float lo = LO (zero_point), hi = HI (zero_point); \
+  __m128 vscale = _mm_set1_ps (scale); \
+  __m128 vlo = _mm_set1_ps (lo), vhi = _mm_set1_ps (hi); \
+  __m128i vzp = _mm_set1_epi32 (zero_point); \
+  __m128i v[4]; \
+  gsize i = 0, j; \
+  for (; i + 16 <= num; i += 16) { \
+    for (j = 0; j < 4; j++) { \
+      __m128 f = _mm_div_ps (_mm_loadu_ps (in + i + j * 4), vscale); \
+      f = _mm_min_ps (_mm_max_ps (f, vlo), vhi); \
+      v[j] = _mm_add_epi32 (_mm_cvtps_epi32 (f), vzp); \
+    } \
+    _mm_storeu_si128 ((__m128i *) (dst + i), pack16 ( \
+        _mm_packs_epi32 (v[0], v[1]), _mm_packs_epi32 (v[2], v[3]))); \
+  } \
+  for (; i < num; i++) \
+    dst[i] = (ctype) (transform_accel_quantize_value (in[i], scale, \
+        lo, hi) + zero_point); \
+} \
+ACCEL_TARGET ("avx2") \
+static void \
+_quantize_f32_ ## name ## _avx2 (const float *in, void *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  ctype *dst = (ctype *) out; \
+  const float lo = LO (zero_point), hi = HI (zero_point); \
+  __m256 vscale = _mm256_set1_ps (scale); \
+  __m256 vlo = _mm256_set1_ps (lo), vhi = _mm256_set1_ps (hi); \
+  __m256i vzp = _mm256_set1_epi32 (zero_point); \
+  __m256i v; \
+  __m128i p; \
+  gsize i = 0; \
+  for (; i + 8 <= num; i += 8) { \
+    __m256 f = _mm256_div_ps (_mm256_loadu_ps (in + i), vscale); \
+    f = _mm256_min_ps (_mm256_max_ps (f, vlo), vhi); \
+    v = _mm256_add_epi32 (_mm256_cvtps_epi32 (f), vzp); \
+    p = _mm_packs_epi32 (_mm256_castsi256_si128 (v), \
+        _mm256_extracti128_si256 (v, 1)); \
+    _mm_storel_epi64 ((__m128i *) (dst + i), pack16 (p, p)); \
+  } \
+  for (; i < num; i++) \
+    dst[i] = (ctype) (transform_accel_quantize_value (in[i], scale, \
+        lo, hi) + zero_point); \
+} \
+ACCEL_TARGET ("avx512f") \
+static void \
+_quantize_f32_ ## name ## _avx512 (const float *in, void *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  ctype *dst = (ctype *) out; \
+  const float lo = LO (zero_point), hi = HI (zero_point); \
+  __m512 vscale = _mm512_set1_ps (scale); \
+  __m512 vlo = _mm512_set1_ps (lo), vhi = _mm512_set1_ps (hi); \
+  __m512i vzp = _mm512_set1_epi32 (zero_point); \
+  __m512i v; \
+  gsize i = 0; \
+  for (; i + 16 <= num; i += 16) { \
+    __m512 f = _mm512_div_ps (_mm512_loadu_ps (in + i), vscale); \
+    f = _mm512_min_ps (_mm512_max_ps (f, vlo), vhi); \
+    v = _mm512_add_epi32 (_mm512_cvtps_epi32 (f), vzp); \
+    /* already saturated, truncation is enough */ \
+    _mm_storeu_si128 ((__m128i *) (dst + i), _mm512_cvtepi32_epi8 (v)); \
+  } \
+  for (; i < num; i++) \
+    dst[i] = (ctype) (transform_accel_quantize_value (in[i], scale, \
+        lo, hi) + zero_point); \
+}
+
+DEFINE_QUANTIZE_X86 (u8, guint8, QUANT_U8_LO, QUANT_U8_HI, _mm_packus_epi16)
+DEFINE_QUANTIZE_X86 (s8, gint8, QUANT_S8_LO, QUANT_S8_HI, _mm_packs_epi16)
+
+/**
+ * @brief Define the dequantize kernels of an 8-bit integer type.
+ */
+#define DEFINE_DEQUANTIZE_X86(name,ctype,cvt) \
+ACCEL_TARGET ("sse4.2") \
+static void \
+_dequantize_ ## name ## _f32_sse42 (const void *in, float *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  const ctype *src = (const ctype *) in; \
+  __m128 vscale = _mm_set1_ps (scale); \
+  __m128i vzp = _mm_set1_epi32 (zero_point); \
+  __m128i v; \
+  gint32 b; \
+  gsize i = 0; \
+  for (; i + 4 <= num; i += 4) { \
+    memcpy (&b, src + i, sizeof (b)); \
+    v = _mm_sub_epi32 (_mm_ ## cvt ## _epi32 (_mm_cvtsi32_si128 (b)), vzp); \
+    _mm_storeu_ps (out + i, _mm_mul_ps (_mm_cvtepi32_ps (v), vscale)); \
+  } \
+  for (; i < num; i++) \
+    out[i] = (float) ((gint32) src[i] - zero_point) * scale; \
+} \
+ACCEL_TARGET ("avx2") \
+static void \
+_dequantize_ ## name ## _f32_avx2 (const void *in, float *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  const ctype *src = (const ctype *) in; \
+  __m256 vscale = _mm256_set1_ps (scale); \
+  __m256i vzp = _mm256_set1_epi32 (zero_point); \
+  __m256i v; \
+  gsize i = 0; \
+  for (; i + 8 <= num; i += 8) { \
+    v = _mm256_ ## cvt ## _epi32 (_mm_loadl_epi64 ((const __m128i *) (src + i))); \
+    v = _mm256_sub_epi32 (v, vzp); \
+    _mm256_storeu_ps (out + i, \
+        _mm256_mul_ps (_mm256_cvtepi32_ps (v), vscale)); \
+  } \
+  for (; i < num; i++) \
+    out[i] = (float) ((gint32) src[i] - zero_point) * scale; \
+} \
+ACCEL_TARGET ("avx512f") \
+static void \
+_dequantize_ ## name ## _f32_avx512 (const void *in, float *out, \
+    float scale, gint32 zero_point, gsize num) \
+{ \
+  const ctype *src = (const ctype *) in; \
+  __m512 vscale = _mm512_set1_ps (scale); \
+  __m512i vzp = _mm512_set1_epi32 (zero_point); \
+  __m512i v; \
+  gsize i = 0; \
+  for (; i + 16 <= num; i += 16) { \
+    v = _mm512_ ## cvt ## _epi32 (_mm_loadu_si128 ((const __m128i *) (src + i))); \
+    v = _mm512_sub_epi32 (v, vzp); \
+    _mm512_storeu_ps (out + i, \
+        _mm512_mul_ps (_mm512_cvtepi32_ps (v), vscale)); \
+  } \
+  for (; i < num; i++) \
+    out[i] = (float) ((gint32) src[i] - zero_point) * scale; \
+}
+
+DEFINE_DEQUANTIZE_X86 (u8, guint8, cvtepu8)
+DEFINE_DEQUANTIZE_X86 (s8, gint8, cvtepi8)
+
+/**
+ * @brief float16 to float32 (F16C)
+ */
+ACCEL_TARGET ("avx,f16c")
+static void
+_typecast_f16_f32_f16c (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    _mm256_storeu_ps (dst + i,
+        _mm256_cvtph_ps (_mm_loadu_si128 ((const __m128i *) (src + i))));
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to float16 (F16C)
+ */
+ACCEL_TARGET ("avx,f16c")
+static void
+_typecast_f32_f16_f16c (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm256_cvtps_ph (_mm256_loadu_ps (src + i), _MM_FROUND_TO_NEAREST_INT));
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_float16 (src[i]);
+}
+
+/**
+ * @brief float16 to float32 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_typecast_f16_f32_avx512 (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16)
+    _mm512_storeu_ps (dst + i,
+        _mm512_cvtph_ps (_mm256_loadu_si256 ((const __m256i *) (src + i))));
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to float16 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_typecast_f32_f16_avx512 (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16)
+    _mm256_storeu_si256 ((__m256i *) (dst + i),
+        _mm512_cvtps_ph (_mm512_loadu_ps (src + i),
+            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_float16 (src[i]);
+}
+
+/**
+ * @brief bfloat16 to float32 (SSE4.2), the upper half of float32.
+ */
+ACCEL_TARGET ("sse4.2")
+static void
+_typecast_bf16_f32_sse42 (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  __m128i v;
+
+  for (; i + 4 <= num; i += 4) {
+    v = _mm_cvtepu16_epi32 (_mm_loadl_epi64 ((const __m128i *) (src + i)));
+    _mm_storeu_si128 ((__m128i *) (dst + i), _mm_slli_epi32 (v, 16));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_bfloat16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to bfloat16 (SSE4.2), rounding to nearest even and keeping NaN quiet.
+ */
+ACCEL_TARGET ("sse4.2")
+static void
+_typecast_f32_bf16_sse42 (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  const __m128i bias = _mm_set1_epi32 (0x7fff);
+  const __m128i one = _mm_set1_epi32 (1);
+  const __m128i abs_mask = _mm_set1_epi32 (0x7fffffff);
+  const __m128i inf = _mm_set1_epi32 (0x7f800000);
+  const __m128i quiet = _mm_set1_epi32 (0x00400000);
+  __m128i v, r, nan;
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4) {
+    v = _mm_loadu_si128 ((const __m128i *) (src + i));
+    r = _mm_add_epi32 (_mm_add_epi32 (v, bias),
+        _mm_and_si128 (_mm_srli_epi32 (v, 16), one));
+    nan = _mm_cmpgt_epi32 (_mm_and_si128 (v, abs_mask), inf);
+    r = _mm_blendv_epi8 (r, _mm_or_si128 (v, quiet), nan);
+    r = _mm_srli_epi32 (r, 16);
+    _mm_storel_epi64 ((__m128i *) (dst + i), _mm_packus_epi32 (r, r));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_bfloat16 (src[i]);
+}
+
+/**
+ * @brief bfloat16 to float32 (AVX2)
+ */
+ACCEL_TARGET ("avx2")
+static void
+_typecast_bf16_f32_avx2 (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  __m256i v;
+
+  for (; i + 8 <= num; i += 8) {
+    v = _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) (src + i)));
+    _mm256_storeu_si256 ((__m256i *) (dst + i), _mm256_slli_epi32 (v, 16));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_bfloat16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to bfloat16 (AVX2)
+ */
+ACCEL_TARGET ("avx2")
+static void
+_typecast_f32_bf16_avx2 (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  const __m256i bias = _mm256_set1_epi32 (0x7fff);
+  const __m256i one = _mm256_set1_epi32 (1);
+  const __m256i abs_mask = _mm256_set1_epi32 (0x7fffffff);
+  const __m256i inf = _mm256_set1_epi32 (0x7f800000);
+  const __m256i quiet = _mm256_set1_epi32 (0x00400000);
+  __m256i v, r, nan;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v = _mm256_loadu_si256 ((const __m256i *) (src + i));
+    r = _mm256_add_epi32 (_mm256_add_epi32 (v, bias),
+        _mm256_and_si256 (_mm256_srli_epi32 (v, 16), one));
+    nan = _mm256_cmpgt_epi32 (_mm256_and_si256 (v, abs_mask), inf);
+    r = _mm256_blendv_epi8 (r, _mm256_or_si256 (v, quiet), nan);
+    r = _mm256_srli_epi32 (r, 16);
+    /* packus works in 128-bit lanes, gather the low 64 bits of each lane */
+    r = _mm256_permute4x64_epi64 (_mm256_packus_epi32 (r, r), 0x08);
+    _mm_storeu_si128 ((__m128i *) (dst + i), _mm256_castsi256_si128 (r));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_bfloat16 (src[i]);
+}
+
+/**
+ * @brief bfloat16 to float32 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_typecast_bf16_f32_avx512 (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  __m512i v;
+
+  for (; i + 16 <= num; i += 16) {
+    v = _mm512_cvtepu16_epi32 (_mm256_loadu_si256 ((const __m256i *) (src
+                + i)));
+    _mm512_storeu_si512 ((void *) (dst + i), _mm512_slli_epi32 (v, 16));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_bfloat16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to bfloat16 (AVX-512)
+ */
+ACCEL_TARGET ("avx512f")
+static void
+_typecast_f32_bf16_avx512 (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  const __m512i bias = _mm512_set1_epi32 (0x7fff);
+  const __m512i one = _mm512_set1_epi32 (1);
+  const __m512i abs_mask = _mm512_set1_epi32 (0x7fffffff);
+  const __m512i inf = _mm512_set1_epi32 (0x7f800000);
+  const __m512i quiet = _mm512_set1_epi32 (0x00400000);
+  __m512i v, r;
+  __mmask16 nan;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    v = _mm512_loadu_si512 ((const void *) (src + i));
+    r = _mm512_add_epi32 (_mm512_add_epi32 (v, bias),
+        _mm512_and_si512 (_mm512_srli_epi32 (v, 16), one));
+    nan = _mm512_cmpgt_epi32_mask (_mm512_and_si512 (v, abs_mask), inf);
+    r = _mm512_mask_or_epi32 (r, nan, v, quiet);
+    _mm256_storeu_si256 ((__m256i *) (dst + i),
+        _mm512_cvtepi32_epi16 (_mm512_srli_epi32 (r, 16)));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_bfloat16 (src[i]);
+}
+#endif /* TRANSFORM_ACCEL_X86 */
+
+#if defined(TRANSFORM_ACCEL_NEON)
+/**
+ * @brief uint8 to float32 (NEON)
+ */
+static void
+_typecast_u8_f32_neon (const void *in, void *out, gsize num)
+{
+  const guint8 *src = (const guint8 *) in;
+  float *dst = (float *) out;
+  gsize i = 0;
+  uint16x8_t v16;
+
+  for (; i + 8 <= num; i += 8) {
+    v16 = vmovl_u8 (vld1_u8 (src + i));
+    vst1q_f32 (dst + i, vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (v16))));
+    vst1q_f32 (dst + i + 4, vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (v16))));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (float) src[i];
+}
+
+/**
+ * @brief add a constant to float32 (NEON)
+ */
+static void
+_add_f32_neon (float *data, float value, gsize num)
+{
+  float32x4_t v = vdupq_n_f32 (value);
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4)
+    vst1q_f32 (data + i, vaddq_f32 (vld1q_f32 (data + i), v));
+
+  for (; i < num; i++)
+    data[i] = data[i] + value;
+}
+
+/**
+ * @brief multiply a constant to float32 (NEON)
+ */
+static void
+_mul_f32_neon (float *data, float value, gsize num)
+{
+  float32x4_t v = vdupq_n_f32 (value);
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4)
+    vst1q_f32 (data + i, vmulq_f32 (vld1q_f32 (data + i), v));
+
+  for (; i < num; i++)
+    data[i] = data[i] * value;
+}
+
+/**
+ * @brief clamp float32 (NEON)
+ */
+static void
+_clamp_f32_neon (const float *in, float *out, float min, float max,
+    gsize num)
+{
+  float32x4_t vmin = vdupq_n_f32 (min);
+  float32x4_t vmax = vdupq_n_f32 (max);
+  gsize i = 0;
+
+  for (; i + 4 <= num; i += 4)
+    vst1q_f32 (out + i, vminq_f32 (vmaxq_f32 (vld1q_f32 (in + i), vmin), vmax));
+
+  for (; i < num; i++)
+    out[i] = CLAMP (in[i], min, max);
+}
+
+/**
+ * @brief add a constant to int64 (NEON)
+ */
+static void
+_add_s64_neon (gint64 * data, gint64 value, gsize num)
+{
+  int64x2_t v = vdupq_n_s64 (value);
+  gsize i = 0;
+
+  for (; i + 2 <= num; i += 2)
+    vst1q_s64 ((int64_t *) (data + i),
+        vaddq_s64 (vld1q_s64 ((const int64_t *) (data + i)), v));
+
+  for (; i < num; i++)
+    data[i] = (gint64) ((guint64) data[i] + (guint64) value);
+}
+
+#if defined(__aarch64__)
+/**
+ * @brief quantize float32 to uint8 (NEON, AArch64 for vcvtnq and vmaxnmq)
+ * @note vmaxnmq returns the number for NaN as the SSE kernels do.
+ */
+static void
+_quantize_f32_u8_neon (const float *in, void *out, float scale,
+    gint32 zero_point, gsize num)
+{
+  guint8 *dst = (guint8 *) out;
+  const float lo = QUANT_U8_LO (zero_point), hi = QUANT_U8_HI (zero_point);
+  float32x4_t vscale = vdupq_n_f32 (scale);
+  float32x4_t vlo = vdupq_n_f32 (lo), vhi = vdupq_n_f32 (hi);
+  int32x4_t vzp = vdupq_n_s32 (zero_point);
+  int32x4_t v0, v1;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v0 = vcvtnq_s32_f32 (vminq_f32 (vmaxnmq_f32 (vdivq_f32 (vld1q_f32 (in
+                        + i), vscale), vlo), vhi));
+    v1 = vcvtnq_s32_f32 (vminq_f32 (vmaxnmq_f32 (vdivq_f32 (vld1q_f32 (in
+                        + i + 4), vscale), vlo), vhi));
+    vst1_u8 (dst + i, vqmovun_s16 (vcombine_s16 (vqmovn_s32 (vaddq_s32 (v0,
+                    vzp)), vqmovn_s32 (vaddq_s32 (v1, vzp)))));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (guint8) (transform_accel_quantize_value (in[i], scale,
+            lo, hi) + zero_point);
+}
+
+/**
+ * @brief quantize float32 to int8 (NEON, AArch64 for vcvtnq and vmaxnmq)
+ */
+static void
+_quantize_f32_s8_neon (const float *in, void *out, float scale,
+    gint32 zero_point, gsize num)
+{
+  gint8 *dst = (gint8 *) out;
+  const float lo = QUANT_S8_LO (zero_point), hi = QUANT_S8_HI (zero_point);
+  float32x4_t vscale = vdupq_n_f32 (scale);
+  float32x4_t vlo = vdupq_n_f32 (lo), vhi = vdupq_n_f32 (hi);
+  int32x4_t vzp = vdupq_n_s32 (zero_point);
+  int32x4_t v0, v1;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v0 = vcvtnq_s32_f32 (vminq_f32 (vmaxnmq_f32 (vdivq_f32 (vld1q_f32 (in
+                        + i), vscale), vlo), vhi));
+    v1 = vcvtnq_s32_f32 (vminq_f32 (vmaxnmq_f32 (vdivq_f32 (vld1q_f32 (in
+                        + i + 4), vscale), vlo), vhi));
+    vst1_s8 (dst + i, vqmovn_s16 (vcombine_s16 (vqmovn_s32 (vaddq_s32 (v0,
+                    vzp)), vqmovn_s32 (vaddq_s32 (v1, vzp)))));
+  }
+
+  for (; i < num; i++)
+    dst[i] = (gint8) (transform_accel_quantize_value (in[i], scale,
+            lo, hi) + zero_point);
+}
+#endif /* __aarch64__ */
+
+/**
+ * @brief dequantize uint8 to float32 (NEON)
+ */
+static void
+_dequantize_u8_f32_neon (const void *in, float *out, float scale,
+    gint32 zero_point, gsize num)
+{
+  const guint8 *src = (const guint8 *) in;
+  int32x4_t vzp = vdupq_n_s32 (zero_point);
+  int16x8_t v16;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v16 = vreinterpretq_s16_u16 (vmovl_u8 (vld1_u8 (src + i)));
+    vst1q_f32 (out + i, vmulq_n_f32 (vcvtq_f32_s32 (vsubq_s32 (vmovl_s16
+                    (vget_low_s16 (v16)), vzp)), scale));
+    vst1q_f32 (out + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vsubq_s32 (vmovl_s16
+                    (vget_high_s16 (v16)), vzp)), scale));
+  }
+
+  for (; i < num; i++)
+    out[i] = (float) ((gint32) src[i] - zero_point) * scale;
+}
+
+/**
+ * @brief dequantize int8 to float32 (NEON)
+ */
+static void
+_dequantize_s8_f32_neon (const void *in, float *out, float scale,
+    gint32 zero_point, gsize num)
+{
+  const gint8 *src = (const gint8 *) in;
+  int32x4_t vzp = vdupq_n_s32 (zero_point);
+  int16x8_t v16;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v16 = vmovl_s8 (vld1_s8 (src + i));
+    vst1q_f32 (out + i, vmulq_n_f32 (vcvtq_f32_s32 (vsubq_s32 (vmovl_s16
+                    (vget_low_s16 (v16)), vzp)), scale));
+    vst1q_f32 (out + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vsubq_s32 (vmovl_s16
+                    (vget_high_s16 (v16)), vzp)), scale));
+  }
+
+  for (; i < num; i++)
+    out[i] = (float) ((gint32) src[i] - zero_point) * scale;
+}
+
+#if defined(__aarch64__)
+/**
+ * @brief float16 to float32 (NEON, AArch64 for the half-precision conversion)
+ */
+static void
+_typecast_f16_f32_neon (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  float16x8_t v;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v = vreinterpretq_f16_u16 (vld1q_u16 (src + i));
+    vst1q_f32 (dst + i, vcvt_f32_f16 (vget_low_f16 (v)));
+    vst1q_f32 (dst + i + 4, vcvt_high_f32_f16 (v));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float16_to_float (src[i]);
+}
+
+/**
+ * @brief float32 to float16 (NEON, AArch64 for the half-precision conversion)
+ */
+static void
+_typecast_f32_f16_neon (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  float16x8_t v;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v = vcvt_high_f16_f32 (vcvt_f16_f32 (vld1q_f32 (src + i)),
+        vld1q_f32 (src + i + 4));
+    vst1q_u16 (dst + i, vreinterpretq_u16_f16 (v));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_float16 (src[i]);
+}
+#endif /* __aarch64__ */
+
+/**
+ * @brief bfloat16 to float32 (NEON)
+ */
+static void
+_typecast_bf16_f32_neon (const void *in, void *out, gsize num)
+{
+  const guint16 *src = (const guint16 *) in;
+  float *dst = (float *) out;
+  uint16x8_t v;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    v = vld1q_u16 (src + i);
+    vst1q_f32 (dst + i,
+        vreinterpretq_f32_u32 (vshll_n_u16 (vget_low_u16 (v), 16)));
+    vst1q_f32 (dst + i + 4,
+        vreinterpretq_f32_u32 (vshll_n_u16 (vget_high_u16 (v), 16)));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_bfloat16_to_float (src[i]);
+}
+
+/**
+ * @brief Round float32 bits to bfloat16 in the upper half (NEON).
+ */
+static inline uint16x4_t
+_round_f32_bf16_neon (uint32x4_t v)
+{
+  uint32x4_t r, nan;
+
+  r = vaddq_u32 (vaddq_u32 (v, vdupq_n_u32 (0x7fff)),
+      vandq_u32 (vshrq_n_u32 (v, 16), vdupq_n_u32 (1)));
+  nan = vcgtq_u32 (vandq_u32 (v, vdupq_n_u32 (0x7fffffff)),
+      vdupq_n_u32 (0x7f800000));
+  r = vbslq_u32 (nan, vorrq_u32 (v, vdupq_n_u32 (0x00400000)), r);
+  return vshrn_n_u32 (r, 16);
+}
+
+/**
+ * @brief float32 to bfloat16 (NEON)
+ */
+static void
+_typecast_f32_bf16_neon (const void *in, void *out, gsize num)
+{
+  const float *src = (const float *) in;
+  guint16 *dst = (guint16 *) out;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8) {
+    vst1q_u16 (dst + i,
+        vcombine_u16 (_round_f32_bf16_neon (vld1q_u32 ((const guint32 *) (src
+                        + i))), _round_f32_bf16_neon (vld1q_u32 ((const guint32
+                        *) (src + i + 4)))));
+  }
+
+  for (; i < num; i++)
+    dst[i] = gst_tensor_data_float_to_bfloat16 (src[i]);
+}
+#endif /* TRANSFORM_ACCEL_NEON */
+
+/**
+ * @brief Get the upper half of the 32-bit multiplication.
+ */
+static inline guint32
+_mulhi_u32 (guint32 a, guint32 b)
+{
+  return (guint32) (((guint64) a * b) >> 32);
+}
+
+#if defined(__SIZEOF_INT128__)
+/**
+ * @brief Get the upper half of the 64-bit multiplication.
+ */
+static inline guint64
+_mulhi_u64 (guint64 a, guint64 b)
+{
+  return (guint64) (((unsigned __int128) a * b) >> 64);
+}
+#endif
+
+/**
+ * @brief Precompute the reciprocal of an integer divisor.
+ */
+gboolean
+transform_accel_divisor_init (transform_accel_divisor * div, tensor_type type,
+    const void *value)
+{
+  gint64 sval = 0;
+  guint64 uval = 0;
+  gboolean is_signed = TRUE;
+  guint l;
+
+  g_return_val_if_fail (div != NULL, FALSE);
+  g_return_val_if_fail (value != NULL, FALSE);
+
+  switch (type) {
+    case _NNS_INT8:
+      sval = *((const gint8 *) value);
+      break;
+    case _NNS_INT16:
+      sval = *((const gint16 *) value);
+      break;
+    case _NNS_INT32:
+      sval = *((const gint32 *) value);
+      break;
+    case _NNS_INT64:
+      sval = *((const gint64 *) value);
+      break;
+    case _NNS_UINT8:
+      uval = *((const guint8 *) value);
+      is_signed = FALSE;
+      break;
+    case _NNS_UINT16:
+      uval = *((const guint16 *) value);
+      is_signed = FALSE;
+      break;
+    case _NNS_UINT32:
+      uval = *((const guint32 *) value);
+      is_signed = FALSE;
+      break;
+    case _NNS_UINT64:
+      uval = *((const guint64 *) value);
+      is_signed = FALSE;
+      break;
+    default:
+      return FALSE;
+  }
+
+  memset (div, 0, sizeof (transform_accel_divisor));
+  div->type = type;
+
+  if (is_signed) {
+    div->value = (guint64) sval;
+    div->negative = (sval < 0);
+    div->abs = div->negative ? -(guint64) sval : (guint64) sval;
+  } else {
+    div->value = uval;
+    div->abs = uval;
+  }
+
+  if (div->abs == 0)
+    return FALSE;
+
+  if (div->abs == 1) {
+    /* nothing to precompute, rarely used */
+    div->use_div = TRUE;
+#if !defined(__SIZEOF_INT128__)
+  } else if (type == _NNS_INT64 || type == _NNS_UINT64) {
+    /* no 128-bit multiply-high */
+    div->use_div = TRUE;
+#endif
+  } else if ((div->abs & (div->abs - 1)) == 0) {
+    /* power of 2, q = ((n >> 1) >> shift) with magic 0 */
+    div->magic = 0;
+    div->shift = g_bit_storage (div->abs) - 2;
+  } else {
+    /* l = ceil(log2(d)), m = floor(2^N * (2^l - d) / d) + 1 */
+    l = g_bit_storage (div->abs);
+    div->shift = l - 1;
+
+    if (type == _NNS_INT64 || type == _NNS_UINT64) {
+#if defined(__SIZEOF_INT128__)
+      div->magic = (guint64) (((((unsigned __int128) 1 << l) - div->abs) << 64)
+          / div->abs) + 1;
+#endif
+    } else {
+      div->magic = ((((guint64) 1 << l) - div->abs) << 32) / div->abs + 1;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Divide the unsigned array with the reciprocal.
+ */
+#define DIV_UNSIGNED_LOOP(ctype,utype,mulhi) do { \
+    ctype *_d = (ctype *) data; \
+    const utype _m = (utype) div->magic; \
+    const guint _s = div->shift; \
+    utype _n, _t; \
+    for (i = 0; i < num; i++) { \
+      _n = (utype) _d[i]; \
+      _t = mulhi (_m, _n); \
+      _d[i] = (ctype) ((_t + ((_n - _t) >> 1)) >> _s); \
+    } \
+  } while (0)
+
+/**
+ * @brief Divide the signed array with the reciprocal of the absolute value.
+ */
+#define DIV_SIGNED_LOOP(ctype,utype,mulhi) do { \
+    ctype *_d = (ctype *) data; \
+    const utype _m = (utype) div->magic; \
+    const guint _s = div->shift; \
+    const gboolean _neg = div->negative; \
+    utype _n, _t, _q; \
+    for (i = 0; i < num; i++) { \
+      _n = (_d[i] < 0) ? -(utype) _d[i] : (utype) _d[i]; \
+      _t = mulhi (_m, _n); \
+      _q = (_t + ((_n - _t) >> 1)) >> _s; \
+      _d[i] = (ctype) (((_d[i] < 0) != _neg) ? -_q : _q); \
+    } \
+  } while (0)
+
+/**
+ * @brief Divide the array with the division instruction.
+ */
+#define DIV_PLAIN_LOOP(ctype) do { \
+    ctype *_d = (ctype *) data; \
+    const ctype _v = (ctype) div->value; \
+    for (i = 0; i < num; i++) \
+      _d[i] = _d[i] / _v; \
+  } while (0)
+
+/**
+ * @brief Divide the integer array by the precomputed divisor in place.
+ */
+void
+transform_accel_div (void *data, const transform_accel_divisor * div,
+    gsize num)
+{
+  gsize i;
+
+  g_return_if_fail (data != NULL);
+  g_return_if_fail (div != NULL);
+
+  if (div->use_div) {
+    switch (div->type) {
+      case _NNS_INT8: DIV_PLAIN_LOOP (gint8); break;
+      case _NNS_INT16: DIV_PLAIN_LOOP (gint16); break;
+      case _NNS_INT32: DIV_PLAIN_LOOP (gint32); break;
+      case _NNS_INT64: DIV_PLAIN_LOOP (gint64); break;
+      case _NNS_UINT8: DIV_PLAIN_LOOP (guint8); break;
+      case _NNS_UINT16: DIV_PLAIN_LOOP (guint16); break;
+      case _NNS_UINT32: DIV_PLAIN_LOOP (guint32); break;
+      case _NNS_UINT64: DIV_PLAIN_LOOP (guint64); break;
+      default: g_assert (0); break;
+    }
+    return;
+  }
+
+  switch (div->type) {
+    case _NNS_INT8: DIV_SIGNED_LOOP (gint8, guint32, _mulhi_u32); break;
+    case _NNS_INT16: DIV_SIGNED_LOOP (gint16, guint32, _mulhi_u32); break;
+    case _NNS_INT32: DIV_SIGNED_LOOP (gint32, guint32, _mulhi_u32); break;
+    case _NNS_UINT8: DIV_UNSIGNED_LOOP (guint8, guint32, _mulhi_u32); break;
+    case _NNS_UINT16: DIV_UNSIGNED_LOOP (guint16, guint32, _mulhi_u32); break;
+    case _NNS_UINT32: DIV_UNSIGNED_LOOP (guint32, guint32, _mulhi_u32); break;
+#if defined(__SIZEOF_INT128__)
+    case _NNS_INT64: DIV_SIGNED_LOOP (gint64, guint64, _mulhi_u64); break;
+    case _NNS_UINT64: DIV_UNSIGNED_LOOP (guint64, guint64, _mulhi_u64); break;
+#endif
+    default: g_assert (0); break;
+  }
+}
+
+/**
+ * @brief Register the kernels and select them for the CPU features.
+ */
+void
+transform_accel_init (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized)) {
+#if defined(TRANSFORM_ACCEL_X86)
+    cpu_accel_register (KERNEL_TYPECAST_U8_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_typecast_u8_f32_sse42));
+    cpu_accel_register (KERNEL_TYPECAST_U8_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_typecast_u8_f32_avx2));
+    cpu_accel_register (KERNEL_TYPECAST_U8_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_typecast_u8_f32_avx512));
+
+    cpu_accel_register (KERNEL_ADD_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_add_f32_sse42));
+    cpu_accel_register (KERNEL_ADD_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_add_f32_avx2));
+    cpu_accel_register (KERNEL_ADD_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_add_f32_avx512));
+
+    cpu_accel_register (KERNEL_MUL_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_mul_f32_sse42));
+    cpu_accel_register (KERNEL_MUL_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_mul_f32_avx2));
+    cpu_accel_register (KERNEL_MUL_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_mul_f32_avx512));
+
+    cpu_accel_register (KERNEL_CLAMP_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_clamp_f32_sse42));
+    cpu_accel_register (KERNEL_CLAMP_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_clamp_f32_avx2));
+    cpu_accel_register (KERNEL_CLAMP_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_clamp_f32_avx512));
+
+    cpu_accel_register (KERNEL_ADD_S64, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_add_s64_sse42));
+    cpu_accel_register (KERNEL_ADD_S64, CPU_FEATURE_AVX2,
+        G_CALLBACK (_add_s64_avx2));
+    cpu_accel_register (KERNEL_ADD_S64, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_add_s64_avx512));
+
+    cpu_accel_register (KERNEL_MUL_S64, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_mul_s64_avx512));
+
+    cpu_accel_register (KERNEL_QUANTIZE_F32_U8, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_quantize_f32_u8_sse42));
+    cpu_accel_register (KERNEL_QUANTIZE_F32_U8, CPU_FEATURE_AVX2,
+        G_CALLBACK (_quantize_f32_u8_avx2));
+    cpu_accel_register (KERNEL_QUANTIZE_F32_U8, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_quantize_f32_u8_avx512));
+
+    cpu_accel_register (KERNEL_QUANTIZE_F32_S8, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_quantize_f32_s8_sse42));
+    cpu_accel_register (KERNEL_QUANTIZE_F32_S8, CPU_FEATURE_AVX2,
+        G_CALLBACK (_quantize_f32_s8_avx2));
+    cpu_accel_register (KERNEL_QUANTIZE_F32_S8, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_quantize_f32_s8_avx512));
+
+    cpu_accel_register (KERNEL_DEQUANTIZE_U8_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_dequantize_u8_f32_sse42));
+    cpu_accel_register (KERNEL_DEQUANTIZE_U8_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_dequantize_u8_f32_avx2));
+    cpu_accel_register (KERNEL_DEQUANTIZE_U8_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_dequantize_u8_f32_avx512));
+
+    cpu_accel_register (KERNEL_DEQUANTIZE_S8_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_dequantize_s8_f32_sse42));
+    cpu_accel_register (KERNEL_DEQUANTIZE_S8_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_dequantize_s8_f32_avx2));
+    cpu_accel_register (KERNEL_DEQUANTIZE_S8_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_dequantize_s8_f32_avx512));
+
+    /* AVX-512 implies F16C, prefer the wider kernel */
+    cpu_accel_register (KERNEL_TYPECAST_F16_F32, CPU_FEATURE_F16C,
+        G_CALLBACK (_typecast_f16_f32_f16c));
+    cpu_accel_register (KERNEL_TYPECAST_F16_F32,
+        CPU_FEATURE_F16C | CPU_FEATURE_AVX512F,
+        G_CALLBACK (_typecast_f16_f32_avx512));
+
+    cpu_accel_register (KERNEL_TYPECAST_F32_F16, CPU_FEATURE_F16C,
+        G_CALLBACK (_typecast_f32_f16_f16c));
+    cpu_accel_register (KERNEL_TYPECAST_F32_F16,
+        CPU_FEATURE_F16C | CPU_FEATURE_AVX512F,
+        G_CALLBACK (_typecast_f32_f16_avx512));
+
+    cpu_accel_register (KERNEL_TYPECAST_BF16_F32, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_typecast_bf16_f32_sse42));
+    cpu_accel_register (KERNEL_TYPECAST_BF16_F32, CPU_FEATURE_AVX2,
+        G_CALLBACK (_typecast_bf16_f32_avx2));
+    cpu_accel_register (KERNEL_TYPECAST_BF16_F32, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_typecast_bf16_f32_avx512));
+
+    cpu_accel_register (KERNEL_TYPECAST_F32_BF16, CPU_FEATURE_SSE4_2,
+        G_CALLBACK (_typecast_f32_bf16_sse42));
+    cpu_accel_register (KERNEL_TYPECAST_F32_BF16, CPU_FEATURE_AVX2,
+        G_CALLBACK (_typecast_f32_bf16_avx2));
+    cpu_accel_register (KERNEL_TYPECAST_F32_BF16, CPU_FEATURE_AVX512F,
+        G_CALLBACK (_typecast_f32_bf16_avx512));
+#endif /* TRANSFORM_ACCEL_X86 */
+
+#if defined(TRANSFORM_ACCEL_NEON)
+    cpu_accel_register (KERNEL_TYPECAST_U8_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_typecast_u8_f32_neon));
+    cpu_accel_register (KERNEL_ADD_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_add_f32_neon));
+    cpu_accel_register (KERNEL_MUL_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_mul_f32_neon));
+    cpu_accel_register (KERNEL_CLAMP_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_clamp_f32_neon));
+    cpu_accel_register (KERNEL_ADD_S64, CPU_FEATURE_NEON,
+        G_CALLBACK (_add_s64_neon));
+#if defined(__aarch64__)
+    cpu_accel_register (KERNEL_QUANTIZE_F32_U8, CPU_FEATURE_NEON,
+        G_CALLBACK (_quantize_f32_u8_neon));
+    cpu_accel_register (KERNEL_QUANTIZE_F32_S8, CPU_FEATURE_NEON,
+        G_CALLBACK (_quantize_f32_s8_neon));
+#endif
+    cpu_accel_register (KERNEL_DEQUANTIZE_U8_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_dequantize_u8_f32_neon));
+    cpu_accel_register (KERNEL_DEQUANTIZE_S8_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_dequantize_s8_f32_neon));
+#if defined(__aarch64__)
+    cpu_accel_register (KERNEL_TYPECAST_F16_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_typecast_f16_f32_neon));
+    cpu_accel_register (KERNEL_TYPECAST_F32_F16, CPU_FEATURE_NEON,
+        G_CALLBACK (_typecast_f32_f16_neon));
+#endif
+    cpu_accel_register (KERNEL_TYPECAST_BF16_F32, CPU_FEATURE_NEON,
+        G_CALLBACK (_typecast_bf16_f32_neon));
+    cpu_accel_register (KERNEL_TYPECAST_F32_BF16, CPU_FEATURE_NEON,
+        G_CALLBACK (_typecast_f32_bf16_neon));
+#endif /* TRANSFORM_ACCEL_NEON */
+
+    /* function table chosen once, no lookup in the streaming thread */
+    accel_funcs.typecast_u8_f32 = (transform_accel_typecast_func)
+        cpu_accel_get (KERNEL_TYPECAST_U8_F32);
+    accel_funcs.add_f32 = (transform_accel_operator_f32_func)
+        cpu_accel_get (KERNEL_ADD_F32);
+    accel_funcs.mul_f32 = (transform_accel_operator_f32_func)
+        cpu_accel_get (KERNEL_MUL_F32);
+    accel_funcs.clamp_f32 = (transform_accel_clamp_f32_func)
+        cpu_accel_get (KERNEL_CLAMP_F32);
+    accel_funcs.add_s64 = (transform_accel_operator_s64_func)
+        cpu_accel_get (KERNEL_ADD_S64);
+    accel_funcs.mul_s64 = (transform_accel_operator_s64_func)
+        cpu_accel_get (KERNEL_MUL_S64);
+    accel_funcs.quantize_f32_u8 = (transform_accel_quantize_func)
+        cpu_accel_get (KERNEL_QUANTIZE_F32_U8);
+    accel_funcs.quantize_f32_s8 = (transform_accel_quantize_func)
+        cpu_accel_get (KERNEL_QUANTIZE_F32_S8);
+    accel_funcs.dequantize_u8_f32 = (transform_accel_dequantize_func)
+        cpu_accel_get (KERNEL_DEQUANTIZE_U8_F32);
+    accel_funcs.dequantize_s8_f32 = (transform_accel_dequantize_func)
+        cpu_accel_get (KERNEL_DEQUANTIZE_S8_F32);
+    accel_funcs.typecast_f16_f32 = (transform_accel_typecast_func)
+        cpu_accel_get (KERNEL_TYPECAST_F16_F32);
+    accel_funcs.typecast_f32_f16 = (transform_accel_typecast_func)
+        cpu_accel_get (KERNEL_TYPECAST_F32_F16);
+    accel_funcs.typecast_bf16_f32 = (transform_accel_typecast_func)
+        cpu_accel_get (KERNEL_TYPECAST_BF16_F32);
+    accel_funcs.typecast_f32_bf16 = (transform_accel_typecast_func)
+        cpu_accel_get (KERNEL_TYPECAST_F32_BF16);
+
+    g_once_init_leave (&initialized, 1);
+  }
+}
+
+/**
+ * @brief Get the kernels selected at initialization.
+ */
+const transform_accel_funcs *
+transform_accel_get (void)
+{
+  transform_accel_init ();
+  return &accel_funcs;
+}
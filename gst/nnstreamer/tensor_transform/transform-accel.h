@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file	transform-accel.h
+ * @date	18 Oct 2021
+ * @brief	CPU-specific kernels of tensor_transform selected at runtime
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	Samsung Electronics Co., Ltd.
+ * @bug		No known bugs.
+ *
+ */
+
+#ifndef __TRANSFORM_ACCEL_H__
+#define __TRANSFORM_ACCEL_H__
+
+#include <glib.h>
+#include <math.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Kernel to convert the array type.
+ */
+typedef void (*transform_accel_typecast_func) (const void *in, void *out,
+    gsize num);
+
+/**
+ * @brief Kernel to do an operation with a constant value in place.
+ */
+typedef void (*transform_accel_operator_f32_func) (float *data, float value,
+    gsize num);
+
+/**
+ * @brief Kernel to do an operation with a 64-bit integer constant in place.
+ * @note The same kernel is used for uint64, the result of add and multiply is identical in two's complement.
+ */
+typedef void (*transform_accel_operator_s64_func) (gint64 *data, gint64 value,
+    gsize num);
+
+/**
+ * @brief Kernel to clamp the array.
+ */
+typedef void (*transform_accel_clamp_f32_func) (const float *in, float *out,
+    float min, float max, gsize num);
+
+/**
+ * @brief Kernel to quantize float32 array to 8-bit integer, q = round (x / scale) + zero_point.
+ * @note The value is saturated to the range of the output type before rounding (see transform_accel_quantize_value).
+ */
+typedef void (*transform_accel_quantize_func) (const float *in, void *out,
+    float scale, gint32 zero_point, gsize num);
+
+/**
+ * @brief Kernel to dequantize 8-bit integer array to float32, x = (q - zero_point) * scale.
+ */
+typedef void (*transform_accel_dequantize_func) (const void *in, float *out,
+    float scale, gint32 zero_point, gsize num);
+
+/**
+ * @brief Kernels selected for the CPU features. NULL if there is no specialized kernel.
+ */
+typedef struct
+{
+  transform_accel_typecast_func typecast_u8_f32; /**< uint8 to float32 */
+  transform_accel_operator_f32_func add_f32; /**< add a constant */
+  transform_accel_operator_f32_func mul_f32; /**< multiply a constant */
+  transform_accel_clamp_f32_func clamp_f32; /**< clamp */
+  transform_accel_operator_s64_func add_s64; /**< add a 64-bit integer constant */
+  transform_accel_operator_s64_func mul_s64; /**< multiply a 64-bit integer constant */
+  transform_accel_quantize_func quantize_f32_u8; /**< float32 to uint8 (quantize) */
+  transform_accel_quantize_func quantize_f32_s8; /**< float32 to int8 (quantize) */
+  transform_accel_dequantize_func dequantize_u8_f32; /**< uint8 to float32 (dequantize) */
+  transform_accel_dequantize_func dequantize_s8_f32; /**< int8 to float32 (dequantize) */
+  transform_accel_typecast_func typecast_f16_f32; /**< float16 to float32 */
+  transform_accel_typecast_func typecast_f32_f16; /**< float32 to float16 */
+  transform_accel_typecast_func typecast_bf16_f32; /**< bfloat16 to float32 */
+  transform_accel_typecast_func typecast_f32_bf16; /**< float32 to bfloat16 */
+} transform_accel_funcs;
+
+/**
+ * @brief Quantize a value without the zero-point.
+ * @param x the value to be quantized
+ * @param scale the scale, x is divided by this (not multiplied by the reciprocal, to get the same result at the ties)
+ * @param lo the minimum of the output type minus the zero-point
+ * @param hi the maximum of the output type minus the zero-point
+ * @return the value rounded to the nearest even integer, saturated to [lo, hi] (NaN to lo).
+ * @note The kernels and the typed loops share this to get the identical result.
+ */
+static inline gint32
+transform_accel_quantize_value (float x, float scale, float lo, float hi)
+{
+  x /= scale;
+  x = (x >= lo) ? x : lo;
+  x = (x <= hi) ? x : hi;
+  return (gint32) rintf (x);
+}
+
+/**
+ * @brief Precomputed reciprocal to divide an integer array by a constant.
+ *
+ * The quotient is computed with a multiply-high and shifts (Granlund and
+ * Montgomery, "Division by Invariant Integers using Multiplication"),
+ * rounded toward zero as the integer division of C.
+ */
+typedef struct
+{
+  tensor_type type; /**< integer type of the array */
+  guint64 value;    /**< the divisor (sign-extended bits for signed types) */
+  guint64 abs;      /**< absolute value of the divisor */
+  guint64 magic;    /**< multiplier, 0 if the divisor is a power of 2 */
+  guint shift;      /**< post-shift */
+  gboolean negative; /**< TRUE if the divisor is negative */
+  gboolean use_div; /**< TRUE to use the division instruction */
+} transform_accel_divisor;
+
+/**
+ * @brief Precompute the reciprocal of an integer divisor.
+ * @param[out] div the divisor to be initialized
+ * @param[in] type integer type of the divisor and the array
+ * @param[in] value pointer of the divisor value of the type
+ * @return FALSE if the type is not an integer or the divisor is 0.
+ */
+extern gboolean
+transform_accel_divisor_init (transform_accel_divisor * div, tensor_type type,
+    const void *value);
+
+/**
+ * @brief Divide the integer array by the precomputed divisor in place.
+ */
+extern void
+transform_accel_div (void *data, const transform_accel_divisor * div,
+    gsize num);
+
+/**
+ * @brief Register the kernels and select them for the CPU features.
+ */
+extern void
+transform_accel_init (void);
+
+/**
+ * @brief Get the kernels selected at initialization.
+ */
+extern const transform_accel_funcs *
+transform_accel_get (void);
+
+G_END_DECLS
+#endif /* __TRANSFORM_ACCEL_H__ */
@@ -48,6 +48,7 @@ NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_common_pipeline.c \
     $(NNSTREAMER_GST_HOME)/registerer/nnstreamer.c \
     $(NNSTREAMER_GST_HOME)/tensor_converter/tensor_converter.c \
+    $(NNSTREAMER_GST_HOME)/tensor_converter/converter-video-preproc.c \
     $(NNSTREAMER_GST_HOME)/tensor_crop/tensor_crop.c \
     $(NNSTREAMER_GST_HOME)/tensor_aggregator/tensor_aggregator.c \
     $(NNSTREAMER_GST_HOME)/tensor_decoder/tensordec.c \
@@ -61,12 +62,17 @@ NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_sink/tensor_sink.c \
     $(NNSTREAMER_GST_HOME)/tensor_split/gsttensorsplit.c \
     $(NNSTREAMER_GST_HOME)/tensor_transform/tensor_transform.c \
+    $(NNSTREAMER_GST_HOME)/tensor_transform/transform-accel.c \
     $(NNSTREAMER_GST_HOME)/tensor_if/gsttensorif.c \
+    $(NNSTREAMER_GST_HOME)/tensor_if/gsttensorif_expr.c \
     $(NNSTREAMER_GST_HOME)/tensor_rate/gsttensorrate.c \
+    $(NNSTREAMER_GST_HOME)/tensor_file/tensor_filesink.c \
+    $(NNSTREAMER_GST_HOME)/tensor_file/tensor_filesrc.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_common.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_client.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversink.c \
-    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversrc.c
+    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversrc.c \
+    $(NNSTREAMER_GST_HOME)/tensor_tracer/gsttensortracer.c
 
 # source AMC (Android MediaCodec)
 NNSTREAMER_SOURCE_AMC_SRCS := \
@@ -969,6 +969,7 @@ cp -r result %{buildroot}%{_datadir}/nnstreamer/unittest/
 %{_includedir}/nnstreamer/nnstreamer_plugin_api.h
 %{_includedir}/nnstreamer/nnstreamer_version.h
 %{_includedir}/nnstreamer/tensor_filter_cpp.hh
+%{_includedir}/nnstreamer/tensor_filter_cpp_typed.hh
 %{_includedir}/nnstreamer/nnstreamer_cppplugin_api_filter.hh
 %{_libdir}/pkgconfig/nnstreamer.pc
 %{_libdir}/pkgconfig/nnstreamer-cpp.pc
@@ -16,11 +16,15 @@
 #include <gtest/gtest.h>
 #include <glib.h>
 #include <glib/gstdio.h>
+#include <hw_accel.h>
+#include <math.h>
 #include <nnstreamer_conf.h>
 #include <nnstreamer_plugin_api.h>
 #include <tensor_common.h>
+#include <tensor_data.h>
 #include <unistd.h>
 #include <unittest_util.h>
+#include <utime.h>
 
 /**
  * @brief Test for int32 type string.
@@ -231,6 +235,31 @@ TEST (commonGetTensorType, uint64_n)
   EXPECT_EQ (gst_tensor_get_type ("uint6"), _NNS_END);
 }
 
+/**
+ * @brief Test for float16 and bfloat16 type string.
+ */
+TEST (commonGetTensorType, float16)
+{
+  EXPECT_EQ (gst_tensor_get_type ("float16"), _NNS_FLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("FloaT16"), _NNS_FLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat16"), _NNS_BFLOAT16);
+  EXPECT_EQ (gst_tensor_get_type ("BFLOAT16"), _NNS_BFLOAT16);
+  EXPECT_STREQ (gst_tensor_get_type_string (_NNS_FLOAT16), "float16");
+  EXPECT_STREQ (gst_tensor_get_type_string (_NNS_BFLOAT16), "bfloat16");
+  EXPECT_EQ (gst_tensor_get_element_size (_NNS_FLOAT16), 2U);
+  EXPECT_EQ (gst_tensor_get_element_size (_NNS_BFLOAT16), 2U);
+}
+
+/**
+ * @brief Test for float16 and bfloat16 type string.
+ */
+TEST (commonGetTensorType, float16_n)
+{
+  EXPECT_EQ (gst_tensor_get_type ("float8"), _NNS_END);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat32"), _NNS_END);
+  EXPECT_EQ (gst_tensor_get_type ("bfloat"), _NNS_END);
+}
+
 /**
  * @brief Test to find index of the key.
  */
@@ -1416,6 +1445,54 @@ TEST (commonMetaInfo, appendHeader)
   gst_memory_unref (result);
 }
 
+/**
+ * @brief Test for tensor meta info (append header to memory with prefix).
+ */
+TEST (commonMetaInfo, appendHeaderPrefix)
+{
+  GstTensorMetaInfo meta1, meta2;
+  GstMemory *result, *data;
+  GstMapInfo map1, map2;
+  gsize hsize, msize;
+  gboolean ret;
+
+  gst_tensor_meta_info_init (&meta1);
+  meta1.type = _NNS_UINT8;
+  meta1.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta1.dimension[0] = 100U;
+  meta1.dimension[1] = 1U;
+
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+  data = gst_tensor_alloc_memory (100);
+  ASSERT_TRUE (data != NULL);
+
+  ASSERT_TRUE (gst_memory_map (data, &map1, GST_MAP_WRITE));
+  memset (map1.data, 0xAB, map1.size);
+  gst_memory_unmap (data, &map1);
+
+  result = gst_tensor_meta_info_append_header (&meta1, data);
+  EXPECT_TRUE (result != NULL);
+
+  msize = gst_memory_get_sizes (result, NULL, NULL);
+  EXPECT_EQ (msize, hsize + 100U);
+
+  ret = gst_tensor_meta_info_parse_memory (&meta2, result);
+  EXPECT_TRUE (ret);
+  EXPECT_EQ (meta2.type, _NNS_UINT8);
+  EXPECT_EQ (meta2.dimension[0], 100U);
+
+  /* tensor data should not be copied */
+  ASSERT_TRUE (gst_memory_map (data, &map1, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (result, &map2, GST_MAP_READ));
+  EXPECT_TRUE (map2.data + hsize == map1.data);
+  EXPECT_EQ (map2.data[hsize], 0xAB);
+  gst_memory_unmap (result, &map2);
+  gst_memory_unmap (data, &map1);
+
+  gst_memory_unref (data);
+  gst_memory_unref (result);
+}
+
 /**
  * @brief Test for tensor meta info (append header to memory with invalid param).
  */
@@ -1755,6 +1832,462 @@ TEST (confCustom, envStr01)
   }
 }
 
+/**
+ * @brief Set the access and modification time of the file to the past.
+ */
+static void
+set_past_mtime (const gchar *path)
+{
+  struct utimbuf times;
+
+  times.actime = times.modtime = time (NULL) - 10;
+  EXPECT_EQ (g_utime (path, &times), 0);
+}
+
+/**
+ * @brief Test the registry cache of sub-plugins
+ */
+TEST (confRegistry, subpluginCache)
+{
+  gchar *fullpath = g_build_path ("/", g_get_tmp_dir (), "nns-tizen-XXXXXX", NULL);
+  gchar *dir = g_mkdtemp (fullpath);
+  gchar *filename = g_build_path ("/", dir, "nnstreamer.ini", NULL);
+  gchar *cachefile = g_build_path ("/", dir, "registry.cache", NULL);
+  gchar *dirc = g_build_path ("/", dir, "converters", NULL);
+  gchar *contents = NULL;
+  gchar *value;
+  const gchar *base_confenv;
+  gchar *confenv;
+  FILE *fp;
+
+  EXPECT_EQ (g_mkdir (dirc, 0755), 0);
+
+  base_confenv = g_getenv ("NNSTREAMER_CONF");
+  confenv = (base_confenv != NULL) ? g_strdup (base_confenv) : NULL;
+
+  fp = g_fopen (filename, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "[common]\n");
+  g_fprintf (fp, "registry_cache=%s\n", cachefile);
+  g_fprintf (fp, "[converter]\n");
+  g_fprintf (fp, "converters=%s\n", dirc);
+  fclose (fp);
+
+  gchar *f1 = create_null_file (
+      dirc, "libnnstreamer_converter_fancy" NNSTREAMER_SO_FILE_EXTENSION);
+  set_past_mtime (f1);
+  set_past_mtime (dirc);
+
+  /* the directory listing is saved in the cache */
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", filename, TRUE));
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  EXPECT_STREQ (nnsconf_get_fullpath ("fancy", NNSCONF_PATH_CONVERTERS), f1);
+
+  EXPECT_TRUE (g_file_get_contents (cachefile, &contents, NULL, NULL));
+  EXPECT_TRUE (contents && g_strrstr (contents, "fancy") != NULL);
+  g_free (contents);
+
+  /* cached info of sub-plugin */
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, "fancy", "caps");
+  EXPECT_TRUE (value == NULL);
+
+  nnsconf_set_subplugin_cache (NNSCONF_PATH_CONVERTERS, "fancy", "caps", "fancy/x-raw");
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, "fancy", "caps");
+  EXPECT_STREQ (value, "fancy/x-raw");
+  g_free (value);
+
+  /* reload from the cache file */
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  EXPECT_STREQ (nnsconf_get_fullpath ("fancy", NNSCONF_PATH_CONVERTERS), f1);
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, "fancy", "caps");
+  EXPECT_STREQ (value, "fancy/x-raw");
+  g_free (value);
+
+  /* the cached info is invalid if the library is changed */
+  EXPECT_TRUE (g_file_set_contents (f1, "changed", -1, NULL));
+  set_past_mtime (f1);
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, "fancy", "caps");
+  EXPECT_TRUE (value == NULL);
+
+  /* the listing is updated if the directory is changed */
+  gchar *f2 = create_null_file (
+      dirc, "libnnstreamer_converter_another" NNSTREAMER_SO_FILE_EXTENSION);
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  EXPECT_STREQ (nnsconf_get_fullpath ("another", NNSCONF_PATH_CONVERTERS), f2);
+
+  g_remove (f1);
+  g_remove (f2);
+  g_remove (cachefile);
+  g_remove (filename);
+  g_rmdir (dirc);
+  g_rmdir (dir);
+
+  g_free (f1);
+  g_free (f2);
+  g_free (fullpath);
+  g_free (filename);
+  g_free (cachefile);
+  g_free (dirc);
+
+  if (confenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", confenv, TRUE));
+    g_free (confenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_CONF");
+  }
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+}
+
+/**
+ * @brief Test the registry cache with invalid sub-plugin (negative)
+ */
+TEST (confRegistry, subpluginCacheInvalid_n)
+{
+  gchar *value;
+
+  nnsconf_set_subplugin_cache (NNSCONF_PATH_CONVERTERS, "not_existing_converter", "caps", "any");
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, "not_existing_converter", "caps");
+  EXPECT_TRUE (value == NULL);
+
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_END, "any", "caps");
+  EXPECT_TRUE (value == NULL);
+
+  value = nnsconf_get_subplugin_cache (NNSCONF_PATH_CONVERTERS, NULL, "caps");
+  EXPECT_TRUE (value == NULL);
+}
+
+/**
+ * @brief Dummy kernels to test the dispatch registry.
+ */
+static void
+_dummy_kernel_default (void)
+{
+}
+
+/**
+ * @brief Dummy kernels to test the dispatch registry.
+ */
+static void
+_dummy_kernel_unsupported (void)
+{
+}
+
+/**
+ * @brief Test for the dispatch registry of the CPU-specific kernels.
+ */
+TEST (commonCpuAccel, registerKernel)
+{
+  guint features = cpu_accel_get_features ();
+
+  EXPECT_TRUE (cpu_accel_has_features (CPU_FEATURE_NONE));
+  EXPECT_TRUE (cpu_accel_has_features (features));
+
+  /* the kernel requiring the features not enabled is never selected */
+  EXPECT_TRUE (cpu_accel_register ("unittest_kernel", (1U << 30),
+          G_CALLBACK (_dummy_kernel_unsupported)));
+  EXPECT_TRUE (cpu_accel_get ("unittest_kernel") == NULL);
+
+  EXPECT_TRUE (cpu_accel_register ("unittest_kernel", CPU_FEATURE_NONE,
+          G_CALLBACK (_dummy_kernel_default)));
+  EXPECT_TRUE (cpu_accel_get ("unittest_kernel") ==
+      G_CALLBACK (_dummy_kernel_default));
+}
+
+/**
+ * @brief Test for the priority of the kernels, not depending on the registration order and the feature bits.
+ */
+TEST (commonCpuAccel, registerKernelPriority)
+{
+  /* f16c (bit 5) should not outrank avx512f (bit 2) */
+  EXPECT_TRUE (cpu_accel_register ("unittest_priority_x86", CPU_FEATURE_AVX512F,
+          G_CALLBACK (_dummy_kernel_default)));
+  EXPECT_TRUE (cpu_accel_register ("unittest_priority_x86", CPU_FEATURE_F16C,
+          G_CALLBACK (_dummy_kernel_unsupported)));
+
+  if (cpu_accel_has_features (CPU_FEATURE_AVX512F)) {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_x86") ==
+        G_CALLBACK (_dummy_kernel_default));
+  } else if (cpu_accel_has_features (CPU_FEATURE_F16C)) {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_x86") ==
+        G_CALLBACK (_dummy_kernel_unsupported));
+  } else {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_x86") == NULL);
+  }
+
+  /* the kernel requiring more features comes first with the same priority */
+  EXPECT_TRUE (cpu_accel_register ("unittest_priority_arm", CPU_FEATURE_NEON,
+          G_CALLBACK (_dummy_kernel_unsupported)));
+  EXPECT_TRUE (cpu_accel_register ("unittest_priority_arm",
+          CPU_FEATURE_NEON | CPU_FEATURE_SVE,
+          G_CALLBACK (_dummy_kernel_default)));
+
+  if (cpu_accel_has_features (CPU_FEATURE_NEON | CPU_FEATURE_SVE)) {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_arm") ==
+        G_CALLBACK (_dummy_kernel_default));
+  } else if (cpu_accel_has_features (CPU_FEATURE_NEON)) {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_arm") ==
+        G_CALLBACK (_dummy_kernel_unsupported));
+  } else {
+    EXPECT_TRUE (cpu_accel_get ("unittest_priority_arm") == NULL);
+  }
+}
+
+/**
+ * @brief Test for the dispatch registry with invalid param.
+ */
+TEST (commonCpuAccel, registerKernelInvalidParam_n)
+{
+  EXPECT_FALSE (cpu_accel_register (NULL, CPU_FEATURE_NONE,
+          G_CALLBACK (_dummy_kernel_default)));
+  EXPECT_FALSE (cpu_accel_register ("", CPU_FEATURE_NONE,
+          G_CALLBACK (_dummy_kernel_default)));
+  EXPECT_FALSE (cpu_accel_register ("unittest_invalid", CPU_FEATURE_NONE,
+          NULL));
+  EXPECT_TRUE (cpu_accel_get ("unittest_invalid") == NULL);
+  EXPECT_TRUE (cpu_accel_get (NULL) == NULL);
+}
+
+/**
+ * @brief Test for the throttling QoS to skip the frames in producers.
+ */
+TEST (commonTensorQoS, skipFrames)
+{
+  GstTensorQoS qos;
+  GstEvent *event;
+  GstClockTime ts, frame = 10 * GST_MSECOND;
+
+  gst_tensor_qos_reset (&qos);
+  EXPECT_FALSE (gst_tensor_qos_skip (&qos, 0));
+
+  /* the frame at 0 is dropped, the next one after 40ms (proportion 0.25) */
+  event = gst_event_new_qos (GST_QOS_TYPE_OVERFLOW, 0.25, -40 * GST_MSECOND, 0);
+  EXPECT_TRUE (gst_tensor_qos_update (&qos, event, frame));
+  gst_event_unref (event);
+
+  EXPECT_EQ (qos.earliest, (GstClockTime) (40 * GST_MSECOND));
+  EXPECT_EQ (qos.period, (GstClockTime) (40 * GST_MSECOND));
+
+  for (ts = frame; ts < 200 * GST_MSECOND; ts += frame) {
+    /* 40, 80, 120 and 160ms are processed */
+    if ((ts / frame) % 4 == 0)
+      EXPECT_FALSE (gst_tensor_qos_skip (&qos, ts));
+    else
+      EXPECT_TRUE (gst_tensor_qos_skip (&qos, ts));
+  }
+  EXPECT_EQ (qos.skipped, 15U);
+
+  /* expired without new event */
+  EXPECT_FALSE (gst_tensor_qos_skip (&qos, 2 * GST_SECOND));
+  EXPECT_FALSE (gst_tensor_qos_skip (&qos, 2 * GST_SECOND + frame));
+}
+
+/**
+ * @brief Test for the throttling QoS with invalid param.
+ */
+TEST (commonTensorQoS, updateInvalidParam_n)
+{
+  GstTensorQoS qos;
+  GstEvent *event;
+
+  gst_tensor_qos_reset (&qos);
+
+  /* only the overflow type is handled */
+  event = gst_event_new_qos (GST_QOS_TYPE_THROTTLE, 0.9, GST_SECOND, 0);
+  EXPECT_FALSE (gst_tensor_qos_update (&qos, event, GST_MSECOND));
+  EXPECT_FALSE (gst_tensor_qos_update (NULL, event, GST_MSECOND));
+  gst_event_unref (event);
+
+  event = gst_event_new_eos ();
+  EXPECT_FALSE (gst_tensor_qos_update (&qos, event, GST_MSECOND));
+  gst_event_unref (event);
+
+  EXPECT_FALSE (gst_tensor_qos_update (&qos, NULL, GST_MSECOND));
+  EXPECT_FALSE (gst_tensor_qos_skip (&qos, 0));
+  EXPECT_FALSE (gst_tensor_qos_skip (NULL, 0));
+}
+
+/**
+ * @brief Naive two-pass reference of the mean and standard deviation of each channel.
+ */
+template <typename T>
+static void
+_mean_std_reference (const T *data, gsize num, gsize channels,
+    gdouble *means, gdouble *stds)
+{
+  gsize pixels = num / channels;
+  gsize i, c;
+
+  for (c = 0; c < channels; c++) {
+    gdouble sum = 0.0, sq = 0.0;
+
+    for (i = 0; i < pixels; i++)
+      sum += (gdouble) data[i * channels + c];
+    means[c] = sum / pixels;
+
+    for (i = 0; i < pixels; i++) {
+      gdouble d = (gdouble) data[i * channels + c] - means[c];
+      sq += d * d;
+    }
+    stds[c] = sqrt (sq / pixels);
+  }
+}
+
+/**
+ * @brief Test for the mean and standard deviation of uint8 tensor.
+ */
+TEST (commonTensorData, meanStdUint8)
+{
+  const gsize num = 1000;
+  guint8 *data = (guint8 *) g_malloc (num);
+  gdouble mean, std, ref_mean, ref_std;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    data[i] = (guint8) ((i * 7 + i / 13) % 256);
+
+  _mean_std_reference (data, num, 1, &ref_mean, &ref_std);
+
+  EXPECT_TRUE (gst_tensor_data_raw_mean_std (data, num, _NNS_UINT8, &mean, &std));
+  EXPECT_NEAR (mean, ref_mean, 1e-9);
+  EXPECT_NEAR (std, ref_std, 1e-9);
+
+  /* std is nullable */
+  EXPECT_TRUE (gst_tensor_data_raw_mean_std (data, num, _NNS_UINT8, &mean, NULL));
+  EXPECT_NEAR (mean, ref_mean, 1e-9);
+
+  g_free (data);
+}
+
+/**
+ * @brief Test for the mean and standard deviation of large float32 tensor (multi-threaded).
+ */
+TEST (commonTensorData, meanStdFloat32Large)
+{
+  /* larger than twice of the threshold, split into the threads if available */
+  const gsize num = (4U << 20) + 123;
+  gfloat *data = (gfloat *) g_malloc (num * sizeof (gfloat));
+  gdouble mean, std, ref_mean, ref_std;
+  gsize i;
+
+  /* large offset with small deviations, naive single-pass sums lose precision */
+  for (i = 0; i < num; i++)
+    data[i] = 10000.0f + (gfloat) (i % 97) * 0.25f - (i < num / 2 ? 8.0f : 0.0f);
+
+  _mean_std_reference (data, num, 1, &ref_mean, &ref_std);
+
+  EXPECT_TRUE (gst_tensor_data_raw_mean_std (
+      data, num * sizeof (gfloat), _NNS_FLOAT32, &mean, &std));
+  EXPECT_NEAR (mean, ref_mean, 1e-6 * ref_mean);
+  EXPECT_NEAR (std, ref_std, 1e-6 * ref_std);
+
+  g_free (data);
+}
+
+/**
+ * @brief Test for the mean and standard deviation per channel with uneven channels.
+ */
+TEST (commonTensorData, meanStdPerChannel)
+{
+  const gsize channels = 3, pixels = 1000;
+  gint16 *data = (gint16 *) g_malloc (channels * pixels * sizeof (gint16));
+  gdouble means[3], stds[3], ref_means[3], ref_stds[3];
+  tensor_dim dim = { 0 };
+  gsize i, c;
+
+  dim[0] = channels;
+  dim[1] = pixels;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    if (dim[i] == 0)
+      dim[i] = 1;
+  }
+
+  for (i = 0; i < pixels; i++) {
+    data[i * channels] = 5; /* constant */
+    data[i * channels + 1] = (gint16) (1000 + (i % 31) * 3);
+    data[i * channels + 2] = (gint16) (-20000 + (gint) ((i * 37) % 4001));
+  }
+
+  _mean_std_reference (data, channels * pixels, channels, ref_means, ref_stds);
+
+  EXPECT_TRUE (gst_tensor_data_raw_mean_std_per_channel (data,
+      channels * pixels * sizeof (gint16), _NNS_INT16, dim, means, stds));
+
+  for (c = 0; c < channels; c++) {
+    EXPECT_NEAR (means[c], ref_means[c], 1e-9);
+    if (ref_stds[c] == 0.0)
+      EXPECT_DOUBLE_EQ (stds[c], 1e-10);
+    else
+      EXPECT_NEAR (stds[c], ref_stds[c], 1e-9);
+  }
+
+  g_free (data);
+}
+
+/**
+ * @brief Test for the mean and standard deviation per channel of large float32 tensor (multi-threaded, many channels).
+ */
+TEST (commonTensorData, meanStdPerChannelFloat32Large)
+{
+  /* more channels than a chunk of the channels to compute at once */
+  const gsize channels = 70, pixels = 40000;
+  gfloat *data = (gfloat *) g_malloc (channels * pixels * sizeof (gfloat));
+  gdouble *means = g_new0 (gdouble, channels);
+  gdouble *stds = g_new0 (gdouble, channels);
+  gdouble *ref_means = g_new0 (gdouble, channels);
+  gdouble *ref_stds = g_new0 (gdouble, channels);
+  tensor_dim dim = { 0 };
+  gsize i, c;
+
+  dim[0] = channels;
+  dim[1] = pixels;
+  for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++) {
+    if (dim[i] == 0)
+      dim[i] = 1;
+  }
+
+  for (i = 0; i < pixels; i++) {
+    for (c = 0; c < channels; c++) {
+      data[i * channels + c] = (gfloat) c * 100.0f
+          + (gfloat) ((i * (c + 1)) % 53) * 0.5f;
+    }
+  }
+
+  _mean_std_reference (data, channels * pixels, channels, ref_means, ref_stds);
+
+  EXPECT_TRUE (gst_tensor_data_raw_mean_std_per_channel (data,
+      channels * pixels * sizeof (gfloat), _NNS_FLOAT32, dim, means, stds));
+
+  for (c = 0; c < channels; c++) {
+    EXPECT_NEAR (means[c], ref_means[c], 1e-6 * MAX (1.0, ref_means[c]));
+    EXPECT_NEAR (stds[c], ref_stds[c], 1e-6 * MAX (1.0, ref_stds[c]));
+  }
+
+  g_free (data);
+  g_free (means);
+  g_free (stds);
+  g_free (ref_means);
+  g_free (ref_stds);
+}
+
+/**
+ * @brief Test for the mean and standard deviation with invalid param.
+ */
+TEST (commonTensorData, meanStdInvalidParam_n)
+{
+  guint8 data[4] = { 1, 2, 3, 4 };
+  gdouble mean, std, means[4];
+  tensor_dim dim = { 4, 1, 1, 1 };
+
+  EXPECT_FALSE (gst_tensor_data_raw_mean_std (NULL, 4, _NNS_UINT8, &mean, &std));
+  EXPECT_FALSE (gst_tensor_data_raw_mean_std (data, 0, _NNS_UINT8, &mean, &std));
+  EXPECT_FALSE (gst_tensor_data_raw_mean_std (data, 4, _NNS_END, &mean, &std));
+  EXPECT_FALSE (gst_tensor_data_raw_mean_std (data, 4, _NNS_UINT8, NULL, &std));
+
+  dim[0] = 0;
+  EXPECT_FALSE (gst_tensor_data_raw_mean_std_per_channel (
+      data, 4, _NNS_UINT8, dim, means, NULL));
+}
+
 /**
  * @brief Test version control (positive)
  */
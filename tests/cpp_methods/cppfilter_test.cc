@@ -303,3 +303,48 @@ fini_shared_lib (void)
   delete reg2;
   delete reg3;
 }
+
+/** @brief API method */
+filter_typed::filter_typed (const char *str) : typed_filter (str)
+{
+}
+
+/** @brief API method */
+filter_typed::~filter_typed ()
+{
+}
+
+/** @brief API method */
+int
+filter_typed::invoke_typed (const input_type &in, output_type &out)
+{
+  const size_t n = in.size ();
+
+  for (size_t i = 0; i < n; i++) {
+    out[i] = in[i] * 2;
+    out[i + n] = in[i] + 1;
+  }
+  return 0;
+}
+
+/** @brief API method */
+filter_typed_batch::filter_typed_batch (const char *str) : typed_filter (str)
+{
+}
+
+/** @brief API method */
+filter_typed_batch::~filter_typed_batch ()
+{
+}
+
+/** @brief API method */
+int
+filter_typed_batch::invoke_typed (const input_type &in, output_type &out)
+{
+  const auto &a = std::get<0> (in);
+  const auto &b = std::get<1> (in);
+
+  for (size_t i = 0; i < out.size (); i++)
+    out[i] = a[i] + b[i];
+  return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <glib.h>
 #include <tensor_filter_cpp.hh>
+#include <tensor_filter_cpp_typed.hh>
 
 class filter_basic: public tensor_filter_cpp {
   public:
@@ -41,3 +42,26 @@ class filter_basic2: public tensor_filter_cpp {
 
     static int resultCompare(const char *inputFile, const char *outputFile, unsigned int nDropAllowed=0);
 };
+
+/** @brief Typed filter with the same behavior as filter_basic */
+class filter_typed
+    : public nnstreamer::typed_filter<nnstreamer::In<uint8_t, 3, 4, 4>,
+          nnstreamer::Out<uint8_t, 3, 4, 4, 2>> {
+  public:
+    filter_typed(const char *str);
+    ~filter_typed();
+
+    int invoke_typed(const input_type &in, output_type &out) override;
+};
+
+/** @brief Typed filter with two input tensors and 2 frames in a buffer */
+class filter_typed_batch
+    : public nnstreamer::typed_filter<nnstreamer::tensors_spec<nnstreamer::tensor_spec<float, 4>,
+                                          nnstreamer::tensor_spec<int16_t, 2, 2>>,
+          nnstreamer::Out<float, 4>, 2> {
+  public:
+    filter_typed_batch(const char *str);
+    ~filter_typed_batch();
+
+    int invoke_typed(const input_type &in, output_type &out) override;
+};
@@ -10,6 +10,7 @@
 #include <glib.h>
 #include <gst/gst.h>
 
+#include <nnstreamer_plugin_api.h>
 #include <unittest_util.h>
 #include "cppfilter_test.hh"
 
@@ -293,6 +294,130 @@ TEST (cppFilterObj, base03)
   g_free (tmp5);
 }
 
+/** @brief Positive case for the dimensions generated from the typed filter */
+TEST (cppFilterTyped, dimension01)
+{
+  filter_typed typed ("typed_01");
+  filter_typed_batch batch ("typed_02");
+  GstTensorsInfo info;
+
+  gst_tensors_info_init (&info);
+  EXPECT_EQ (typed.getInputDim (&info), 0);
+  EXPECT_EQ (info.num_tensors, 1U);
+  EXPECT_EQ (info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (info.info[0].dimension[0], 3U);
+  EXPECT_EQ (info.info[0].dimension[1], 4U);
+  EXPECT_EQ (info.info[0].dimension[2], 4U);
+  EXPECT_EQ (info.info[0].dimension[3], 1U);
+
+  EXPECT_EQ (typed.getOutputDim (&info), 0);
+  EXPECT_EQ (info.num_tensors, 1U);
+  EXPECT_EQ (info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (info.info[0].dimension[3], 2U);
+
+  /** the outermost dimension is the number of frames */
+  EXPECT_EQ (batch.getInputDim (&info), 0);
+  EXPECT_EQ (info.num_tensors, 2U);
+  EXPECT_EQ (info.info[0].type, _NNS_FLOAT32);
+  EXPECT_EQ (info.info[0].dimension[0], 4U);
+  EXPECT_EQ (info.info[0].dimension[1], 2U);
+  EXPECT_EQ (info.info[1].type, _NNS_INT16);
+  EXPECT_EQ (info.info[1].dimension[0], 2U);
+  EXPECT_EQ (info.info[1].dimension[1], 2U);
+  EXPECT_EQ (info.info[1].dimension[2], 2U);
+
+  EXPECT_TRUE (typed.isAllocatedBeforeInvoke ());
+}
+
+/** @brief Positive case to invoke the typed filter with multiple frames */
+TEST (cppFilterTyped, invokeBatch01)
+{
+  filter_typed_batch batch ("typed_03");
+  tensor_filter_cpp *filter = &batch;
+  float a[8], out[8];
+  int16_t b[8];
+  GstTensorMemory in_mem[2], out_mem[1];
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    a[i] = (float) i;
+    b[i] = (int16_t) (i * 10);
+    out[i] = 0.0f;
+  }
+
+  in_mem[0].data = a;
+  in_mem[0].size = sizeof (a);
+  in_mem[1].data = b;
+  in_mem[1].size = sizeof (b);
+  out_mem[0].data = out;
+  out_mem[0].size = sizeof (out);
+
+  EXPECT_EQ (filter->invoke (in_mem, out_mem), 0);
+  for (i = 0; i < 8; i++)
+    EXPECT_FLOAT_EQ (out[i], (float) (i * 11));
+}
+
+/** @brief Negative case, the dimensions of the typed filter cannot be changed */
+TEST (cppFilterTyped, setInputDim01_n)
+{
+  filter_typed typed ("typed_04");
+  GstTensorsInfo in_info, out_info;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+  EXPECT_EQ (typed.getInputDim (&in_info), 0);
+  EXPECT_NE (typed.setInputDim (&in_info, &out_info), 0);
+}
+
+/** @brief Actual GST Pipeline with the typed filter */
+TEST (cppFilterTyped, pipeline01)
+{
+  filter_typed typed ("typed_pl01");
+  char *tmp1 = getTempFilename ();
+  char *tmp2 = getTempFilename ();
+
+  EXPECT_NE (tmp1, nullptr);
+  EXPECT_NE (tmp2, nullptr);
+  EXPECT_EQ (typed._register (), 0);
+
+  gchar *str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=5 ! videoconvert ! videoscale ! "
+      "video/x-raw,width=4,height=4,format=RGB ! tensor_converter ! tee name=t "
+      "t. ! queue name=q1 ! tensor_filter framework=cpp model=typed_pl01 ! filesink location=%s "
+      "t. ! queue name=q2 ! filesink location=%s ",
+      tmp1, tmp2);
+
+  GError *err = NULL;
+  GstElement *pipeline = gst_parse_launch (str_pipeline, &err);
+
+  EXPECT_NE (pipeline, nullptr);
+  EXPECT_EQ (err, nullptr);
+
+  if (err) {
+    g_printerr ("Cannot construct pipeline: %s\n", err->message);
+    g_clear_error (&err);
+  }
+
+  if (pipeline) {
+    EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT),
+        0);
+
+    g_usleep (100000);
+
+    EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+    g_usleep (100000);
+
+    gst_object_unref (pipeline);
+
+    EXPECT_EQ (filter_basic::resultCompare (tmp2, tmp1), 0);
+  }
+  g_free (str_pipeline);
+
+  g_free (tmp1);
+  g_free (tmp2);
+  EXPECT_EQ (typed._unregister (), 0);
+}
+
 /**
  * @brief Main GTest
  */
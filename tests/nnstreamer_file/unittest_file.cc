@@ -0,0 +1,383 @@
+/**
+ * @file    unittest_file.cc
+ * @date    18 Oct 2021
+ * @brief   Unit test for tensor_filesink and tensor_filesrc
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Samsung Electronics Co., Ltd.
+ * @bug     No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+
+#include <unittest_util.h>
+
+#define NNS_TENSOR_FILESINK_NAME "tensor_filesink"
+#define NNS_TENSOR_FILESRC_NAME "tensor_filesrc"
+
+#define TEST_NUM_BUFFERS (10U)
+#define TEST_FRAME_SIZE (16U * 16U * 3U)
+#define TEST_EOS_TIMEOUT (5 * GST_SECOND)
+
+/**
+ * @brief Test tensor_filesink and tensor_filesrc existence.
+ */
+TEST (nnstreamerFile, checkExistence)
+{
+  GstElementFactory *factory;
+
+  factory = gst_element_factory_find (NNS_TENSOR_FILESINK_NAME);
+  EXPECT_TRUE (factory != NULL);
+  gst_object_unref (factory);
+
+  factory = gst_element_factory_find (NNS_TENSOR_FILESRC_NAME);
+  EXPECT_TRUE (factory != NULL);
+  gst_object_unref (factory);
+}
+
+/**
+ * @brief Test tensor_filesink and tensor_filesrc existence (negative).
+ */
+TEST (nnstreamerFile, checkExistence_n)
+{
+  GstElementFactory *factory;
+  gchar *name;
+
+  name = g_strconcat (NNS_TENSOR_FILESINK_NAME, "_dummy", NULL);
+  factory = gst_element_factory_find (name);
+  EXPECT_TRUE (factory == NULL);
+  g_free (name);
+
+  name = g_strconcat (NNS_TENSOR_FILESRC_NAME, "_dummy", NULL);
+  factory = gst_element_factory_find (name);
+  EXPECT_TRUE (factory == NULL);
+  g_free (name);
+}
+
+/**
+ * @brief Callback for tensor sink signal, keep the received buffers.
+ */
+static void
+new_data_cb (GstElement *element, GstBuffer *buffer, gpointer user_data)
+{
+  GPtrArray *buffers = (GPtrArray *) user_data;
+
+  g_ptr_array_add (buffers, gst_buffer_ref (buffer));
+}
+
+/**
+ * @brief Internal function to connect the signal of tensor_sink in the pipeline.
+ */
+static void
+_connect_sink (GstElement *pipeline, const gchar *name, GPtrArray *buffers)
+{
+  GstElement *sink;
+
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+  ASSERT_TRUE (sink != NULL);
+
+  g_signal_connect (sink, "new-data", (GCallback) new_data_cb, buffers);
+  gst_object_unref (sink);
+}
+
+/**
+ * @brief Internal function to run the pipeline until EOS.
+ * @return TRUE if the pipeline is finished without error.
+ */
+static gboolean
+_run_until_eos (GstElement *pipeline)
+{
+  GstBus *bus;
+  GstMessage *msg;
+  gboolean eos = FALSE;
+
+  if (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT) != 0)
+    return FALSE;
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, TEST_EOS_TIMEOUT,
+      (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  if (msg) {
+    eos = (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_EOS);
+    gst_message_unref (msg);
+  }
+  gst_object_unref (bus);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+  return eos;
+}
+
+/**
+ * @brief Internal function to record the video stream, returns the recorded buffers.
+ */
+static GPtrArray *
+_record_video (const gchar *location)
+{
+  GstElement *pipeline;
+  GPtrArray *buffers;
+  gchar *str_pipeline;
+
+  buffers = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=%u pattern=snow ! "
+      "video/x-raw,format=RGB,width=16,height=16,framerate=30/1 ! "
+      "tensor_converter ! tee name=t "
+      "t. ! queue ! tensor_filesink location=%s "
+      "t. ! queue ! tensor_sink name=orig",
+      TEST_NUM_BUFFERS, location);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+
+  if (pipeline) {
+    _connect_sink (pipeline, "orig", buffers);
+    EXPECT_TRUE (_run_until_eos (pipeline));
+    gst_object_unref (pipeline);
+  }
+
+  return buffers;
+}
+
+/**
+ * @brief Internal function to compare the buffers.
+ */
+static void
+_compare_buffers (GstBuffer *expected, GstBuffer *replayed)
+{
+  GstMapInfo map;
+
+  EXPECT_EQ (GST_BUFFER_PTS (expected), GST_BUFFER_PTS (replayed));
+  EXPECT_EQ (GST_BUFFER_DURATION (expected), GST_BUFFER_DURATION (replayed));
+  EXPECT_EQ (gst_buffer_n_memory (expected), gst_buffer_n_memory (replayed));
+  ASSERT_EQ (gst_buffer_get_size (replayed), TEST_FRAME_SIZE);
+
+  ASSERT_TRUE (gst_buffer_map (expected, &map, GST_MAP_READ));
+  EXPECT_EQ (gst_buffer_memcmp (replayed, 0, map.data, map.size), 0);
+  gst_buffer_unmap (expected, &map);
+}
+
+/**
+ * @brief Record the tensor stream and replay it.
+ */
+TEST (nnstreamerFile, recordReplay)
+{
+  GstElement *pipeline;
+  GPtrArray *recorded, *replayed;
+  gchar *location, *str_pipeline;
+  guint i;
+
+  location = getTempFilename ();
+  ASSERT_TRUE (location != NULL);
+
+  recorded = _record_video (location);
+  ASSERT_EQ (recorded->len, TEST_NUM_BUFFERS);
+
+  replayed = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  str_pipeline = g_strdup_printf (
+      "tensor_filesrc location=%s ! tensor_sink name=sinkx", location);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  _connect_sink (pipeline, "sinkx", replayed);
+  EXPECT_TRUE (_run_until_eos (pipeline));
+
+  ASSERT_EQ (replayed->len, TEST_NUM_BUFFERS);
+  for (i = 0; i < TEST_NUM_BUFFERS; i++) {
+    _compare_buffers ((GstBuffer *) g_ptr_array_index (recorded, i),
+        (GstBuffer *) g_ptr_array_index (replayed, i));
+  }
+
+  gst_object_unref (pipeline);
+  g_ptr_array_free (replayed, TRUE);
+  g_ptr_array_free (recorded, TRUE);
+  g_remove (location);
+  g_free (location);
+  g_free (str_pipeline);
+}
+
+/**
+ * @brief Seek the recorded stream.
+ */
+TEST (nnstreamerFile, seek)
+{
+  GstElement *pipeline;
+  GPtrArray *recorded, *replayed;
+  gchar *location, *str_pipeline;
+  GstClockTime start;
+  gint64 duration;
+  guint i;
+
+  location = getTempFilename ();
+  ASSERT_TRUE (location != NULL);
+
+  recorded = _record_video (location);
+  ASSERT_EQ (recorded->len, TEST_NUM_BUFFERS);
+
+  replayed = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  str_pipeline = g_strdup_printf (
+      "tensor_filesrc location=%s ! tensor_sink name=sinkx", location);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  _connect_sink (pipeline, "sinkx", replayed);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PAUSED, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  EXPECT_TRUE (gst_element_query_duration (pipeline, GST_FORMAT_TIME, &duration));
+  EXPECT_EQ (duration, (gint64) gst_util_uint64_scale (TEST_NUM_BUFFERS, GST_SECOND, 30));
+
+  /* seek to the 6th frame */
+  start = GST_BUFFER_PTS ((GstBuffer *) g_ptr_array_index (recorded, 5));
+  g_ptr_array_set_size (replayed, 0);
+  EXPECT_TRUE (gst_element_seek_simple (pipeline, GST_FORMAT_TIME,
+      (GstSeekFlags) (GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE), start));
+
+  EXPECT_TRUE (_run_until_eos (pipeline));
+
+  ASSERT_EQ (replayed->len, TEST_NUM_BUFFERS - 5);
+  for (i = 0; i < replayed->len; i++) {
+    _compare_buffers ((GstBuffer *) g_ptr_array_index (recorded, i + 5),
+        (GstBuffer *) g_ptr_array_index (replayed, i));
+  }
+
+  gst_object_unref (pipeline);
+  g_ptr_array_free (replayed, TRUE);
+  g_ptr_array_free (recorded, TRUE);
+  g_remove (location);
+  g_free (location);
+  g_free (str_pipeline);
+}
+
+/**
+ * @brief Replay the file without the index (unfinished recording).
+ */
+TEST (nnstreamerFile, rebuildIndex)
+{
+  GstElement *pipeline;
+  GPtrArray *recorded, *replayed;
+  gchar *location, *str_pipeline;
+  gchar *contents;
+  gsize length;
+  guint i;
+
+  location = getTempFilename ();
+  ASSERT_TRUE (location != NULL);
+
+  recorded = _record_video (location);
+  ASSERT_EQ (recorded->len, TEST_NUM_BUFFERS);
+
+  /* break the tail of the file */
+  ASSERT_TRUE (g_file_get_contents (location, &contents, &length, NULL));
+  ASSERT_GT (length, 8U);
+  ASSERT_TRUE (g_file_set_contents (location, contents, length - 8, NULL));
+  g_free (contents);
+
+  replayed = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  str_pipeline = g_strdup_printf (
+      "tensor_filesrc location=%s ! tensor_sink name=sinkx", location);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  _connect_sink (pipeline, "sinkx", replayed);
+  EXPECT_TRUE (_run_until_eos (pipeline));
+
+  ASSERT_EQ (replayed->len, TEST_NUM_BUFFERS);
+  for (i = 0; i < TEST_NUM_BUFFERS; i++) {
+    _compare_buffers ((GstBuffer *) g_ptr_array_index (recorded, i),
+        (GstBuffer *) g_ptr_array_index (replayed, i));
+  }
+
+  gst_object_unref (pipeline);
+  g_ptr_array_free (replayed, TRUE);
+  g_ptr_array_free (recorded, TRUE);
+  g_remove (location);
+  g_free (location);
+  g_free (str_pipeline);
+}
+
+/**
+ * @brief Replay the invalid file (negative).
+ */
+TEST (nnstreamerFile, invalidFile_n)
+{
+  GstElement *pipeline;
+  gchar *location, *str_pipeline;
+
+  location = getTempFilename ();
+  ASSERT_TRUE (location != NULL);
+  ASSERT_TRUE (g_file_set_contents (location, "invalid tensor file", -1, NULL));
+
+  str_pipeline = g_strdup_printf (
+      "tensor_filesrc location=%s ! tensor_sink", location);
+  pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_NE (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+  gst_object_unref (pipeline);
+  g_remove (location);
+  g_free (location);
+  g_free (str_pipeline);
+}
+
+/**
+ * @brief Replay without the location (negative).
+ */
+TEST (nnstreamerFile, noLocation_n)
+{
+  GstElement *pipeline;
+
+  pipeline = gst_parse_launch ("tensor_filesrc ! tensor_sink", NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  EXPECT_NE (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT);
+  gst_object_unref (pipeline);
+}
+
+/**
+ * @brief Record with invalid alignment (negative).
+ */
+TEST (nnstreamerFile, invalidAlignment_n)
+{
+  GstElement *sink;
+  guint alignment;
+
+  sink = gst_element_factory_make (NNS_TENSOR_FILESINK_NAME, NULL);
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_set (sink, "alignment", 100U, NULL);
+  g_object_get (sink, "alignment", &alignment, NULL);
+  EXPECT_NE (alignment, 100U);
+
+  gst_object_unref (sink);
+}
+
+/**
+ * @brief Main GTest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -84,6 +84,11 @@ callCompareTest combi.dummy.golden tensorfilter.combi.in.log 4_0 "Output Combina
 python3 checkLabel.py tensorfilter.out.log ${PATH_TO_IMAGE}
 testResult $? 1 "Golden test comparison" 0 1
 
+# Test with custom options (intra-op threads, inference mode)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_IMAGE} ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw,format=GRAY8,framerate=0/1 ! tensor_converter ! tensor_filter framework=pytorch model=${PATH_TO_MODEL} input=1:28:28:1 inputtype=uint8 output=10:1:1:1 outputtype=uint8 custom=NumThreads:2,InferenceMode:true ! filesink location=tensorfilter.out.log" 5 0 0 $PERFORMANCE
+python3 checkLabel.py tensorfilter.out.log ${PATH_TO_IMAGE}
+testResult $? 5 "Golden test comparison with custom options" 0 1
+
 # Test the setting of accelerators
 gst-launch-1.0 --gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_IMAGE} ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw,format=GRAY8,framerate=0/1 ! tensor_converter ! tensor_filter framework=pytorch model=${PATH_TO_MODEL} output=1:7 outputtype=int8 accelerator=true:gpu ! filesink location=tensorfilter.out.log 2>info
 cat info | grep "gpu = 1, accl = gpu"
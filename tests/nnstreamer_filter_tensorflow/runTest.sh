@@ -79,6 +79,11 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_DATA} !
 python3 checkLabel.py tensorfilter.out.1.log 9
 testResult $? 1 "Golden test comparison" 0 1
 
+# Test with thread pools and warmup
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=${PATH_TO_DATA} ! application/octet-stream ! tensor_converter input-dim=784:1 input-type=uint8 ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 ! tensor_filter framework=tensorflow model=${PATH_TO_MODEL} input=784:1 inputtype=float32 inputname=input output=10:1 outputtype=float32 outputname=softmax custom=IntraOpThreads:2,InterOpThreads:1,Warmup:2 ! filesink location=tensorfilter.out.4.log " 4 0 0 $PERFORMANCE
+python3 checkLabel.py tensorfilter.out.4.log 9
+testResult $? 4 "Golden test comparison with custom options" 0 1
+
 # Input and output comnination test
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc pattern=13 num-buffers=1 ! videoconvert !  video/x-raw,width=640,height=480,framerate=30/1 ! tensor_converter ! tee name=t t. ! queue ! filesink location=combi.dummy.golden buffer-mode=unbuffered sync=false async=false t. ! queue ! mux.sink_0 filesrc location=${PATH_TO_DATA} ! application/octet-stream ! tensor_converter input-dim=784:1 input-type=uint8 ! tensor_transform mode=arithmetic option=typecast:float32,add:-127.5,div:127.5 ! mux.sink_1 tensor_mux name=mux ! tensor_filter framework=tensorflow model=${PATH_TO_MODEL} input=784:1 inputtype=float32 inputname=input output=10:1 outputtype=float32 outputname=softmax input-combination=1 output-combination=i0,o0 ! tensor_demux name=demux demux.src_0 ! queue ! filesink location=tensorfilter.combi.in.log buffer-mode=unbuffered sync=false async=false demux.src_1 ! queue ! filesink location=tensorfilter.out.1.log buffer-mode=unbuffered sync=false async=false" 2 0 0 $PERFORMANCE
 callCompareTest combi.dummy.golden tensorfilter.combi.in.log 2_0 "Output Combination Golden Test 2-0" 1 0
@@ -422,6 +422,218 @@ TEST (nnstreamerGrpc, sinkInvalidPort_n)
   gst_object_unref (test_data.pipeline);
 }
 
+/**
+ * @brief Test gRPC tensor_src properties for non-blocking server
+ */
+TEST (nnstreamerGrpc, srcSetPropertyFanIn)
+{
+  TestOption option;
+  GstElement *src;
+  guint num_threads, queue_size;
+  gchar *fanin;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SRC;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  src = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "src");
+  ASSERT_TRUE (src != NULL);
+
+  g_object_get (src, "num-threads", &num_threads, "queue-size", &queue_size,
+      "fan-in", &fanin, NULL);
+  EXPECT_EQ (num_threads, 1U);
+  EXPECT_EQ (queue_size, 0U);
+  EXPECT_STREQ (fanin, "fifo");
+  g_free (fanin);
+
+  g_object_set (src, "num-threads", 4, "queue-size", 2,
+      "fan-in", "round-robin", NULL);
+  g_object_get (src, "num-threads", &num_threads, "queue-size", &queue_size,
+      "fan-in", &fanin, NULL);
+  EXPECT_EQ (num_threads, 4U);
+  EXPECT_EQ (queue_size, 2U);
+  EXPECT_STREQ (fanin, "round-robin");
+  g_free (fanin);
+
+  gst_object_unref (src);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_src invalid fan-in policy
+ */
+TEST (nnstreamerGrpc, srcInvalidFanIn_n)
+{
+  TestOption option;
+  GstElement *src;
+  gchar *fanin;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SRC;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  src = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "src");
+  ASSERT_TRUE (src != NULL);
+
+  g_object_set (src, "fan-in", "invalid", NULL);
+  g_object_get (src, "fan-in", &fanin, NULL);
+  EXPECT_STREQ (fanin, "fifo");
+  g_free (fanin);
+
+  gst_object_unref (src);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test non-blocking tensor_src server fanning in two clients over loopback
+ */
+TEST (nnstreamerGrpc, srcFanInLoopback)
+{
+  GstElement *server, *src;
+  GstElement *client[2];
+  gchar *str_pipeline;
+  gint port;
+  guint i, out = 0;
+
+  server = gst_parse_launch (
+      "tensor_src_grpc name=src server=TRUE blocking=FALSE host=localhost port=0 "
+      "num-threads=2 fan-in=round-robin ! "
+      "other/tensor,dimension=(string)1:4:4:1,type=(string)uint8,framerate=(fraction)30/1 ! "
+      "fakesink", NULL);
+  ASSERT_TRUE (server != NULL);
+
+  src = gst_bin_get_by_name (GST_BIN (server), "src");
+  ASSERT_TRUE (src != NULL);
+
+  gst_element_set_state (server, GST_STATE_PLAYING);
+  g_usleep (G_USEC_PER_SEC / 10);
+
+  /* the server listens on a random available port */
+  g_object_get (src, "port", &port, NULL);
+  ASSERT_GT (port, 0);
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=10 ! "
+      "video/x-raw,format=GRAY8,width=4,height=4,framerate=30/1 ! "
+      "tensor_converter ! tensor_sink_grpc server=FALSE host=localhost port=%d",
+      port);
+
+  for (i = 0; i < 2; i++) {
+    client[i] = gst_parse_launch (str_pipeline, NULL);
+    ASSERT_TRUE (client[i] != NULL);
+    gst_element_set_state (client[i], GST_STATE_PLAYING);
+  }
+  g_free (str_pipeline);
+
+  /* wait until buffers of both clients arrive (3 sec at most) */
+  for (i = 0; i < 30 && out < 20U; i++) {
+    g_usleep (G_USEC_PER_SEC / 10);
+    g_object_get (src, "out", &out, NULL);
+  }
+  EXPECT_EQ (out, 20U);
+
+  for (i = 0; i < 2; i++) {
+    gst_element_set_state (client[i], GST_STATE_NULL);
+    gst_object_unref (client[i]);
+  }
+
+  gst_element_set_state (server, GST_STATE_NULL);
+  gst_object_unref (src);
+  gst_object_unref (server);
+}
+
+/**
+ * @brief Callback to check the sequence id of responses
+ */
+static GstPadProbeReturn
+_check_invoke_seq (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  guint64 *expected = (guint64 *) user_data;
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+
+  EXPECT_EQ (GST_BUFFER_OFFSET (buffer), *expected);
+  (*expected)++;
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Test request/response streams of invoke mode over loopback
+ */
+TEST (nnstreamerGrpc, invokeLoopback)
+{
+  GstElement *server, *client;
+  GstElement *server_src, *server_sink, *client_src;
+  GstPad *pad;
+  gchar *str_pipeline;
+  gint port;
+  guint i, out = 0;
+  guint64 expected_seq = 0;
+
+  /* server: requests are incremented and returned to the client */
+  server = gst_parse_launch (
+      "tensor_src_grpc name=src invoke=TRUE server=TRUE host=localhost port=0 ! "
+      "other/tensor,dimension=(string)1:4:4:1,type=(string)uint8,framerate=(fraction)30/1 ! "
+      "tensor_transform mode=arithmetic option=typecast:float32,add:1 ! "
+      "tensor_sink_grpc name=sink invoke=TRUE server=TRUE host=localhost", NULL);
+  ASSERT_TRUE (server != NULL);
+
+  server_src = gst_bin_get_by_name (GST_BIN (server), "src");
+  server_sink = gst_bin_get_by_name (GST_BIN (server), "sink");
+  ASSERT_TRUE (server_src != NULL);
+  ASSERT_TRUE (server_sink != NULL);
+
+  gst_element_set_state (server, GST_STATE_PLAYING);
+  g_usleep (G_USEC_PER_SEC / 10);
+
+  /* pair the sink with the server listening on a random available port */
+  g_object_get (server_src, "port", &port, NULL);
+  ASSERT_GT (port, 0);
+  g_object_set (server_sink, "port", port, NULL);
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=10 ! "
+      "video/x-raw,format=GRAY8,width=4,height=4,framerate=30/1 ! "
+      "tensor_converter ! tensor_sink_grpc invoke=TRUE host=localhost port=%d "
+      "tensor_src_grpc name=src invoke=TRUE server=FALSE host=localhost port=%d "
+      "max-in-flight=2 ! "
+      "other/tensor,dimension=(string)1:4:4:1,type=(string)float32,framerate=(fraction)30/1 ! "
+      "fakesink", port, port);
+  client = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (client != NULL);
+
+  client_src = gst_bin_get_by_name (GST_BIN (client), "src");
+  ASSERT_TRUE (client_src != NULL);
+
+  pad = gst_element_get_static_pad (client_src, "src");
+  gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER,
+      _check_invoke_seq, &expected_seq, NULL);
+  gst_object_unref (pad);
+
+  gst_element_set_state (client, GST_STATE_PLAYING);
+
+  /* wait until all responses arrive (3 sec at most) */
+  for (i = 0; i < 30 && out < 10U; i++) {
+    g_usleep (G_USEC_PER_SEC / 10);
+    g_object_get (client_src, "out", &out, NULL);
+  }
+  EXPECT_EQ (out, 10U);
+
+  gst_element_set_state (client, GST_STATE_NULL);
+  gst_element_set_state (server, GST_STATE_NULL);
+
+  EXPECT_EQ (expected_seq, 10U);
+
+  gst_object_unref (client_src);
+  gst_object_unref (client);
+  gst_object_unref (server_src);
+  gst_object_unref (server_sink);
+  gst_object_unref (server);
+}
+
 /**
  * @brief gtest main
  */
@@ -859,6 +859,201 @@ TEST (tensorIfCustom, invalidParam3_n)
 }
 
 
+/**
+ * @brief Set the tensors info of test_frames for the expression tests
+ */
+static void
+tensor_if_expr_set_info (GstTensorsInfo *info)
+{
+  guint i;
+
+  gst_tensors_info_init (info);
+  info->num_tensors = 2;
+  for (i = 0; i < info->num_tensors; i++) {
+    info->info[i].type = _NNS_INT32;
+    gst_tensor_parse_dimension ("3:4:2:2", info->info[i].dimension);
+  }
+}
+
+/**
+ * @brief Test for the expression (compared-value=EXPR) evaluation
+ */
+TEST (tensorIfExpr, eval0)
+{
+  GstTensorsInfo info;
+  GstTensorMemory tensors[NNS_TENSOR_SIZE_LIMIT];
+  tensor_if_expr *expr;
+  gboolean result;
+  guint i;
+  const struct {
+    const gchar *str;
+    gboolean expected;
+  } cases[] = {
+    { "t[0][40] == 1217", TRUE },
+    { "max(t[0][0:24]) == 1124 && mean(t[1]) > 2000", TRUE },
+    { "min(t[1][24:]) < 2200 || argmax(t[1]) != 47", FALSE },
+    { "count(t[0] > 1200) == 24", TRUE },
+    { "any(t[1] < 2101) || !all(t[1] >= 2101)", FALSE },
+    { "(sum(t[0][0:2]) - 2 * 1101) / 2 == 0.5", TRUE },
+  };
+
+  tensor_if_expr_set_info (&info);
+  memset (tensors, 0, sizeof (tensors));
+  for (i = 0; i < info.num_tensors; i++) {
+    tensors[i].data = (gpointer)test_frames[i];
+    tensors[i].size = sizeof (test_frames[i]);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (cases); i++) {
+    expr = gst_tensor_if_expr_compile (cases[i].str, &info);
+    ASSERT_NE (expr, nullptr);
+
+    result = !cases[i].expected;
+    EXPECT_TRUE (gst_tensor_if_expr_eval (expr, tensors, &result));
+    EXPECT_EQ (result, cases[i].expected) << cases[i].str;
+    gst_tensor_if_expr_free (expr);
+  }
+
+  expr = gst_tensor_if_expr_compile ("t[1][0] > 0", &info);
+  ASSERT_NE (expr, nullptr);
+  EXPECT_EQ (gst_tensor_if_expr_get_used_tensors (expr), 2U);
+  gst_tensor_if_expr_free (expr);
+}
+
+/**
+ * @brief Test for the invalid expressions (compared-value=EXPR)
+ */
+TEST (tensorIfExpr, compileInvalid_n)
+{
+  GstTensorsInfo info;
+  guint i;
+  const gchar *invalid[] = {
+    "", "t[2][0] > 0", "t[0][48] > 0", "max(t[0][10:10]) > 0",
+    "median(t[0]) > 0", "t[0][0:2] > 0", "1 < t[0][0] < 2", "t[0][0] >",
+  };
+
+  tensor_if_expr_set_info (&info);
+  EXPECT_EQ (gst_tensor_if_expr_compile (NULL, &info), nullptr);
+  EXPECT_EQ (gst_tensor_if_expr_compile ("t[0][0] > 0", NULL), nullptr);
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++)
+    EXPECT_EQ (gst_tensor_if_expr_compile (invalid[i], &info), nullptr) << invalid[i];
+}
+
+/**
+ * @brief Test for the expressions nested too deeply (compared-value=EXPR)
+ */
+TEST (tensorIfExpr, compileNested_n)
+{
+  GstTensorsInfo info;
+  tensor_if_expr *expr;
+  gchar *str;
+  guint i;
+  GString *nested = g_string_new (NULL);
+
+  tensor_if_expr_set_info (&info);
+
+  /* the nesting within the limit is allowed */
+  for (i = 0; i < 8; i++)
+    g_string_append (nested, "(-");
+  g_string_append (nested, "t[0][0]");
+  for (i = 0; i < 8; i++)
+    g_string_append_c (nested, ')');
+  g_string_append (nested, " > 0");
+
+  expr = gst_tensor_if_expr_compile (nested->str, &info);
+  EXPECT_NE (expr, nullptr);
+  gst_tensor_if_expr_free (expr);
+  g_string_free (nested, TRUE);
+
+  /* parentheses and unary operators without the limit */
+  str = g_strnfill (100000, '(');
+  EXPECT_EQ (gst_tensor_if_expr_compile (str, &info), nullptr);
+  g_free (str);
+
+  str = g_strnfill (100000, '-');
+  EXPECT_EQ (gst_tensor_if_expr_compile (str, &info), nullptr);
+  g_free (str);
+}
+
+/**
+ * @brief Test behavior: TENSORPICK with the expression using appsrc
+ */
+TEST (tensorIfExpr, action0)
+{
+  GstBuffer *buf_0, *buf_1;
+  GstMemory *mem;
+  GstMapInfo info;
+  GstElement *appsrc_handle, *sink_handle, *tif_handle;
+  gint i, idx;
+
+  gchar *str_pipeline = g_strdup (
+      "appsrc name=appsrc ! other/tensors,num_tensors=2,dimensions=(string)3:4:2:2.3:4:2:2, types=(string)int32.int32,framerate=(fraction)0/1 ! "
+      "tensor_if name=tif compared-value=EXPR compared-value-option=\"max(t[0][0:24]) == 1124 && mean(t[1]) > 2000\" "
+      "then=TENSORPICK then-option=0 else=TENSORPICK else-option=1 "
+      "tif.src_0 ! queue ! tensor_sink name=sink_true async=false "
+      "tif.src_1 ! queue ! tensor_sink name=sink_false async=false");
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  ASSERT_NE (pipeline, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  tif_handle = gst_bin_get_by_name (GST_BIN (pipeline), "tif");
+  EXPECT_NE (tif_handle, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_true");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+  gst_object_unref (sink_handle);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_false");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+  gst_object_unref (sink_handle);
+
+  buf_0 = gst_buffer_new ();
+  for (i = 0; i < 2; i++) {
+    gboolean ret;
+    mem = gst_allocator_alloc (NULL, 192, NULL);
+    ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+    ASSERT_TRUE (ret);
+    memcpy (info.data, test_frames[i], 192);
+    gst_memory_unmap (mem, &info);
+    gst_buffer_append_memory (buf_0, mem);
+  }
+  buf_1 = gst_buffer_copy (buf_0);
+
+  data_received = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  idx = 0;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_0), GST_FLOW_OK);
+  g_usleep (100000);
+
+  /* the expression is compiled again with the negotiated tensors info */
+  g_object_set (tif_handle, "compared-value-option",
+      "argmax(t[1]) != 47 || t[0][40] != 1217", NULL);
+
+  idx = 1;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_1), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  EXPECT_EQ (2, data_received);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (tif_handle);
+  gst_object_unref (pipeline);
+  g_free (str_pipeline);
+}
+
 /**
  * @brief Main GTest
  */
@@ -926,6 +926,95 @@ TEST (testTensorTransform, standProperties5_n)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for invalid properties of tensor_transform (quantize)
+ */
+TEST (testTensorTransform, quantizeProperties0_n)
+{
+  GstHarness *h;
+  gchar *str = NULL;
+  guint i;
+  const gchar *invalid[] = {
+    "float32,scale:0.5", /* quantized type should be (u)int(8|16) */
+    "uint8", /* scale is not given */
+    "uint8,scale:0", /* scale should be positive */
+    "uint8,scale:-0.5,zero-point:128",
+    "uint8,scale:0.5,zero-point:256", /* out of the range of uint8 */
+    "int8,scale:0.5,zero-point:-129",
+    "uint8,scale:0.5:0.25,zero-point:1:2:3", /* different number of channels */
+    "uint8,zero-point:128,scale:0.5",
+  };
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++) {
+    h = gst_harness_new ("tensor_transform");
+    ASSERT_TRUE (NULL != h);
+
+    g_object_set (h->element, "mode", GTT_QUANTIZE, "option", invalid[i], NULL);
+
+    g_object_get (h->element, "option", &str, NULL);
+    EXPECT_TRUE (str == NULL) << invalid[i];
+    g_free (str);
+
+    gst_harness_teardown (h);
+  }
+}
+
+/**
+ * @brief Test for invalid properties of tensor_transform (dequantize)
+ */
+TEST (testTensorTransform, dequantizeProperties0_n)
+{
+  GstHarness *h;
+  gchar *str = NULL;
+  guint i;
+  const gchar *invalid[] = {
+    "uint8,scale:0.5", /* output type should be float(32|64) */
+    "float32,scale:1e-50", /* out of the range of float */
+    "float32,scale:0.5,zero-point:1.5",
+    "float32,scale:0.5:0.1:0.2,zero-point:1:2",
+  };
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++) {
+    h = gst_harness_new ("tensor_transform");
+    ASSERT_TRUE (NULL != h);
+
+    g_object_set (h->element, "mode", GTT_DEQUANTIZE, "option", invalid[i], NULL);
+
+    g_object_get (h->element, "option", &str, NULL);
+    EXPECT_TRUE (str == NULL) << invalid[i];
+    g_free (str);
+
+    gst_harness_teardown (h);
+  }
+}
+
+/**
+ * @brief Test for tensor_transform dequantize with float input (invalid caps)
+ */
+TEST (testTensorTransform, dequantizeInvalidType_n)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_DEQUANTIZE, "option",
+      "float32,scale:0.5", NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("10", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  EXPECT_NE (gst_harness_push (h, gst_harness_create_buffer (h, 40)),
+      GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_transform typecast (uint8 > uint32)
  */
@@ -1721,122 +1810,610 @@ TEST (testTensorTransform, arithmetic5)
   gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
   data_in_size = gst_tensors_info_get_size (&config.info, 0);
 
-  config.info.info[0].type = _NNS_INT32;
-  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+  config.info.info[0].type = _NNS_INT32;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i + 1) * (b + 1);
+      ((uint8_t *)info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      int32_t expected = (i + 1) * (b + 1) - 1;
+      EXPECT_EQ (((int32_t *)info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform arithmetic (acceleration, typecast uint8 > int32, mul 2, div 2, add -1)
+ */
+TEST (testTensorTransform, arithmetic5Accel)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 5;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
+      "typecast:int32,mul:2,div:2,add:-1", NULL);
+  g_object_set (h->element, "acceleration", (gboolean)TRUE, NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("5", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_INT32;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      uint8_t value = (i + 1) * (b + 1);
+      ((uint8_t *)info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      int32_t expected = (i + 1) * (b + 1) - 1;
+      EXPECT_EQ (((int32_t *)info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform arithmetic (typecast int32 > int64, add -7, mul 3, div -4, multiple blocks)
+ */
+TEST (testTensorTransform, arithmetic6Int64)
+{
+  const guint num_buffers = 3;
+  const guint array_size = 5000;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
+      "typecast:int64,add:-7,mul:3,div:-4", NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("5000", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_INT64;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++) {
+      int32_t value = ((int32_t) i - 2500) * (int32_t) (b + 1) * 1001;
+      ((int32_t *)info.data)[i] = value;
+    }
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      int64_t value = ((int64_t) i - 2500) * (int64_t) (b + 1) * 1001;
+      int64_t expected = (value - 7) * 3 / -4;
+      EXPECT_EQ (((int64_t *)info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quantize and dequantize (per-tensor, with acceleration)
+ */
+TEST (testTensorTransform, quantize1)
+{
+  const guint array_size = 5000;
+  const gfloat scale = 0.02f;
+  const gint zero_point = 128;
+
+  GstHarness *h, *h2;
+  GstBuffer *in_buf, *out_buf, *deq_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+  gsize data_in_size, data_out_size;
+  guint8 expected[5000];
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_QUANTIZE, "option",
+      "uint8,scale:0.02,zero-point:128", NULL);
+
+  h2 = gst_harness_new ("tensor_transform");
+  g_object_set (h2->element, "mode", GTT_DEQUANTIZE, "option",
+      "float32,scale:0.02,zero-point:128", NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("5000", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_UINT8;
+  gst_harness_set_src_caps (h2, gst_tensors_caps_from_config (&config));
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* set input buffer */
+  in_buf = gst_harness_create_buffer (h, data_in_size);
+
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+  for (i = 0; i < array_size; i++) {
+    gfloat value = ((gint) i - 2500) * 0.0013f;
+    gint q = (gint) rintf (value / scale) + zero_point;
+
+    ((gfloat *) info.data)[i] = value;
+    expected[i] = (guint8) CLAMP (q, 0, 255);
+  }
+
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_EQ (((guint8 *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+
+  /* dequantize the output */
+  EXPECT_EQ (gst_harness_push (h2, out_buf), GST_FLOW_OK);
+
+  deq_buf = gst_harness_pull (h2);
+
+  ASSERT_TRUE (deq_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (deq_buf), data_in_size);
+
+  mem = gst_buffer_peek_memory (deq_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (((gfloat *) info.data)[i],
+        (gfloat) ((gint) expected[i] - zero_point) * scale);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (deq_buf);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  EXPECT_EQ (gst_harness_buffers_received (h2), 1U);
+  gst_harness_teardown (h);
+  gst_harness_teardown (h2);
+}
+
+/**
+ * @brief Test for tensor_transform dequantize to float64 (the scale in float64 precision)
+ */
+TEST (testTensorTransform, dequantizeFloat64)
+{
+  const guint array_size = 256;
+  const gdouble scale = 0.1;
+  const gint zero_point = -3;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_DEQUANTIZE, "option",
+      "float64,scale:0.1,zero-point:-3", NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT8;
+  gst_tensor_parse_dimension ("256", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, array_size);
+
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  for (i = 0; i < array_size; i++)
+    ((gint8 *) info.data)[i] = (gint8) (i - 128);
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size * sizeof (gdouble));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  /* not rounded to float32 (0.1f is not 0.1) */
+  for (i = 0; i < array_size; i++)
+    EXPECT_DOUBLE_EQ (((gdouble *) info.data)[i],
+        (gdouble) ((gint) i - 128 - zero_point) * scale);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quantize and dequantize (per-channel, saturation)
+ */
+TEST (testTensorTransform, quantizePerChannel)
+{
+  const guint array_size = 12;
+  const gfloat scale[3] = { 0.5f, 0.25f, 2.0f };
+  const gint zero_point[3] = { 0, -10, 5 };
+  const gfloat input[12] = { 1.0f, 1.0f, 1.0f, -100.0f, -100.0f, -100.0f,
+    100.0f, 100.0f, 100.0f, 0.75f, 0.125f, -3.0f };
+  const gint8 expected[12] = { 2, -6, 5, -128, -128, -45, 127, 127, 55,
+    2, -10, 3 };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_QUANTIZE, "option",
+      "int8,scale:0.5:0.25:2,zero-point:0:-10:5", NULL);
+
+  /* input tensor info, 3 channels */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT64;
+  gst_tensor_parse_dimension ("3:4", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, array_size * sizeof (gdouble));
+
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  for (i = 0; i < array_size; i++)
+    ((gdouble *) info.data)[i] = input[i];
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  /* rounded to the nearest even, 0.75 / 0.5 = 1.5 -> 2 and 0.125 / 0.25 = 0.5 -> 0 */
+  for (i = 0; i < array_size; i++)
+    EXPECT_EQ (((gint8 *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+
+  /* dequantize the output with the same parameters */
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_DEQUANTIZE, "option",
+      "float32,scale:0.5:0.25:2,zero-point:0:-10:5", NULL);
+
+  config.info.info[0].type = _NNS_INT8;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, array_size);
+
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, expected, array_size);
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size * sizeof (gfloat));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (((gfloat *) info.data)[i],
+        (expected[i] - zero_point[i % 3]) * scale[i % 3]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform typecast from/to float16.
+ */
+TEST (testTensorTransform, typecastFloat16)
+{
+  const guint array_size = 3000;
+
+  GstHarness *h, *h2;
+  GstBuffer *in_buf, *out_buf, *f32_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_TYPECAST, "option", "float16", NULL);
+
+  h2 = gst_harness_new ("tensor_transform");
+  g_object_set (h2->element, "mode", GTT_TYPECAST, "option", "float32", NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("3000", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_FLOAT16;
+  gst_harness_set_src_caps (h2, gst_tensors_caps_from_config (&config));
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+  EXPECT_EQ (data_out_size, data_in_size / 2);
+
+  /* set input buffer, the values are exact in float16 */
+  in_buf = gst_harness_create_buffer (h, data_in_size);
+
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+  for (i = 0; i < array_size; i++)
+    ((gfloat *) info.data)[i] = ((gint) i - 1500) * 0.25f;
+
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
 
-  /* push buffers */
-  for (b = 0; b < num_buffers; b++) {
-    /* set input buffer */
-    in_buf = gst_harness_create_buffer (h, data_in_size);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
 
-    mem = gst_buffer_peek_memory (in_buf, 0);
-    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-    for (i = 0; i < array_size; i++) {
-      uint8_t value = (i + 1) * (b + 1);
-      ((uint8_t *)info.data)[i] = value;
-    }
+  /* -375.0, 0.0, 1.0 and 374.75 in float16 */
+  EXPECT_EQ (((guint16 *) info.data)[0], 0xdddcU);
+  EXPECT_EQ (((guint16 *) info.data)[1500], 0x0000U);
+  EXPECT_EQ (((guint16 *) info.data)[1504], 0x3c00U);
+  EXPECT_EQ (((guint16 *) info.data)[2999], 0x5ddbU);
 
-    gst_memory_unmap (mem, &info);
+  gst_memory_unmap (mem, &info);
 
-    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  /* typecast back to float32 */
+  EXPECT_EQ (gst_harness_push (h2, out_buf), GST_FLOW_OK);
 
-    /* get output buffer */
-    out_buf = gst_harness_pull (h);
+  f32_buf = gst_harness_pull (h2);
 
-    ASSERT_TRUE (out_buf != NULL);
-    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
-    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+  ASSERT_TRUE (f32_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (f32_buf), data_in_size);
 
-    mem = gst_buffer_peek_memory (out_buf, 0);
-    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+  mem = gst_buffer_peek_memory (f32_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-    for (i = 0; i < array_size; i++) {
-      int32_t expected = (i + 1) * (b + 1) - 1;
-      EXPECT_EQ (((int32_t *)info.data)[i], expected);
-    }
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (((gfloat *) info.data)[i], ((gint) i - 1500) * 0.25f);
 
-    gst_memory_unmap (mem, &info);
-    gst_buffer_unref (out_buf);
-  }
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (f32_buf);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  EXPECT_EQ (gst_harness_buffers_received (h2), 1U);
   gst_harness_teardown (h);
+  gst_harness_teardown (h2);
 }
 
 /**
- * @brief Test for tensor_transform arithmetic (acceleration, typecast uint8 > int32, mul 2, div 2, add -1)
+ * @brief Test for tensor_transform arithmetic to bfloat16 (computed in float32).
  */
-TEST (testTensorTransform, arithmetic5Accel)
+TEST (testTensorTransform, arithmeticBfloat16)
 {
-  const guint num_buffers = 3;
-  const guint array_size = 5;
+  const guint array_size = 3000;
 
   GstHarness *h;
   GstBuffer *in_buf, *out_buf;
   GstTensorsConfig config;
   GstMemory *mem;
   GstMapInfo info;
-  guint i, b;
+  guint i;
   gsize data_in_size, data_out_size;
 
   h = gst_harness_new ("tensor_transform");
-
   g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
-      "typecast:int32,mul:2,div:2,add:-1", NULL);
-  g_object_set (h->element, "acceleration", (gboolean)TRUE, NULL);
+      "typecast:bfloat16,add:0.5,mul:2", NULL);
 
   /* input tensor info */
   gst_tensors_config_init (&config);
   config.info.num_tensors = 1;
   config.info.info[0].type = _NNS_UINT8;
-  gst_tensor_parse_dimension ("5", config.info.info[0].dimension);
+  gst_tensor_parse_dimension ("3000", config.info.info[0].dimension);
   config.rate_n = 0;
   config.rate_d = 1;
 
   gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
   data_in_size = gst_tensors_info_get_size (&config.info, 0);
 
-  config.info.info[0].type = _NNS_INT32;
+  config.info.info[0].type = _NNS_BFLOAT16;
   data_out_size = gst_tensors_info_get_size (&config.info, 0);
 
-  /* push buffers */
-  for (b = 0; b < num_buffers; b++) {
-    /* set input buffer */
-    in_buf = gst_harness_create_buffer (h, data_in_size);
+  /* set input buffer */
+  in_buf = gst_harness_create_buffer (h, data_in_size);
 
-    mem = gst_buffer_peek_memory (in_buf, 0);
-    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
 
-    for (i = 0; i < array_size; i++) {
-      uint8_t value = (i + 1) * (b + 1);
-      ((uint8_t *)info.data)[i] = value;
-    }
+  for (i = 0; i < array_size; i++)
+    ((guint8 *) info.data)[i] = (guint8) (i % 64);
 
-    gst_memory_unmap (mem, &info);
+  gst_memory_unmap (mem, &info);
 
-    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-    /* get output buffer */
-    out_buf = gst_harness_pull (h);
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
 
-    ASSERT_TRUE (out_buf != NULL);
-    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
-    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
 
-    mem = gst_buffer_peek_memory (out_buf, 0);
-    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
 
-    for (i = 0; i < array_size; i++) {
-      int32_t expected = (i + 1) * (b + 1) - 1;
-      EXPECT_EQ (((int32_t *)info.data)[i], expected);
-    }
+  /* (x + 0.5) * 2 is an odd integer up to 127, exact in bfloat16 */
+  for (i = 0; i < array_size; i++) {
+    guint32 bits = ((guint32) ((guint16 *) info.data)[i]) << 16;
+    gfloat value;
 
-    gst_memory_unmap (mem, &info);
-    gst_buffer_unref (out_buf);
+    memcpy (&value, &bits, sizeof (value));
+    EXPECT_FLOAT_EQ (value, (gfloat) ((i % 64) * 2 + 1));
   }
 
-  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
   gst_harness_teardown (h);
 }
 
@@ -2923,118 +3500,323 @@ TEST (testTensorConverter, bytesToMultiInvalidFrames_n)
   in_buf = gst_harness_create_buffer (h, data_size);
   EXPECT_EQ (GST_FLOW_NOT_NEGOTIATED, gst_harness_push (h, in_buf));
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (flexible to static tensor)
+ */
+TEST (testTensorConverter, flexToStaticInvalidBuffer1_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstMemory *mem;
+  GstTensorMetaInfo meta;
+  GstTensorInfo info;
+  GstCaps *caps;
+  gpointer data;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
+      "int32,int32", NULL);
+
+  /* in/out caps and tensors info */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_harness_set_src_caps (h, caps);
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.dimension);
+
+  /* push buffer (invalid number) */
+  in_buf = gst_buffer_new ();
+
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta);
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (flexible to static tensor)
+ */
+TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstMemory *mem;
+  GstTensorMetaInfo meta;
+  GstTensorsInfo info;
+  GstCaps *caps;
+  gpointer data;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
+      "int32,int32", NULL);
+
+  /* in/out caps and tensors info */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_harness_set_src_caps (h, caps);
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 2;
+
+  info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.info[0].dimension);
+  info.info[1].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.info[1].dimension);
+
+  /* push buffer (invalid buffer size) */
+  in_buf = gst_buffer_new ();
+
+  /* 1st mem block */
+  gst_tensor_info_convert_to_meta (&info.info[0], &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta);
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  /* 2nd mem block (invalid size) */
+  gst_tensor_info_convert_to_meta (&info.info[1], &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta) / 2;
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (video pre-processing, NV12 to normalized RGB in NCHW)
+ */
+TEST (testTensorConverter, videoPreprocNv12)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstCaps *caps;
+  GstMapInfo info;
+  guint8 *data;
+  gfloat *out;
+  guint c;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "output-size", "2:1", "output-format", "RGB",
+      "normalize", "mean:0,std:255", "layout", "NCHW", NULL);
+
+  /* NV12 4x2 (Y 4x2 and interleaved UV 2x1) */
+  caps = gst_caps_from_string ("video/x-raw,format=NV12,width=4,height=2,framerate=(fraction)30/1");
+  gst_harness_set_src_caps (h, caps);
+
+  in_buf = gst_harness_create_buffer (h, 12);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &info, GST_MAP_WRITE));
+  data = info.data;
+  /* black (Y=16) on the left and white (Y=235) on the right, no chroma */
+  for (c = 0; c < 8; c++)
+    data[c] = ((c % 4) < 2) ? 16 : 235;
+  memset (data + 8, 128, 4);
+  gst_buffer_unmap (in_buf, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer (2:1:3:1, float32) */
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 2U * 1U * 3U * sizeof (gfloat));
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (gfloat *) info.data;
+  for (c = 0; c < 3; c++) {
+    EXPECT_NEAR (out[c * 2], 0.0f, 0.0001f);
+    EXPECT_NEAR (out[c * 2 + 1], 1.0f, 0.0001f);
+  }
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (video pre-processing, RGB to BGR uint8 without padding)
+ */
+TEST (testTensorConverter, videoPreprocRgbToBgr)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstCaps *caps;
+  GstMapInfo info;
+  guint i, x, y;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "output-format", "BGR", NULL);
+
+  /* RGB 3x2, row stride is 12 */
+  caps = gst_caps_from_string ("video/x-raw,format=RGB,width=3,height=2,framerate=(fraction)30/1");
+  gst_harness_set_src_caps (h, caps);
+
+  in_buf = gst_harness_create_buffer (h, 24);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &info, GST_MAP_WRITE));
+  for (i = 0; i < 24; i++)
+    info.data[i] = i;
+  gst_buffer_unmap (in_buf, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 18U);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  for (y = 0; y < 2; y++) {
+    for (x = 0; x < 3; x++) {
+      for (i = 0; i < 3; i++)
+        EXPECT_EQ (info.data[(y * 3 + x) * 3 + i], y * 12 + x * 3 + (2 - i));
+    }
+  }
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
   gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_converter (flexible to static tensor)
+ * @brief Test for tensor_converter (yuv format without pre-processing options)
  */
-TEST (testTensorConverter, flexToStaticInvalidBuffer1_n)
+TEST (testTensorConverter, videoPreprocNoOption_n)
 {
   GstHarness *h;
   GstBuffer *in_buf;
-  GstMemory *mem;
-  GstTensorMetaInfo meta;
-  GstTensorInfo info;
   GstCaps *caps;
-  gpointer data;
-  gsize data_size;
 
   h = gst_harness_new ("tensor_converter");
 
-  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
-      "int32,int32", NULL);
-
-  /* in/out caps and tensors info */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  caps = gst_caps_from_string ("video/x-raw,format=NV12,width=4,height=2,framerate=(fraction)30/1");
   gst_harness_set_src_caps (h, caps);
 
-  gst_tensor_info_init (&info);
-  info.type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.dimension);
+  in_buf = gst_harness_create_buffer (h, 12);
+  EXPECT_EQ (GST_FLOW_NOT_NEGOTIATED, gst_harness_push (h, in_buf));
 
-  /* push buffer (invalid number) */
-  in_buf = gst_buffer_new ();
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
 
-  gst_tensor_info_convert_to_meta (&info, &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta);
+/**
+ * @brief Test for tensor_converter (invalid pre-processing options)
+ */
+TEST (testTensorConverter, videoPreprocInvalidOption_n)
+{
+  GstHarness *h;
+  gchar *str;
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+  h = gst_harness_new ("tensor_converter");
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  g_object_set (h->element, "output-size", "224", "normalize", "std:0",
+      "layout", "CHW", "output-type", "int8", NULL);
 
-  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  g_object_get (h->element, "output-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_get (h->element, "normalize", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  g_object_get (h->element, "layout", &str, NULL);
+  EXPECT_STREQ (str, "NHWC");
+  g_free (str);
+
+  g_object_get (h->element, "output-type", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
   gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_converter (flexible to static tensor)
+ * @brief Test for tensor_converter (pre-processing options cannot be changed in playing state)
  */
-TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
+TEST (testTensorConverter, videoPreprocChangeOption_n)
 {
   GstHarness *h;
-  GstBuffer *in_buf;
-  GstMemory *mem;
-  GstTensorMetaInfo meta;
-  GstTensorsInfo info;
+  GstBuffer *in_buf, *out_buf;
   GstCaps *caps;
-  gpointer data;
-  gsize data_size;
+  gchar *str;
 
   h = gst_harness_new ("tensor_converter");
 
-  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
-      "int32,int32", NULL);
+  g_object_set (h->element, "output-format", "BGR", NULL);
 
-  /* in/out caps and tensors info */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  caps = gst_caps_from_string ("video/x-raw,format=RGB,width=3,height=2,framerate=(fraction)30/1");
   gst_harness_set_src_caps (h, caps);
 
-  gst_tensors_info_init (&info);
-  info.num_tensors = 2;
-
-  info.info[0].type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.info[0].dimension);
-  info.info[1].type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.info[1].dimension);
-
-  /* push buffer (invalid buffer size) */
-  in_buf = gst_buffer_new ();
+  in_buf = gst_harness_create_buffer (h, 24);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* 1st mem block */
-  gst_tensor_info_convert_to_meta (&info.info[0], &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta);
+  /* the options are not changed after the caps are negotiated */
+  g_object_set (h->element, "output-size", "6:4", "output-type", "float32",
+      "layout", "NCHW", NULL);
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+  g_object_get (h->element, "output-size", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  g_object_get (h->element, "output-type", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
 
-  /* 2nd mem block (invalid size) */
-  gst_tensor_info_convert_to_meta (&info.info[1], &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta) / 2;
+  g_object_get (h->element, "layout", &str, NULL);
+  EXPECT_STREQ (str, "NHWC");
+  g_free (str);
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+  in_buf = gst_harness_create_buffer (h, 24);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  /* the output frame has the negotiated size */
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 18U);
+  gst_buffer_unref (out_buf);
 
-  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 18U);
+  gst_buffer_unref (out_buf);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  EXPECT_EQ (gst_harness_buffers_received (h), 2U);
   gst_harness_teardown (h);
 }
 
@@ -4722,6 +5504,187 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   g_free (test_model2);
 }
 
+/**
+ * @brief Push buffers until tensor_filter posts the model-reload message.
+ */
+static GstStructure *
+_push_until_model_reloaded (GstHarness *h, GstBus *bus, gsize in_size)
+{
+  GstMessage *msg;
+  GstBuffer *in_buf, *out_buf;
+  GstStructure *s = NULL;
+  guint i;
+
+  for (i = 0; i < 200 && s == NULL; i++) {
+    in_buf = gst_harness_create_buffer (h, in_size);
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    out_buf = gst_harness_pull (h);
+    gst_buffer_unref (out_buf);
+
+    while ((msg = gst_bus_pop_filtered (bus, GST_MESSAGE_ELEMENT)) != NULL) {
+      const GstStructure *ms = gst_message_get_structure (msg);
+
+      if (ms && gst_structure_has_name (ms, "tensor-filter-model-reload"))
+        s = gst_structure_copy (ms);
+      gst_message_unref (msg);
+    }
+
+    if (s == NULL)
+      g_usleep (10000);
+  }
+
+  return s;
+}
+
+/**
+ * @brief Test to reload tf-lite model in background and swap at the buffer boundary
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsyncSwap)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstStructure *s;
+  GstTensorConfig config;
+  gboolean success = FALSE;
+  gint64 load_time = -1;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model, *test_model2;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v2_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "is-updatable=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  wait_for_element_state (h->element, GST_STATE_PLAYING);
+
+  /* the first buffer opens the model */
+  EXPECT_EQ (gst_harness_push (h, gst_harness_create_buffer (h, 3 * 224 * 224)), GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+
+  /* the property is updated immediately, the current model keeps serving */
+  gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model2);
+  g_free (prop_string);
+
+  s = _push_until_model_reloaded (h, bus, 3 * 224 * 224);
+  ASSERT_TRUE (s != NULL);
+  EXPECT_STREQ (gst_structure_get_string (s, "model"), test_model2);
+  EXPECT_TRUE (gst_structure_get_boolean (s, "success", &success));
+  EXPECT_TRUE (success);
+  EXPECT_TRUE (gst_structure_get_int64 (s, "load-time", &load_time));
+  EXPECT_GE (load_time, 0);
+  EXPECT_TRUE (gst_structure_has_field (s, "swap-latency"));
+  gst_structure_free (s);
+
+  gst_element_set_bus (h->element, NULL);
+  gst_object_unref (bus);
+  gst_harness_teardown (h);
+  g_free (test_model);
+  g_free (test_model2);
+}
+
+/**
+ * @brief Test to reload tf-lite model in background with unmatched dimension (negative)
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsyncWrongDims_n)
+{
+  GstHarness *h;
+  GstBus *bus;
+  GstStructure *s;
+  GstTensorConfig config;
+  gboolean success = TRUE;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model, *test_model2;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  /* it has unmatched dimension with mobilenet v1 */
+  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
+      "add.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "is-updatable=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensor_caps_from_config (&config));
+  wait_for_element_state (h->element, GST_STATE_PLAYING);
+
+  EXPECT_EQ (gst_harness_push (h, gst_harness_create_buffer (h, 3 * 224 * 224)), GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+
+  gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
+
+  /* the current model keeps serving and the property is restored */
+  s = _push_until_model_reloaded (h, bus, 3 * 224 * 224);
+  ASSERT_TRUE (s != NULL);
+  EXPECT_TRUE (gst_structure_get_boolean (s, "success", &success));
+  EXPECT_FALSE (success);
+  gst_structure_free (s);
+
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model);
+  g_free (prop_string);
+
+  gst_element_set_bus (h->element, NULL);
+  gst_object_unref (bus);
+  gst_harness_teardown (h);
+  g_free (test_model);
+  g_free (test_model2);
+}
+
 /**
  * @brief Test to reload tf-lite; model does not exist (negative)
  */
@@ -6984,6 +7947,85 @@ TEST (testTensorCrop, infoDelayed_n)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Internal function to push a buffer with given timestamp.
+ */
+static void
+_mux_test_push_buffer (GstHarness * h, GstClockTime ts)
+{
+  GstBuffer *in_buf;
+
+  in_buf = gst_harness_create_buffer (h, 4U);
+  GST_BUFFER_PTS (in_buf) = ts;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+}
+
+/**
+ * @brief Test for tensor_mux, nearest sync mode (fast pad is not blocked by slow pad).
+ */
+TEST (testTensorMux, syncNearest)
+{
+  GstHarness *h, *h0, *h1;
+  GstTensorConfig config;
+  GstBuffer *out_buf;
+  GstStructure *stats = NULL;
+  guint64 received, dropped;
+  guint i;
+
+  h = gst_harness_new_with_padnames ("tensor_mux", NULL, "src");
+  g_object_set (h->element, "sync-mode", "nearest", "sync-option", "4", NULL);
+
+  h0 = gst_harness_new_with_element (h->element, "sink_0", NULL);
+  h1 = gst_harness_new_with_element (h->element, "sink_1", NULL);
+
+  gst_tensor_config_init (&config);
+  config.info.type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", config.info.dimension);
+  config.rate_n = 30;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h0, gst_tensor_caps_from_config (&config));
+  gst_harness_set_src_caps (h1, gst_tensor_caps_from_config (&config));
+
+  /* fast pad receives 4 buffers before slow pad */
+  for (i = 0; i < 4U; i++)
+    _mux_test_push_buffer (h0, i * 33333333U);
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+
+  _mux_test_push_buffer (h1, 0);
+  EXPECT_EQ (_harness_wait_for_output_buffer (h, 1U), 1U);
+
+  /* 33333333 and 66666666 are dropped, 99999999 is the nearest one */
+  _mux_test_push_buffer (h1, 100000000U);
+  EXPECT_EQ (_harness_wait_for_output_buffer (h, 2U), 2U);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (GST_BUFFER_PTS (out_buf), 0U);
+  gst_buffer_unref (out_buf);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (GST_BUFFER_PTS (out_buf), 99999999U);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 2U);
+  gst_buffer_unref (out_buf);
+
+  g_object_get (h->element, "sync-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "sink_0-received", &received));
+  EXPECT_EQ (received, 4U);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "sink_0-dropped", &dropped));
+  EXPECT_EQ (dropped, 2U);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "sink_1-received", &received));
+  EXPECT_EQ (received, 2U);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "sink_1-dropped", &dropped));
+  EXPECT_EQ (dropped, 0U);
+
+  gst_structure_free (stats);
+  gst_harness_teardown (h0);
+  gst_harness_teardown (h1);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -0,0 +1,288 @@
+/**
+ * @file    unittest_query.cc
+ * @date    20 Jul 2021
+ * @brief   Unit test for tensor_query elements
+ * @see     https://github.com/nnstreamer/nnstreamer
+ * @author  Junhwan Kim <jejudo.kim@samsung.com>
+ * @bug     No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <gio/gio.h>
+
+
+/**
+ * @brief Test tensor_query elements existence.
+ */
+TEST (tensorQuery, checkExistence)
+{
+  const gchar *names[] = { "tensor_query_serversrc",
+      "tensor_query_serversink", "tensor_query_client" };
+  GstElementFactory *factory;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (names); i++) {
+    factory = gst_element_factory_find (names[i]);
+    EXPECT_TRUE (factory != NULL);
+    gst_object_unref (factory);
+  }
+}
+
+/**
+ * @brief Test properties of tensor_query_client.
+ */
+TEST (tensorQuery, clientProperties)
+{
+  GstElement *client;
+  gchar *str;
+  guint val;
+  guint64 latency;
+
+  client = gst_element_factory_make ("tensor_query_client", NULL);
+  ASSERT_TRUE (client != NULL);
+
+  g_object_get (client, "host", &str, "port", &val, NULL);
+  EXPECT_STREQ (str, "localhost");
+  EXPECT_EQ (val, 3001U);
+  g_free (str);
+
+  g_object_get (client, "protocol", &str, "max-in-flight", &val, NULL);
+  EXPECT_STREQ (str, "tcp");
+  EXPECT_EQ (val, 4U);
+  g_free (str);
+
+  g_object_set (client, "host", "127.0.0.1", "port", 5001,
+      "max-in-flight", 8, NULL);
+  g_object_get (client, "host", &str, "port", &val, NULL);
+  EXPECT_STREQ (str, "127.0.0.1");
+  EXPECT_EQ (val, 5001U);
+  g_free (str);
+
+  g_object_get (client, "max-in-flight", &val, "latency", &latency, NULL);
+  EXPECT_EQ (val, 8U);
+  EXPECT_EQ (latency, 0U);
+
+  gst_object_unref (client);
+}
+
+/**
+ * @brief Test invalid protocol (negative).
+ */
+TEST (tensorQuery, invalidProtocol_n)
+{
+  GstElement *src;
+  gchar *str;
+
+  src = gst_element_factory_make ("tensor_query_serversrc", NULL);
+  ASSERT_TRUE (src != NULL);
+
+  g_object_set (src, "protocol", "invalid", NULL);
+  g_object_get (src, "protocol", &str, NULL);
+  EXPECT_STREQ (str, "tcp");
+  g_free (str);
+
+  /* not supported yet */
+  g_object_set (src, "protocol", "udp", "port", 0, NULL);
+  EXPECT_EQ (gst_element_set_state (src, GST_STATE_PAUSED),
+      GST_STATE_CHANGE_FAILURE);
+
+  gst_element_set_state (src, GST_STATE_NULL);
+  gst_object_unref (src);
+}
+
+/**
+ * @brief Test the client without the server (negative).
+ */
+TEST (tensorQuery, connectFail_n)
+{
+  GstElement *client;
+  GSocketListener *listener;
+  guint16 port;
+
+  /* get an available port and close it */
+  listener = g_socket_listener_new ();
+  port = g_socket_listener_add_any_inet_port (listener, NULL, NULL);
+  ASSERT_GT (port, 0);
+  g_socket_listener_close (listener);
+  g_object_unref (listener);
+
+  client = gst_element_factory_make ("tensor_query_client", NULL);
+  ASSERT_TRUE (client != NULL);
+
+  g_object_set (client, "port", port, NULL);
+  EXPECT_EQ (gst_element_set_state (client, GST_STATE_PAUSED),
+      GST_STATE_CHANGE_FAILURE);
+
+  gst_element_set_state (client, GST_STATE_NULL);
+  gst_object_unref (client);
+}
+
+/**
+ * @brief Callback for tensor sink signal.
+ */
+static void
+_new_data_cb (GstElement * element, GstBuffer * buffer, gpointer user_data)
+{
+  guint *received = (guint *) user_data;
+
+  /* 4x4 gray image, typecast to float32 by the server */
+  if (gst_buffer_get_size (buffer) == 4 * 4 * sizeof (float))
+    (*received)++;
+}
+
+/**
+ * @brief Test offloading the requests to the server with pipelining.
+ */
+TEST (tensorQuery, loopback)
+{
+  GstElement *server, *client;
+  GstElement *server_src, *query_client, *sink;
+  gchar *str_pipeline;
+  guint port, i;
+  guint received = 0;
+  guint64 latency, max_latency;
+
+  /* server: requests are incremented and returned to the client */
+  server = gst_parse_launch (
+      "tensor_query_serversrc name=src host=localhost port=0 ! "
+      "tensor_transform mode=arithmetic option=typecast:float32,add:1 ! "
+      "tensor_query_serversink", NULL);
+  ASSERT_TRUE (server != NULL);
+
+  server_src = gst_bin_get_by_name (GST_BIN (server), "src");
+  ASSERT_TRUE (server_src != NULL);
+
+  gst_element_set_state (server, GST_STATE_PLAYING);
+  g_usleep (G_USEC_PER_SEC / 10);
+
+  /* the server listens on a random available port */
+  g_object_get (server_src, "port", &port, NULL);
+  ASSERT_GT (port, 0U);
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=10 ! "
+      "video/x-raw,format=GRAY8,width=4,height=4,framerate=30/1 ! "
+      "tensor_converter ! "
+      "tensor_query_client name=client host=localhost port=%u max-in-flight=2 ! "
+      "tensor_sink name=sink", port);
+  client = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (client != NULL);
+
+  query_client = gst_bin_get_by_name (GST_BIN (client), "client");
+  sink = gst_bin_get_by_name (GST_BIN (client), "sink");
+  ASSERT_TRUE (query_client != NULL);
+  ASSERT_TRUE (sink != NULL);
+
+  g_signal_connect (sink, "new-data", G_CALLBACK (_new_data_cb), &received);
+
+  gst_element_set_state (client, GST_STATE_PLAYING);
+
+  /* wait until all responses arrive (3 sec at most) */
+  for (i = 0; i < 30 && received < 10U; i++)
+    g_usleep (G_USEC_PER_SEC / 10);
+  EXPECT_EQ (received, 10U);
+
+  g_object_get (query_client, "latency", &latency,
+      "max-latency", &max_latency, NULL);
+  EXPECT_GT (latency, 0U);
+  EXPECT_GE (max_latency, latency);
+
+  gst_element_set_state (client, GST_STATE_NULL);
+  gst_element_set_state (server, GST_STATE_NULL);
+
+  gst_object_unref (query_client);
+  gst_object_unref (sink);
+  gst_object_unref (client);
+  gst_object_unref (server_src);
+  gst_object_unref (server);
+}
+
+/**
+ * @brief Test the requests not responded by the server, the client should not be blocked.
+ */
+TEST (tensorQuery, requestTimeout)
+{
+  GstElement *server, *client;
+  GstElement *server_src, *sink;
+  GstBus *bus;
+  GstMessage *msg;
+  gchar *str_pipeline;
+  guint port;
+  guint received = 0;
+
+  /* server: requests are dropped */
+  server = gst_parse_launch (
+      "tensor_query_serversrc name=src host=localhost port=0 ! fakesink", NULL);
+  ASSERT_TRUE (server != NULL);
+
+  server_src = gst_bin_get_by_name (GST_BIN (server), "src");
+  ASSERT_TRUE (server_src != NULL);
+
+  gst_element_set_state (server, GST_STATE_PLAYING);
+  g_usleep (G_USEC_PER_SEC / 10);
+
+  g_object_get (server_src, "port", &port, NULL);
+  ASSERT_GT (port, 0U);
+
+  str_pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=5 ! "
+      "video/x-raw,format=GRAY8,width=4,height=4,framerate=30/1 ! "
+      "tensor_converter ! "
+      "tensor_query_client host=localhost port=%u max-in-flight=1 timeout=100 ! "
+      "tensor_sink name=sink", port);
+  client = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_TRUE (client != NULL);
+
+  sink = gst_bin_get_by_name (GST_BIN (client), "sink");
+  ASSERT_TRUE (sink != NULL);
+  g_signal_connect (sink, "new-data", G_CALLBACK (_new_data_cb), &received);
+
+  gst_element_set_state (client, GST_STATE_PLAYING);
+
+  /* each request expires after the timeout, then the stream reaches EOS */
+  bus = gst_element_get_bus (client);
+  msg = gst_bus_timed_pop_filtered (bus, 5 * GST_SECOND,
+      (GstMessageType) (GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+  ASSERT_TRUE (msg != NULL);
+  EXPECT_EQ (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  EXPECT_EQ (received, 0U);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (client, GST_STATE_NULL);
+  gst_element_set_state (server, GST_STATE_NULL);
+
+  gst_object_unref (sink);
+  gst_object_unref (client);
+  gst_object_unref (server_src);
+  gst_object_unref (server);
+}
+
+/**
+ * @brief gtest main
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -1385,6 +1385,185 @@ TEST (tensorSinkTest, signalRate)
   _free_test_data (option);
 }
 
+/**
+ * @brief Callback for the source of tensor sink (pull-mode).
+ */
+static gboolean
+_ring_source_cb (gpointer user_data)
+{
+  GstBuffer *buffer = NULL;
+  guint *pulled = (guint *) user_data;
+
+  g_signal_emit_by_name (g_test_data.sink, "try-pull", (guint64) 0, &buffer);
+  if (buffer == NULL)
+    return G_SOURCE_REMOVE;
+
+  (*pulled)++;
+  gst_buffer_unref (buffer);
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Test for tensor sink pull-mode (drop the oldest buffers).
+ */
+TEST (tensorSinkTest, ringDropOldest)
+{
+  const guint num_buffers = 5;
+  guint max_buffers = 0;
+  guint64 dropped = 0;
+  GstBufferList *list = NULL;
+  GstBuffer *buffer = NULL;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  /** default max-buffers is 0 (pull-mode disabled) */
+  g_object_get (g_test_data.sink, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (max_buffers, 0U);
+
+  g_object_set (g_test_data.sink, "max-buffers", 2U, NULL);
+  g_object_get (g_test_data.sink, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (max_buffers, 2U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** no signal for new data in pull-mode */
+  EXPECT_EQ (g_test_data.received, 0U);
+
+  /** the ring keeps the newest 2 buffers */
+  g_object_get (g_test_data.sink, "dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, (guint64) (num_buffers - 2));
+
+  g_signal_emit_by_name (g_test_data.sink, "pull-batch", 0U, (guint64) 0, &list);
+  ASSERT_TRUE (list != NULL);
+  EXPECT_EQ (gst_buffer_list_length (list), 2U);
+  gst_buffer_list_unref (list);
+
+  /** eos, no more buffer */
+  g_signal_emit_by_name (g_test_data.sink, "pull", &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull-mode (block the streaming thread).
+ */
+TEST (tensorSinkTest, ringBlock)
+{
+  const guint num_buffers = 10;
+  guint pulled = 0;
+  guint64 dropped = 0;
+  GstBuffer *buffer = NULL;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "max-buffers", 1U, NULL);
+  gst_util_set_object_arg (G_OBJECT (g_test_data.sink), "ring-policy", "block");
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+
+  /** pull all buffers, returns null at eos */
+  do {
+    g_signal_emit_by_name (g_test_data.sink, "pull", &buffer);
+    if (buffer) {
+      EXPECT_TRUE (GST_IS_BUFFER (buffer));
+      gst_buffer_unref (buffer);
+      pulled++;
+    }
+  } while (buffer != NULL);
+
+  EXPECT_EQ (pulled, num_buffers);
+  g_object_get (g_test_data.sink, "dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, 0U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull-mode with the source in main loop.
+ */
+TEST (tensorSinkTest, ringSource)
+{
+  const guint num_buffers = 10;
+  guint pulled = 0;
+  gint fd = -1;
+  GSource *source = NULL;
+  GstBuffer *buffer = NULL;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "max-buffers", num_buffers, NULL);
+  g_object_get (g_test_data.sink, "fd", &fd, NULL);
+#ifdef __linux__
+  EXPECT_GE (fd, 0);
+#endif
+
+  g_signal_emit_by_name (g_test_data.sink, "create-source", &source);
+  ASSERT_TRUE (source != NULL);
+  g_source_set_callback (source, _ring_source_cb, &pulled, NULL);
+  g_source_attach (source, NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** pull remained buffers */
+  do {
+    g_signal_emit_by_name (g_test_data.sink, "try-pull", (guint64) 0, &buffer);
+    if (buffer) {
+      gst_buffer_unref (buffer);
+      pulled++;
+    }
+  } while (buffer != NULL);
+
+  EXPECT_EQ (pulled, num_buffers);
+  EXPECT_EQ (g_test_data.received, 0U);
+
+  g_source_destroy (source);
+  g_source_unref (source);
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull-mode (pull when the element is stopped).
+ */
+TEST (tensorSinkTest, ringPullStopped_n)
+{
+  GstBuffer *buffer = NULL;
+  GstBufferList *list = NULL;
+  TestOption option = { 1, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "max-buffers", 3U, NULL);
+
+  g_signal_emit_by_name (g_test_data.sink, "try-pull", (guint64) (10 * GST_MSECOND), &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  g_signal_emit_by_name (g_test_data.sink, "pull-batch", 3U, (guint64) (10 * GST_MSECOND), &list);
+  EXPECT_TRUE (list == NULL);
+
+  _free_test_data (option);
+}
+
 /**
  * @brief Test for caps negotiation failed.
  */
@@ -3908,6 +4087,67 @@ TEST (tensorStreamTest, filterProperties4_n)
   _free_test_data (option);
 }
 
+/**
+ * @brief Test for the latency statistics of tensor filter.
+ */
+TEST (tensorStreamTest, filterLatencyStats)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  GstStructure *stats = NULL;
+  guint report, samples;
+  gint64 p50, p90, p99, invoke;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  /* profiling is off by default */
+  g_object_get (filter, "latency-report", &report, "latency-stats", &stats, NULL);
+  EXPECT_EQ (report, 0U);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_get_uint (stats, "samples", &samples));
+  EXPECT_EQ (samples, 0U);
+  gst_structure_free (stats);
+
+  g_object_set (filter, "latency-report", 10U, NULL);
+  g_object_get (filter, "latency-report", &report, NULL);
+  EXPECT_EQ (report, 10U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+
+  g_object_get (filter, "latency-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_has_name (stats, "tensor-filter-latency"));
+  EXPECT_TRUE (gst_structure_get_uint (stats, "samples", &samples));
+  EXPECT_EQ (samples, num_buffers);
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "p50", &p50));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "p90", &p90));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "p99", &p99));
+  EXPECT_TRUE (gst_structure_get_int64 (stats, "invoke", &invoke));
+  EXPECT_TRUE (gst_structure_has_field (stats, "map"));
+  EXPECT_TRUE (gst_structure_has_field (stats, "unmap"));
+  EXPECT_TRUE (gst_structure_has_field (stats, "wrap"));
+  EXPECT_GE (p50, 0);
+  EXPECT_LE (p50, p90);
+  EXPECT_LE (p90, p99);
+  EXPECT_LE (invoke, p99);
+  gst_structure_free (stats);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
 /**
  * @brief Test to drop incoming buffer in tensor_filter using custom filter.
  */
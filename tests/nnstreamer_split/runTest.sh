@@ -67,4 +67,27 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  multifilesrc location=\"testsequen
 callCompareTest testcase_stream_2_0.golden split07_0.log 7_0 "Compare 7-0" 1 0
 callCompareTest testcase_stream_2_1.golden split07_1.log 7_1 "Compare 7-1" 1 0
 
+# Test split along the dimension (strided, RGB to the planes)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=testcase_RGB_100x100.png ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format = RGB, width=100, height=100, framerate=0/1 ! tensor_converter ! tensor_split name=split split-dim=0 tensorseg=1:100:100,2:100:100 split. ! queue ! filesink location=split08_0.log split. ! queue ! filesink location=split08_1.log" 8 0 0 $PERFORMANCE
+python3 -c "
+d = open('testcase_0_0.golden', 'rb').read()
+open('testcase_8_0.golden', 'wb').write(d[0::3])
+open('testcase_8_1.golden', 'wb').write(b''.join(d[i + 1:i + 3] for i in range(0, len(d), 3)))
+"
+callCompareTest testcase_8_0.golden split08_0.log 8_0 "Compare 8-0" 1 0
+callCompareTest testcase_8_1.golden split08_1.log 8_1 "Compare 8-1" 1 0
+
+# Test split along the outermost dimension (contiguous, zero-copy)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=testcase_RGB_100x100.png ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format = RGB, width=100, height=100, framerate=0/1 ! tensor_converter ! tensor_split name=split split-dim=2 tensorseg=3:100:40,3:100:60 split. ! queue ! filesink location=split09_0.log split. ! queue ! filesink location=split09_1.log" 9 0 0 $PERFORMANCE
+python3 -c "
+d = open('testcase_0_0.golden', 'rb').read()
+open('testcase_9_0.golden', 'wb').write(d[:12000])
+open('testcase_9_1.golden', 'wb').write(d[12000:])
+"
+callCompareTest testcase_9_0.golden split09_0.log 9_0 "Compare 9-0" 1 0
+callCompareTest testcase_9_1.golden split09_1.log 9_1 "Compare 9-1" 1 0
+
+# Test invalid tensorseg with split-dim (the other dimensions differ)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=testcase_RGB_100x100.png ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format = RGB, width=100, height=100, framerate=0/1 ! tensor_converter ! tensor_split name=split split-dim=0 tensorseg=1:100:50,2:100:50 split. ! queue ! filesink location=split10_0.log split. ! queue ! filesink location=split10_1.log" 10_n 0 1 $PERFORMANCE
+
 report
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# @file runTest.sh
+# @author Samsung Electronics Co., Ltd.
+# @date Oct 18 2021
+# @brief SSAT Test Cases for NNStreamer tracer
+#
+
+if [[ "$SSATAPILOADED" != "1" ]]; then
+    SILENT=0
+    INDEPENDENT=1
+    search="ssat-api.sh"
+    source $search
+    printf "${Blue}Independent Mode${NC}
+"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+PATH_TO_PLUGIN="../../build"
+
+rm -f report_*.log
+
+# Text report at EOS
+export GST_TRACERS="nnstreamer(file=report_1.log)"
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=10 ! video/x-raw,width=160,height=120,format=RGB,framerate=30/1 ! tensor_converter ! queue ! tensor_transform mode=typecast option=float32 ! fakesink" 1 0 0 $PERFORMANCE
+unset GST_TRACERS
+
+grep -q "tensor_converter" report_1.log && grep -q "tensor_transform" report_1.log && grep -q "queue" report_1.log
+testResult $? 1-1 "Text report of the pipeline" 0 1
+
+# JSON report, the bytes and buffers of the elements
+export GST_TRACERS="nnstreamer(format=json,file=report_2.log)"
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=10 ! video/x-raw,width=160,height=120,format=RGB,framerate=30/1 ! tensor_converter ! queue ! tensor_transform mode=typecast option=float32 ! fakesink" 2 0 0 $PERFORMANCE
+unset GST_TRACERS
+
+python3 -c "
+import json
+report = json.load(open('report_2.log'))
+elements = {e['factory']: e for e in report['elements']}
+assert 'videotestsrc' not in elements
+assert elements['tensor_converter']['buffers_in'] == 10
+assert elements['tensor_converter']['bytes_out'] == 10 * 3 * 160 * 120
+assert elements['tensor_transform']['bytes_out'] == 10 * 4 * 3 * 160 * 120
+assert elements['queue']['buffers_out'] == 10
+"
+testResult $? 2-1 "JSON report of the pipeline" 0 1
+
+# Trace all elements
+export GST_TRACERS="nnstreamer(format=json,all=true,file=report_3.log)"
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=10 ! video/x-raw,width=160,height=120,format=RGB,framerate=30/1 ! tensor_converter ! fakesink" 3 0 0 $PERFORMANCE
+unset GST_TRACERS
+
+python3 -c "
+import json
+report = json.load(open('report_3.log'))
+elements = {e['factory']: e for e in report['elements']}
+assert elements['videotestsrc']['buffers_out'] == 10
+assert elements['fakesink']['buffers_in'] == 10
+"
+testResult $? 3-1 "JSON report of all elements" 0 1
+
+rm -f report_*.log
+
+report